@@ -0,0 +1,133 @@
+#version 330
+
+// Фрагментный шейдер PBR (Cook-Torrance, GGX), общий для всех вариантов pbr*.vs.
+// Каналы как у metallicRoughness glTF: AO в R, roughness в G, metallic в B.
+// Отдельные одноканальные карты дают одно значение во всех каналах и читаются так же.
+// ormPacked = 1: все три канала в одной ORM текстуре слота metallicMap,
+// roughnessMap и aoMap не привязаны (PBRMaterial::setOrmPacked).
+
+#define MAX_LIGHTS 16
+
+#define LIGHT_POINT       0
+#define LIGHT_DIRECTIONAL 1
+#define LIGHT_SPOT        2
+
+const float PI = 3.14159265359;
+
+struct Light {
+    int enabled;
+    int type;
+    vec3 position;
+    vec3 direction;
+    vec3 color;
+    float intensity;
+    float cutoff;        // косинус внутреннего угла
+    float outerCutoff;   // косинус внешнего угла
+};
+
+in vec3 fragPosition;
+in vec2 fragTexCoord;
+in vec4 fragColor;
+in vec3 fragNormal;
+in mat3 TBN;
+
+uniform sampler2D albedoMap;
+uniform sampler2D normalMap;
+uniform sampler2D metallicMap;
+uniform sampler2D roughnessMap;
+uniform sampler2D aoMap;
+uniform vec4 colDiffuse;
+uniform int ormPacked;
+
+uniform vec3 viewPos;
+uniform int lightCount;
+uniform vec3 ambientColor;
+uniform Light lights[MAX_LIGHTS];
+
+out vec4 finalColor;
+
+float distributionGGX(vec3 N, vec3 H, float roughness)
+{
+    float a = roughness * roughness;
+    float a2 = a * a;
+    float NdotH = max(dot(N, H), 0.0);
+    float denom = NdotH * NdotH * (a2 - 1.0) + 1.0;
+    return a2 / (PI * denom * denom);
+}
+
+float geometrySchlickGGX(float NdotX, float roughness)
+{
+    float r = roughness + 1.0;
+    float k = r * r / 8.0;
+    return NdotX / (NdotX * (1.0 - k) + k);
+}
+
+vec3 fresnelSchlick(float cosTheta, vec3 F0)
+{
+    return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
+}
+
+void main()
+{
+    vec4 albedoSample = texture(albedoMap, fragTexCoord) * colDiffuse * fragColor;
+    vec3 albedo = pow(albedoSample.rgb, vec3(2.2));
+
+    vec3 metalSample = texture(metallicMap, fragTexCoord).rgb;
+    float metallic = metalSample.b;
+    float roughness;
+    float ao;
+    if (ormPacked != 0) {
+        roughness = metalSample.g;
+        ao = metalSample.r;
+    } else {
+        roughness = texture(roughnessMap, fragTexCoord).g;
+        ao = texture(aoMap, fragTexCoord).r;
+    }
+    roughness = clamp(roughness, 0.04, 1.0);
+
+    vec3 N = normalize(TBN * (texture(normalMap, fragTexCoord).rgb * 2.0 - 1.0));
+    vec3 V = normalize(viewPos - fragPosition);
+    vec3 F0 = mix(vec3(0.04), albedo, metallic);
+
+    vec3 Lo = vec3(0.0);
+    for (int i = 0; i < MAX_LIGHTS; ++i) {
+        if (i >= lightCount) break;
+        if (lights[i].enabled == 0) continue;
+
+        vec3 L;
+        float attenuation = 1.0;
+        if (lights[i].type == LIGHT_DIRECTIONAL) {
+            L = normalize(-lights[i].direction);
+        } else {
+            vec3 toLight = lights[i].position - fragPosition;
+            float distance = length(toLight);
+            L = toLight / distance;
+            attenuation = 1.0 / (distance * distance);
+            if (lights[i].type == LIGHT_SPOT) {
+                float theta = dot(L, normalize(-lights[i].direction));
+                float epsilon = max(lights[i].cutoff - lights[i].outerCutoff, 1e-4);
+                attenuation *= clamp((theta - lights[i].outerCutoff) / epsilon, 0.0, 1.0);
+            }
+        }
+
+        vec3 H = normalize(V + L);
+        float NdotL = max(dot(N, L), 0.0);
+        float NdotV = max(dot(N, V), 0.0);
+
+        float D = distributionGGX(N, H, roughness);
+        float G = geometrySchlickGGX(NdotV, roughness) * geometrySchlickGGX(NdotL, roughness);
+        vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
+
+        vec3 specular = D * G * F / (4.0 * NdotV * NdotL + 1e-4);
+        vec3 kD = (vec3(1.0) - F) * (1.0 - metallic);
+
+        vec3 radiance = lights[i].color * lights[i].intensity * attenuation;
+        Lo += (kD * albedo / PI + specular) * radiance * NdotL;
+    }
+
+    vec3 color = ambientColor * albedo * ao + Lo;
+    color = color / (color + vec3(1.0));
+    color = pow(color, vec3(1.0 / 2.2));
+
+    finalColor = vec4(color, albedoSample.a);
+}
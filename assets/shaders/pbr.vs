@@ -0,0 +1,37 @@
+#version 330
+
+// Базовый вершинный шейдер PBR: float атрибуты, матрица модели uniform'ом.
+// Выходы общие для всех вариантов, их читает pbr.fs.
+
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec3 vertexNormal;
+in vec4 vertexTangent;
+in vec4 vertexColor;
+
+uniform mat4 mvp;
+uniform mat4 matModel;
+
+out vec3 fragPosition;
+out vec2 fragTexCoord;
+out vec4 fragColor;
+out vec3 fragNormal;
+out mat3 TBN;
+
+void main()
+{
+    mat3 normalMatrix = transpose(inverse(mat3(matModel)));
+
+    vec3 N = normalize(normalMatrix * vertexNormal);
+    vec3 T = normalize(normalMatrix * vertexTangent.xyz);
+    T = normalize(T - dot(T, N) * N);
+    vec3 B = cross(N, T) * vertexTangent.w;
+
+    fragPosition = vec3(matModel * vec4(vertexPosition, 1.0));
+    fragTexCoord = vertexTexCoord;
+    fragColor = vertexColor;
+    fragNormal = N;
+    TBN = mat3(T, B, N);
+
+    gl_Position = mvp * vec4(vertexPosition, 1.0);
+}
@@ -0,0 +1,37 @@
+#version 330
+
+// Инстансный вариант pbr.vs: матрица модели приходит атрибутом на инстанс,
+// mvp содержит только view * projection. Выходы совпадают с pbr.vs.
+
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec3 vertexNormal;
+in vec4 vertexTangent;
+in vec4 vertexColor;
+in mat4 instanceTransform;
+
+uniform mat4 mvp;
+
+out vec3 fragPosition;
+out vec2 fragTexCoord;
+out vec4 fragColor;
+out vec3 fragNormal;
+out mat3 TBN;
+
+void main()
+{
+    mat3 normalMatrix = transpose(inverse(mat3(instanceTransform)));
+
+    vec3 N = normalize(normalMatrix * vertexNormal);
+    vec3 T = normalize(normalMatrix * vertexTangent.xyz);
+    T = normalize(T - dot(T, N) * N);
+    vec3 B = cross(N, T) * vertexTangent.w;
+
+    fragPosition = vec3(instanceTransform * vec4(vertexPosition, 1.0));
+    fragTexCoord = vertexTexCoord;
+    fragColor = vertexColor;
+    fragNormal = N;
+    TBN = mat3(T, B, N);
+
+    gl_Position = mvp * vec4(fragPosition, 1.0);
+}
@@ -0,0 +1,55 @@
+#version 330
+
+// Вариант pbr.vs для сжатого interleaved формата (VertexFormat::Packed).
+// Декодирование должно совпадать с packMesh в VertexQuantization.cpp.
+
+in vec4 vertexPosition;   // xyz: unorm16 в AABB меша, w: знак тангента (0 / 1)
+in vec2 vertexTexCoord;   // half-float или unorm16 в диапазоне UV меша
+in vec2 vertexNormal;     // octahedral snorm16
+in vec2 vertexTangent;    // octahedral snorm16
+in vec4 vertexColor;
+
+uniform mat4 mvp;
+uniform mat4 matModel;
+
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+uniform vec2 texcoordOffset;
+uniform vec2 texcoordScale;
+
+out vec3 fragPosition;
+out vec2 fragTexCoord;
+out vec4 fragColor;
+out vec3 fragNormal;
+out mat3 TBN;
+
+vec3 octDecode(vec2 e)
+{
+    e = max(e, vec2(-1.0));
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+void main()
+{
+    vec3 position = positionOffset + vertexPosition.xyz * positionScale;
+    float tangentSign = vertexPosition.w * 2.0 - 1.0;
+
+    mat3 normalMatrix = transpose(inverse(mat3(matModel)));
+
+    vec3 N = normalize(normalMatrix * octDecode(vertexNormal));
+    vec3 T = normalize(normalMatrix * octDecode(vertexTangent));
+    T = normalize(T - dot(T, N) * N);
+    vec3 B = cross(N, T) * tangentSign;
+
+    fragPosition = vec3(matModel * vec4(position, 1.0));
+    fragTexCoord = texcoordOffset + vertexTexCoord * texcoordScale;
+    fragColor = vertexColor;
+    fragNormal = N;
+    TBN = mat3(T, B, N);
+
+    gl_Position = mvp * vec4(position, 1.0);
+}
@@ -0,0 +1,49 @@
+#version 330
+
+// Вариант pbr.vs со скиннингом на GPU: до 4 костей на вершину.
+// Размер палитры должен совпадать с MaxGpuSkinningJoints (animation/Skinning.hpp).
+
+#define MAX_BONES 128
+
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec3 vertexNormal;
+in vec4 vertexTangent;
+in vec4 vertexColor;
+in vec4 vertexBoneIds;      // индексы суставов (unsigned byte без нормализации)
+in vec4 vertexBoneWeights;  // сумма весов = 1
+
+uniform mat4 mvp;
+uniform mat4 matModel;
+uniform mat4 boneMatrices[MAX_BONES];
+
+out vec3 fragPosition;
+out vec2 fragTexCoord;
+out vec4 fragColor;
+out vec3 fragNormal;
+out mat3 TBN;
+
+void main()
+{
+    mat4 skin = boneMatrices[int(vertexBoneIds.x)] * vertexBoneWeights.x +
+                boneMatrices[int(vertexBoneIds.y)] * vertexBoneWeights.y +
+                boneMatrices[int(vertexBoneIds.z)] * vertexBoneWeights.z +
+                boneMatrices[int(vertexBoneIds.w)] * vertexBoneWeights.w;
+
+    vec4 position = skin * vec4(vertexPosition, 1.0);
+    mat3 skinModel = mat3(matModel) * mat3(skin);
+    mat3 normalMatrix = transpose(inverse(skinModel));
+
+    vec3 N = normalize(normalMatrix * vertexNormal);
+    vec3 T = normalize(skinModel * vertexTangent.xyz);
+    T = normalize(T - dot(T, N) * N);
+    vec3 B = cross(N, T) * vertexTangent.w;
+
+    fragPosition = vec3(matModel * position);
+    fragTexCoord = vertexTexCoord;
+    fragColor = vertexColor;
+    fragNormal = N;
+    TBN = mat3(T, B, N);
+
+    gl_Position = mvp * position;
+}
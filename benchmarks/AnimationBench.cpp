@@ -0,0 +1,203 @@
+// Headless бенчмарк анимации: оценка поз N скелетов за кадр (однопоточно
+// и на пуле воркеров), сжатие клипов и CPU скиннинг — SIMD против скалярного пути.
+
+#include "Benchmarks.hpp"
+#include "animation/ClipCompression.hpp"
+#include "animation/Skinning.hpp"
+#include "resources/ParallelLoader.hpp"
+#include "scene/AnimationSystem.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Скелет из цепочек по 8 суставов от общего корня и один клип: каждый сустав
+// покачивается вокруг своей оси, ключи с частотой fps
+std::shared_ptr<kalan::ModelAnimations> MakeAnimations(int joints, float duration, int fps) {
+    auto animations = std::make_shared<kalan::ModelAnimations>();
+    kalan::Skeleton& skeleton = animations->skeleton;
+    for (int i = 0; i < joints; ++i) {
+        skeleton.names.push_back("joint" + std::to_string(i));
+        skeleton.parents.push_back(i == 0 ? -1 : (i % 8 == 1 ? 0 : i - 1));
+        kalan::JointTransform bind;
+        bind.translation = {0.0f, i == 0 ? 0.0f : 0.1f, 0.0f};
+        skeleton.bindPose.push_back(bind);
+    }
+    std::vector<Matrix> model(joints);
+    kalan::computeModelMatrices(skeleton, skeleton.bindPose, model.data());
+    for (const Matrix& m : model) skeleton.inverseBind.push_back(MatrixInvert(m));
+
+    kalan::AnimationClip clip;
+    clip.name = "sway";
+    clip.duration = duration;
+    const int keys = static_cast<int>(duration * fps) + 1;
+    for (int j = 0; j < joints; ++j) {
+        kalan::AnimationTrack track;
+        track.joint = j;
+        const Vector3 axis = Vector3Normalize({std::sin(j * 1.3f), 1.0f, std::cos(j * 0.7f)});
+        for (int k = 0; k < keys; ++k) {
+            const float t = static_cast<float>(k) / fps;
+            track.rotationTimes.push_back(t);
+            track.rotations.push_back(QuaternionFromAxisAngle(axis, 0.4f * std::sin(t * 3.0f + j)));
+            track.translationTimes.push_back(t);
+            track.translations.push_back({0.0f, j == 0 ? 0.05f * std::sin(t * 2.0f) : 0.1f, 0.0f});
+        }
+        clip.tracks.push_back(std::move(track));
+    }
+    animations->clips.push_back(std::move(clip));
+    return animations;
+}
+
+struct Result {
+    double avgMs = 0.0;
+    double minMs = 0.0;
+};
+
+template <typename Fn>
+Result Measure(int frames, Fn&& fn) {
+    Result result;
+    result.minMs = 1e9;
+    for (int f = 0; f < frames; ++f) {
+        auto start = Clock::now();
+        fn();
+        double ms = MsSince(start);
+        result.avgMs += ms;
+        result.minMs = std::min(result.minMs, ms);
+    }
+    result.avgMs /= frames;
+    return result;
+}
+
+} // anonymous namespace
+
+int RunAnimationBench(int argc, char** argv) {
+    const size_t animatorCount = argc > 0 ? std::strtoul(argv[0], nullptr, 10) : 1000;
+    const size_t vertexCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const int joints = 64;
+    const int frames = 60;
+
+    kalan::ImageThreadPool pool;
+
+    // ===== Позы =====
+    auto animations = MakeAnimations(joints, 2.0f, 30);
+    entt::registry registry;
+    for (size_t i = 0; i < animatorCount; ++i) {
+        auto& animator = registry.emplace<kalan::Animator>(registry.create(), kalan::Animator{.animations = animations});
+        kalan::AnimationSystem::play(animator, 0);
+        animator.time = static_cast<float>(i % 60) / 30.0f;
+    }
+
+    kalan::AnimationSystem system(registry);
+    system.update(0.0f);    // первый кадр выделяет буферы поз и палитр
+
+    std::printf("AnimationSystem: %zu animators, %d joints, 2 s clip at 30 fps\n", animatorCount, joints);
+    Result single = Measure(frames, [&] { system.update(1.0f / 60.0f); });
+    Result threaded = Measure(frames, [&] { system.update(1.0f / 60.0f, &pool); });
+    std::printf("  evaluate   1 thread: %8.3f ms (min %8.3f)   %zu threads: %8.3f ms (min %8.3f)\n",
+                single.avgMs, single.minMs, pool.getThreadCount(), threaded.avgMs, threaded.minMs);
+    RecordResult("anim", "evaluate, 1 thread", single.avgMs, "ms");
+    RecordResult("anim", "evaluate, pool", threaded.avgMs, "ms");
+
+    // ===== Сжатие клипов =====
+    // Тот же клип с ключами 60 fps: степень сжатия, ошибка и оценка из сжатого потока
+    auto compressed = MakeAnimations(joints, 2.0f, 60);
+    kalan::ClipCompressionStats stats;
+    kalan::AnimationClip& clip = compressed->clips[0];
+    clip.compressed = std::make_shared<const kalan::CompressedClip>(
+        kalan::compressClip(clip, compressed->skeleton, kalan::ClipCompressionSettings{}, &stats));
+    clip.tracks.clear();
+
+    entt::registry compressedRegistry;
+    for (size_t i = 0; i < animatorCount; ++i) {
+        auto& animator = compressedRegistry.emplace<kalan::Animator>(compressedRegistry.create(),
+                                                                     kalan::Animator{.animations = compressed});
+        kalan::AnimationSystem::play(animator, 0);
+        animator.time = static_cast<float>(i % 60) / 30.0f;
+    }
+    kalan::AnimationSystem compressedSystem(compressedRegistry);
+    compressedSystem.update(0.0f);
+    Result fromStream = Measure(frames, [&] { compressedSystem.update(1.0f / 60.0f); });
+
+    std::printf("Clip compression: %d -> %d keys, %.1f -> %.1f KB (x%.1f), max error %.5f, %.2f ms\n",
+                stats.rawKeys, stats.keys, stats.rawBytes / 1024.0, stats.compressedBytes / 1024.0,
+                stats.getRatio(), stats.maxError, stats.ms);
+    std::printf("  evaluate compressed, 1 thread: %8.3f ms (min %8.3f)\n", fromStream.avgMs, fromStream.minMs);
+    RecordResult("anim", "compression ratio", stats.getRatio(), "x");
+    RecordResult("anim", "compression max error", stats.maxError, "units");
+    RecordResult("anim", "evaluate compressed, 1 thread", fromStream.avgMs, "ms");
+
+    // ===== Скиннинг =====
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coord(-1.0f, 1.0f);
+    std::uniform_int_distribution<int> joint(0, joints - 1);
+    std::vector<float> positions(vertexCount * 3);
+    std::vector<float> normals(vertexCount * 3);
+    std::vector<unsigned char> boneIds(vertexCount * 4);
+    std::vector<float> boneWeights(vertexCount * 4);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        Vector3 n = Vector3Normalize({coord(rng), coord(rng), coord(rng)});
+        for (int i = 0; i < 3; ++i) positions[v * 3 + i] = coord(rng);
+        normals[v * 3 + 0] = n.x;
+        normals[v * 3 + 1] = n.y;
+        normals[v * 3 + 2] = n.z;
+        float sum = 0.0f;
+        for (int k = 0; k < 4; ++k) {
+            boneIds[v * 4 + k] = static_cast<unsigned char>(joint(rng));
+            boneWeights[v * 4 + k] = 0.1f + std::abs(coord(rng));
+            sum += boneWeights[v * 4 + k];
+        }
+        for (int k = 0; k < 4; ++k) boneWeights[v * 4 + k] /= sum;
+    }
+
+    const kalan::Animator& animator = registry.get<kalan::Animator>(*registry.view<kalan::Animator>().begin());
+    std::vector<kalan::SkinMatrix> palette(joints);
+    kalan::packSkinPalette(animator.skinning.data(), joints, palette.data());
+
+    const kalan::SkinningInput input{positions.data(), normals.data(), boneIds.data(), boneWeights.data(), vertexCount};
+    std::vector<float> outPositions(vertexCount * 3), outNormals(vertexCount * 3);
+    std::vector<float> refPositions(vertexCount * 3), refNormals(vertexCount * 3);
+
+    Result scalar = Measure(frames, [&] {
+        kalan::skinVerticesScalar(input, palette.data(), refPositions.data(), refNormals.data(), 0, vertexCount);
+    });
+    Result simd = Measure(frames, [&] {
+        kalan::skinVertices(input, palette.data(), outPositions.data(), outNormals.data(), 0, vertexCount);
+    });
+    Result parallel = Measure(frames, [&] {
+        pool.parallelFor(vertexCount, 4096, [&](size_t begin, size_t end) {
+            kalan::skinVertices(input, palette.data(), outPositions.data(), outNormals.data(), begin, end);
+        });
+    });
+
+    float maxError = 0.0f;
+    for (size_t i = 0; i < vertexCount * 3; ++i) {
+        maxError = std::max(maxError, std::abs(outPositions[i] - refPositions[i]));
+        maxError = std::max(maxError, std::abs(outNormals[i] - refNormals[i]));
+    }
+
+    std::printf("Skinning: %zu vertices, 4 bones each (%s)\n", vertexCount,
+                kalan::isSimdSkinningAvailable() ? "SSE" : "no SIMD in this build");
+    std::printf("  scalar   %8.3f ms (min %8.3f)\n", scalar.avgMs, scalar.minMs);
+    std::printf("  simd     %8.3f ms (min %8.3f)   x%.2f\n", simd.avgMs, simd.minMs, scalar.avgMs / simd.avgMs);
+    std::printf("  simd, %zu threads %8.3f ms (min %8.3f)   x%.2f\n", pool.getThreadCount(),
+                parallel.avgMs, parallel.minMs, scalar.avgMs / parallel.avgMs);
+    std::printf("  max difference to scalar: %.2e\n", maxError);
+    RecordResult("anim", "skinning, scalar", scalar.avgMs, "ms");
+    RecordResult("anim", "skinning, simd", simd.avgMs, "ms");
+    RecordResult("anim", "skinning, simd pool", parallel.avgMs, "ms");
+    return maxError < 1e-4f && stats.maxError <= kalan::ClipCompressionSettings{}.tolerance ? 0 : 1;
+}
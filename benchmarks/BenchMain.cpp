@@ -0,0 +1,134 @@
+// kalan_bench [--json <файл>] [имя [аргументы...]] — без имени запускаются все бенчмарки
+
+#include "Benchmarks.hpp"
+#include "raylib.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Bench {
+    const char* name;
+    int (*run)(int argc, char** argv);
+};
+
+const Bench benches[] = {
+    {"instancing", RunInstancingBench},
+    {"meshopt", RunMeshOptimizeBench},
+    {"quantize", RunQuantizationBench},
+    {"texpack", RunTexturePackBench},
+    {"transforms", RunTransformBench},
+    {"physics", RunPhysicsBench},
+    {"character", RunCharacterBench},
+    {"decode", RunDecodeBench},
+    {"meshconvert", RunMeshConvertBench},
+    {"import", RunImportBench},
+    {"assetcache", RunAssetCacheBench},
+    {"lighting", RunLightingBench},
+    {"texstream", RunTextureStreamBench},
+    {"anim", RunAnimationBench},
+    {"occlusion", RunOcclusionBench},
+};
+
+struct Result {
+    std::string bench;
+    std::string name;
+    double value;
+    std::string unit;
+};
+
+std::vector<Result> results;
+
+void WriteJsonString(std::FILE* file, const std::string& text) {
+    std::fputc('"', file);
+    for (char c : text) {
+        if (c == '"' || c == '\\') std::fputc('\\', file);
+        if (static_cast<unsigned char>(c) >= 0x20) std::fputc(c, file);
+    }
+    std::fputc('"', file);
+}
+
+bool WriteJson(const char* path, int exitCode) {
+    std::FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        std::fprintf(stderr, "Cannot write %s\n", path);
+        return false;
+    }
+
+    char date[32] = {};
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+#if defined(_MSC_VER)
+    const std::string compiler = "MSVC " + std::to_string(_MSC_VER);
+#elif defined(__clang__)
+    const std::string compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    const std::string compiler = "gcc " __VERSION__;
+#else
+    const std::string compiler = "unknown";
+#endif
+#ifdef NDEBUG
+    const char* buildType = "release";
+#else
+    const char* buildType = "debug";
+#endif
+
+    std::fprintf(file, "{\n  \"date\": \"%s\",\n  \"hardwareThreads\": %u,\n  \"compiler\": ",
+                 date, std::thread::hardware_concurrency());
+    WriteJsonString(file, compiler);
+    std::fprintf(file, ",\n  \"build\": \"%s\",\n  \"passed\": %s,\n  \"results\": [",
+                 buildType, exitCode == 0 ? "true" : "false");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fputs(i ? ",\n    {\"bench\": " : "\n    {\"bench\": ", file);
+        WriteJsonString(file, r.bench);
+        std::fputs(", \"name\": ", file);
+        WriteJsonString(file, r.name);
+        std::fprintf(file, ", \"value\": %.6g, \"unit\": ", r.value);
+        WriteJsonString(file, r.unit);
+        std::fputc('}', file);
+    }
+    std::fputs("\n  ]\n}\n", file);
+    return std::fclose(file) == 0;
+}
+
+} // anonymous namespace
+
+void RecordResult(const char* bench, const std::string& name, double value, const char* unit) {
+    results.push_back({bench, name, value, unit});
+}
+
+int main(int argc, char** argv) {
+    SetTraceLogLevel(LOG_WARNING);
+
+    const char* jsonPath = nullptr;
+    if (argc >= 3 && std::strcmp(argv[1], "--json") == 0) {
+        jsonPath = argv[2];
+        argc -= 2;
+        argv += 2;
+    }
+
+    int result = 0;
+    if (argc < 2) {
+        for (const Bench& bench : benches) result |= bench.run(0, nullptr);
+    } else {
+        const Bench* selected = nullptr;
+        for (const Bench& bench : benches) {
+            if (std::strcmp(argv[1], bench.name) == 0) selected = &bench;
+        }
+        if (!selected) {
+            std::fprintf(stderr, "Unknown benchmark '%s'. Available:", argv[1]);
+            for (const Bench& bench : benches) std::fprintf(stderr, " %s", bench.name);
+            std::fprintf(stderr, "\n");
+            return 1;
+        }
+        result = selected->run(argc - 2, argv + 2);
+    }
+
+    if (jsonPath && !WriteJson(jsonPath, result)) result |= 1;
+    return result;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+// Headless бенчмарки kalan_bench. argv — аргументы после имени бенчмарка.
+int RunInstancingBench(int argc, char** argv);
+int RunMeshOptimizeBench(int argc, char** argv);
+int RunQuantizationBench(int argc, char** argv);
+int RunTexturePackBench(int argc, char** argv);
+int RunTransformBench(int argc, char** argv);
+int RunPhysicsBench(int argc, char** argv);
+int RunCharacterBench(int argc, char** argv);
+int RunDecodeBench(int argc, char** argv);
+int RunMeshConvertBench(int argc, char** argv);
+int RunImportBench(int argc, char** argv);
+int RunAssetCacheBench(int argc, char** argv);
+int RunLightingBench(int argc, char** argv);
+int RunTextureStreamBench(int argc, char** argv);
+int RunAnimationBench(int argc, char** argv);
+int RunOcclusionBench(int argc, char** argv);
+
+// Результат в JSON отчёт (kalan_bench --json <файл>). bench — имя бенчмарка,
+// name — случай; сравниваются между релизами по паре (bench, name).
+void RecordResult(const char* bench, const std::string& name, double value, const char* unit);
@@ -0,0 +1,119 @@
+// Headless прогон CharacterController по скриптовому маршруту:
+// ступени, пандус, площадка и стена. Кадры идут с частотой 240 Гц,
+// физика — 60 Гц; печатается стоимость move-and-slide за шаг.
+
+#include "Benchmarks.hpp"
+#include "physics/CharacterController.hpp"
+#include "physics/PhysicsWorld.hpp"
+#include "resources/ParallelLoader.hpp"
+#include "scene/TransformSystem.hpp"
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+void AddStaticBox(entt::registry& registry, kalan::PhysicsWorld& world, Vector3 center, Vector3 halfExtent,
+                  JPH::Quat rotation = JPH::Quat::sIdentity()) {
+    world.addBody(kalan::TransformSystem::createEntity(registry), JPH::BodyCreationSettings(
+        new JPH::BoxShape(kalan::toJolt(halfExtent), 0.0f), JPH::RVec3(kalan::toJolt(center)), rotation,
+        JPH::EMotionType::Static, kalan::physics_layers::NonMoving), JPH::EActivation::DontActivate);
+}
+
+// Маршрут вдоль +Z, ширина 4 м
+void BuildCourse(entt::registry& registry, kalan::PhysicsWorld& world) {
+    AddStaticBox(registry, world, {0.0f, -0.5f, 10.0f}, {20.0f, 0.5f, 20.0f});
+
+    // 4 ступени по 0.2 м, затем площадка на 0.8 м
+    for (int k = 1; k <= 4; ++k) {
+        AddStaticBox(registry, world, {0.0f, 0.1f * k, 3.25f + 0.5f * (k - 1)}, {2.0f, 0.1f * k, 0.25f});
+    }
+    AddStaticBox(registry, world, {0.0f, 0.4f, 6.0f}, {2.0f, 0.4f, 1.0f});
+
+    // Пандус 20° длиной 6 м от z = 7
+    const float angle = 20.0f * DEG2RAD;
+    const float halfLength = 3.0f;
+    const float thickness = 0.1f;
+    Vector3 rampCenter{0.0f,
+                       0.8f + halfLength * std::sin(angle) - thickness * std::cos(angle),
+                       7.0f + halfLength * std::cos(angle) + thickness * std::sin(angle)};
+    AddStaticBox(registry, world, rampCenter, {2.0f, thickness, halfLength},
+                 JPH::Quat::sRotation(JPH::Vec3::sAxisX(), -angle));
+
+    // Верхняя площадка и стена в её конце
+    const float top = 0.8f + 2.0f * halfLength * std::sin(angle);
+    const float rampEnd = 7.0f + 2.0f * halfLength * std::cos(angle);
+    AddStaticBox(registry, world, {0.0f, top * 0.5f, rampEnd + 3.0f}, {2.0f, top * 0.5f, 3.0f});
+    AddStaticBox(registry, world, {0.0f, top + 2.0f, 18.25f}, {2.0f, 2.0f, 0.25f});
+}
+
+struct ScriptStep {
+    float seconds;
+    Vector3 velocity;
+    bool jump;
+};
+
+} // anonymous namespace
+
+int RunCharacterBench(int, char**) {
+    entt::registry registry;
+    kalan::ImageThreadPool pool;
+    kalan::PhysicsWorld world(registry, pool);
+    BuildCourse(registry, world);
+    world.optimizeBroadPhase();
+
+    kalan::CharacterController character(world, {0.0f, 0.0f, 0.0f});
+
+    const ScriptStep script[] = {
+        {8.0f, {0.0f, 0.0f, 4.0f}, false},     // ступени, пандус, упор в стену
+        {0.5f, {3.0f, 0.0f, 3.0f}, false},     // скольжение вдоль стены
+        {0.1f, {0.0f, 0.0f, 0.0f}, true},      // прыжок на месте
+        {1.5f, {0.0f, 0.0f, 0.0f}, false},     // приземление
+    };
+
+    const float displayDt = 1.0f / 240.0f;
+    int frames = 0;
+    float maxHeight = 0.0f;
+    for (const ScriptStep& step : script) {
+        bool jump = step.jump;
+        for (float t = 0.0f; t < step.seconds; t += displayDt) {
+            character.setInput(step.velocity, jump);
+            jump = false;
+            world.update(displayDt);
+            maxHeight = std::max(maxHeight, character.getPosition().y);
+            ++frames;
+        }
+    }
+
+    const auto& stats = character.getStats();
+    Vector3 p = character.getPosition();
+    const float top = 0.8f + 6.0f * std::sin(20.0f * DEG2RAD);
+
+    std::printf("CharacterController: %d frames at 240 Hz, %llu physics ticks\n",
+                frames, static_cast<unsigned long long>(stats.ticks));
+    std::printf("  move-and-slide: avg %.4f ms, max %.4f ms per tick\n", stats.avgTickMs(), stats.maxTickMs);
+    std::printf("  final position (%.2f, %.2f, %.2f), on ground %d\n", p.x, p.y, p.z, character.isOnGround());
+    RecordResult("character", "tick avg", stats.avgTickMs(), "ms");
+    RecordResult("character", "tick max", stats.maxTickMs, "ms");
+
+    struct Check {
+        const char* name;
+        bool ok;
+    };
+    const Check checks[] = {
+        {"climbed stairs and ramp", std::fabs(p.y - top) < 0.1f},
+        {"blocked by wall", p.z < 18.0f - character.getSettings().radius + 0.05f},
+        {"slid along wall", p.x > 1.0f},
+        {"jumped", maxHeight > top + 0.5f},
+        {"landed", character.isOnGround()},
+        {"ticks decoupled from frames", stats.ticks <= static_cast<uint64_t>(frames / 4 + 1)},
+    };
+    int failed = 0;
+    for (const Check& check : checks) {
+        std::printf("  [%s] %s\n", check.ok ? " ok " : "FAIL", check.name);
+        failed += !check.ok;
+    }
+    RecordResult("character", "failed checks", failed, "count");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+// Headless бенчмарк декодирования изображений через ImageThreadPool:
+// PNG из памяти, пропускная способность в зависимости от числа воркеров.
+
+#include "Benchmarks.hpp"
+#include "core/PixelBufferPool.hpp"
+#include "resources/ParallelLoader.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Шум сжимается хуже реальных текстур — оценка снизу
+std::shared_ptr<std::vector<unsigned char>> MakePng(int size) {
+    Image image = GenImagePerlinNoise(size, size, 0, 0, 4.0f);
+    int fileSize = 0;
+    unsigned char* file = ExportImageToMemory(image, ".png", &fileSize);
+    UnloadImage(image);
+
+    auto data = std::make_shared<std::vector<unsigned char>>(file, file + fileSize);
+    MemFree(file);
+    return data;
+}
+
+} // anonymous namespace
+
+int RunDecodeBench(int argc, char** argv) {
+    int imageCount = argc > 0 ? std::atoi(argv[0]) : 64;
+    int size = argc > 1 ? std::atoi(argv[1]) : 1024;
+    size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+
+    auto png = MakePng(size);
+    if (png->empty()) {
+        std::printf("ImageThreadPool decode: PNG export unavailable, skipped\n");
+        return 0;
+    }
+    const double decodedMb = static_cast<double>(size) * size * 4 * imageCount / (1024.0 * 1024.0);
+
+    std::printf("ImageThreadPool decode: %d PNG %dx%d (%.1f KB each)\n",
+                imageCount, size, size, png->size() / 1024.0);
+    for (size_t workers = 1;; workers *= 2) {
+        workers = std::min(workers, hardware);
+        kalan::ImageThreadPool pool(workers);
+
+        auto start = Clock::now();
+        std::vector<std::future<kalan::PreloadedImage>> futures;
+        futures.reserve(imageCount);
+        for (int i = 0; i < imageCount; ++i) {
+            futures.push_back(pool.decodeFromMemoryAsync(png, "bench.png"));
+        }
+        int failed = 0;
+        for (auto& future : futures) {
+            // Буфер возвращается в пул деструктором PreloadedImage
+            kalan::PreloadedImage result = future.get();
+            failed += !result.valid;
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::printf("  %2zu workers: %8.1f images/s   %8.1f MB/s decoded%s\n",
+                    workers, imageCount / seconds, decodedMb / seconds, failed ? "   (decode errors)" : "");
+        RecordResult("decode", std::to_string(workers) + " workers", imageCount / seconds, "images/s");
+        if (failed) return 1;
+        if (workers == hardware) break;
+    }
+    
+    auto pixels = kalan::PixelBufferPool::instance().getStats();
+    std::printf("  pixel pool: %llu buffers reused, %llu from OS, peak %.1f MB%s\n",
+                static_cast<unsigned long long>(pixels.reuses),
+                static_cast<unsigned long long>(pixels.osAllocations),
+                static_cast<double>(pixels.peakBytes) / (1024.0 * 1024.0),
+                pixels.hugePages ? ", huge pages" : "");
+    RecordResult("decode", "pixel pool peak", static_cast<double>(pixels.peakBytes) / (1024.0 * 1024.0), "MB");
+    return 0;
+}
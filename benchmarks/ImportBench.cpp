@@ -0,0 +1,96 @@
+// Headless бенчмарк импорта Assimp с флагами загрузчика: плоский импорт
+// (PreTransformVertices), с сохранением иерархии и плоский без GenSmoothNormals и
+// JoinIdenticalVertices (как у ассета с gen_normals/join_vertices = false в .import),
+// плюс конвертация мешей.
+
+#include "Benchmarks.hpp"
+#include "resources/AssimpConvert.hpp"
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    double importMs = 1e9;
+    double convertMs = 1e9;
+    unsigned int meshes = 0;
+    size_t vertices = 0;
+};
+
+struct Mode {
+    const char* name;
+    bool keepHierarchy;
+    kalan::ImportSteps steps;
+};
+
+bool Run(const char* path, const Mode& mode, int repeats, Result& result) {
+    for (int r = 0; r < repeats; ++r) {
+        Assimp::Importer importer;
+        auto start = Clock::now();
+        const aiScene* scene = importer.ReadFile(path, kalan::assimpImportFlags(mode.keepHierarchy, mode.steps));
+        double importMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (!scene || !scene->HasMeshes()) {
+            std::printf("  import failed: %s\n", importer.GetErrorString());
+            return false;
+        }
+
+        start = Clock::now();
+        result.vertices = 0;
+        for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+            Mesh mesh = kalan::ConvertAssimpMesh(scene->mMeshes[m]);
+            result.vertices += mesh.vertexCount;
+            MemFree(mesh.vertices);
+            MemFree(mesh.normals);
+            MemFree(mesh.tangents);
+            MemFree(mesh.texcoords);
+            MemFree(mesh.colors);
+            MemFree(mesh.indices);
+        }
+        double convertMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        result.importMs = std::min(result.importMs, importMs);
+        result.convertMs = std::min(result.convertMs, convertMs);
+        result.meshes = scene->mNumMeshes;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+int RunImportBench(int argc, char** argv) {
+    const char* path = argc > 0 ? argv[0] : "assets/models/nerf/nerf_retaliator.glb";
+    const int repeats = argc > 1 ? std::max(1, std::atoi(argv[1])) : 3;
+
+    if (!std::filesystem::exists(path)) {
+        std::printf("Assimp import: %s not found, skipped\n", path);
+        return 0;
+    }
+
+    std::printf("Assimp import: %s, best of %d\n", path, repeats);
+    kalan::ImportSteps clean;
+    clean.genNormals = false;
+    clean.joinVertices = false;
+    const Mode modes[] = {
+        {"flattened", false, {}},
+        {"hierarchy", true, {}},
+        {"clean", false, clean},
+    };
+    for (const Mode& mode : modes) {
+        Result result;
+        if (!Run(path, mode, repeats, result)) return 1;
+
+        std::printf("  %-10s import %8.2f ms   convert %7.2f ms   %u meshes, %zu vertices\n",
+                    mode.name, result.importMs, result.convertMs, result.meshes, result.vertices);
+        RecordResult("import", std::string(mode.name) + " import", result.importMs, "ms");
+        RecordResult("import", std::string(mode.name) + " convert", result.convertMs, "ms");
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+// Headless бенчмарк CPU части инстансинга: сбор заявок в InstanceBatcher и построение
+// мировых матриц батчей, однопоточно и на пуле. GPU не нужен — меши и материалы пустые,
+// батчер смотрит только на их адреса и transform модели.
+
+#include "Benchmarks.hpp"
+#include "rendering/InstancedRenderer.hpp"
+#include "resources/ParallelLoader.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct Result {
+    double submitMs = 0.0;
+    double buildMs = 0.0;
+    double minBuildMs = 0.0;
+    size_t batches = 0;
+};
+
+// Заявка: меш meshes[mesh] с материалом materials[mesh % materials.size()] — несколько
+// мешей делят материал, как узлы одной модели
+struct Instance {
+    size_t mesh;
+    Matrix transform;
+};
+
+Result Run(kalan::InstanceBatcher& batcher, kalan::ImageThreadPool* pool, const std::vector<Mesh>& meshes,
+           const std::vector<Material>& materials, const Matrix& base, const std::vector<Instance>& instances,
+           int frames) {
+    Result result;
+    result.minBuildMs = 1e9;
+    for (int f = 0; f < frames; ++f) {
+        auto start = Clock::now();
+        batcher.begin();
+        for (const Instance& instance : instances) {
+            batcher.submit(meshes[instance.mesh], materials[instance.mesh % materials.size()],
+                           instance.transform, &base);
+        }
+        result.submitMs += MsSince(start);
+
+        start = Clock::now();
+        batcher.build(pool);
+        double ms = MsSince(start);
+        result.buildMs += ms;
+        result.minBuildMs = std::min(result.minBuildMs, ms);
+        result.batches = batcher.getBatches().size();
+    }
+    result.submitMs /= frames;
+    result.buildMs /= frames;
+    return result;
+}
+
+// Матрицы батчей должны совпасть при любом пуле
+bool SameTransforms(const kalan::InstanceBatcher& a, const kalan::InstanceBatcher& b) {
+    if (a.getBatches().size() != b.getBatches().size()) return false;
+    for (size_t i = 0; i < a.getBatches().size(); ++i) {
+        const kalan::InstanceBatch& batch = a.getBatches()[i];
+        const Matrix* x = a.getTransforms(batch);
+        const Matrix* y = b.getTransforms(b.getBatches()[i]);
+        for (size_t j = 0; j < batch.count; ++j) {
+            if (std::memcmp(&x[j], &y[j], sizeof(Matrix)) != 0) return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+int RunInstancingBench(int argc, char** argv) {
+    const size_t instanceCount = argc > 0 ? std::strtoul(argv[0], nullptr, 10) : 100000;
+    const size_t meshCount = std::max<size_t>(1, argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 16);
+    const int frames = 30;
+
+    // Пустые меши и материалы: батчер различает их только по адресу
+    const std::vector<Mesh> meshes(meshCount, Mesh{});
+    const std::vector<Material> materials(std::max<size_t>(1, meshCount / 2), Material{});
+    const Matrix base = MatrixScale(0.5f, 0.5f, 0.5f);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<size_t> pickMesh(0, meshes.size() - 1);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 2.0f * PI);
+    std::vector<Instance> instances(instanceCount);
+    for (Instance& instance : instances) {
+        instance.mesh = pickMesh(rng);
+        instance.transform = MatrixMultiply(MatrixRotateY(angle(rng)),
+                                            MatrixTranslate(position(rng), 0.0f, position(rng)));
+    }
+
+    kalan::ImageThreadPool pool;
+    kalan::InstanceBatcher single;
+    kalan::InstanceBatcher threaded;
+    const Result serial = Run(single, nullptr, meshes, materials, base, instances, frames);
+    const Result parallel = Run(threaded, &pool, meshes, materials, base, instances, frames);
+    const bool same = SameTransforms(single, threaded);
+    // Меши, делящие материал, всё равно в разных батчах: батч на каждый использованный меш
+    std::vector<bool> used(meshes.size(), false);
+    for (const Instance& instance : instances) used[instance.mesh] = true;
+    const size_t usedMeshes = static_cast<size_t>(std::count(used.begin(), used.end(), true));
+    const bool grouped = serial.batches == usedMeshes;
+
+    std::printf("InstanceBatcher: %zu instances of %zu meshes -> %zu batches\n",
+                instanceCount, meshes.size(), serial.batches);
+    std::printf("  submit                %8.3f ms\n", serial.submitMs);
+    std::printf("  build, 1 thread       %8.3f ms (min %8.3f)\n", serial.buildMs, serial.minBuildMs);
+    std::printf("  build, %zu threads     %8.3f ms (min %8.3f)   x%.2f%s\n", pool.getThreadCount(),
+                parallel.buildMs, parallel.minBuildMs, serial.buildMs / parallel.buildMs,
+                same ? "" : "   MISMATCH");
+    if (!grouped) std::printf("  expected %zu batches\n", usedMeshes);
+    RecordResult("instancing", "submit", serial.submitMs, "ms");
+    RecordResult("instancing", "build, 1 thread", serial.buildMs, "ms");
+    RecordResult("instancing", "build, pool", parallel.buildMs, "ms");
+    return same && grouped ? 0 : 1;
+}
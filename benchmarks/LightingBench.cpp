@@ -0,0 +1,37 @@
+// Headless бенчмарк упаковки источников света LightingSystem::update.
+// Без init() вариантов шейдера нет, поэтому меряется только сборка PackedLight.
+
+#include "Benchmarks.hpp"
+#include "rendering/Lighting.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+int RunLightingBench(int argc, char** argv) {
+    const int updates = argc > 0 ? std::atoi(argv[0]) : 200000;
+    using Clock = std::chrono::steady_clock;
+
+    auto& lighting = kalan::LightingSystem::instance();
+    lighting.clearLights();
+    for (int i = 0; i < kalan::LightingSystem::MaxLights; ++i) {
+        kalan::Light light;
+        light.type = static_cast<kalan::LightType>(i % 3);
+        light.position = {static_cast<float>(i), 3.0f, 0.0f};
+        light.cutoff = 20.0f + i;
+        light.outerCutoff = 30.0f + i;
+        lighting.addLight(light);
+    }
+
+    raylib::Camera camera({0.0f, 2.0f, 5.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 60.0f);
+    auto start = Clock::now();
+    for (int i = 0; i < updates; ++i) {
+        lighting.getLight(i % kalan::LightingSystem::MaxLights).intensity = static_cast<float>(i & 7);
+        lighting.update(camera);
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / updates;
+    lighting.clearLights();
+
+    std::printf("LightingSystem: %d lights, pack %.1f ns per update\n", kalan::LightingSystem::MaxLights, ns);
+    RecordResult("lighting", "pack 16 lights", ns, "ns");
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Headless бенчмарк конвертации мешей Assimp -> raylib: ConvertAssimpMesh,
+// TransformMeshVertices и generateTangents на синтетическом меше, время на миллион вершин.
+
+#include "Benchmarks.hpp"
+#include "resources/AssimpConvert.hpp"
+#include "resources/MeshTangents.hpp"
+#include "raymath.h"
+#include <assimp/mesh.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Меш со всеми атрибутами, которые читает ConvertAssimpMesh
+aiMesh* MakeMesh(unsigned int vertexCount) {
+    auto* mesh = new aiMesh();
+    mesh->mNumVertices = vertexCount;
+    mesh->mVertices = new aiVector3D[vertexCount];
+    mesh->mNormals = new aiVector3D[vertexCount];
+    mesh->mTangents = new aiVector3D[vertexCount];
+    mesh->mBitangents = new aiVector3D[vertexCount];
+    mesh->mTextureCoords[0] = new aiVector3D[vertexCount];
+    mesh->mNumUVComponents[0] = 2;
+    for (unsigned int i = 0; i < vertexCount; ++i) {
+        float x = static_cast<float>(i % 1024);
+        float z = static_cast<float>(i / 1024);
+        mesh->mVertices[i] = aiVector3D(x, 0.0f, z);
+        mesh->mNormals[i] = aiVector3D(0.0f, 1.0f, 0.0f);
+        mesh->mTangents[i] = aiVector3D(1.0f, 0.0f, 0.0f);
+        mesh->mBitangents[i] = aiVector3D(0.0f, 0.0f, 1.0f);
+        mesh->mTextureCoords[0][i] = aiVector3D(x / 1024.0f, z / 1024.0f, 0.0f);
+    }
+
+    // Индексы 16-битные — треугольники ссылаются на первые 65535 вершин
+    mesh->mNumFaces = vertexCount / 3;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        aiFace& face = mesh->mFaces[f];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[3];
+        for (unsigned int k = 0; k < 3; ++k) face.mIndices[k] = (f * 3 + k) % 65535;
+    }
+    return mesh;
+}
+
+// UnloadMesh трогает GL — освобождаем только CPU буферы
+void FreeMeshData(Mesh& mesh) {
+    MemFree(mesh.vertices);
+    MemFree(mesh.normals);
+    MemFree(mesh.tangents);
+    MemFree(mesh.texcoords);
+    MemFree(mesh.colors);
+    MemFree(mesh.indices);
+    mesh = Mesh{};
+}
+
+} // anonymous namespace
+
+int RunMeshConvertBench(int argc, char** argv) {
+    unsigned int vertexCount = argc > 0 ? static_cast<unsigned int>(std::strtoul(argv[0], nullptr, 10)) : 1000000;
+    const int repeats = 5;
+
+    aiMesh* source = MakeMesh(vertexCount);
+    const double millions = vertexCount / 1e6;
+    const Matrix transform = MatrixMultiply(MatrixRotateXYZ({0.3f, 0.7f, 0.1f}), MatrixTranslate(1.0f, 2.0f, 3.0f));
+
+    double convertMs = 1e9;
+    double transformMs = 1e9;
+    double tangentMs = 1e9;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = Clock::now();
+        Mesh mesh = kalan::ConvertAssimpMesh(source);
+        convertMs = std::min(convertMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+        start = Clock::now();
+        kalan::TransformMeshVertices(mesh, transform);
+        transformMs = std::min(transformMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+        FreeMeshData(mesh);
+
+        // Без авторских тангентов, как у меша с normal map из OBJ
+        mesh = kalan::ConvertAssimpMesh(source, false);
+        start = Clock::now();
+        kalan::generateTangents(mesh);
+        tangentMs = std::min(tangentMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+        FreeMeshData(mesh);
+    }
+    delete source;
+
+    std::printf("Mesh conversion: %u vertices, best of %d\n", vertexCount, repeats);
+    std::printf("  ConvertAssimpMesh      %8.3f ms   %8.3f ms per 1M vertices\n", convertMs, convertMs / millions);
+    std::printf("  TransformMeshVertices  %8.3f ms   %8.3f ms per 1M vertices\n", transformMs, transformMs / millions);
+    std::printf("  generateTangents       %8.3f ms   %8.3f ms per 1M vertices\n", tangentMs, tangentMs / millions);
+    RecordResult("meshconvert", "ConvertAssimpMesh per 1M vertices", convertMs / millions, "ms");
+    RecordResult("meshconvert", "TransformMeshVertices per 1M vertices", transformMs / millions, "ms");
+    RecordResult("meshconvert", "generateTangents per 1M vertices", tangentMs / millions, "ms");
+    return 0;
+}
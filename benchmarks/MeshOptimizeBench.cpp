@@ -0,0 +1,161 @@
+// Headless проверка оптимизации мешей при импорте (optimizeMesh): сетка с
+// перемешанными треугольниками прогоняется с настройками импорта по умолчанию и с
+// overdraw. ACMR и ATVR должны уменьшиться, а треугольники (с тем же обходом)
+// и вершины со всеми атрибутами — остаться теми же с точностью до перестановки.
+
+#include "Benchmarks.hpp"
+#include "resources/MeshOptimizer.hpp"
+#include "raylib.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Triangle = std::array<uint32_t, 3>;
+
+// side x side вершин, треугольники в случайном порядке. Позиция вершины
+// (x, 0, z) однозначно задаёт её исходный индекс z * side + x.
+Mesh MakeShuffledGrid(int side) {
+    Mesh mesh{};
+    mesh.vertexCount = side * side;
+    mesh.triangleCount = (side - 1) * (side - 1) * 2;
+    mesh.vertices = static_cast<float*>(MemAlloc(mesh.vertexCount * 3 * sizeof(float)));
+    mesh.normals = static_cast<float*>(MemAlloc(mesh.vertexCount * 3 * sizeof(float)));
+    mesh.texcoords = static_cast<float*>(MemAlloc(mesh.vertexCount * 2 * sizeof(float)));
+    mesh.indices = static_cast<unsigned short*>(MemAlloc(mesh.triangleCount * 3 * sizeof(unsigned short)));
+
+    for (int z = 0; z < side; ++z) {
+        for (int x = 0; x < side; ++x) {
+            const int v = z * side + x;
+            const float fx = static_cast<float>(x);
+            const float fz = static_cast<float>(z);
+            mesh.vertices[v * 3 + 0] = fx;
+            mesh.vertices[v * 3 + 1] = 0.0f;
+            mesh.vertices[v * 3 + 2] = fz;
+            mesh.normals[v * 3 + 0] = 0.0f;
+            mesh.normals[v * 3 + 1] = 1.0f;
+            mesh.normals[v * 3 + 2] = 0.0f;
+            mesh.texcoords[v * 2 + 0] = fx / (side - 1);
+            mesh.texcoords[v * 2 + 1] = fz / (side - 1);
+        }
+    }
+
+    std::vector<Triangle> triangles;
+    for (int z = 0; z + 1 < side; ++z) {
+        for (int x = 0; x + 1 < side; ++x) {
+            const uint32_t v = z * side + x;
+            triangles.push_back({v, v + side, v + 1});
+            triangles.push_back({v + 1, v + side, v + side + 1});
+        }
+    }
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937(5));
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        for (int k = 0; k < 3; ++k) mesh.indices[t * 3 + k] = static_cast<unsigned short>(triangles[t][k]);
+    }
+    return mesh;
+}
+
+void FreeMeshData(Mesh& mesh) {
+    MemFree(mesh.vertices);
+    MemFree(mesh.normals);
+    MemFree(mesh.texcoords);
+    MemFree(mesh.indices);
+    mesh = Mesh{};
+}
+
+// Треугольник в исходных индексах, повёрнутый так, чтобы меньший индекс шёл
+// первым: обход сохраняется, порядок вершин внутри — нет
+Triangle Canonical(Triangle t) {
+    while (t[0] > t[1] || t[0] > t[2]) t = {t[1], t[2], t[0]};
+    return t;
+}
+
+std::vector<Triangle> SortedTriangles(const Mesh& mesh, const std::vector<uint32_t>& toSource) {
+    std::vector<Triangle> triangles(mesh.triangleCount);
+    for (int t = 0; t < mesh.triangleCount; ++t) {
+        triangles[t] = Canonical({toSource[mesh.indices[t * 3]], toSource[mesh.indices[t * 3 + 1]],
+                                  toSource[mesh.indices[t * 3 + 2]]});
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+// Исходный индекс каждой вершины по её позиции; false — позиция вне сетки,
+// атрибуты не совпали с исходными или вершина встретилась дважды
+bool MapToSource(const Mesh& mesh, const Mesh& source, int side, std::vector<uint32_t>& toSource) {
+    toSource.assign(mesh.vertexCount, 0);
+    std::vector<bool> seen(source.vertexCount, false);
+    for (int v = 0; v < mesh.vertexCount; ++v) {
+        const int x = static_cast<int>(mesh.vertices[v * 3]);
+        const int z = static_cast<int>(mesh.vertices[v * 3 + 2]);
+        if (x < 0 || z < 0 || x >= side || z >= side) return false;
+        const int s = z * side + x;
+        if (seen[s]) return false;
+        seen[s] = true;
+        if (std::memcmp(&mesh.vertices[v * 3], &source.vertices[s * 3], 3 * sizeof(float)) != 0 ||
+            std::memcmp(&mesh.normals[v * 3], &source.normals[s * 3], 3 * sizeof(float)) != 0 ||
+            std::memcmp(&mesh.texcoords[v * 2], &source.texcoords[s * 2], 2 * sizeof(float)) != 0) {
+            return false;
+        }
+        toSource[v] = static_cast<uint32_t>(s);
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+int RunMeshOptimizeBench(int argc, char** argv) {
+    const int side = argc > 0 ? std::clamp(std::atoi(argv[0]), 2, 255) : 128;
+
+    struct Case {
+        const char* name;
+        kalan::MeshOptimizeSettings settings;
+    };
+    kalan::MeshOptimizeSettings withOverdraw;
+    withOverdraw.overdraw = true;
+    const Case cases[] = {
+        {"import defaults", kalan::MeshOptimizeSettings{}},
+        {"with overdraw", withOverdraw},
+    };
+
+    Mesh source = MakeShuffledGrid(side);
+    std::vector<uint32_t> identity(source.vertexCount);
+    for (int v = 0; v < source.vertexCount; ++v) identity[v] = static_cast<uint32_t>(v);
+    const std::vector<Triangle> sourceTriangles = SortedTriangles(source, identity);
+
+    std::printf("optimizeMesh: %dx%d grid, %d vertices, %d shuffled triangles\n",
+                side, side, source.vertexCount, source.triangleCount);
+
+    int failures = 0;
+    for (const Case& c : cases) {
+        Mesh mesh = MakeShuffledGrid(side);
+        const kalan::MeshOptimizeStats stats = kalan::optimizeMesh(mesh, c.settings);
+
+        std::vector<uint32_t> toSource;
+        const bool sameVertices =
+            mesh.vertexCount == source.vertexCount && MapToSource(mesh, source, side, toSource);
+        const bool sameTriangles = sameVertices && mesh.triangleCount == source.triangleCount &&
+                                   SortedTriangles(mesh, toSource) == sourceTriangles;
+        const bool improved = stats.after.acmr < stats.before.acmr && stats.after.atvr < stats.before.atvr;
+        const bool ok = sameVertices && sameTriangles && improved;
+        failures += !ok;
+
+        std::printf("  %-16s ACMR %.3f -> %.3f   ATVR %.3f -> %.3f   %7.2f ms   %s%s%s\n", c.name,
+                    stats.before.acmr, stats.after.acmr, stats.before.atvr, stats.after.atvr, stats.ms,
+                    ok ? "ok" : "FAILED:", sameVertices ? "" : " vertices", sameTriangles ? "" : " triangles");
+        if (!improved) std::printf("    cache metrics did not improve\n");
+        RecordResult("meshopt", std::string(c.name) + ", ACMR", stats.after.acmr, "miss/tri");
+        RecordResult("meshopt", std::string(c.name) + ", ATVR", stats.after.atvr, "miss/vert");
+        RecordResult("meshopt", std::string(c.name) + ", time", stats.ms, "ms");
+        FreeMeshData(mesh);
+    }
+
+    FreeMeshData(source);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,220 @@
+// Headless бенчмарк отсечения перекрытых объектов: сетка комнат с дверными проёмами,
+// стены — окклюдеры, в комнатах случайные объекты. Камера обходит комнату, каждый
+// кадр строится буфер перекрытия (скалярно, SIMD, SIMD на пуле) и проверяются все
+// объекты. Проверяет совпадение SIMD и скалярного буфера; ложные перекрытия
+// (центр объекта виден лучом, а объект отсечён) только считаются — буфер низкого
+// разрешения закрывает щели уже пикселя.
+
+#include "Benchmarks.hpp"
+#include "resources/ParallelLoader.hpp"
+#include "scene/OcclusionSystem.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Единичный куб с центром в нуле: 8 вершин, 12 треугольников
+std::shared_ptr<kalan::ModelOccluders> MakeUnitBox() {
+    auto model = std::make_shared<kalan::ModelOccluders>();
+    kalan::OccluderMesh box;
+    for (int i = 0; i < 8; ++i) {
+        box.positions.insert(box.positions.end(), {i & 1 ? 0.5f : -0.5f, i & 2 ? 0.5f : -0.5f, i & 4 ? 0.5f : -0.5f});
+    }
+    box.indices = {0, 2, 1, 1, 2, 3,  4, 5, 6, 5, 7, 6,  0, 1, 4, 1, 5, 4,
+                   2, 6, 3, 3, 6, 7,  0, 4, 2, 2, 4, 6,  1, 3, 5, 3, 7, 5};
+    box.bounds = {{-0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}};
+    model->meshes.push_back(std::move(box));
+    return model;
+}
+
+// Отрезок from -> to пересекает AABB раньше конца
+bool SegmentHitsBox(Vector3 from, Vector3 to, const BoundingBox& box) {
+    const float origin[3] = {from.x, from.y, from.z};
+    const float dir[3] = {to.x - from.x, to.y - from.y, to.z - from.z};
+    const float lo[3] = {box.min.x, box.min.y, box.min.z};
+    const float hi[3] = {box.max.x, box.max.y, box.max.z};
+    float tMin = 0.0f, tMax = 1.0f;
+    for (int i = 0; i < 3; ++i) {
+        if (std::fabs(dir[i]) < 1e-9f) {
+            if (origin[i] < lo[i] || origin[i] > hi[i]) return false;
+            continue;
+        }
+        float t0 = (lo[i] - origin[i]) / dir[i];
+        float t1 = (hi[i] - origin[i]) / dir[i];
+        if (t0 > t1) std::swap(t0, t1);
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax) return false;
+    }
+    return true;
+}
+
+struct Scene {
+    entt::registry registry;
+    std::vector<BoundingBox> walls;
+    std::vector<BoundingBox> objects;
+};
+
+void AddWall(Scene& scene, const std::shared_ptr<kalan::ModelOccluders>& box, Vector3 center, Vector3 size) {
+    const entt::entity entity = scene.registry.create();
+    scene.registry.emplace<kalan::Occluder>(entity, kalan::Occluder{.occluders = box});
+    scene.registry.emplace<kalan::WorldTransform>(entity, kalan::WorldTransform{
+        MatrixMultiply(MatrixScale(size.x, size.y, size.z), MatrixTranslate(center.x, center.y, center.z))});
+    const Vector3 extent = Vector3Scale(size, 0.5f);
+    scene.walls.push_back({Vector3Subtract(center, extent), Vector3Add(center, extent)});
+}
+
+// rooms x rooms комнат со стороной roomSize; во внутренних стенах проём по центру
+void BuildScene(Scene& scene, int rooms, float roomSize, size_t objectCount) {
+    const auto box = MakeUnitBox();
+    const float height = 3.0f;
+    const float thickness = 0.2f;
+    const float door = 1.2f;
+    const float half = (roomSize - door) * 0.5f;
+    for (int line = 0; line <= rooms; ++line) {
+        const bool outer = line == 0 || line == rooms;
+        for (int room = 0; room < rooms; ++room) {
+            const float a = line * roomSize;
+            const float b = room * roomSize;
+            if (outer) {
+                AddWall(scene, box, {a, height * 0.5f, b + roomSize * 0.5f}, {thickness, height, roomSize});
+                AddWall(scene, box, {b + roomSize * 0.5f, height * 0.5f, a}, {roomSize, height, thickness});
+                continue;
+            }
+            AddWall(scene, box, {a, height * 0.5f, b + half * 0.5f}, {thickness, height, half});
+            AddWall(scene, box, {a, height * 0.5f, b + roomSize - half * 0.5f}, {thickness, height, half});
+            AddWall(scene, box, {b + half * 0.5f, height * 0.5f, a}, {half, height, thickness});
+            AddWall(scene, box, {b + roomSize - half * 0.5f, height * 0.5f, a}, {half, height, thickness});
+        }
+    }
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> position(0.5f, rooms * roomSize - 0.5f);
+    std::uniform_real_distribution<float> size(0.2f, 0.6f);
+    std::uniform_real_distribution<float> lift(0.0f, 2.0f);
+    for (size_t i = 0; i < objectCount; ++i) {
+        const Vector3 center = {position(rng), lift(rng), position(rng)};
+        const float r = size(rng) * 0.5f;
+        scene.objects.push_back({Vector3Subtract(center, {r, r, r}), Vector3Add(center, {r, r, r})});
+    }
+}
+
+struct Result {
+    double renderMs = 0.0;
+    double testMs = 0.0;
+    double occludedShare = 0.0;
+    int triangles = 0;
+    int falseOcclusions = 0;
+    std::vector<float> lastDepth;
+};
+
+} // anonymous namespace
+
+int RunOcclusionBench(int argc, char** argv) {
+    const size_t objectCount = argc > 0 ? std::strtoul(argv[0], nullptr, 10) : 10000;
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 120;
+    const int rooms = 8;
+    const float roomSize = 10.0f;
+
+    Scene scene;
+    BuildScene(scene, rooms, roomSize, objectCount);
+    kalan::ImageThreadPool pool;
+    const Matrix projection = MatrixPerspective(60.0 * DEG2RAD, 320.0 / 192.0, 0.05, 500.0);
+
+    auto run = [&](bool simd, kalan::ImageThreadPool* workers) {
+        kalan::OcclusionSystem::Settings settings;
+        settings.maxOccluders = 1024;
+        settings.buffer.simd = simd;
+        kalan::OcclusionSystem occlusion(scene.registry, settings);
+        Result result;
+
+        for (int frame = 0; frame < frames; ++frame) {
+            // Камера в углу комнаты у центра сетки поворачивается вокруг вертикали
+            const float angle = static_cast<float>(frame) / frames * 2.0f * PI;
+            const Vector3 eye = {rooms * roomSize * 0.5f + 1.5f, 1.7f, rooms * roomSize * 0.5f + 1.5f};
+            const Vector3 target = Vector3Add(eye, {std::cos(angle), -0.1f, std::sin(angle)});
+            const Matrix viewProjection = MatrixMultiply(MatrixLookAt(eye, target, {0.0f, 1.0f, 0.0f}), projection);
+            const kalan::Frustum frustum = kalan::Frustum::fromMatrix(viewProjection);
+
+            auto start = Clock::now();
+            auto stats = occlusion.update(viewProjection, eye, workers);
+            result.renderMs += MsSince(start);
+            result.triangles = std::max(result.triangles, stats.triangles);
+
+            start = Clock::now();
+            const kalan::OcclusionBuffer& buffer = occlusion.getBuffer();
+            size_t inFrustum = 0, hidden = 0;
+            for (const BoundingBox& object : scene.objects) {
+                if (!frustum.intersects(object)) continue;
+                ++inFrustum;
+                hidden += !buffer.isVisible(object);
+            }
+            result.testMs += MsSince(start);
+            result.occludedShare += inFrustum > 0 ? static_cast<double>(hidden) / inFrustum : 0.0;
+
+            // Ложные перекрытия: отсечённый объект, центр которого виден из камеры
+            if (frame == frames - 1) {
+                for (const BoundingBox& object : scene.objects) {
+                    if (!frustum.intersects(object) || buffer.isVisible(object)) continue;
+                    const Vector3 center = Vector3Scale(Vector3Add(object.min, object.max), 0.5f);
+                    bool blocked = false;
+                    for (const BoundingBox& wall : scene.walls) {
+                        if (SegmentHitsBox(eye, center, wall)) {
+                            blocked = true;
+                            break;
+                        }
+                    }
+                    result.falseOcclusions += !blocked;
+                }
+                const float* depth = buffer.getDepth();
+                result.lastDepth.assign(depth, depth + static_cast<size_t>(buffer.getWidth()) * buffer.getHeight());
+            }
+        }
+        result.renderMs /= frames;
+        result.testMs /= frames;
+        result.occludedShare /= frames;
+        return result;
+    };
+
+    const Result scalar = run(false, nullptr);
+    const Result simd = run(true, nullptr);
+    const Result parallel = run(true, &pool);
+
+    float maxDifference = 0.0f;
+    for (size_t i = 0; i < scalar.lastDepth.size(); ++i) {
+        maxDifference = std::max(maxDifference, std::fabs(scalar.lastDepth[i] - simd.lastDepth[i]));
+        maxDifference = std::max(maxDifference, std::fabs(scalar.lastDepth[i] - parallel.lastDepth[i]));
+    }
+
+    std::printf("Occlusion: %d rooms, %zu walls, %zu objects, 320x192 buffer (%s)\n", rooms * rooms,
+                scene.walls.size(), objectCount, kalan::isSimdOcclusionAvailable() ? "SSE" : "no SIMD in this build");
+    std::printf("  render scalar        %8.3f ms   %d triangles\n", scalar.renderMs, scalar.triangles);
+    std::printf("  render simd          %8.3f ms   x%.2f\n", simd.renderMs, scalar.renderMs / simd.renderMs);
+    std::printf("  render simd, %zu threads %8.3f ms   x%.2f\n", pool.getThreadCount(),
+                parallel.renderMs, scalar.renderMs / parallel.renderMs);
+    std::printf("  test %zu AABBs       %8.3f ms   %.1f%% of frustum-visible occluded\n", objectCount,
+                simd.testMs, simd.occludedShare * 100.0);
+    std::printf("  false occlusions (last frame): %d, max difference to scalar: %.2e\n",
+                simd.falseOcclusions, maxDifference);
+    RecordResult("occlusion", "render, scalar", scalar.renderMs, "ms");
+    RecordResult("occlusion", "render, simd", simd.renderMs, "ms");
+    RecordResult("occlusion", "render, simd pool", parallel.renderMs, "ms");
+    RecordResult("occlusion", "test AABBs", simd.testMs, "ms");
+    RecordResult("occlusion", "occluded share", simd.occludedShare * 100.0, "%");
+    RecordResult("occlusion", "false occlusions", simd.falseOcclusions, "count");
+    return maxDifference < 1e-4f ? 0 : 1;
+}
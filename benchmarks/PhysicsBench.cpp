@@ -0,0 +1,92 @@
+// Headless стресс-тест физики: тысячи падающих коробок, время шага
+// в зависимости от числа воркеров общего пула.
+
+#include "Benchmarks.hpp"
+#include "physics/PhysicsWorld.hpp"
+#include "resources/ParallelLoader.hpp"
+#include "scene/TransformSystem.hpp"
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    double avgMs = 0.0;
+    double maxMs = 0.0;
+    double syncMs = 0.0;
+    size_t activeBodies = 0;
+};
+
+Result Run(size_t workers, int bodyCount, int steps) {
+    entt::registry registry;
+    kalan::ImageThreadPool pool(workers);
+    kalan::PhysicsWorld world(registry, pool);
+
+    entt::entity ground = kalan::TransformSystem::createEntity(registry);
+    world.addBody(ground, JPH::BodyCreationSettings(
+        new JPH::BoxShape(JPH::Vec3(200.0f, 1.0f, 200.0f)), JPH::RVec3(0.0f, -1.0f, 0.0f),
+        JPH::Quat::sIdentity(), JPH::EMotionType::Static, kalan::physics_layers::NonMoving),
+        JPH::EActivation::DontActivate);
+
+    // Столбики коробок на сетке, чуть сдвинутые, чтобы стопки разваливались
+    JPH::RefConst<JPH::Shape> box = new JPH::BoxShape(JPH::Vec3(0.5f, 0.5f, 0.5f));
+    const int columns = 32;
+    for (int i = 0; i < bodyCount; ++i) {
+        int column = i % (columns * columns);
+        int layer = i / (columns * columns);
+        float x = (column % columns - columns / 2) * 2.5f + (layer % 2) * 0.3f;
+        float z = (column / columns - columns / 2) * 2.5f;
+        float y = 1.0f + layer * 1.2f;
+        entt::entity entity = kalan::TransformSystem::createEntity(registry);
+        world.addBody(entity, JPH::BodyCreationSettings(
+            box, JPH::RVec3(x, y, z), JPH::Quat::sIdentity(),
+            JPH::EMotionType::Dynamic, kalan::physics_layers::Moving));
+    }
+    world.optimizeBroadPhase();
+
+    Result result;
+    for (int s = 0; s < steps; ++s) {
+        auto start = Clock::now();
+        world.step();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        // Интерполяция и запись в LocalTransform — на главном потоке, как в кадре
+        auto syncStart = Clock::now();
+        world.interpolate(1.0f);
+        result.syncMs += std::chrono::duration<double, std::milli>(Clock::now() - syncStart).count();
+
+        result.avgMs += ms;
+        result.maxMs = std::max(result.maxMs, ms);
+    }
+    result.avgMs /= steps;
+    result.syncMs /= steps;
+    result.activeBodies = world.getSystem().GetNumActiveBodies(JPH::EBodyType::RigidBody);
+    return result;
+}
+
+} // anonymous namespace
+
+int RunPhysicsBench(int argc, char** argv) {
+    int bodyCount = argc > 0 ? std::atoi(argv[0]) : 8000;
+    int steps = argc > 1 ? std::atoi(argv[1]) : 300;
+    size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+
+    std::printf("PhysicsWorld: %d dynamic boxes, %d steps of 1/60 s\n", bodyCount, steps);
+    for (size_t workers = 1;; workers *= 2) {
+        workers = std::min(workers, hardware);
+        Result r = Run(workers, bodyCount, steps);
+        std::printf("  %2zu workers + caller: step %8.3f ms (max %8.3f)   interpolate %6.3f ms   active %zu\n",
+                    workers, r.avgMs, r.maxMs, r.syncMs, r.activeBodies);
+        RecordResult("physics", "step, " + std::to_string(workers) + " workers", r.avgMs, "ms");
+        if (workers == hardware) break;
+    }
+    return 0;
+}
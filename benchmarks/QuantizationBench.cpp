@@ -0,0 +1,200 @@
+// Headless проверка сжатого формата вершин (packMesh): синтетические меши
+// упаковываются с half и unorm16 UV, вершины декодируются так же, как в
+// pbr_packed.vs, и ошибка каждого атрибута сравнивается с теоретической границей
+// (unorm16ErrorBound, octahedralErrorBoundDegrees, halfErrorBound).
+
+#include "Benchmarks.hpp"
+#include "resources/VertexQuantization.hpp"
+#include "raylib.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Позиции в кубе center ± extent/2, нормали и тангенты по всей сфере (плюс оси
+// и экватор — края октаэдра), UV в [uvMin, uvMax]
+struct MeshDesc {
+    const char* name;
+    float center;
+    float extent;
+    float uvMin;
+    float uvMax;
+};
+
+struct Streams {
+    std::vector<float> vertices;
+    std::vector<float> normals;
+    std::vector<float> tangents;
+    std::vector<float> texcoords;
+};
+
+void RandomUnit(std::mt19937& rng, float out[3]) {
+    std::normal_distribution<float> gauss(0.0f, 1.0f);
+    float length = 0.0f;
+    while (length < 1e-3f) {
+        for (int k = 0; k < 3; ++k) out[k] = gauss(rng);
+        length = std::sqrt(out[0] * out[0] + out[1] * out[1] + out[2] * out[2]);
+    }
+    for (int k = 0; k < 3; ++k) out[k] /= length;
+}
+
+Mesh MakeMesh(const MeshDesc& desc, int vertexCount, Streams& streams) {
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> position(desc.center - desc.extent * 0.5f,
+                                                   desc.center + desc.extent * 0.5f);
+    std::uniform_real_distribution<float> uv(desc.uvMin, desc.uvMax);
+    std::uniform_real_distribution<float> angle(0.0f, 2.0f * PI);
+
+    streams.vertices.resize(vertexCount * 3);
+    streams.normals.resize(vertexCount * 3);
+    streams.tangents.resize(vertexCount * 4);
+    streams.texcoords.resize(vertexCount * 2);
+    const float axes[6][3] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+    for (int i = 0; i < vertexCount; ++i) {
+        for (int k = 0; k < 3; ++k) streams.vertices[i * 3 + k] = position(rng);
+        float n[3];
+        if (i < 6) {
+            std::copy(axes[i], axes[i] + 3, n);
+        } else if (i % 7 == 0) {
+            const float a = angle(rng);     // z = 0: шов сложения нижней полусферы
+            n[0] = std::cos(a);
+            n[1] = std::sin(a);
+            n[2] = 0.0f;
+        } else {
+            RandomUnit(rng, n);
+        }
+        std::copy(n, n + 3, &streams.normals[i * 3]);
+        float t[3];
+        RandomUnit(rng, t);
+        std::copy(t, t + 3, &streams.tangents[i * 4]);
+        streams.tangents[i * 4 + 3] = (i & 1) ? 1.0f : -1.0f;
+        streams.texcoords[i * 2] = uv(rng);
+        streams.texcoords[i * 2 + 1] = uv(rng);
+    }
+
+    Mesh mesh{};
+    mesh.vertexCount = vertexCount;
+    mesh.vertices = streams.vertices.data();
+    mesh.normals = streams.normals.data();
+    mesh.tangents = streams.tangents.data();
+    mesh.texcoords = streams.texcoords.data();
+    return mesh;
+}
+
+double AngleDegrees(const float a[3], const float b[3]) {
+    const double cx = static_cast<double>(a[1]) * b[2] - static_cast<double>(a[2]) * b[1];
+    const double cy = static_cast<double>(a[2]) * b[0] - static_cast<double>(a[0]) * b[2];
+    const double cz = static_cast<double>(a[0]) * b[1] - static_cast<double>(a[1]) * b[0];
+    const double d = static_cast<double>(a[0]) * b[0] + static_cast<double>(a[1]) * b[1] +
+                     static_cast<double>(a[2]) * b[2];
+    return std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), d) * RAD2DEG;
+}
+
+// Худшее отношение ошибки к границе по атрибуту; > 1 — граница нарушена
+struct Ratios {
+    double position = 0.0;
+    double normal = 0.0;
+    double tangent = 0.0;
+    double texcoord = 0.0;
+    bool tangentSign = true;
+    bool reported = true;       // QuantizationError из packMesh тоже в границах
+};
+
+Ratios Check(const Mesh& mesh, const kalan::PackedMeshData& data) {
+    Ratios r;
+    const kalan::PackedMeshInfo& info = data.info;
+    const float offset[3] = {info.positionOffset.x, info.positionOffset.y, info.positionOffset.z};
+    const float scale[3] = {info.positionScale.x, info.positionScale.y, info.positionScale.z};
+    const float uvOffset[2] = {info.texcoordOffset.x, info.texcoordOffset.y};
+    const float uvScale[2] = {info.texcoordScale.x, info.texcoordScale.y};
+    const float octBound = kalan::octahedralErrorBoundDegrees();
+    // Декодирование во float: несколько ulp от модуля значения
+    auto slack = [](float magnitude) { return 8.0f * 1.1920929e-7f * magnitude; };
+
+    float positionBound = 0.0f;
+    float uvBound = 0.0f;
+    for (int i = 0; i < mesh.vertexCount; ++i) {
+        const kalan::PackedVertex& v = data.vertices[i];
+        for (int k = 0; k < 3; ++k) {
+            const float p = mesh.vertices[i * 3 + k];
+            const float decoded = offset[k] + v.position[k] / 65535.0f * scale[k];
+            const float bound = kalan::unorm16ErrorBound(scale[k]) + slack(std::fabs(offset[k]) + scale[k]);
+            positionBound = std::max(positionBound, bound);
+            r.position = std::max(r.position, std::fabs(decoded - p) / static_cast<double>(bound));
+        }
+        r.tangentSign &= (v.position[3] == 65535) == (mesh.tangents[i * 4 + 3] >= 0.0f);
+
+        float decoded[3];
+        kalan::decodeOctahedral(v.normal, decoded);
+        r.normal = std::max(r.normal, AngleDegrees(&mesh.normals[i * 3], decoded) / octBound);
+        kalan::decodeOctahedral(v.tangent, decoded);
+        r.tangent = std::max(r.tangent, AngleDegrees(&mesh.tangents[i * 4], decoded) / octBound);
+
+        for (int k = 0; k < 2; ++k) {
+            const float uv = mesh.texcoords[i * 2 + k];
+            float value;
+            float bound;
+            if (data.texcoords == kalan::TexcoordEncoding::Half) {
+                value = kalan::halfToFloat(v.texcoord[k]);
+                bound = kalan::halfErrorBound(uv);
+            } else {
+                value = uvOffset[k] + v.texcoord[k] / 65535.0f * uvScale[k];
+                bound = kalan::unorm16ErrorBound(uvScale[k]) + slack(std::fabs(uvOffset[k]) + uvScale[k]);
+            }
+            uvBound = std::max(uvBound, bound);
+            r.texcoord = std::max(r.texcoord, std::fabs(value - uv) / static_cast<double>(bound));
+        }
+    }
+
+    const kalan::QuantizationError& e = data.error;
+    r.reported = e.position <= positionBound && e.normalDegrees <= octBound &&
+                 e.tangentDegrees <= octBound && e.texcoord <= uvBound;
+    return r;
+}
+
+} // anonymous namespace
+
+int RunQuantizationBench(int argc, char** argv) {
+    const int vertexCount = argc > 0 ? std::max(8, std::atoi(argv[0])) : 200000;
+
+    const MeshDesc meshes[] = {
+        {"unit cube", 0.0f, 1.0f, 0.0f, 1.0f},
+        {"far offset", 1000.0f, 50.0f, 0.0f, 1.0f},
+        {"tiled uv", -3.0f, 20.0f, -4.0f, 8.0f},
+    };
+    const kalan::TexcoordEncoding encodings[] = {kalan::TexcoordEncoding::Unorm16, kalan::TexcoordEncoding::Half};
+
+    std::printf("packMesh: %d vertices per mesh, error / analytic bound (<= 1 passes), oct bound %.5f deg\n",
+                vertexCount, kalan::octahedralErrorBoundDegrees());
+    int failures = 0;
+    for (const MeshDesc& desc : meshes) {
+        Streams streams;
+        const Mesh mesh = MakeMesh(desc, vertexCount, streams);
+        for (kalan::TexcoordEncoding encoding : encodings) {
+            const char* uvName = encoding == kalan::TexcoordEncoding::Half ? "half" : "unorm16";
+            const auto start = std::chrono::steady_clock::now();
+            const kalan::PackedMeshData data = kalan::packMesh(mesh, encoding);
+            const double ms =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            const Ratios r = Check(mesh, data);
+            const bool ok = r.position <= 1.0 && r.normal <= 1.0 && r.tangent <= 1.0 && r.texcoord <= 1.0 &&
+                            r.tangentSign && r.reported;
+            failures += !ok;
+
+            std::printf("  %-10s %-7s position %.3f  normal %.3f  tangent %.3f  uv %.3f  %7.2f ms  %s%s%s\n",
+                        desc.name, uvName, r.position, r.normal, r.tangent, r.texcoord, ms, ok ? "ok" : "FAILED",
+                        r.tangentSign ? "" : " (tangent sign)", r.reported ? "" : " (reported error)");
+            const std::string name = std::string(desc.name) + ", " + uvName;
+            RecordResult("quantize", name + ", position error/bound", r.position, "ratio");
+            RecordResult("quantize", name + ", normal error/bound", r.normal, "ratio");
+            RecordResult("quantize", name + ", uv error/bound", r.texcoord, "ratio");
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
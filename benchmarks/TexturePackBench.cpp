@@ -0,0 +1,364 @@
+// Headless проверка TexturePacker: раскладка каналов ORM (общая metallicRoughness
+// текстура glTF и отдельные карты), дедупликация, непересекающиеся прямоугольники
+// атласа с продлённой рамкой padding и UV, которые после переноса остаются в своём тайле.
+// Всё на CPU изображениях — GPU не нужен.
+
+#include "Benchmarks.hpp"
+#include "resources/TexturePacker.hpp"
+#include "raylib.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using kalan::AtlasItem;
+using kalan::AtlasLayout;
+using kalan::AtlasRect;
+using kalan::MaterialTextureSlots;
+using kalan::UvTransform;
+
+Color PixelAt(const Image& image, int x, int y) {
+    const auto* p = static_cast<const unsigned char*>(image.data) +
+                    (static_cast<size_t>(y) * image.width + x) * 4;
+    return {p[0], p[1], p[2], p[3]};
+}
+
+bool SameColor(Color a, Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+Color Gray(unsigned char value) {
+    return {value, value, value, 255};
+}
+
+MaterialTextureSlots EmptySlots() {
+    MaterialTextureSlots slots;
+    slots.fill(-1);
+    return slots;
+}
+
+int AddImage(std::vector<Image>& images, Image image) {
+    images.push_back(image);
+    return static_cast<int>(images.size()) - 1;
+}
+
+void UnloadImages(std::vector<Image>& images) {
+    for (Image& image : images) {
+        if (image.data) UnloadImage(image);
+    }
+    images.clear();
+}
+
+// Пиксель изображения слота в центре тайла материала (UV после атласа)
+Color SampleTileCenter(const std::vector<Image>& images, const MaterialTextureSlots& slots, int slot,
+                       const UvTransform& uv) {
+    const Image& image = images[slots[slot]];
+    int x = static_cast<int>((uv.offset.x + uv.scale.x * 0.5f) * image.width);
+    int y = static_cast<int>((uv.offset.y + uv.scale.y * 0.5f) * image.height);
+    return PixelAt(image, std::clamp(x, 0, image.width - 1), std::clamp(y, 0, image.height - 1));
+}
+
+void Report(const char* name, bool ok, int& failures) {
+    std::printf("  %-44s %s\n", name, ok ? "ok" : "FAILED");
+    failures += !ok;
+}
+
+// packOrmImage напрямую: каналы, константы и размер по крупнейшему источнику
+bool CheckOrmImage() {
+    Image ao = GenImageColor(4, 4, Gray(50));
+    Image rough = GenImageColor(8, 8, Gray(100));
+    Image metalRough = GenImageColor(8, 8, {7, 120, 230, 255});
+
+    Image separate = kalan::packOrmImage({&ao, 0, 1.0f}, {&rough, 0, 1.0f}, {nullptr, 0, 0.0f});
+    Image shared = kalan::packOrmImage({nullptr, 0, 1.0f}, {&metalRough, 1, 1.0f}, {&metalRough, 2, 0.0f});
+
+    bool ok = separate.width == 8 && separate.height == 8 &&
+              SameColor(PixelAt(separate, 7, 7), {50, 100, 0, 255}) &&
+              SameColor(PixelAt(shared, 0, 0), {255, 120, 230, 255});
+
+    UnloadImage(ao);
+    UnloadImage(rough);
+    UnloadImage(metalRough);
+    UnloadImage(separate);
+    UnloadImage(shared);
+    return ok;
+}
+
+// Дубликаты сворачиваются в первое вхождение, копии освобождаются
+bool CheckDedupe() {
+    std::vector<Image> images;
+    int a = AddImage(images, GenImageColor(16, 16, RED));
+    int aCopy = AddImage(images, GenImageColor(16, 16, RED));
+    int b = AddImage(images, GenImageColor(16, 16, BLUE));
+    int bCopy = AddImage(images, GenImageColor(16, 16, BLUE));
+    int bSecondCopy = AddImage(images, GenImageColor(16, 16, BLUE));
+    int c = AddImage(images, GenImageColor(32, 16, RED));   // тот же цвет, другой размер
+
+    std::vector<MaterialTextureSlots> materials(3, EmptySlots());
+    materials[0][MATERIAL_MAP_ALBEDO] = aCopy;
+    materials[0][MATERIAL_MAP_NORMAL] = bCopy;
+    materials[1][MATERIAL_MAP_ALBEDO] = bSecondCopy;
+    materials[2][MATERIAL_MAP_ALBEDO] = c;
+
+    kalan::TexturePackSettings settings;
+    settings.packOrm = false;
+    settings.atlas = false;
+    kalan::TexturePackResult result = kalan::packMaterialTextures(images, materials, {}, settings);
+
+    bool ok = result.stats.sourceImages == 6 && result.stats.duplicatesRemoved == 3 &&
+              result.stats.resultImages == 3 &&
+              materials[0][MATERIAL_MAP_ALBEDO] == a && materials[0][MATERIAL_MAP_NORMAL] == b &&
+              materials[1][MATERIAL_MAP_ALBEDO] == b && materials[2][MATERIAL_MAP_ALBEDO] == c &&
+              images[aCopy].data == nullptr && images[bCopy].data == nullptr;
+
+    UnloadImages(images);
+    return ok;
+}
+
+// Прямоугольники с рамкой padding не пересекаются и не выходят за страницу
+bool RectsDisjoint(const AtlasLayout& layout, int padding) {
+    const auto& rects = layout.rects;
+    for (size_t i = 0; i < rects.size(); ++i) {
+        const AtlasRect& a = rects[i];
+        if (a.page < 0 || a.page >= layout.pageCount || a.x - padding < 0 || a.y - padding < 0 ||
+            a.x + a.width + padding > layout.width || a.y + a.height + padding > layout.height) {
+            return false;
+        }
+        for (size_t j = i + 1; j < rects.size(); ++j) {
+            const AtlasRect& b = rects[j];
+            if (a.page != b.page) continue;
+            bool separateX = a.x + a.width + padding <= b.x - padding || b.x + b.width + padding <= a.x - padding;
+            bool separateY = a.y + a.height + padding <= b.y - padding || b.y + b.height + padding <= a.y - padding;
+            if (!separateX && !separateY) return false;
+        }
+    }
+    return true;
+}
+
+bool CheckAtlasLayout(int& pages) {
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> size(4, 64);
+    std::vector<AtlasItem> items(60);
+    for (auto& item : items) item = {size(rng), size(rng)};
+
+    const int padding = 4;
+    AtlasLayout single = kalan::packAtlas(items, 2048, padding);
+    AtlasLayout paged = kalan::packAtlas(items, 128, padding);
+    pages = paged.pageCount;
+
+    return single.pageCount == 1 && single.rects.size() == items.size() && RectsDisjoint(single, padding) &&
+           paged.pageCount > 1 && paged.width == 128 && RectsDisjoint(paged, padding);
+}
+
+// Рамка повторяет ближайший краевой пиксель тайла, остальное — заливка
+bool CheckAtlasPadding() {
+    const int padding = 3;
+    const Color fill = {255, 0, 255, 255};
+    std::vector<AtlasItem> items = {{8, 8}, {16, 12}, {5, 9}, {12, 4}, {7, 7}};
+
+    std::vector<Image> tiles;
+    for (size_t t = 0; t < items.size(); ++t) {
+        Image tile = GenImageColor(items[t].width, items[t].height, BLACK);
+        for (int y = 0; y < tile.height; ++y) {
+            for (int x = 0; x < tile.width; ++x) {
+                ImageDrawPixel(&tile, x, y, {static_cast<unsigned char>(x * 15),
+                                             static_cast<unsigned char>(y * 15),
+                                             static_cast<unsigned char>(t * 40), 255});
+            }
+        }
+        tiles.push_back(tile);
+    }
+    std::vector<const Image*> tilePtrs;
+    for (const Image& tile : tiles) tilePtrs.push_back(&tile);
+
+    AtlasLayout layout = kalan::packAtlas(items, 256, padding);
+    Image atlas = kalan::buildAtlasImage(layout, 0, tilePtrs, padding, fill);
+
+    std::vector<bool> covered(static_cast<size_t>(atlas.width) * atlas.height, false);
+    bool ok = layout.pageCount == 1;
+    for (size_t t = 0; t < items.size() && ok; ++t) {
+        const AtlasRect& rect = layout.rects[t];
+        for (int y = -padding; y < rect.height + padding; ++y) {
+            for (int x = -padding; x < rect.width + padding; ++x) {
+                Color expected = PixelAt(tiles[t], std::clamp(x, 0, rect.width - 1),
+                                         std::clamp(y, 0, rect.height - 1));
+                ok &= SameColor(PixelAt(atlas, rect.x + x, rect.y + y), expected);
+                covered[static_cast<size_t>(rect.y + y) * atlas.width + rect.x + x] = true;
+            }
+        }
+    }
+    for (int y = 0; y < atlas.height && ok; ++y) {
+        for (int x = 0; x < atlas.width; ++x) {
+            if (!covered[static_cast<size_t>(y) * atlas.width + x]) ok &= SameColor(PixelAt(atlas, x, y), fill);
+        }
+    }
+
+    UnloadImage(atlas);
+    UnloadImages(tiles);
+    return ok;
+}
+
+// UV в [0, 1] после переноса (в том числе поверх преобразования материала) лежат в тайле
+bool CheckUvRemap() {
+    std::vector<float> unit = {0.0f, 0.0f, 1.0f, 1.0f, 0.5f, 0.25f, 1.0005f, -0.0005f};
+    std::vector<float> tiled = {0.0f, 0.0f, 2.0f, 0.5f};
+    if (!kalan::texcoordsInUnitRange(unit.data(), 4) || kalan::texcoordsInUnitRange(tiled.data(), 2) ||
+        kalan::texcoordsInUnitRange(nullptr, 0)) {
+        return false;
+    }
+
+    const AtlasRect rect = {0, 36, 68, 24, 40};
+    const int width = 256, height = 128;
+    const float minU = 36.0f / width, maxU = 60.0f / width;
+    const float minV = 68.0f / height, maxV = 108.0f / height;
+    const float eps = 1e-5f;
+    UvTransform atlas = kalan::atlasUvTransform(rect, width, height);
+    UvTransform base;
+    base.offset = {0.25f, 0.5f};
+    base.scale = {0.5f, 0.25f};
+    UvTransform combined = kalan::combineUvTransform(base, atlas);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> uv(0.0f, 1.0f);
+    std::vector<float> texcoords(2000);
+    for (float& t : texcoords) t = uv(rng);
+    texcoords[0] = texcoords[1] = 0.0f;
+    texcoords[2] = texcoords[3] = 1.0f;
+
+    std::vector<float> direct = texcoords;
+    std::vector<float> twoStep = texcoords;
+    std::vector<float> once = texcoords;
+    kalan::remapTexcoords(direct.data(), 1000, atlas);
+    kalan::remapTexcoords(twoStep.data(), 1000, base);
+    kalan::remapTexcoords(twoStep.data(), 1000, atlas);
+    kalan::remapTexcoords(once.data(), 1000, combined);
+
+    for (int i = 0; i < 1000; ++i) {
+        for (const std::vector<float>* out : {&direct, &once}) {
+            float u = (*out)[i * 2], v = (*out)[i * 2 + 1];
+            if (u < minU - eps || u > maxU + eps || v < minV - eps || v > maxV + eps) return false;
+        }
+        if (std::abs(once[i * 2] - twoStep[i * 2]) > eps || std::abs(once[i * 2 + 1] - twoStep[i * 2 + 1]) > eps) {
+            return false;
+        }
+    }
+    return std::abs(direct[0] - minU) < eps && std::abs(direct[3] - maxV) < eps;
+}
+
+// Полный проход: ORM из общей metallicRoughness (G/B) и из отдельных карт, затем атлас.
+// В центре тайла каждого материала должны оказаться его альбедо и его ORM
+bool CheckMaterialPack(int& atlasedMaterials) {
+    struct Source {
+        Color albedo;
+        unsigned char ao;          // 0 — карты AO нет, в ORM константа 255
+        unsigned char roughness;
+        unsigned char metallic;
+        bool shared;               // metallicRoughness одной текстурой
+    };
+    const Source sources[] = {
+        {{200, 10, 10, 255}, 40, 110, 220, true},
+        {{10, 200, 10, 255}, 25, 90, 30, true},
+        {{10, 10, 200, 255}, 70, 140, 180, false},
+        {{200, 200, 10, 255}, 0, 60, 250, false},
+    };
+    const int count = static_cast<int>(std::size(sources));
+
+    std::vector<Image> images;
+    std::vector<MaterialTextureSlots> materials(count + 1, EmptySlots());
+    for (int m = 0; m < count; ++m) {
+        const Source& s = sources[m];
+        MaterialTextureSlots& slots = materials[m];
+        slots[MATERIAL_MAP_ALBEDO] = AddImage(images, GenImageColor(32, 32, s.albedo));
+        if (s.shared) {
+            // R у metallicRoughness не используется — там мусор, который не должен попасть в AO
+            int mr = AddImage(images, GenImageColor(32, 32, {13, s.roughness, s.metallic, 255}));
+            slots[MATERIAL_MAP_METALNESS] = mr;
+            slots[MATERIAL_MAP_ROUGHNESS] = mr;
+        } else {
+            slots[MATERIAL_MAP_METALNESS] = AddImage(images, GenImageColor(32, 32, Gray(s.metallic)));
+            slots[MATERIAL_MAP_ROUGHNESS] = AddImage(images, GenImageColor(32, 32, Gray(s.roughness)));
+        }
+        if (s.ao != 0) slots[MATERIAL_MAP_OCCLUSION] = AddImage(images, GenImageColor(32, 32, Gray(s.ao)));
+    }
+    // Тайлящий материал остаётся на своей текстуре
+    const int tiledAlbedo = AddImage(images, GenImageColor(32, 32, {1, 2, 3, 255}));
+    materials[count][MATERIAL_MAP_ALBEDO] = tiledAlbedo;
+    std::vector<bool> atlasable(count + 1, true);
+    atlasable[count] = false;
+
+    kalan::TexturePackResult result =
+        kalan::packMaterialTextures(images, materials, atlasable, kalan::TexturePackSettings{});
+    atlasedMaterials = result.stats.atlasedMaterials;
+
+    bool ok = result.stats.ormPacked == count && result.stats.atlasedMaterials == count &&
+              result.stats.atlasPages == 1 && !result.materialOrm[count] &&
+              materials[count][MATERIAL_MAP_ALBEDO] == tiledAlbedo &&
+              result.materialUv[count].scale.x == 1.0f && result.materialUv[count].offset.x == 0.0f;
+    for (int m = 0; m < count && ok; ++m) {
+        const Source& s = sources[m];
+        const MaterialTextureSlots& slots = materials[m];
+        Color orm = {s.ao != 0 ? s.ao : static_cast<unsigned char>(255), s.roughness, s.metallic, 255};
+        ok = result.materialOrm[m] && slots[MATERIAL_MAP_ROUGHNESS] < 0 && slots[MATERIAL_MAP_OCCLUSION] < 0 &&
+             slots[MATERIAL_MAP_ALBEDO] == materials[0][MATERIAL_MAP_ALBEDO] &&
+             slots[MATERIAL_MAP_METALNESS] == materials[0][MATERIAL_MAP_METALNESS] &&
+             result.materialUv[m].scale.x < 1.0f &&
+             SameColor(SampleTileCenter(images, slots, MATERIAL_MAP_ALBEDO, result.materialUv[m]), s.albedo) &&
+             SameColor(SampleTileCenter(images, slots, MATERIAL_MAP_METALNESS, result.materialUv[m]), orm);
+    }
+
+    UnloadImages(images);
+    return ok;
+}
+
+} // anonymous namespace
+
+int RunTexturePackBench(int argc, char** argv) {
+    const int materialCount = argc > 0 ? std::max(2, std::atoi(argv[0])) : 64;
+
+    std::printf("TexturePacker: correctness checks\n");
+    int failures = 0;
+    int pages = 0;
+    int atlasedMaterials = 0;
+    Report("ORM channels (packOrmImage)", CheckOrmImage(), failures);
+    Report("dedupe", CheckDedupe(), failures);
+    Report("atlas rects disjoint with padding", CheckAtlasLayout(pages), failures);
+    Report("atlas padding extends tile edges", CheckAtlasPadding(), failures);
+    Report("remapped UVs stay inside the tile", CheckUvRemap(), failures);
+    Report("ORM + atlas (shared and separate maps)", CheckMaterialPack(atlasedMaterials), failures);
+    RecordResult("texpack", "multi-page layout, pages", pages, "count");
+    RecordResult("texpack", "end-to-end, atlased materials", atlasedMaterials, "count");
+
+    // Время упаковки: по материалу с альбедо и отдельными metallic/roughness 64x64
+    std::vector<Image> images;
+    std::vector<MaterialTextureSlots> materials(materialCount, EmptySlots());
+    for (int m = 0; m < materialCount; ++m) {
+        const Color albedo = {static_cast<unsigned char>(m % 256), static_cast<unsigned char>(m / 256), 77, 255};
+        const auto metallic = static_cast<unsigned char>(m % 7 * 30);
+        const auto roughness = static_cast<unsigned char>(m % 5 * 50 + 1);
+        materials[m][MATERIAL_MAP_ALBEDO] = AddImage(images, GenImageColor(64, 64, albedo));
+        materials[m][MATERIAL_MAP_METALNESS] = AddImage(images, GenImageColor(64, 64, Gray(metallic)));
+        materials[m][MATERIAL_MAP_ROUGHNESS] = AddImage(images, GenImageColor(64, 64, Gray(roughness)));
+    }
+    std::vector<bool> atlasable(materialCount, true);
+
+    const auto start = std::chrono::steady_clock::now();
+    kalan::TexturePackResult result =
+        kalan::packMaterialTextures(images, materials, atlasable, kalan::TexturePackSettings{});
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    const kalan::TexturePackStats& stats = result.stats;
+    std::printf("packMaterialTextures: %d materials, %d images -> %d (%d duplicates, %d ORM, %d atlas pages), %.2f ms\n",
+                materialCount, stats.sourceImages, stats.resultImages, stats.duplicatesRemoved,
+                stats.ormPacked, stats.atlasPages, ms);
+    RecordResult("texpack", std::to_string(materialCount) + " materials, pack time", ms, "ms");
+    RecordResult("texpack", std::to_string(materialCount) + " materials, result images", stats.resultImages, "count");
+    UnloadImages(images);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+// Headless бенчмарк решений mip стриминга: TextureResidency для сцены из многих
+// текстур при облёте камеры и уменьшение изображения до уровня (downsampleImage).
+// Проверяет, что цели не выходят за бюджет.
+
+#include "Benchmarks.hpp"
+#include "rendering/TextureResidency.hpp"
+#include "resources/PooledImageDecoder.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct SceneTexture {
+    kalan::TextureResidency::Handle handle;
+    float x, z;             // объект на плоскости, радиус 1
+    int size;
+};
+
+} // anonymous namespace
+
+int RunTextureStreamBench(int argc, char** argv) {
+    const int textureCount = argc > 0 ? std::atoi(argv[0]) : 4096;
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 600;
+    const size_t budget = size_t(256) * 1024 * 1024;
+
+    kalan::TextureResidency residency;
+    kalan::TextureResidency::Settings settings;
+    settings.budgetBytes = budget;
+    settings.evictDelayFrames = 30;
+    residency.setSettings(settings);
+
+    // Сетка объектов с текстурами 1024..4096, размещение повторяемое
+    std::vector<SceneTexture> scene;
+    const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(textureCount))));
+    for (int i = 0; i < textureCount; ++i) {
+        int size = 1024 << (i % 3);
+        int tail = kalan::TextureResidency::tailMipFor(size, size, settings.tailSize);
+        scene.push_back({residency.add(size, size, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, tail),
+                         static_cast<float>(i % side) * 4.0f, static_cast<float>(i / side) * 4.0f, size});
+    }
+
+    // Камера на 1080p, fovy 60: пикселей на единицу на расстоянии 1
+    const float pixelsAtUnit = 540.0f / std::tan(30.0f * DEG2RAD);
+    const float center = side * 2.0f;
+    std::vector<kalan::TextureResidency::Request> requests;
+    size_t maxTarget = 0;
+    uint64_t loads = 0;
+    uint64_t evictions = 0;
+
+    auto start = Clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        float angle = static_cast<float>(frame) * 0.01f;
+        float camX = center + std::cos(angle) * center * 0.5f;
+        float camZ = center + std::sin(angle) * center * 0.5f;
+        float dirX = -std::sin(angle);
+        float dirZ = std::cos(angle);
+
+        residency.beginFrame();
+        for (const SceneTexture& object : scene) {
+            float dx = object.x - camX;
+            float dz = object.z - camZ;
+            float along = dx * dirX + dz * dirZ;
+            // Грубый фрустум: впереди и в конусе около 60 градусов
+            if (along <= 0.0f || std::fabs(dx * dirZ - dz * dirX) > along * 0.6f) continue;
+            float distance = std::max(std::sqrt(dx * dx + dz * dz) - 1.0f, 0.1f);
+            float pixelsPerUnit = pixelsAtUnit / distance;
+            // UV покрывает объект 2x2 единицы
+            float texelsPerUnit = object.size * 0.5f;
+            residency.addDemand(object.handle, kalan::TextureResidency::screenMipLevel(texelsPerUnit, pixelsPerUnit),
+                                2.0f * pixelsPerUnit);
+        }
+
+        residency.plan(requests, 8);
+        maxTarget = std::max(maxTarget, residency.getStats().targetBytes);
+        // Загрузки и выгрузки завершаются сразу
+        for (const auto& request : requests) {
+            if (request.toMip < request.fromMip) ++loads;
+            else ++evictions;
+            residency.commit(request.handle, request.toMip);
+        }
+    }
+    double usPerFrame = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / frames;
+    auto stats = residency.getStats();
+
+    std::printf("TextureResidency: %d textures, %d frames: %.1f us per frame, %llu loads, %llu evictions\n",
+                textureCount, frames, usPerFrame,
+                static_cast<unsigned long long>(loads), static_cast<unsigned long long>(evictions));
+    std::printf("  resident %.1f MB, max target %.1f MB of %.0f MB budget, %d over budget\n",
+                static_cast<double>(stats.residentBytes) / (1024.0 * 1024.0),
+                static_cast<double>(maxTarget) / (1024.0 * 1024.0),
+                static_cast<double>(budget) / (1024.0 * 1024.0), stats.budgetLimited);
+    RecordResult("texstream", "plan " + std::to_string(textureCount) + " textures", usPerFrame, "us");
+
+    Image source = GenImageColor(2048, 2048, GRAY);
+    const int repeats = 8;
+    start = Clock::now();
+    for (int i = 0; i < repeats; ++i) {
+        Image reduced = kalan::downsampleImage(source, 1 + i % 3);
+        UnloadImage(reduced);
+    }
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / repeats;
+    UnloadImage(source);
+    std::printf("  downsample 2048x2048 RGBA: %.2f ms\n", ms);
+    RecordResult("texstream", "downsample 2048 rgba", ms, "ms");
+
+    // Хвосты всегда резидентны, поэтому выйти за бюджет может только их сумма
+    size_t tails = 0;
+    for (const SceneTexture& object : scene) {
+        tails += kalan::TextureResidency::chainBytes(object.size, object.size, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8,
+                                                     residency.getTailMip(object.handle));
+    }
+    if (maxTarget > std::max(budget, tails)) {
+        std::printf("  FAILED: target exceeded budget\n");
+        return 1;
+    }
+    return 0;
+}
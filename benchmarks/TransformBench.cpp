@@ -0,0 +1,116 @@
+// Headless бенчмарк TransformSystem: 1M сущностей, обновление за кадр
+// с dirty flags и без, однопоточно и на пуле воркеров.
+
+#include "Benchmarks.hpp"
+#include "resources/ParallelLoader.hpp"
+#include "scene/TransformSystem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Лес из roots деревьев с ветвлением branching, пока не наберётся total сущностей
+std::vector<entt::entity> BuildForest(entt::registry& registry, size_t total, size_t roots, size_t branching) {
+    std::vector<entt::entity> entities;
+    entities.reserve(total);
+    for (size_t r = 0; r < roots && entities.size() < total; ++r) {
+        entities.push_back(kalan::TransformSystem::createEntity(registry));
+    }
+    // Родители берутся по порядку — получается сбалансированная иерархия по уровням
+    for (size_t parent = 0; entities.size() < total; ++parent) {
+        for (size_t c = 0; c < branching && entities.size() < total; ++c) {
+            kalan::LocalTransform local;
+            local.translation = {static_cast<float>(c), 1.0f, 0.0f};
+            entities.push_back(kalan::TransformSystem::createEntity(registry, local, entities[parent]));
+        }
+    }
+    return entities;
+}
+
+struct Result {
+    double avgMs = 0.0;
+    double minMs = 0.0;
+    size_t updated = 0;
+};
+
+Result Run(entt::registry& registry, kalan::TransformSystem& system, kalan::ImageThreadPool* pool,
+           const std::vector<entt::entity>& entities, double touchFraction, int frames) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, entities.size() - 1);
+    size_t touches = static_cast<size_t>(entities.size() * touchFraction);
+
+    Result result;
+    result.minMs = 1e9;
+    for (int f = 0; f < frames; ++f) {
+        for (size_t t = 0; t < touches; ++t) {
+            registry.patch<kalan::LocalTransform>(entities[pick(rng)], [f](kalan::LocalTransform& l) {
+                l.translation.y = static_cast<float>(f);
+            });
+        }
+
+        auto start = Clock::now();
+        auto stats = system.update(pool);
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        result.avgMs += ms;
+        result.minMs = std::min(result.minMs, ms);
+        result.updated = stats.updated;
+    }
+    result.avgMs /= frames;
+    return result;
+}
+
+} // anonymous namespace
+
+int RunTransformBench(int argc, char** argv) {
+    size_t entityCount = argc > 0 ? std::strtoul(argv[0], nullptr, 10) : 1000000;
+    const int frames = 30;
+
+    entt::registry registry;
+    auto buildStart = Clock::now();
+    auto entities = BuildForest(registry, entityCount, 1000, 8);
+    double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - buildStart).count();
+
+    kalan::TransformSystem system(registry);
+    auto rebuildStart = Clock::now();
+    auto first = system.update();
+    double rebuildMs = std::chrono::duration<double, std::milli>(Clock::now() - rebuildStart).count();
+
+    std::printf("TransformSystem: %zu entities, %zu levels (create %.1f ms, first update %.1f ms)\n",
+                first.entities, first.levels, buildMs, rebuildMs);
+
+    kalan::ImageThreadPool pool;
+
+    struct Case {
+        const char* name;
+        bool dirtyFlags;
+        double touch;
+    };
+    const Case cases[] = {
+        {"full recompute", false, 0.0},
+        {"dirty flags, 1% touched", true, 0.01},
+        {"dirty flags, static", true, 0.0},
+    };
+
+    for (const Case& c : cases) {
+        kalan::TransformSystem::Settings settings;
+        settings.useDirtyFlags = c.dirtyFlags;
+        system.setSettings(settings);
+
+        Result single = Run(registry, system, nullptr, entities, c.touch, frames);
+        Result threaded = Run(registry, system, &pool, entities, c.touch, frames);
+        std::printf("  %-26s 1 thread: %8.3f ms (min %8.3f)   %zu threads: %8.3f ms (min %8.3f)   updated %zu\n",
+                    c.name, single.avgMs, single.minMs, pool.getThreadCount(),
+                    threaded.avgMs, threaded.minMs, threaded.updated);
+        RecordResult("transforms", std::string(c.name) + ", 1 thread", single.avgMs, "ms");
+        RecordResult("transforms", std::string(c.name) + ", pool", threaded.avgMs, "ms");
+    }
+    return 0;
+}
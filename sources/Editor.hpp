@@ -1,10 +1,18 @@
 #pragma once
 
 #include "Player.hpp"
+#include "core/FrameStats.hpp"
+#include "core/PixelBufferPool.hpp"
+#include "core/Profiler.hpp"
+#include "rendering/TextureStreamer.hpp"
+#include "rendering/TextureUploader.hpp"
+#include "resources/AssetManager.hpp"
+#include "resources/ParallelLoader.hpp"
 #include "imgui.h"
 #include "raylib-cpp.hpp"
 #include "raylib.h"
 #include "rlImGui.h"
+#include <algorithm>
 
 namespace kalan {
 
@@ -21,6 +29,8 @@ public:
   void ToggleShow();
   bool IsVisible();
   void SetPlayer(Player *player) { this->player = player; }
+  // Источник данных панели Performance; nullptr — панель без метрик кадра
+  void SetFrameStats(const FrameStats *stats) { frameStats = stats; }
 
 private:
   Editor(Player *player)
@@ -32,6 +42,8 @@ private:
   }
   ~Editor() { rlImGuiShutdown(); }
 
+  void DrawPerformance();
+
   float fastStep = 10.f;
   float step = 1.f;
   Player *player;
@@ -39,6 +51,23 @@ private:
   raylib::Vector3 handsRotation;
   float smoothFactor;
   bool show;
+  bool profilerCapture = true;
+  bool traceExported = false;
+  bool traceExportFailed = false;
+
+  const FrameStats *frameStats = nullptr;
+  // Загрузка пула и память кэшей обновляются раз в SampleInterval
+  static constexpr double SampleInterval = 0.5;
+  double lastSampleTime = -1.0;
+  uint64_t lastPoolBusyNs = 0;
+  float poolUtilization = 0.0f;
+  AssetManager::MemoryStats memoryStats;
+  PixelBufferPool::Stats pixelStats;
+  TextureUploader::Stats uploadStats;
+  TextureStreamer::Stats streamStats;
+  // Копия отчётов загрузчика, обновляется только при смене версии
+  std::vector<ImportReport> loaderReports;
+  uint64_t loaderReportsVersion = 0;
 };
 
 inline bool Editor::IsVisible() { return show; }
@@ -48,6 +77,7 @@ inline void Editor::Draw() {
   if (!show)
     return;
 
+  KALAN_PROFILE_ZONE("Editor::Draw");
   rlImGuiBegin();
   if (ImGui::Begin("Player Settings")) {
     ImGui::Text("Hands Offset:");
@@ -75,7 +105,180 @@ inline void Editor::Draw() {
     ImGui::PopItemWidth();
   }
   ImGui::End();
+
+  DrawPerformance();
+
+  if (ImGui::Begin("Profiler")) {
+    if (!profiler::compiledIn()) {
+      ImGui::TextDisabled("Built without KALAN_PROFILER");
+    } else {
+      if (ImGui::Checkbox("Capture", &profilerCapture))
+        profiler::setEnabled(profilerCapture);
+      ImGui::SameLine();
+      if (ImGui::Button("Clear"))
+        profiler::clear();
+      ImGui::SameLine();
+      // Последние ThreadBufferCapacity зон каждого потока
+      if (ImGui::Button("Export trace")) {
+        traceExported = profiler::exportChromeTrace("kalan_trace.json");
+        traceExportFailed = !traceExported;
+      }
+      if (traceExported)
+        ImGui::Text("Saved kalan_trace.json (open in ui.perfetto.dev)");
+      else if (traceExportFailed)
+        ImGui::TextColored({1.0f, 0.4f, 0.4f, 1.0f}, "Export failed");
+    }
+  }
+  ImGui::End();
   rlImGuiEnd();
 }
 
+inline void Editor::DrawPerformance() {
+  const ImageThreadPool *pool =
+      ParallelModelLoader::instance().findThreadPool();
+  ImageThreadPool::Stats poolStats = pool ? pool->getStats()
+                                          : ImageThreadPool::Stats{};
+
+  // Редкие выборки: разница busyNs за интервал и обход кэшей ассетов
+  double now = GetTime();
+  if (lastSampleTime < 0.0 || now - lastSampleTime >= SampleInterval) {
+    if (lastSampleTime >= 0.0 && poolStats.threads > 0) {
+      double busy = static_cast<double>(poolStats.busyNs - lastPoolBusyNs) * 1e-9;
+      poolUtilization = static_cast<float>(
+          busy / ((now - lastSampleTime) * static_cast<double>(poolStats.threads)));
+    }
+    lastPoolBusyNs = poolStats.busyNs;
+    lastSampleTime = now;
+    memoryStats = AssetManager::instance().getMemoryStats();
+    pixelStats = PixelBufferPool::instance().getStats();
+    uploadStats = TextureUploader::instance().getStats();
+    streamStats = TextureStreamer::instance().getStats();
+  }
+
+  uint64_t reportsVersion = ParallelModelLoader::instance().getReportsVersion();
+  if (reportsVersion != loaderReportsVersion) {
+    loaderReports = ParallelModelLoader::instance().getRecentReports();
+    loaderReportsVersion = reportsVersion;
+  }
+
+  if (!ImGui::Begin("Performance")) {
+    ImGui::End();
+    return;
+  }
+
+  if (frameStats && frameStats->frameCount() > 0) {
+    FrameStats::Summary summary = frameStats->summarize();
+    ImGui::Text("Frame %.2f ms (%.0f FPS)", frameStats->lastFrameMs(),
+                summary.avgMs > 0.0f ? 1000.0f / summary.avgMs : 0.0f);
+    ImGui::Text("avg %.2f  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms",
+                summary.avgMs, summary.p50Ms, summary.p95Ms, summary.p99Ms,
+                summary.maxMs);
+    ImGui::PlotHistogram(
+        "##frameTimes", frameStats->frameTimes(),
+        static_cast<int>(frameStats->frameCount()),
+        static_cast<int>(frameStats->historyOffset()), nullptr, 0.0f,
+        std::max(33.3f, summary.maxMs), ImVec2(0, 80));
+
+    if (ImGui::CollapsingHeader("CPU by subsystem",
+                                ImGuiTreeNodeFlags_DefaultOpen)) {
+      for (size_t i = 0; i < frameStats->sectionCount(); ++i) {
+        const FrameStats::Section &section = frameStats->sections()[i];
+        ImGui::Text("%-14s %6.2f ms  (avg %.2f)", section.name, section.ms,
+                    section.avgMs);
+      }
+    }
+    if (ImGui::CollapsingHeader("Counters", ImGuiTreeNodeFlags_DefaultOpen)) {
+      for (size_t i = 0; i < frameStats->counterCount(); ++i) {
+        const FrameStats::Counter &counter = frameStats->counters()[i];
+        ImGui::Text("%-14s %lld", counter.name,
+                    static_cast<long long>(counter.value));
+      }
+    }
+  } else {
+    ImGui::TextDisabled("No frame stats");
+  }
+
+  if (ImGui::CollapsingHeader("Thread pool", ImGuiTreeNodeFlags_DefaultOpen)) {
+    if (pool) {
+      ImGui::Text("%zu threads, %zu queued, %zu pending", poolStats.threads,
+                  poolStats.queued, poolStats.pending);
+      ImGui::Text("queued: %zu critical, %zu visible, %zu prefetch",
+                  poolStats.queuedByPriority[0], poolStats.queuedByPriority[1],
+                  poolStats.queuedByPriority[2]);
+      ImGui::Text("%llu tasks done",
+                  static_cast<unsigned long long>(poolStats.completed));
+      ImGui::ProgressBar(std::clamp(poolUtilization, 0.0f, 1.0f),
+                         ImVec2(-1, 0), "utilization");
+    } else {
+      ImGui::TextDisabled("Not started");
+    }
+  }
+
+  if (ImGui::CollapsingHeader("Asset memory", ImGuiTreeNodeFlags_DefaultOpen)) {
+    ImGui::Text("%zu models, %zu textures, %zu sounds", memoryStats.models,
+                memoryStats.textures, memoryStats.sounds);
+    ImGui::Text("CPU %.1f MB, GPU %.1f MB",
+                static_cast<double>(memoryStats.cpuBytes) / (1024.0 * 1024.0),
+                static_cast<double>(memoryStats.gpuBytes) / (1024.0 * 1024.0));
+    ImGui::Text("Pixel buffers: %.1f MB in use, %.1f MB cached, peak %.1f / "
+                "%.0f MB%s",
+                static_cast<double>(pixelStats.inUseBytes) / (1024.0 * 1024.0),
+                static_cast<double>(pixelStats.cachedBytes) / (1024.0 * 1024.0),
+                static_cast<double>(pixelStats.peakBytes) / (1024.0 * 1024.0),
+                static_cast<double>(pixelStats.budgetBytes) / (1024.0 * 1024.0),
+                pixelStats.hugePages ? ", huge pages" : "");
+    ImGui::Text("%llu reused, %llu from OS",
+                static_cast<unsigned long long>(pixelStats.reuses),
+                static_cast<unsigned long long>(pixelStats.osAllocations));
+    if (uploadStats.persistent) {
+      ImGui::Text("Upload ring: %.1f / %.0f MB, %llu staged, %llu direct, "
+                  "%llu ring full",
+                  static_cast<double>(uploadStats.ringUsed) / (1024.0 * 1024.0),
+                  static_cast<double>(uploadStats.ringBytes) / (1024.0 * 1024.0),
+                  static_cast<unsigned long long>(uploadStats.stagedUploads),
+                  static_cast<unsigned long long>(uploadStats.directUploads),
+                  static_cast<unsigned long long>(uploadStats.stageFailures));
+    } else {
+      ImGui::TextDisabled("Upload ring unavailable, %llu direct uploads",
+                          static_cast<unsigned long long>(uploadStats.directUploads));
+    }
+    if (streamStats.residency.textures > 0) {
+      const auto& residency = streamStats.residency;
+      ImGui::Text("Streamed textures: %zu in %d models, %.1f / %.0f MB resident, "
+                  "target %.1f MB",
+                  residency.textures, streamStats.models,
+                  static_cast<double>(residency.residentBytes) / (1024.0 * 1024.0),
+                  static_cast<double>(residency.budgetBytes) / (1024.0 * 1024.0),
+                  static_cast<double>(residency.targetBytes) / (1024.0 * 1024.0));
+      ImGui::Text("  %d demanded, %d over budget, %d loading, %llu streamed in, "
+                  "%llu evicted",
+                  residency.demanded, residency.budgetLimited, streamStats.inFlight,
+                  static_cast<unsigned long long>(streamStats.streamedIn),
+                  static_cast<unsigned long long>(streamStats.evicted));
+    }
+  }
+
+  if (ImGui::CollapsingHeader("Loader stages")) {
+    if (loaderReports.empty())
+      ImGui::TextDisabled("No models loaded");
+    // Последняя загрузка сверху
+    for (size_t r = loaderReports.size(); r-- > 0;) {
+      const ImportReport &report = loaderReports[r];
+      ImGui::PushID(static_cast<int>(r));
+      if (ImGui::TreeNode("report", "%s  %.1f ms", report.path.c_str(),
+                          report.totalMs)) {
+        for (const auto &stage : report.stages)
+          ImGui::Text("%-10s %8.2f ms", stage.name.c_str(), stage.ms);
+        if (report.meshCpuReleased > 0)
+          ImGui::Text("Mesh RAM: %.2f MB released, %.2f MB kept",
+                      report.meshCpuReleased / (1024.0 * 1024.0),
+                      report.meshCpuRetained / (1024.0 * 1024.0));
+        ImGui::TreePop();
+      }
+      ImGui::PopID();
+    }
+  }
+  ImGui::End();
+}
+
 } // namespace kalan
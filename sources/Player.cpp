@@ -7,30 +7,84 @@
 #include "Vector4.hpp"
 #include "raylib-cpp.hpp"
 #include "raylib.h"
+#include "physics/PhysicsWorld.hpp"
+#include "scene/AnimationSystem.hpp"
+#include "scene/TransformSystem.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace kalan {
 
-Player::Player(std::shared_ptr<raylib::Model> handsModel,
+Player::Player(entt::registry &registry, PhysicsWorld &physics,
+               std::shared_ptr<raylib::Model> handsModel,
                raylib::Camera3D *camera, raylib::Vector3 position, int speed)
-    : handsModel(std::move(handsModel)), camera(camera), position(position),
-      speed(speed) {}
+    : position(position), camera(camera), speed(speed),
+      controller(std::make_unique<CharacterController>(physics, position)),
+      registry(&registry) {
+  // Начальное направление взгляда берём из камеры
+  if (camera) {
+    raylib::Vector3 direction =
+        (raylib::Vector3(camera->target) - camera->position).Normalize();
+    yaw = std::atan2(direction.x, direction.z);
+    pitch = std::asin(std::clamp(direction.y, -1.0f, 1.0f));
+  }
+  rig = TransformSystem::createEntity(registry);
+  hands = TransformSystem::createEntity(registry, {}, rig);
+  registry.emplace<MeshRenderer>(hands, MeshRenderer{
+                                            .model = std::move(handsModel),
+                                            .tint = RED,
+                                        });
+  UpdateHandsLocal();
+}
+
+Player::~Player() { TransformSystem::destroySubtree(*registry, rig); }
 
 void Player::SetCamera(raylib::Camera3D *camera) { this->camera = camera; }
 
+void Player::SetHandsAnimations(
+    std::shared_ptr<const ModelAnimations> animations) {
+  if (!animations) {
+    registry->remove<Animator>(hands);
+    return;
+  }
+  Animator &animator = registry->emplace_or_replace<Animator>(
+      hands, Animator{.animations = std::move(animations)});
+  // Клип "idle", если он есть, иначе первый
+  if (!AnimationSystem::play(animator, "idle") &&
+      !animator.animations->clips.empty())
+    AnimationSystem::play(animator, 0);
+}
+
 void Player::SetHandsOffset(const raylib::Vector3 &offset) {
   handsOffset = offset;
+  UpdateHandsLocal();
 }
 
 void Player::SetHandsRotation(const raylib::Vector3 &rotation) {
   handsRotation = rotation;
+  UpdateHandsLocal();
 }
 
 raylib::Vector3 Player::GetHandsOffset() const { return handsOffset; }
 
 raylib::Vector3 Player::GetHandsRotation() const { return handsRotation; }
 
+void Player::UpdateHandsLocal() {
+  raylib::Matrix rotationMatrix =
+      raylib::Matrix::RotateZ(handsRotation.z * DEG2RAD) *
+      raylib::Matrix::RotateY(handsRotation.y * DEG2RAD) *
+      raylib::Matrix::RotateX(handsRotation.x * DEG2RAD);
+
+  // Сначала вращение, потом смещение — модель рук вращается вокруг своих осей
+  registry->replace<LocalTransform>(
+      hands, LocalTransform{
+                 .translation = handsOffset,
+                 .rotation = QuaternionFromMatrix(rotationMatrix),
+             });
+}
+
 void Player::UpdateHandsTransform() {
-  if (!camera || !handsModel)
+  if (!camera)
     return;
 
   raylib::Vector3 direction =
@@ -45,35 +99,54 @@ void Player::UpdateHandsTransform() {
   targetHandsRot = raylib::Vector4::FromMatrix(lookToMatrix);
   currHandsRot = targetHandsRot;
 
-  lookToMatrix = currHandsRot.ToMatrix();
-  lookToMatrix.m12 = handsPos.x;
-  lookToMatrix.m13 = handsPos.y;
-  lookToMatrix.m14 = handsPos.z;
-
-  raylib::Matrix rotationMatrix =
-      raylib::Matrix::RotateZ(handsRotation.z * DEG2RAD) *
-      raylib::Matrix::RotateY(handsRotation.y * DEG2RAD) *
-      raylib::Matrix::RotateX(handsRotation.x * DEG2RAD);
-
-  // Сначала умножаем матрицу трансформации на матрицу передвижения c оффсетом -
-  // и только потом задаем вращение, чтобы модель рук вращалсь вокруг своих осей
-  handsModel->transform =
-      raylib::Matrix::Translate(handsOffset.x, handsOffset.y, handsOffset.z) *
-      lookToMatrix;
-  handsModel->transform =
-      rotationMatrix * raylib::Matrix(handsModel->transform);
+  // Мировую матрицу рук (смещение и вращение относительно рига) соберёт
+  // TransformSystem
+  registry->replace<LocalTransform>(rig, LocalTransform{
+                                             .translation = handsPos,
+                                             .rotation = currHandsRot,
+                                         });
 }
 
-void Player::Update() {
-  if (!camera)
+void Player::HandleInput(bool enabled) {
+  if (!enabled) {
+    controller->setInput({0.0f, 0.0f, 0.0f}, false);
     return;
-  UpdateHandsTransform();
+  }
+
+  raylib::Vector2 mouseDelta = GetMouseDelta();
+  yaw -= mouseDelta.x * mouseSensitivity;
+  pitch -= mouseDelta.y * mouseSensitivity;
+  pitch = std::clamp(pitch, -89.0f * DEG2RAD, 89.0f * DEG2RAD);
+
+  raylib::Vector3 forward = {std::sin(yaw), 0.0f, std::cos(yaw)};
+  raylib::Vector3 right = {-forward.z, 0.0f, forward.x};
+  raylib::Vector3 wish = {0.0f, 0.0f, 0.0f};
+  if (IsKeyDown(KEY_W))
+    wish += forward;
+  if (IsKeyDown(KEY_S))
+    wish -= forward;
+  if (IsKeyDown(KEY_D))
+    wish += right;
+  if (IsKeyDown(KEY_A))
+    wish -= right;
+  if (wish.LengthSqr() > 0.0f)
+    wish = wish.Normalize() * static_cast<float>(speed);
+
+  controller->setInput(wish, IsKeyPressed(KEY_SPACE));
 }
 
-void Player::Draw() {
-  if (!camera || !handsModel)
+void Player::Update(float alpha) {
+  position = controller->getInterpolatedPosition(alpha);
+  if (!camera)
     return;
-  handsModel->Draw({0}, 1.0f, RED);
+
+  raylib::Vector3 eye = position + raylib::Vector3{0.0f, eyeHeight, 0.0f};
+  raylib::Vector3 look = {std::cos(pitch) * std::sin(yaw), std::sin(pitch),
+                          std::cos(pitch) * std::cos(yaw)};
+  camera->position = eye;
+  camera->target = eye + look;
+
+  UpdateHandsTransform();
 }
 
 } // namespace kalan
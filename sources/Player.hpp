@@ -1,7 +1,10 @@
 #pragma once
 #include "Model.hpp"
+#include "physics/CharacterController.hpp"
+#include "scene/Components.hpp"
 #include "Vector4.hpp"
 #include "raylib-cpp.hpp"
+#include <entt/entt.hpp>
 #include <memory>
 
 namespace kalan {
@@ -9,31 +12,55 @@ namespace kalan {
 class Player {
 private:
   raylib::Vector3 position;
-  std::shared_ptr<raylib::Model> handsModel;
   raylib::Camera3D *camera;
   int speed;
 
+  // Движение и коллизии — на фиксированном шаге физики,
+  // камера и руки интерполируются с частотой кадров
+  std::unique_ptr<CharacterController> controller;
+  float yaw = 0.0f;
+  float pitch = 0.0f;
+  float eyeHeight = 1.6f;
+  float mouseSensitivity = 0.003f;
+
+  // Руки — дочерняя сущность "рига", который следует за камерой
+  entt::registry *registry;
+  entt::entity rig = entt::null;
+  entt::entity hands = entt::null;
+
   raylib::Vector3 handsOffset = {-0.4f, 0.05f, 0.0f};
   raylib::Vector3 handsRotation = {0.0f, 80.0f, 0.0f};
   raylib::Quaternion targetHandsRot = {0};
   raylib::Quaternion currHandsRot = {0};
   void UpdateHandsTransform();
+  void UpdateHandsLocal();
 
 public:
-  Player(std::shared_ptr<raylib::Model> handsModel,
+  Player(entt::registry &registry, PhysicsWorld &physics,
+         std::shared_ptr<raylib::Model> handsModel,
          raylib::Camera3D *camera = nullptr, raylib::Vector3 position = {0.},
          int speed = 10);
+  ~Player();
+
+  Player(const Player &) = delete;
+  Player &operator=(const Player &) = delete;
 
   void SetCamera(raylib::Camera3D *camera);
+  // Скелет и клипы модели рук (LoadedModel::animations); nullptr — убрать Animator
+  void SetHandsAnimations(std::shared_ptr<const ModelAnimations> animations);
 
   void SetHandsOffset(const raylib::Vector3 &offset);
   void SetHandsRotation(const raylib::Vector3 &rotation);
 
   raylib::Vector3 GetHandsOffset() const;
   raylib::Vector3 GetHandsRotation() const;
+  entt::entity GetHandsEntity() const { return hands; }
+  const CharacterController &GetController() const { return *controller; }
 
-  void Draw();
-  void Update();
+  // До PhysicsWorld::update: ввод мыши и клавиатуры (enabled == false — стоять)
+  void HandleInput(bool enabled = true);
+  // После PhysicsWorld::update: камера и руки по интерполированной позиции
+  void Update(float alpha);
 };
 
 } // namespace kalan
@@ -0,0 +1,75 @@
+#include "AnimationClip.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace kalan {
+
+namespace {
+
+// Пара соседних ключей и доля между ними для момента time
+struct KeySpan {
+    size_t first;
+    size_t second;
+    float t;
+};
+
+KeySpan findSpan(const std::vector<float>& times, float time) {
+    if (times.size() < 2 || time <= times.front()) return {0, 0, 0.0f};
+    if (time >= times.back()) return {times.size() - 1, times.size() - 1, 0.0f};
+    const size_t second = static_cast<size_t>(std::upper_bound(times.begin(), times.end(), time) - times.begin());
+    const size_t first = second - 1;
+    const float span = times[second] - times[first];
+    return {first, second, span > 0.0f ? (time - times[first]) / span : 0.0f};
+}
+
+Vector3 sampleVector(const std::vector<float>& times, const std::vector<Vector3>& values, float time) {
+    const KeySpan span = findSpan(times, time);
+    const Vector3& a = values[span.first];
+    const Vector3& b = values[span.second];
+    return {a.x + (b.x - a.x) * span.t, a.y + (b.y - a.y) * span.t, a.z + (b.z - a.z) * span.t};
+}
+
+Quaternion sampleRotation(const std::vector<float>& times, const std::vector<Quaternion>& values, float time) {
+    const KeySpan span = findSpan(times, time);
+    const Quaternion& a = values[span.first];
+    if (span.first == span.second) return a;
+    const Quaternion& b = values[span.second];
+
+    const float dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    const float s = 1.0f - span.t;
+    const float t = dot < 0.0f ? -span.t : span.t;
+    Quaternion q = {a.x * s + b.x * t, a.y * s + b.y * t, a.z * s + b.z * t, a.w * s + b.w * t};
+    const float inv = 1.0f / std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    return {q.x * inv, q.y * inv, q.z * inv, q.w * inv};
+}
+
+} // anonymous namespace
+
+int ModelAnimations::findClip(std::string_view name) const {
+    for (size_t i = 0; i < clips.size(); ++i) {
+        if (clips[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void sampleClip(const AnimationClip& clip, const Skeleton& skeleton, float time, Pose& out,
+                ClipCursor* cursor) {
+    if (clip.compressed) {
+        ClipCursor local;
+        sampleCompressedClip(*clip.compressed, skeleton, time, cursor ? *cursor : local, out);
+        return;
+    }
+
+    out.assign(skeleton.bindPose.begin(), skeleton.bindPose.end());
+    time = std::clamp(time, 0.0f, clip.duration);
+
+    for (const AnimationTrack& track : clip.tracks) {
+        if (track.joint < 0 || track.joint >= static_cast<int>(out.size())) continue;
+        JointTransform& joint = out[track.joint];
+        if (!track.translations.empty()) joint.translation = sampleVector(track.translationTimes, track.translations, time);
+        if (!track.rotations.empty()) joint.rotation = sampleRotation(track.rotationTimes, track.rotations, time);
+        if (!track.scales.empty()) joint.scale = sampleVector(track.scaleTimes, track.scales, time);
+    }
+}
+
+} // namespace kalan
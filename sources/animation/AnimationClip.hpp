@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Skeleton.hpp"
+#include "CompressedClip.hpp"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kalan {
+
+// Ключи одного сустава. Времена в секундах, по возрастанию; между ключами —
+// линейная интерполяция (вращения — nlerp). Пустой канал берётся из bindPose.
+struct AnimationTrack {
+    int joint = -1;
+    std::vector<float> translationTimes;
+    std::vector<Vector3> translations;
+    std::vector<float> rotationTimes;
+    std::vector<Quaternion> rotations;
+    std::vector<float> scaleTimes;
+    std::vector<Vector3> scales;
+};
+
+struct AnimationClip {
+    std::string name;
+    float duration = 0.0f;          // в секундах
+    std::vector<AnimationTrack> tracks;
+    // После сжатия (ClipCompression.hpp) сырые дорожки освобождаются и сэмплинг
+    // идёт по сжатому потоку
+    std::shared_ptr<const CompressedClip> compressed;
+};
+
+// Скелет и клипы модели (LoadOptions::importAnimation). Неизменяемы после загрузки
+// и разделяются всеми сущностями модели.
+struct ModelAnimations {
+    Skeleton skeleton;
+    std::vector<AnimationClip> clips;
+
+    // -1, если клипа нет
+    [[nodiscard]] int findClip(std::string_view name) const;
+};
+
+// Поза клипа в момент time (зажимается в [0, duration]). Суставы без дорожки — bindPose.
+// Потокобезопасно: клип и скелет только читаются. Сжатому клипу нужна позиция
+// чтения потока: без cursor поток читается с начала при каждом вызове.
+void sampleClip(const AnimationClip& clip, const Skeleton& skeleton, float time, Pose& out,
+                ClipCursor* cursor = nullptr);
+
+} // namespace kalan
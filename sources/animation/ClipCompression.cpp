@@ -0,0 +1,288 @@
+#include "ClipCompression.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <tuple>
+#include <type_traits>
+
+namespace kalan {
+
+namespace {
+
+// Длина рычага и доля допуска сустава
+struct JointBudget {
+    float length = 0.0f;
+    float tolerance = 0.0f;
+};
+
+std::vector<JointBudget> ComputeBudgets(const Skeleton& skeleton, const ClipCompressionSettings& settings) {
+    const int count = skeleton.getJointCount();
+    std::vector<Matrix> model(count);
+    computeModelMatrices(skeleton, skeleton.bindPose, model.data());
+
+    std::vector<float> reach(count, 0.0f);  // до самого дальнего потомка
+    std::vector<int> depth(count, 0);
+    std::vector<int> height(count, 0);      // суставов ниже по самой длинной ветке
+    for (int i = 0; i < count; ++i) {
+        if (skeleton.parents[i] >= 0) depth[i] = depth[skeleton.parents[i]] + 1;
+    }
+    for (int i = count - 1; i >= 0; --i) {
+        const Vector3 origin = {model[i].m12, model[i].m13, model[i].m14};
+        for (int a = skeleton.parents[i]; a >= 0; a = skeleton.parents[a]) {
+            const Vector3 ancestor = {model[a].m12, model[a].m13, model[a].m14};
+            reach[a] = std::max(reach[a], Vector3Distance(origin, ancestor));
+        }
+        if (skeleton.parents[i] >= 0) {
+            height[skeleton.parents[i]] = std::max(height[skeleton.parents[i]], height[i] + 1);
+        }
+    }
+
+    std::vector<JointBudget> budgets(count);
+    for (int i = 0; i < count; ++i) {
+        budgets[i].length = settings.vertexDistance + reach[i];
+        budgets[i].tolerance = settings.tolerance / static_cast<float>(depth[i] + 1 + height[i]);
+    }
+    return budgets;
+}
+
+// Канал дорожки: xyz или кватернион в Vector4. values — после квантования,
+// source — исходные значения, с которыми сравнивается интерполяция
+struct Channel {
+    TrackChannel type;
+    std::vector<float> times;
+    std::vector<Vector4> values;
+    std::vector<Vector4> source;
+};
+
+Vector4 Interpolate(TrackChannel type, const Vector4& a, const Vector4& b, float t) {
+    if (type != TrackChannel::Rotation) {
+        return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, 0.0f};
+    }
+    // Как в сэмплере: nlerp по кратчайшей дуге
+    const float dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    const float s = 1.0f - t;
+    const float tb = dot < 0.0f ? -t : t;
+    Vector4 q = {a.x * s + b.x * tb, a.y * s + b.y * tb, a.z * s + b.z * tb, a.w * s + b.w * tb};
+    const float inv = 1.0f / std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    return {q.x * inv, q.y * inv, q.z * inv, q.w * inv};
+}
+
+// Смещение вершины на расстоянии length от сустава
+float ChannelError(TrackChannel type, const Vector4& a, const Vector4& b, float length) {
+    if (type == TrackChannel::Rotation) {
+        // Хорда дуги поворота на угол 2φ, cos φ = |dot|. sqrt(1 - dot²) во float
+        // теряет всё ниже ~3e-4, поэтому sin φ считается через хорду |a - b| = 2 sin(φ/2)
+        const float sign = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w < 0.0f ? -1.0f : 1.0f;
+        const float dx = a.x - b.x * sign, dy = a.y - b.y * sign, dz = a.z - b.z * sign, dw = a.w - b.w * sign;
+        const float chord = std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+        return 2.0f * length * chord * std::sqrt(std::max(0.0f, 1.0f - chord * chord * 0.25f));
+    }
+    const float distance = std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) + (a.z - b.z) * (a.z - b.z));
+    return type == TrackChannel::Scale ? distance * length : distance;
+}
+
+// Индексы ключей, которые остаются: ключ убирается, если интерполяция между
+// оставленными соседями восстанавливает его (и все убранные до него) в пределах допуска
+std::vector<size_t> ReduceKeys(const Channel& channel, float length, float tolerance) {
+    const size_t count = channel.times.size();
+    std::vector<size_t> kept{0};
+    if (count < 2) return kept;
+
+    // Постоянный канал — один ключ
+    bool constant = true;
+    for (size_t k = 1; k < count && constant; ++k) {
+        constant = ChannelError(channel.type, channel.values[0], channel.source[k], length) <= tolerance;
+    }
+    if (constant) return kept;
+
+    size_t anchor = 0;
+    for (size_t end = 2; end < count; ++end) {
+        const float span = channel.times[end] - channel.times[anchor];
+        for (size_t k = anchor + 1; k < end; ++k) {
+            const float t = span > 0.0f ? (channel.times[k] - channel.times[anchor]) / span : 0.0f;
+            const Vector4 value = Interpolate(channel.type, channel.values[anchor], channel.values[end], t);
+            if (ChannelError(channel.type, value, channel.source[k], length) > tolerance) {
+                anchor = end - 1;
+                kept.push_back(anchor);
+                break;
+            }
+        }
+    }
+    kept.push_back(count - 1);
+    return kept;
+}
+
+Vector4 BindValue(TrackChannel type, const JointTransform& bind) {
+    switch (type) {
+    case TrackChannel::Translation: return {bind.translation.x, bind.translation.y, bind.translation.z, 0.0f};
+    case TrackChannel::Rotation: return bind.rotation;
+    case TrackChannel::Scale: return {bind.scale.x, bind.scale.y, bind.scale.z, 0.0f};
+    }
+    return {};
+}
+
+template <typename T>
+void AppendChannel(std::vector<Channel>& out, TrackChannel type, const std::vector<float>& times,
+                   const std::vector<T>& values) {
+    Channel channel{type, {}, {}, {}};
+    const size_t count = std::min(times.size(), values.size());
+    for (size_t k = 0; k < count; ++k) {
+        Vector4 value;
+        if constexpr (std::is_same_v<T, Quaternion>) value = values[k];
+        else value = {values[k].x, values[k].y, values[k].z, 0.0f};
+        // Ключи с одинаковым временем: остаётся последний
+        if (!channel.times.empty() && channel.times.back() >= times[k]) {
+            channel.values.back() = value;
+            continue;
+        }
+        channel.times.push_back(times[k]);
+        channel.values.push_back(value);
+    }
+    channel.source = channel.values;
+    if (!channel.times.empty()) out.push_back(std::move(channel));
+}
+
+// Наибольшее смещение виртуальных вершин (начало сустава и точки на осях)
+// между несжатым и сжатым клипом
+void MeasureError(const AnimationClip& clip, const CompressedClip& compressed, const Skeleton& skeleton,
+                  const ClipCompressionSettings& settings, ClipCompressionStats& stats) {
+    const int count = skeleton.getJointCount();
+    const int samples = std::max(1, static_cast<int>(std::ceil(clip.duration * settings.errorSampleRate)));
+    const float d = settings.vertexDistance;
+    const Vector3 points[4] = {{0.0f, 0.0f, 0.0f}, {d, 0.0f, 0.0f}, {0.0f, d, 0.0f}, {0.0f, 0.0f, d}};
+
+    Pose rawPose, compressedPose;
+    ClipCursor cursor;
+    std::vector<Matrix> rawModel(count), compressedModel(count);
+    for (int s = 0; s <= samples; ++s) {
+        const float time = clip.duration * static_cast<float>(s) / samples;
+        sampleClip(clip, skeleton, time, rawPose);
+        sampleCompressedClip(compressed, skeleton, time, cursor, compressedPose);
+        computeModelMatrices(skeleton, rawPose, rawModel.data());
+        computeModelMatrices(skeleton, compressedPose, compressedModel.data());
+
+        for (int j = 0; j < count; ++j) {
+            for (const Vector3& p : points) {
+                const float error = Vector3Distance(Vector3Transform(p, rawModel[j]),
+                                                    Vector3Transform(p, compressedModel[j]));
+                if (error > stats.maxError) {
+                    stats.maxError = error;
+                    stats.maxErrorJoint = j;
+                    stats.maxErrorTime = time;
+                }
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+CompressedClip compressClip(const AnimationClip& clip, const Skeleton& skeleton,
+                            const ClipCompressionSettings& settings, ClipCompressionStats* stats) {
+    auto start = std::chrono::steady_clock::now();
+    ClipCompressionStats local;
+    local.clip = clip.name;
+
+    const std::vector<JointBudget> budgets = ComputeBudgets(skeleton, settings);
+    CompressedClip result;
+    result.duration = clip.duration;
+
+    auto quantizeTime = [&](float time) {
+        const float normalized = clip.duration > 0.0f ? std::clamp(time / clip.duration, 0.0f, 1.0f) : 0.0f;
+        return static_cast<uint16_t>(std::lround(normalized * 65535.0f));
+    };
+
+    // Ключи с порядком чтения: первые два ключа дорожки — в начале потока,
+    // ключ k — когда проигрывание пройдёт ключ k-1
+    std::vector<std::tuple<int, uint16_t, uint32_t, PackedKey>> ordered;
+
+    for (const AnimationTrack& track : clip.tracks) {
+        local.rawKeys += static_cast<int>(track.translations.size() + track.rotations.size() + track.scales.size());
+        local.rawBytes += track.translations.size() * (sizeof(float) + sizeof(Vector3)) +
+                          track.rotations.size() * (sizeof(float) + sizeof(Quaternion)) +
+                          track.scales.size() * (sizeof(float) + sizeof(Vector3));
+        if (track.joint < 0 || track.joint >= skeleton.getJointCount()) continue;
+        const JointBudget& budget = budgets[track.joint];
+
+        std::vector<Channel> channels;
+        AppendChannel(channels, TrackChannel::Translation, track.translationTimes, track.translations);
+        AppendChannel(channels, TrackChannel::Rotation, track.rotationTimes, track.rotations);
+        AppendChannel(channels, TrackChannel::Scale, track.scaleTimes, track.scales);
+
+        for (Channel& channel : channels) {
+            CompressedTrack info;
+            info.joint = static_cast<uint16_t>(track.joint);
+            info.channel = channel.type;
+
+            // Квантуем до удаления ключей: интерполируются те значения, которые
+            // увидит сэмплер, а сравниваются с исходными — ошибка квантования входит в допуск
+            std::vector<PackedKey> packed(channel.values.size());
+            if (channel.type != TrackChannel::Rotation) {
+                Vector3 lo = {channel.values[0].x, channel.values[0].y, channel.values[0].z};
+                Vector3 hi = lo;
+                for (const Vector4& v : channel.values) {
+                    lo = Vector3Min(lo, {v.x, v.y, v.z});
+                    hi = Vector3Max(hi, {v.x, v.y, v.z});
+                }
+                info.rangeMin = lo;
+                info.rangeExtent = Vector3Subtract(hi, lo);
+            }
+            for (size_t k = 0; k < channel.values.size(); ++k) {
+                Vector4& v = channel.values[k];
+                if (channel.type == TrackChannel::Rotation) {
+                    packQuaternion(v, packed[k].value);
+                    v = unpackQuaternion(packed[k].value);
+                } else {
+                    packVector({v.x, v.y, v.z}, info.rangeMin, info.rangeExtent, packed[k].value);
+                    const Vector3 decoded = unpackVector(packed[k].value, info.rangeMin, info.rangeExtent);
+                    v = {decoded.x, decoded.y, decoded.z, 0.0f};
+                }
+            }
+
+            const std::vector<size_t> kept = ReduceKeys(channel, budget.length, budget.tolerance);
+            if (kept.size() == 1) {
+                // Постоянный канал, совпадающий с позой покоя, не хранится вовсе
+                const Vector4 bind = BindValue(channel.type, skeleton.bindPose[track.joint]);
+                bool matchesBind = true;
+                for (size_t k = 0; k < channel.source.size() && matchesBind; ++k) {
+                    matchesBind = ChannelError(channel.type, bind, channel.source[k], budget.length) <= budget.tolerance;
+                }
+                if (matchesBind) {
+                    ++local.droppedTracks;
+                    continue;
+                }
+            }
+
+            const uint16_t trackIndex = static_cast<uint16_t>(result.tracks.size());
+            info.keyCount = static_cast<uint32_t>(kept.size());
+            result.tracks.push_back(info);
+            for (size_t k = 0; k < kept.size(); ++k) {
+                PackedKey key = packed[kept[k]];
+                key.track = trackIndex;
+                key.time = quantizeTime(channel.times[kept[k]]);
+                const int block = k < 2 ? 0 : 1;
+                const uint16_t needed = k < 2 ? 0 : quantizeTime(channel.times[kept[k - 1]]);
+                ordered.emplace_back(block, needed, trackIndex, key);
+            }
+        }
+    }
+
+    std::stable_sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) {
+        return std::tie(std::get<0>(a), std::get<1>(a), std::get<2>(a)) <
+               std::tie(std::get<0>(b), std::get<1>(b), std::get<2>(b));
+    });
+    result.keys.reserve(ordered.size());
+    for (const auto& entry : ordered) result.keys.push_back(std::get<3>(entry));
+
+    local.tracks = static_cast<int>(result.tracks.size());
+    local.keys = static_cast<int>(result.keys.size());
+    local.compressedBytes = result.getByteSize();
+    MeasureError(clip, result, skeleton, settings, local);
+    local.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (stats) *stats = std::move(local);
+    return result;
+}
+
+} // namespace kalan
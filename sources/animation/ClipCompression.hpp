@@ -0,0 +1,49 @@
+#pragma once
+
+#include "AnimationClip.hpp"
+#include "CompressedClip.hpp"
+#include <cstddef>
+#include <string>
+
+namespace kalan {
+
+// Допуск задаётся как смещение вершины в пространстве модели. Ошибка канала
+// считается в пространстве сустава и переводится в смещение через длину цепочки
+// под суставом (vertexDistance плюс самый дальний потомок): поворот у корня руки
+// двигает кончики пальцев сильнее, чем тот же поворот фаланги. Бюджет делится
+// между суставами самой длинной цепочки, проходящей через сустав, поэтому ошибки
+// предков, накопленные вниз по иерархии, остаются в пределах tolerance.
+struct ClipCompressionSettings {
+    float tolerance = 0.0002f;          // единицы ассета (0.2 мм для метров)
+    float vertexDistance = 0.05f;       // расстояние виртуальной вершины от сустава
+    float errorSampleRate = 120.0f;     // частота проверки итоговой ошибки, Гц
+};
+
+struct ClipCompressionStats {
+    std::string clip;
+    int tracks = 0;                 // дорожек после сжатия
+    int droppedTracks = 0;          // постоянные каналы, равные позе покоя
+    int rawKeys = 0;
+    int keys = 0;
+    size_t rawBytes = 0;
+    size_t compressedBytes = 0;
+    // Наибольшее смещение виртуальной вершины относительно несжатого клипа
+    // (с учётом квантования), где и когда оно достигнуто
+    float maxError = 0.0f;
+    int maxErrorJoint = -1;
+    float maxErrorTime = 0.0f;
+    double ms = 0.0;
+
+    [[nodiscard]] float getRatio() const noexcept {
+        return compressedBytes > 0 ? static_cast<float>(rawBytes) / compressedBytes : 0.0f;
+    }
+};
+
+// Сжать клип: квантование, удаление ключей, восстановимых интерполяцией соседних
+// в пределах бюджета сустава, и упорядочивание потока ключей по времени.
+// Потокобезопасно: клип и скелет только читаются.
+[[nodiscard]] CompressedClip compressClip(const AnimationClip& clip, const Skeleton& skeleton,
+                                          const ClipCompressionSettings& settings,
+                                          ClipCompressionStats* stats = nullptr);
+
+} // namespace kalan
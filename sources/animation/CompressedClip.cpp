@@ -0,0 +1,155 @@
+#include "CompressedClip.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace kalan {
+
+namespace {
+
+// Компоненты кроме наибольшей лежат в [-1/sqrt(2), 1/sqrt(2)]. Шагов чётное
+// число, чтобы ноль (частый у поворотов вокруг одной оси) кодировался точно
+constexpr float SmallestRange = 0.70710678f;
+constexpr uint32_t ComponentMask = (1u << 15) - 1;
+constexpr uint32_t ComponentMax = ComponentMask - 1;
+
+float KeyTime(const CompressedClip& clip, uint16_t time) {
+    return clip.duration * (time / 65535.0f);
+}
+
+Vector4 DecodeKey(const CompressedClip& clip, const PackedKey& key) {
+    const CompressedTrack& track = clip.tracks[key.track];
+    if (track.channel == TrackChannel::Rotation) return unpackQuaternion(key.value);
+    Vector3 v = unpackVector(key.value, track.rangeMin, track.rangeExtent);
+    return {v.x, v.y, v.z, 0.0f};
+}
+
+void ResetCursor(const CompressedClip& clip, ClipCursor& cursor) {
+    cursor.clip = &clip;
+    cursor.nextKey = 0;
+    cursor.time = 0.0f;
+    cursor.tracks.assign(clip.tracks.size(), ClipCursor::TrackState{});
+}
+
+} // anonymous namespace
+
+// ============ Квантование ============
+
+void packQuaternion(Quaternion q, uint16_t out[3]) {
+    float c[4] = {q.x, q.y, q.z, q.w};
+    int largest = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (std::fabs(c[i]) > std::fabs(c[largest])) largest = i;
+    }
+    // q и -q — одно вращение: наибольшая компонента делается положительной и не хранится
+    const float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+
+    uint64_t bits = static_cast<uint64_t>(largest) << 45;
+    int shift = 30;
+    for (int i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        const float normalized = std::clamp(c[i] * sign / SmallestRange * 0.5f + 0.5f, 0.0f, 1.0f);
+        bits |= static_cast<uint64_t>(std::lround(normalized * ComponentMax)) << shift;
+        shift -= 15;
+    }
+    out[0] = static_cast<uint16_t>(bits >> 32);
+    out[1] = static_cast<uint16_t>(bits >> 16);
+    out[2] = static_cast<uint16_t>(bits);
+}
+
+Quaternion unpackQuaternion(const uint16_t in[3]) {
+    const uint64_t bits = (static_cast<uint64_t>(in[0]) << 32) | (static_cast<uint64_t>(in[1]) << 16) | in[2];
+    const int largest = static_cast<int>((bits >> 45) & 3);
+
+    float c[4];
+    float sum = 0.0f;
+    int shift = 30;
+    for (int i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        const float normalized = static_cast<float>((bits >> shift) & ComponentMask) / ComponentMax;
+        c[i] = (normalized * 2.0f - 1.0f) * SmallestRange;
+        sum += c[i] * c[i];
+        shift -= 15;
+    }
+    c[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+    return {c[0], c[1], c[2], c[3]};
+}
+
+void packVector(Vector3 v, const Vector3& rangeMin, const Vector3& rangeExtent, uint16_t out[3]) {
+    const float values[3] = {v.x, v.y, v.z};
+    const float mins[3] = {rangeMin.x, rangeMin.y, rangeMin.z};
+    const float extents[3] = {rangeExtent.x, rangeExtent.y, rangeExtent.z};
+    for (int i = 0; i < 3; ++i) {
+        const float normalized = extents[i] > 0.0f ? std::clamp((values[i] - mins[i]) / extents[i], 0.0f, 1.0f) : 0.0f;
+        out[i] = static_cast<uint16_t>(std::lround(normalized * 65535.0f));
+    }
+}
+
+Vector3 unpackVector(const uint16_t in[3], const Vector3& rangeMin, const Vector3& rangeExtent) {
+    return {rangeMin.x + in[0] / 65535.0f * rangeExtent.x,
+            rangeMin.y + in[1] / 65535.0f * rangeExtent.y,
+            rangeMin.z + in[2] / 65535.0f * rangeExtent.z};
+}
+
+// ============ Сэмплинг ============
+
+void sampleCompressedClip(const CompressedClip& clip, const Skeleton& skeleton, float time,
+                          ClipCursor& cursor, Pose& out) {
+    time = std::clamp(time, 0.0f, clip.duration);
+    if (cursor.clip != &clip || cursor.tracks.size() != clip.tracks.size() || time < cursor.time) {
+        ResetCursor(clip, cursor);
+    }
+    cursor.time = time;
+
+    // Дочитать ключи, которые стали нужны: поток упорядочен по времени предыдущего
+    // ключа дорожки, поэтому первый ненужный ключ останавливает чтение
+    while (cursor.nextKey < clip.keys.size()) {
+        const PackedKey& key = clip.keys[cursor.nextKey];
+        ClipCursor::TrackState& state = cursor.tracks[key.track];
+        if (state.loaded >= 2 && time <= state.time[1]) break;
+
+        const float keyTime = KeyTime(clip, key.time);
+        const Vector4 value = DecodeKey(clip, key);
+        if (state.loaded == 0) {
+            state.time[0] = state.time[1] = keyTime;
+            state.value[0] = state.value[1] = value;
+        } else {
+            if (state.loaded >= 2) {
+                state.time[0] = state.time[1];
+                state.value[0] = state.value[1];
+            }
+            state.time[1] = keyTime;
+            state.value[1] = value;
+        }
+        ++state.loaded;
+        ++cursor.nextKey;
+    }
+
+    out.assign(skeleton.bindPose.begin(), skeleton.bindPose.end());
+    for (size_t i = 0; i < clip.tracks.size(); ++i) {
+        const CompressedTrack& track = clip.tracks[i];
+        const ClipCursor::TrackState& state = cursor.tracks[i];
+        if (state.loaded == 0 || track.joint >= out.size()) continue;
+
+        const float span = state.time[1] - state.time[0];
+        const float t = span > 0.0f ? std::clamp((time - state.time[0]) / span, 0.0f, 1.0f) : 1.0f;
+        const Vector4& a = state.value[0];
+        const Vector4& b = state.value[1];
+        JointTransform& joint = out[track.joint];
+
+        if (track.channel == TrackChannel::Rotation) {
+            const float dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+            const float s = 1.0f - t;
+            const float tb = dot < 0.0f ? -t : t;
+            Quaternion q = {a.x * s + b.x * tb, a.y * s + b.y * tb, a.z * s + b.z * tb, a.w * s + b.w * tb};
+            const float inv = 1.0f / std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+            joint.rotation = {q.x * inv, q.y * inv, q.z * inv, q.w * inv};
+            continue;
+        }
+
+        const Vector3 v = {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t};
+        if (track.channel == TrackChannel::Translation) joint.translation = v;
+        else joint.scale = v;
+    }
+}
+
+} // namespace kalan
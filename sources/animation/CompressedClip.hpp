@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Skeleton.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace kalan {
+
+enum class TrackChannel : uint8_t {
+    Translation,
+    Rotation,
+    Scale,
+};
+
+// Ключ сжатого клипа, 10 байт. Вращение — smallest-three в 48 битах
+// (индекс наибольшей компоненты и три остальные по 15 бит), вектор — 16 бит
+// на компоненту в диапазоне дорожки.
+struct PackedKey {
+    uint16_t track;
+    uint16_t time;                  // доля длительности клипа, 0..65535
+    uint16_t value[3];
+};
+
+// Канал одного сустава
+struct CompressedTrack {
+    uint16_t joint = 0;
+    TrackChannel channel = TrackChannel::Rotation;
+    uint32_t keyCount = 0;
+    Vector3 rangeMin{0.0f, 0.0f, 0.0f};     // только для Translation и Scale
+    Vector3 rangeExtent{0.0f, 0.0f, 0.0f};
+};
+
+// Клип после сжатия (animation/ClipCompression.hpp). Ключи всех дорожек лежат
+// одним потоком в порядке, в котором они понадобятся при проигрывании вперёд:
+// сначала первые два ключа каждой дорожки, дальше ключ k — по времени ключа k-1.
+// Сэмплер читает поток последовательно через ClipCursor.
+// Суставы без дорожек берутся из bindPose.
+struct CompressedClip {
+    float duration = 0.0f;
+    std::vector<CompressedTrack> tracks;
+    std::vector<PackedKey> keys;
+
+    [[nodiscard]] size_t getByteSize() const noexcept {
+        return tracks.size() * sizeof(CompressedTrack) + keys.size() * sizeof(PackedKey);
+    }
+};
+
+// Позиция чтения потока и два текущих ключа каждой дорожки (уже распакованные).
+// Проигрывание вперёд дочитывает только новые ключи; шаг назад (петля, перемотка)
+// начинает поток заново. Одна позиция — на один проигрываемый клип.
+struct ClipCursor {
+    struct TrackState {
+        float time[2] = {0.0f, 0.0f};
+        Vector4 value[2] = {};
+        uint32_t loaded = 0;
+    };
+
+    const CompressedClip* clip = nullptr;
+    size_t nextKey = 0;
+    float time = 0.0f;
+    std::vector<TrackState> tracks;
+};
+
+// Поза в момент time (зажимается в [0, duration]). cursor пишется, клип только читается.
+void sampleCompressedClip(const CompressedClip& clip, const Skeleton& skeleton, float time,
+                          ClipCursor& cursor, Pose& out);
+
+// Квантование значений ключей
+void packQuaternion(Quaternion q, uint16_t out[3]);
+[[nodiscard]] Quaternion unpackQuaternion(const uint16_t in[3]);
+void packVector(Vector3 v, const Vector3& rangeMin, const Vector3& rangeExtent, uint16_t out[3]);
+[[nodiscard]] Vector3 unpackVector(const uint16_t in[3], const Vector3& rangeMin, const Vector3& rangeExtent);
+
+} // namespace kalan
@@ -0,0 +1,85 @@
+#include "Skeleton.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace kalan {
+
+int Skeleton::findJoint(std::string_view name) const {
+    auto it = std::find(names.begin(), names.end(), name);
+    return it == names.end() ? -1 : static_cast<int>(it - names.begin());
+}
+
+void blendPoses(const Pose& a, const Pose& b, float t, Pose& out) {
+    const size_t count = std::min(a.size(), b.size());
+    out.resize(count);
+    const float s = 1.0f - t;
+    for (size_t i = 0; i < count; ++i) {
+        const JointTransform& ja = a[i];
+        const JointTransform& jb = b[i];
+        JointTransform& result = out[i];
+
+        result.translation = {ja.translation.x * s + jb.translation.x * t,
+                              ja.translation.y * s + jb.translation.y * t,
+                              ja.translation.z * s + jb.translation.z * t};
+        result.scale = {ja.scale.x * s + jb.scale.x * t,
+                        ja.scale.y * s + jb.scale.y * t,
+                        ja.scale.z * s + jb.scale.z * t};
+
+        // q и -q — одно вращение; берём ближайшее к a
+        const Quaternion& qa = ja.rotation;
+        const Quaternion& qb = jb.rotation;
+        const float dot = qa.x * qb.x + qa.y * qb.y + qa.z * qb.z + qa.w * qb.w;
+        const float tb = dot < 0.0f ? -t : t;
+        Quaternion q = {qa.x * s + qb.x * tb, qa.y * s + qb.y * tb, qa.z * s + qb.z * tb, qa.w * s + qb.w * tb};
+        const float length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        const float inv = length > 0.0f ? 1.0f / length : 0.0f;
+        result.rotation = {q.x * inv, q.y * inv, q.z * inv, length > 0.0f ? q.w * inv : 1.0f};
+    }
+}
+
+Matrix jointMatrix(const JointTransform& joint) {
+    // То же, что MatrixScale * QuaternionToMatrix * MatrixTranslate, без двух умножений
+    const Quaternion& q = joint.rotation;
+    const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+    const Vector3& s = joint.scale;
+
+    Matrix m;
+    m.m0 = (1.0f - 2.0f * (yy + zz)) * s.x;
+    m.m1 = 2.0f * (xy + wz) * s.x;
+    m.m2 = 2.0f * (xz - wy) * s.x;
+    m.m3 = 0.0f;
+    m.m4 = 2.0f * (xy - wz) * s.y;
+    m.m5 = (1.0f - 2.0f * (xx + zz)) * s.y;
+    m.m6 = 2.0f * (yz + wx) * s.y;
+    m.m7 = 0.0f;
+    m.m8 = 2.0f * (xz + wy) * s.z;
+    m.m9 = 2.0f * (yz - wx) * s.z;
+    m.m10 = (1.0f - 2.0f * (xx + yy)) * s.z;
+    m.m11 = 0.0f;
+    m.m12 = joint.translation.x;
+    m.m13 = joint.translation.y;
+    m.m14 = joint.translation.z;
+    m.m15 = 1.0f;
+    return m;
+}
+
+void computeModelMatrices(const Skeleton& skeleton, const Pose& pose, Matrix* out) {
+    const int count = std::min(skeleton.getJointCount(), static_cast<int>(pose.size()));
+    for (int i = 0; i < count; ++i) {
+        const Matrix local = jointMatrix(pose[i]);
+        const int parent = skeleton.parents[i];
+        out[i] = parent < 0 ? local : MatrixMultiply(local, out[parent]);
+    }
+}
+
+void computeSkinningMatrices(const Skeleton& skeleton, const Matrix* model, Matrix* out) {
+    const int count = skeleton.getJointCount();
+    for (int i = 0; i < count; ++i) {
+        out[i] = MatrixMultiply(skeleton.inverseBind[i], model[i]);
+    }
+}
+
+} // namespace kalan
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "raylib.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kalan {
+
+// Локальная трансформация сустава относительно родителя
+struct JointTransform {
+    Vector3 translation{0.0f, 0.0f, 0.0f};
+    Quaternion rotation{0.0f, 0.0f, 0.0f, 1.0f};
+    Vector3 scale{1.0f, 1.0f, 1.0f};
+};
+
+// Поза: локальные трансформации всех суставов скелета
+using Pose = std::vector<JointTransform>;
+
+// Иерархия суставов в порядке обхода в глубину: родитель всегда раньше ребёнка.
+// Суставы — узлы ассета, на которые ссылаются кости и меши, вместе с предками.
+struct Skeleton {
+    std::vector<std::string> names;
+    std::vector<int> parents;               // -1 для корня
+    std::vector<JointTransform> bindPose;   // трансформации узлов в покое
+    // Пространство модели -> пространство сустава в покое (aiBone::mOffsetMatrix)
+    std::vector<Matrix> inverseBind;
+
+    [[nodiscard]] int getJointCount() const noexcept { return static_cast<int>(parents.size()); }
+    // -1, если сустава нет
+    [[nodiscard]] int findJoint(std::string_view name) const;
+};
+
+// Смешать позы: t = 0 — a, t = 1 — b. Вращения — nlerp по кратчайшей дуге
+// (для соседних кадров и кроссфейда отличие от slerp незаметно).
+void blendPoses(const Pose& a, const Pose& b, float t, Pose& out);
+
+// Матрицы суставов в пространстве модели. out — getJointCount() элементов.
+void computeModelMatrices(const Skeleton& skeleton, const Pose& pose, Matrix* out);
+
+// Палитра скиннинга: inverseBind, затем матрица сустава. out может совпадать с model.
+void computeSkinningMatrices(const Skeleton& skeleton, const Matrix* model, Matrix* out);
+
+// Матрица трансформации сустава (scale, rotation, translation — как LocalTransform)
+[[nodiscard]] Matrix jointMatrix(const JointTransform& joint);
+
+} // namespace kalan
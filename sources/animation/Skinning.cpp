@@ -0,0 +1,112 @@
+#include "Skinning.hpp"
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define KALAN_SKINNING_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace kalan {
+
+void packSkinPalette(const Matrix* palette, int count, SkinMatrix* out) {
+    for (int i = 0; i < count; ++i) {
+        const Matrix& m = palette[i];
+        SkinMatrix& s = out[i];
+        s.c[0][0] = m.m0;  s.c[0][1] = m.m1;  s.c[0][2] = m.m2;  s.c[0][3] = 0.0f;
+        s.c[1][0] = m.m4;  s.c[1][1] = m.m5;  s.c[1][2] = m.m6;  s.c[1][3] = 0.0f;
+        s.c[2][0] = m.m8;  s.c[2][1] = m.m9;  s.c[2][2] = m.m10; s.c[2][3] = 0.0f;
+        s.c[3][0] = m.m12; s.c[3][1] = m.m13; s.c[3][2] = m.m14; s.c[3][3] = 0.0f;
+    }
+}
+
+void skinVerticesScalar(const SkinningInput& input, const SkinMatrix* palette,
+                        float* outPositions, float* outNormals, size_t begin, size_t end) {
+    const bool normals = input.normals && outNormals;
+    for (size_t v = begin; v < end; ++v) {
+        // Смешанная матрица вершины: сумма столбцов с весами
+        float c[4][3] = {};
+        for (int k = 0; k < 4; ++k) {
+            const float w = input.boneWeights[v * 4 + k];
+            if (w == 0.0f) continue;
+            const SkinMatrix& m = palette[input.boneIds[v * 4 + k]];
+            for (int col = 0; col < 4; ++col) {
+                c[col][0] += m.c[col][0] * w;
+                c[col][1] += m.c[col][1] * w;
+                c[col][2] += m.c[col][2] * w;
+            }
+        }
+
+        const float* p = &input.positions[v * 3];
+        for (int i = 0; i < 3; ++i) {
+            outPositions[v * 3 + i] = c[0][i] * p[0] + c[1][i] * p[1] + c[2][i] * p[2] + c[3][i];
+        }
+        if (normals) {
+            const float* n = &input.normals[v * 3];
+            float r[3];
+            for (int i = 0; i < 3; ++i) r[i] = c[0][i] * n[0] + c[1][i] * n[1] + c[2][i] * n[2];
+            const float length = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+            const float inv = length > 0.0f ? 1.0f / length : 0.0f;
+            for (int i = 0; i < 3; ++i) outNormals[v * 3 + i] = r[i] * inv;
+        }
+    }
+}
+
+#if KALAN_SKINNING_SSE
+
+void skinVertices(const SkinningInput& input, const SkinMatrix* palette,
+                  float* outPositions, float* outNormals, size_t begin, size_t end) {
+    const bool normals = input.normals && outNormals;
+    alignas(16) float result[4];
+    for (size_t v = begin; v < end; ++v) {
+        __m128 c0 = _mm_setzero_ps();
+        __m128 c1 = _mm_setzero_ps();
+        __m128 c2 = _mm_setzero_ps();
+        __m128 c3 = _mm_setzero_ps();
+        for (int k = 0; k < 4; ++k) {
+            const float weight = input.boneWeights[v * 4 + k];
+            if (weight == 0.0f) continue;
+            const SkinMatrix& m = palette[input.boneIds[v * 4 + k]];
+            const __m128 w = _mm_set1_ps(weight);
+            c0 = _mm_add_ps(c0, _mm_mul_ps(_mm_load_ps(m.c[0]), w));
+            c1 = _mm_add_ps(c1, _mm_mul_ps(_mm_load_ps(m.c[1]), w));
+            c2 = _mm_add_ps(c2, _mm_mul_ps(_mm_load_ps(m.c[2]), w));
+            c3 = _mm_add_ps(c3, _mm_mul_ps(_mm_load_ps(m.c[3]), w));
+        }
+
+        const float* p = &input.positions[v * 3];
+        __m128 position = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p[0])), _mm_mul_ps(c1, _mm_set1_ps(p[1]))),
+                                     _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p[2])), c3));
+        _mm_store_ps(result, position);
+        std::memcpy(&outPositions[v * 3], result, 3 * sizeof(float));
+
+        if (normals) {
+            const float* n = &input.normals[v * 3];
+            __m128 normal = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(n[0])), _mm_mul_ps(c1, _mm_set1_ps(n[1]))),
+                                       _mm_mul_ps(c2, _mm_set1_ps(n[2])));
+            // w столбцов нулевой, поэтому скалярное произведение — сумма всех четырёх
+            __m128 squared = _mm_mul_ps(normal, normal);
+            __m128 sum = _mm_add_ps(squared, _mm_shuffle_ps(squared, squared, _MM_SHUFFLE(2, 3, 0, 1)));
+            sum = _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
+            const float length = std::sqrt(_mm_cvtss_f32(sum));
+            normal = _mm_mul_ps(normal, _mm_set1_ps(length > 0.0f ? 1.0f / length : 0.0f));
+            _mm_store_ps(result, normal);
+            std::memcpy(&outNormals[v * 3], result, 3 * sizeof(float));
+        }
+    }
+}
+
+bool isSimdSkinningAvailable() noexcept { return true; }
+
+#else
+
+void skinVertices(const SkinningInput& input, const SkinMatrix* palette,
+                  float* outPositions, float* outNormals, size_t begin, size_t end) {
+    skinVerticesScalar(input, palette, outPositions, outNormals, begin, end);
+}
+
+bool isSimdSkinningAvailable() noexcept { return false; }
+
+#endif
+
+} // namespace kalan
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstddef>
+
+namespace kalan {
+
+// Размер палитры скиннинг шейдера (MAX_BONES в pbr_skinned.vs). Скелеты крупнее
+// скиннятся на CPU.
+constexpr int MaxGpuSkinningJoints = 128;
+
+// Матрица палитры в виде столбцов под SIMD: p' = c[0]*x + c[1]*y + c[2]*z + c[3].
+// Четвёртые компоненты столбцов нулевые.
+struct alignas(16) SkinMatrix {
+    float c[4][4];
+};
+
+// Палитра скиннинга raylib Matrix -> SkinMatrix
+void packSkinPalette(const Matrix* palette, int count, SkinMatrix* out);
+
+// Входы и выходы CPU скиннинга. Веса на вершину — 4, как у raylib Mesh
+// (boneIds — unsigned char, boneWeights — float). normals/outNormals необязательны;
+// нормали трансформируются смешанной 3x3 частью и нормируются (без обратной
+// транспонированной — для неравномерного масштаба костей неточно).
+struct SkinningInput {
+    const float* positions = nullptr;
+    const float* normals = nullptr;
+    const unsigned char* boneIds = nullptr;
+    const float* boneWeights = nullptr;
+    size_t vertexCount = 0;
+};
+
+// Скиннинг вершин [begin, end) на CPU. SSE, если он доступен при сборке,
+// иначе скалярный путь с тем же результатом.
+void skinVertices(const SkinningInput& input, const SkinMatrix* palette,
+                  float* outPositions, float* outNormals, size_t begin, size_t end);
+
+// Скалярный путь — для сравнения в бенчмарке
+void skinVerticesScalar(const SkinningInput& input, const SkinMatrix* palette,
+                        float* outPositions, float* outNormals, size_t begin, size_t end);
+
+// Собран ли SIMD путь
+[[nodiscard]] bool isSimdSkinningAvailable() noexcept;
+
+} // namespace kalan
@@ -0,0 +1,116 @@
+#include "AllocationCounter.hpp"
+#include "raylib.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace kalan {
+
+#ifdef KALAN_ALLOCATION_COUNTER
+
+namespace {
+
+// Без атомика: поток пишет только свой счётчик. Тривиальный тип инициализируется
+// статически — первое обращение из operator new не требует аллокации
+thread_local uint64_t allocations = 0;
+
+void* countedAlloc(std::size_t size, std::size_t alignment) {
+    ++allocations;
+    if (size == 0) size = 1;
+#ifdef _WIN32
+    void* p = _aligned_malloc(size, alignment);
+#else
+    // aligned_alloc требует размер, кратный выравниванию
+    void* p = alignment <= alignof(std::max_align_t)
+                  ? std::malloc(size)
+                  : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+    return p;
+}
+
+void countedFree(void* p) noexcept {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+} // anonymous namespace
+
+uint64_t allocationCount() noexcept { return allocations; }
+bool allocationCounterEnabled() noexcept { return true; }
+
+#else
+
+uint64_t allocationCount() noexcept { return 0; }
+bool allocationCounterEnabled() noexcept { return false; }
+
+#endif
+
+void FrameAllocationCheck::beginFrame() noexcept {
+    thread_ = std::this_thread::get_id();
+    frameStart_ = allocationCount();
+}
+
+uint64_t FrameAllocationCheck::endFrame() {
+    // Счётчик другого потока с frameStart_ не сравним
+    assert(thread_ == std::this_thread::get_id() && "endFrame called from another thread");
+    uint64_t count = allocationCount() - frameStart_;
+    if (frame_ < warmupFrames_) {
+        ++frame_;
+        return count;
+    }
+    if (count != 0) {
+        TraceLog(LOG_WARNING, "FrameAllocationCheck: %llu heap allocations in a steady-state frame",
+                 static_cast<unsigned long long>(count));
+        assert(count == 0 && "heap allocation in steady-state frame");
+    }
+    return count;
+}
+
+} // namespace kalan
+
+#ifdef KALAN_ALLOCATION_COUNTER
+
+// Замена глобальных operator new/delete: все варианты сходятся в countedAlloc/countedFree
+
+void* operator new(std::size_t size) {
+    if (void* p = kalan::countedAlloc(size, alignof(std::max_align_t))) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return ::operator new(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* p = kalan::countedAlloc(size, static_cast<std::size_t>(alignment))) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) { return ::operator new(size, alignment); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return kalan::countedAlloc(size, alignof(std::max_align_t));
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return kalan::countedAlloc(size, alignof(std::max_align_t));
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return kalan::countedAlloc(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return kalan::countedAlloc(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept { kalan::countedFree(p); }
+void operator delete[](void* p) noexcept { kalan::countedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { kalan::countedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { kalan::countedFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { kalan::countedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { kalan::countedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { kalan::countedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { kalan::countedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { kalan::countedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { kalan::countedFree(p); }
+
+#endif
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <thread>
+
+namespace kalan {
+
+// Счётчик вызовов глобального operator new. Включается опцией CMake
+// KALAN_ALLOCATION_COUNTER; без неё счётчик всегда 0 и проверки ничего не делают.
+// Счётчик свой у каждого потока: возвращается число аллокаций вызывающего потока,
+// фоновые задачи пула (загрузка, стриминг) в него не попадают.
+[[nodiscard]] uint64_t allocationCount() noexcept;
+[[nodiscard]] bool allocationCounterEnabled() noexcept;
+
+// Проверка «ноль аллокаций в установившемся кадре». Первые warmupFrames кадров
+// (загрузка, рост буферов до рабочей ёмкости) не проверяются. Считаются только
+// аллокации потока, вызвавшего beginFrame; endFrame зовётся из него же.
+// Аллокации в задачах, которые кадр отдаёт пулу (parallelFor), сюда не входят.
+class FrameAllocationCheck {
+public:
+    explicit FrameAllocationCheck(int warmupFrames = 120) : warmupFrames_(warmupFrames) {}
+
+    void beginFrame() noexcept;
+    // Аллокаций за кадр; после прогрева ненулевое значение — assert в отладочной сборке
+    uint64_t endFrame();
+    // Начать прогрев заново (после загрузки ассетов, смены сцены)
+    void restartWarmup() noexcept { frame_ = 0; }
+
+private:
+    int warmupFrames_;
+    int frame_ = 0;
+    uint64_t frameStart_ = 0;
+    std::thread::id thread_;
+};
+
+} // namespace kalan
@@ -0,0 +1,95 @@
+#include "FrameArena.hpp"
+#include "raylib.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace kalan {
+
+namespace {
+
+std::atomic<uint64_t> globalFrame{1};
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // anonymous namespace
+
+FrameArena::FrameArena(size_t initialCapacity) {
+    addBlock(initialCapacity);
+}
+
+FrameArena::~FrameArena() {
+    for (const Block& block : blocks_) std::free(block.data);
+}
+
+size_t FrameArena::capacity() const noexcept {
+    size_t total = 0;
+    for (const Block& block : blocks_) total += block.size;
+    return total;
+}
+
+void FrameArena::addBlock(size_t minSize) {
+    // malloc, а не new: рост арены не должен попадать в счётчик аллокаций кадра
+    size_t size = std::max<size_t>(minSize, 64 * 1024);
+    auto* data = static_cast<std::byte*>(std::malloc(size));
+    if (!data) throw std::bad_alloc();
+    blocks_.push_back({data, size});
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    for (;;) {
+        Block& block = blocks_[current_];
+        auto base = reinterpret_cast<uintptr_t>(block.data);
+        size_t start = alignUp(base + offset_, alignment) - base;
+        if (start + bytes <= block.size) {
+            used_ += start + bytes - offset_;
+            peak_ = std::max(peak_, used_);
+            offset_ = start + bytes;
+            return block.data + start;
+        }
+
+        // Следующий блок, если он уже есть, иначе новый вдвое больше
+        used_ += block.size - offset_;
+        offset_ = 0;
+        if (++current_ == blocks_.size()) {
+            addBlock(std::max(block.size * 2, bytes + alignment));
+            TraceLog(LOG_DEBUG, "FrameArena: grew to %zu bytes", capacity());
+        }
+    }
+}
+
+void FrameArena::reset() {
+    // Несколько блоков — значит пик не влез: сливаем в один блок под пик
+    if (blocks_.size() > 1) {
+        size_t total = capacity();
+        for (const Block& block : blocks_) std::free(block.data);
+        blocks_.clear();
+        addBlock(total);
+    }
+    current_ = 0;
+    offset_ = 0;
+    used_ = 0;
+}
+
+FrameArena& FrameArena::local() {
+    thread_local FrameArena arena(256 * 1024);
+    uint64_t frame = globalFrame.load(std::memory_order_relaxed);
+    if (arena.frame_ != frame) {
+        arena.reset();
+        arena.frame_ = frame;
+    }
+    return arena;
+}
+
+void FrameArena::nextFrame() noexcept {
+    globalFrame.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t FrameArena::frameIndex() noexcept {
+    return globalFrame.load(std::memory_order_relaxed);
+}
+
+} // namespace kalan
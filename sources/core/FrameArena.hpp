@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+namespace kalan {
+
+// Линейный аллокатор кадра: выделение — сдвиг указателя, освобождение — reset() целиком.
+// Блоки переиспользуются между кадрами; при переполнении добавляется новый блок,
+// а ближайший reset() сливает их в один, размером с пиковое использование.
+// Является std::pmr::memory_resource, так что pmr-контейнеры кадра работают поверх него.
+// Не потокобезопасен: у каждого потока своя арена (local()).
+class FrameArena final : public std::pmr::memory_resource {
+public:
+    explicit FrameArena(size_t initialCapacity = 1 << 20);
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Массив без конструкторов — только для тривиальных типов
+    template <typename T>
+    [[nodiscard]] T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena does not run destructors");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void reset();
+
+    [[nodiscard]] size_t used() const noexcept { return used_; }
+    [[nodiscard]] size_t capacity() const noexcept;
+    [[nodiscard]] size_t peak() const noexcept { return peak_; }
+
+    // Арена текущего потока. Сбрасывается при первом обращении в новом кадре,
+    // поэтому данные из неё нельзя держать дольше кадра.
+    static FrameArena& local();
+    // Начать новый кадр для всех потоков (вызывать в начале кадра на главном)
+    static void nextFrame() noexcept;
+    [[nodiscard]] static uint64_t frameIndex() noexcept;
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    struct Block {
+        std::byte* data;
+        size_t size;
+    };
+
+    void addBlock(size_t minSize);
+
+    std::vector<Block> blocks_;
+    size_t current_ = 0;        // блок, из которого идёт выделение
+    size_t offset_ = 0;         // сдвиг в текущем блоке
+    size_t used_ = 0;
+    size_t peak_ = 0;
+    uint64_t frame_ = 0;        // для local(): кадр последнего сброса
+};
+
+} // namespace kalan
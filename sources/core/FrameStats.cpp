@@ -0,0 +1,92 @@
+#include "FrameStats.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace kalan {
+
+namespace {
+
+bool sameName(const char* a, const char* b) {
+    // Обычно это один и тот же литерал — сравнение указателей
+    return a == b || std::strcmp(a, b) == 0;
+}
+
+} // anonymous namespace
+
+void FrameStats::beginFrame() {
+    Clock::time_point now = Clock::now();
+    if (started_) {
+        frameTimes_[frameHead_] = std::chrono::duration<float, std::milli>(now - frameStart_).count();
+        frameHead_ = (frameHead_ + 1) % HistorySize;
+        frameCount_ = std::min(frameCount_ + 1, HistorySize);
+
+        for (size_t i = 0; i < sectionCount_; ++i) {
+            Section& section = sections_[i];
+            section.ms = section.accumMs;
+            section.avgMs = section.avgMs == 0.0f ? section.ms : section.avgMs * 0.95f + section.ms * 0.05f;
+            section.accumMs = 0.0f;
+        }
+    }
+    frameStart_ = now;
+    started_ = true;
+}
+
+size_t FrameStats::sectionIndex(const char* name) {
+    for (size_t i = 0; i < sectionCount_; ++i) {
+        if (sameName(sections_[i].name, name)) return i;
+    }
+    if (sectionCount_ == MaxSections) return MaxSections;
+    sections_[sectionCount_].name = name;
+    return sectionCount_++;
+}
+
+void FrameStats::addSectionTime(size_t index, float ms) {
+    if (index < sectionCount_) sections_[index].accumMs += ms;
+}
+
+void FrameStats::setCounter(const char* name, int64_t value) {
+    for (size_t i = 0; i < counterCount_; ++i) {
+        if (sameName(counters_[i].name, name)) {
+            counters_[i].value = value;
+            return;
+        }
+    }
+    if (counterCount_ == MaxCounters) return;
+    counters_[counterCount_++] = {name, value};
+}
+
+float FrameStats::lastFrameMs() const noexcept {
+    if (frameCount_ == 0) return 0.0f;
+    return frameTimes_[(frameHead_ + HistorySize - 1) % HistorySize];
+}
+
+FrameStats::Summary FrameStats::summarize() const {
+    Summary summary;
+    if (frameCount_ == 0) return summary;
+
+    std::array<float, HistorySize> sorted;
+    std::copy_n(frameTimes_.begin(), frameCount_, sorted.begin());
+    auto begin = sorted.begin();
+    auto end = begin + frameCount_;
+
+    float total = 0.0f;
+    for (auto it = begin; it != end; ++it) total += *it;
+    summary.avgMs = total / static_cast<float>(frameCount_);
+
+    // nth_element по возрастанию перцентиля: каждый следующий ищется в правой части
+    auto percentile = [&](float p, decltype(begin) from) {
+        auto nth = begin + std::min(frameCount_ - 1, static_cast<size_t>(p * static_cast<float>(frameCount_)));
+        std::nth_element(from, nth, end);
+        return nth;
+    };
+    auto p50 = percentile(0.50f, begin);
+    auto p95 = percentile(0.95f, p50);
+    auto p99 = percentile(0.99f, p95);
+    summary.p50Ms = *p50;
+    summary.p95Ms = *p95;
+    summary.p99Ms = *p99;
+    summary.maxMs = *std::max_element(p99, end);
+    return summary;
+}
+
+} // namespace kalan
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace kalan {
+
+// Метрики кадра для панели производительности: история времени кадра,
+// CPU время по подсистемам и счётчики (draw calls, треугольники и т.п.).
+// Сбор — пара steady_clock::now() на секцию и запись в фиксированные массивы,
+// без аллокаций, поэтому остаётся включённым и в релизной сборке.
+// Имена секций и счётчиков — строковые литералы. Только главный поток.
+class FrameStats {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t HistorySize = 300;
+    static constexpr size_t MaxSections = 16;
+    static constexpr size_t MaxCounters = 16;
+
+    struct Section {
+        const char* name = nullptr;
+        float ms = 0.0f;            // за последний завершённый кадр
+        float avgMs = 0.0f;         // экспоненциальное среднее
+        float accumMs = 0.0f;       // текущий кадр
+    };
+
+    struct Counter {
+        const char* name = nullptr;
+        int64_t value = 0;
+    };
+
+    struct Summary {
+        float avgMs = 0.0f;
+        float p50Ms = 0.0f;
+        float p95Ms = 0.0f;
+        float p99Ms = 0.0f;
+        float maxMs = 0.0f;
+    };
+
+    // Замер секции до конца области видимости; повторные замеры за кадр складываются
+    class Scope {
+    public:
+        Scope(FrameStats& stats, const char* name)
+            : stats_(stats), index_(stats.sectionIndex(name)), start_(Clock::now()) {}
+        ~Scope() {
+            stats_.addSectionTime(index_, std::chrono::duration<float, std::milli>(Clock::now() - start_).count());
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        FrameStats& stats_;
+        size_t index_;
+        Clock::time_point start_;
+    };
+
+    // Вызывать в начале каждого кадра: закрывает предыдущий кадр
+    void beginFrame();
+
+    // Индекс секции (новая заводится при первом обращении); MaxSections — переполнение
+    size_t sectionIndex(const char* name);
+    void addSectionTime(size_t index, float ms);
+    void setCounter(const char* name, int64_t value);
+
+    // Перцентили по истории; считается по копии, вызывать при отрисовке панели
+    [[nodiscard]] Summary summarize() const;
+
+    // Кольцо истории: для ImGui::PlotHistogram(values, count, offset)
+    [[nodiscard]] const float* frameTimes() const noexcept { return frameTimes_.data(); }
+    [[nodiscard]] size_t frameCount() const noexcept { return frameCount_; }
+    [[nodiscard]] size_t historyOffset() const noexcept { return frameCount_ < HistorySize ? 0 : frameHead_; }
+    [[nodiscard]] float lastFrameMs() const noexcept;
+
+    [[nodiscard]] const Section* sections() const noexcept { return sections_.data(); }
+    [[nodiscard]] size_t sectionCount() const noexcept { return sectionCount_; }
+    [[nodiscard]] const Counter* counters() const noexcept { return counters_.data(); }
+    [[nodiscard]] size_t counterCount() const noexcept { return counterCount_; }
+
+private:
+    std::array<float, HistorySize> frameTimes_{};
+    size_t frameHead_ = 0;          // следующая запись
+    size_t frameCount_ = 0;         // заполнено, не больше HistorySize
+    Clock::time_point frameStart_{};
+    bool started_ = false;
+
+    std::array<Section, MaxSections> sections_{};
+    size_t sectionCount_ = 0;
+    std::array<Counter, MaxCounters> counters_{};
+    size_t counterCount_ = 0;
+};
+
+} // namespace kalan
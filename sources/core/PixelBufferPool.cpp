@@ -0,0 +1,258 @@
+#include "PixelBufferPool.hpp"
+#include "raylib.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
+namespace kalan {
+
+// Заголовок перед каждым выданным буфером: release() и reallocate() получают
+// только указатель (так их зовёт stb_image)
+struct alignas(64) PixelBufferPool::Header {
+    uint32_t magic;
+    uint32_t classIndex;        // ClassCount — буфер вне классов, не кэшируется
+    size_t blockBytes;          // вся выделенная память вместе с заголовком
+    size_t bytes;               // запрошено
+    bool mapped;                // от ОС (mmap/VirtualAlloc), иначе куча
+};
+
+namespace {
+
+constexpr uint32_t HeaderMagic = 0x4B50424Cu;  // "KPBL"
+constexpr size_t HugePageBytes = 2 * 1024 * 1024;
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Память у ОС; hugePages — удалось ли попросить THP
+void* mapMemory(size_t bytes, bool& hugePages) {
+    hugePages = false;
+#if defined(_WIN32)
+    // Large pages требуют SeLockMemoryPrivilege — обычные страницы
+    return VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#elif defined(__unix__) || defined(__APPLE__)
+    if (bytes < HugePageBytes) {
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+    // Выравниваем начало по 2 MB, иначе ядро не сможет отдать блок huge pages
+    size_t span = bytes + HugePageBytes;
+    void* raw = mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return nullptr;
+    auto begin = reinterpret_cast<uintptr_t>(raw);
+    uintptr_t aligned = alignUp(begin, HugePageBytes);
+    if (aligned > begin) munmap(raw, aligned - begin);
+    size_t tail = begin + span - (aligned + bytes);
+    if (tail > 0) munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+#if defined(MADV_HUGEPAGE)
+    hugePages = madvise(reinterpret_cast<void*>(aligned), bytes, MADV_HUGEPAGE) == 0;
+#endif
+    return reinterpret_cast<void*>(aligned);
+#else
+    return std::malloc(bytes);
+#endif
+}
+
+void unmapMemory(void* p, size_t bytes) noexcept {
+#if defined(_WIN32)
+    (void)bytes;
+    VirtualFree(p, 0, MEM_RELEASE);
+#elif defined(__unix__) || defined(__APPLE__)
+    munmap(p, bytes);
+#else
+    (void)bytes;
+    std::free(p);
+#endif
+}
+
+} // anonymous namespace
+
+PixelBufferPool& PixelBufferPool::instance() {
+    static PixelBufferPool pool;
+    return pool;
+}
+
+PixelBufferPool::~PixelBufferPool() {
+    trim();
+}
+
+size_t PixelBufferPool::classBytes(size_t index) noexcept {
+    size_t base = MinPooledBytes << (index / 2);
+    return index % 2 == 0 ? base : base + base / 2;
+}
+
+size_t PixelBufferPool::classIndex(size_t bytes) noexcept {
+    for (size_t i = 0; i < ClassCount; ++i) {
+        if (classBytes(i) >= bytes) return i;
+    }
+    return ClassCount;
+}
+
+void* PixelBufferPool::allocateBlock(size_t bytes, uint32_t index) {
+    const bool pooled = bytes >= MinPooledBytes;
+    size_t capacity = index < ClassCount ? classBytes(index) : bytes;
+    size_t blockBytes = sizeof(Header) + capacity;
+
+    void* block = nullptr;
+    bool hugePages = false;
+    if (pooled) {
+        blockBytes = alignUp(blockBytes, 4096);
+        block = mapMemory(blockBytes, hugePages);
+        osAllocations_.fetch_add(1, std::memory_order_relaxed);
+        if (hugePages) hugePages_.store(true, std::memory_order_relaxed);
+    } else {
+        block = std::malloc(blockBytes);
+    }
+    if (!block) {
+        TraceLog(LOG_WARNING, "PixelBufferPool: failed to allocate %zu bytes", blockBytes);
+        return nullptr;
+    }
+
+    auto* header = new (block) Header{HeaderMagic, index, blockBytes, bytes, pooled};
+    return header + 1;
+}
+
+void PixelBufferPool::freeBlock(Header* header) noexcept {
+    if (header->mapped) unmapMemory(header, header->blockBytes);
+    else std::free(header);
+}
+
+void* PixelBufferPool::acquire(size_t bytes) {
+    if (bytes < MinPooledBytes) return allocateBlock(bytes, static_cast<uint32_t>(ClassCount));
+
+    const size_t index = classIndex(bytes);
+    const size_t charged = index < ClassCount ? classBytes(index) : bytes;
+
+    void* data = nullptr;
+    if (index < ClassCount) {
+        std::lock_guard lock(mutex_);
+        auto& cached = cache_[index];
+        if (!cached.empty()) {
+            Header* header = cached.back();
+            cached.pop_back();
+            cachedBytes_ -= charged;
+            header->bytes = bytes;
+            reuses_.fetch_add(1, std::memory_order_relaxed);
+            data = header + 1;
+        }
+    }
+    if (!data) {
+        data = allocateBlock(bytes, static_cast<uint32_t>(index));
+        if (!data) return nullptr;
+    }
+
+    size_t inUse = inUseBytes_.fetch_add(charged, std::memory_order_relaxed) + charged;
+    size_t cached;
+    {
+        std::lock_guard lock(mutex_);
+        cached = cachedBytes_;
+    }
+    size_t peak = peakBytes_.load(std::memory_order_relaxed);
+    while (inUse + cached > peak &&
+           !peakBytes_.compare_exchange_weak(peak, inUse + cached, std::memory_order_relaxed)) {}
+    return data;
+}
+
+void* PixelBufferPool::reallocate(void* p, size_t bytes) {
+    if (!p) return acquire(bytes);
+
+    Header* header = static_cast<Header*>(p) - 1;
+    if (bytes <= header->blockBytes - sizeof(Header)) {
+        // Помещается в уже выделенный блок — на месте
+        header->bytes = bytes;
+        return p;
+    }
+
+    void* grown = acquire(bytes);
+    if (!grown) return nullptr;
+    std::memcpy(grown, p, std::min(bytes, header->bytes));
+    release(p);
+    return grown;
+}
+
+void PixelBufferPool::release(void* p) noexcept {
+    if (!p) return;
+    Header* header = static_cast<Header*>(p) - 1;
+    if (header->magic != HeaderMagic) {
+        TraceLog(LOG_ERROR, "PixelBufferPool: release of a foreign pointer %p", p);
+        return;
+    }
+    if (!header->mapped) {
+        std::free(header);
+        return;
+    }
+
+    const size_t index = header->classIndex;
+    if (index >= ClassCount) {
+        inUseBytes_.fetch_sub(header->blockBytes - sizeof(Header), std::memory_order_relaxed);
+        freeBlock(header);
+        return;
+    }
+
+    inUseBytes_.fetch_sub(classBytes(index), std::memory_order_relaxed);
+    std::lock_guard lock(mutex_);
+    cache_[index].push_back(header);
+    cachedBytes_ += classBytes(index);
+    trimToBudgetLocked();
+}
+
+void PixelBufferPool::trimToBudgetLocked() noexcept {
+    const size_t budget = budget_.load(std::memory_order_relaxed);
+    // Сначала крупные классы: меньше системных вызовов на освобождённый мегабайт
+    for (size_t i = ClassCount; i-- > 0 && cachedBytes_ > 0;) {
+        auto& cached = cache_[i];
+        while (!cached.empty() && inUseBytes_.load(std::memory_order_relaxed) + cachedBytes_ > budget) {
+            freeBlock(cached.back());
+            cached.pop_back();
+            cachedBytes_ -= classBytes(i);
+        }
+    }
+}
+
+void PixelBufferPool::setBudget(size_t bytes) {
+    budget_.store(bytes, std::memory_order_relaxed);
+    std::lock_guard lock(mutex_);
+    trimToBudgetLocked();
+}
+
+bool PixelBufferPool::overBudget() const noexcept {
+    // Кэш переиспользуется, поэтому в бюджет против новых задач идут только выданные
+    return inUseBytes_.load(std::memory_order_relaxed) >= budget_.load(std::memory_order_relaxed);
+}
+
+void PixelBufferPool::trim() {
+    std::lock_guard lock(mutex_);
+    for (size_t i = 0; i < ClassCount; ++i) {
+        for (Header* header : cache_[i]) freeBlock(header);
+        cache_[i].clear();
+        cache_[i].shrink_to_fit();
+    }
+    cachedBytes_ = 0;
+}
+
+PixelBufferPool::Stats PixelBufferPool::getStats() const {
+    Stats stats;
+    {
+        std::lock_guard lock(mutex_);
+        stats.cachedBytes = cachedBytes_;
+    }
+    stats.inUseBytes = inUseBytes_.load(std::memory_order_relaxed);
+    stats.peakBytes = peakBytes_.load(std::memory_order_relaxed);
+    stats.budgetBytes = budget_.load(std::memory_order_relaxed);
+    stats.osAllocations = osAllocations_.load(std::memory_order_relaxed);
+    stats.reuses = reuses_.load(std::memory_order_relaxed);
+    stats.hugePages = hugePages_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace kalan
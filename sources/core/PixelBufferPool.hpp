@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace kalan {
+
+// Пул буферов пикселей для декодирования текстур. Освобождённый буфер остаётся
+// в кэше своего класса размера и отдаётся следующему декодированию, так что загрузка
+// уровня не гоняет гигабайты через системный аллокатор и не фрагментирует кучу.
+//
+// Классы: 2^k и 1.5 * 2^k от 64 KB (RGB и RGBA текстуры степени двойки попадают точно).
+// Большие блоки берутся у ОС напрямую (mmap + transparent huge pages на Linux,
+// VirtualAlloc на Windows). Меньше 64 KB — обычная куча, без кэша.
+//
+// Память пула освобождается только release(), не UnloadImage/MemFree.
+// Потокобезопасен.
+class PixelBufferPool {
+public:
+    static constexpr size_t MinPooledBytes = 64 * 1024;
+    static constexpr size_t ClassCount = 2 * 20;    // до 48 GB, больше — мимо кэша
+
+    struct Stats {
+        size_t inUseBytes = 0;      // выдано и не возвращено (по классам)
+        size_t cachedBytes = 0;     // в кэше, ждут переиспользования
+        size_t peakBytes = 0;       // максимум inUse + cached
+        size_t budgetBytes = 0;
+        uint64_t osAllocations = 0; // блоки, взятые у ОС
+        uint64_t reuses = 0;        // выдачи из кэша
+        bool hugePages = false;     // хотя бы один блок получил huge pages
+    };
+
+    static PixelBufferPool& instance();
+
+    PixelBufferPool() = default;
+    ~PixelBufferPool();
+
+    PixelBufferPool(const PixelBufferPool&) = delete;
+    PixelBufferPool& operator=(const PixelBufferPool&) = delete;
+
+    // Буферы от MinPooledBytes выровнены по 64 байтам; nullptr при нехватке памяти
+    [[nodiscard]] void* acquire(size_t bytes);
+    // Как realloc: содержимое сохраняется, p == nullptr — acquire
+    [[nodiscard]] void* reallocate(void* p, size_t bytes);
+    void release(void* p) noexcept;
+
+    // Бюджет inUse + cached. Кэш сверх бюджета возвращается ОС, а overBudget()
+    // говорит источникам декодирования придержать новые задачи.
+    void setBudget(size_t bytes);
+    [[nodiscard]] size_t getBudget() const noexcept { return budget_.load(std::memory_order_relaxed); }
+    [[nodiscard]] bool overBudget() const noexcept;
+
+    // Вернуть ОС весь кэш (после загрузки уровня)
+    void trim();
+
+    [[nodiscard]] Stats getStats() const;
+
+private:
+    struct Header;
+
+    static size_t classBytes(size_t index) noexcept;
+    static size_t classIndex(size_t bytes) noexcept;   // ClassCount — вне классов
+
+    void* allocateBlock(size_t bytes, uint32_t classIndex);
+    void freeBlock(Header* header) noexcept;
+    void trimToBudgetLocked() noexcept;                 // под mutex_
+
+    mutable std::mutex mutex_;
+    std::array<std::vector<Header*>, ClassCount> cache_;
+    size_t cachedBytes_ = 0;                            // под mutex_
+    std::atomic<size_t> inUseBytes_{0};
+    std::atomic<size_t> peakBytes_{0};
+    std::atomic<size_t> budget_{size_t(1) << 30};
+    std::atomic<uint64_t> osAllocations_{0};
+    std::atomic<uint64_t> reuses_{0};
+    std::atomic<bool> hugePages_{false};
+};
+
+} // namespace kalan
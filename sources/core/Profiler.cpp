@@ -0,0 +1,184 @@
+#include "Profiler.hpp"
+#include "raylib.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+namespace kalan::profiler {
+
+namespace {
+
+// Кольцо пишет только поток-владелец, читает capture() из любого потока.
+// Схема seqlock: begun увеличивается до записи слота, committed — после.
+// Читатель копирует [committed - Capacity, committed), затем по begun отбрасывает
+// слоты, которые могли быть перезаписаны во время копирования.
+struct ThreadBuffer {
+    struct Slot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> startNs{0};
+        std::atomic<uint64_t> endNs{0};
+    };
+
+    std::array<Slot, ThreadBufferCapacity> slots;
+    std::atomic<uint64_t> begun{0};
+    std::atomic<uint64_t> committed{0};
+    uint32_t threadId = 0;
+    std::string name;               // под registryMutex
+
+    void push(const char* zoneName, uint64_t start, uint64_t end) noexcept {
+        uint64_t index = committed.load(std::memory_order_relaxed);
+        begun.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        Slot& slot = slots[index & (ThreadBufferCapacity - 1)];
+        slot.name.store(zoneName, std::memory_order_relaxed);
+        slot.startNs.store(start, std::memory_order_relaxed);
+        slot.endNs.store(end, std::memory_order_relaxed);
+
+        committed.store(index + 1, std::memory_order_release);
+    }
+};
+
+static_assert((ThreadBufferCapacity & (ThreadBufferCapacity - 1)) == 0, "capacity must be a power of two");
+
+std::atomic<bool> enabled{true};
+std::atomic<uint64_t> clearedAtNs{0};
+
+// Буферы не освобождаются до выхода: зоны завершившихся потоков остаются в захвате
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+thread_local ThreadBuffer* localBuffer = nullptr;
+
+ThreadBuffer& threadBuffer() {
+    if (!localBuffer) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        std::lock_guard lock(registryMutex);
+        buffer->threadId = static_cast<uint32_t>(buffers.size());
+        buffer->name = "Thread " + std::to_string(buffer->threadId);
+        localBuffer = buffer.get();
+        buffers.push_back(std::move(buffer));
+    }
+    return *localBuffer;
+}
+
+void writeEscaped(std::FILE* file, const char* text) {
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') std::fputc('\\', file);
+        if (static_cast<unsigned char>(*c) >= 0x20) std::fputc(*c, file);
+    }
+}
+
+} // anonymous namespace
+
+void setEnabled(bool value) noexcept {
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+bool isEnabled() noexcept {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void setThreadName(const char* name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard lock(registryMutex);
+    buffer.name = name;
+}
+
+void recordZone(const char* name, uint64_t startNs, uint64_t endNs) noexcept {
+    if (!isEnabled()) return;
+    // Регистрация потока аллоцирует один раз, дальше запись без блокировок
+    threadBuffer().push(name, startNs, endNs);
+}
+
+std::vector<ThreadCapture> capture() {
+    std::lock_guard lock(registryMutex);
+    const uint64_t since = clearedAtNs.load(std::memory_order_relaxed);
+
+    std::vector<ThreadCapture> result;
+    result.reserve(buffers.size());
+    for (const auto& buffer : buffers) {
+        ThreadCapture& thread = result.emplace_back();
+        thread.threadId = buffer->threadId;
+        thread.name = buffer->name;
+
+        uint64_t end = buffer->committed.load(std::memory_order_acquire);
+        uint64_t begin = end > ThreadBufferCapacity ? end - ThreadBufferCapacity : 0;
+        thread.events.reserve(end - begin);
+        for (uint64_t i = begin; i < end; ++i) {
+            const auto& slot = buffer->slots[i & (ThreadBufferCapacity - 1)];
+            thread.events.push_back({
+                slot.name.load(std::memory_order_relaxed),
+                slot.startNs.load(std::memory_order_relaxed),
+                slot.endNs.load(std::memory_order_relaxed)
+            });
+        }
+
+        // Слоты с индексом < begun - Capacity могли быть перезаписаны, пока мы копировали
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t begun = buffer->begun.load(std::memory_order_relaxed);
+        uint64_t firstValid = begun > ThreadBufferCapacity ? begun - ThreadBufferCapacity : 0;
+        size_t dropped = static_cast<size_t>(std::min(end, std::max(begin, firstValid)) - begin);
+        thread.events.erase(thread.events.begin(), thread.events.begin() + dropped);
+
+        std::erase_if(thread.events, [since](const ZoneEvent& e) { return e.startNs < since; });
+    }
+    return result;
+}
+
+void clear() noexcept {
+    clearedAtNs.store(nowNs(), std::memory_order_relaxed);
+}
+
+bool exportChromeTrace(const std::filesystem::path& path) {
+    std::vector<ThreadCapture> threads = capture();
+
+    uint64_t originNs = UINT64_MAX;
+    size_t zoneCount = 0;
+    for (const auto& thread : threads) {
+        for (const auto& e : thread.events) originNs = std::min(originNs, e.startNs);
+        zoneCount += thread.events.size();
+    }
+    if (originNs == UINT64_MAX) originNs = 0;
+
+    std::error_code ec;
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), ec);
+
+    std::FILE* file = std::fopen(path.string().c_str(), "wb");
+    if (!file) {
+        TraceLog(LOG_WARNING, "Profiler: cannot write %s", path.string().c_str());
+        return false;
+    }
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    bool first = true;
+    for (const auto& thread : threads) {
+        std::fprintf(file, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%" PRIu32 ",\"args\":{\"name\":\"",
+                     first ? "" : ",\n", thread.threadId);
+        writeEscaped(file, thread.name.c_str());
+        std::fputs("\"}}", file);
+        first = false;
+
+        for (const auto& e : thread.events) {
+            // Время в микросекундах от первой зоны захвата
+            std::fputs(",\n{\"ph\":\"X\",\"name\":\"", file);
+            writeEscaped(file, e.name ? e.name : "?");
+            std::fprintf(file, "\",\"pid\":1,\"tid\":%" PRIu32 ",\"ts\":%.3f,\"dur\":%.3f}",
+                         thread.threadId,
+                         static_cast<double>(e.startNs - originNs) / 1000.0,
+                         static_cast<double>(e.endNs - e.startNs) / 1000.0);
+        }
+    }
+    std::fputs("\n]}\n", file);
+
+    bool ok = std::fclose(file) == 0;
+    TraceLog(ok ? LOG_INFO : LOG_WARNING, "Profiler: %zu zones from %zu threads -> %s",
+             zoneCount, threads.size(), path.string().c_str());
+    return ok;
+}
+
+} // namespace kalan::profiler
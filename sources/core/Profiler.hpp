@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Встроенный CPU профайлер: зоны пишутся в кольцевой буфер своего потока
+// без блокировок, захват экспортируется в Chrome trace JSON
+// (chrome://tracing, ui.perfetto.dev).
+//
+// Макросы компилируются в ничто без опции CMake KALAN_PROFILER.
+// Имена зон — строковые литералы: хранится только указатель.
+#ifdef KALAN_PROFILER
+#define KALAN_PROFILE_CONCAT_IMPL(a, b) a##b
+#define KALAN_PROFILE_CONCAT(a, b) KALAN_PROFILE_CONCAT_IMPL(a, b)
+#define KALAN_PROFILE_ZONE(name) ::kalan::profiler::Zone KALAN_PROFILE_CONCAT(kalanZone_, __LINE__)(name)
+#define KALAN_PROFILE_FUNCTION() KALAN_PROFILE_ZONE(__func__)
+#define KALAN_PROFILE_THREAD(name) ::kalan::profiler::setThreadName(name)
+#else
+#define KALAN_PROFILE_ZONE(name) ((void)0)
+#define KALAN_PROFILE_FUNCTION() ((void)0)
+#define KALAN_PROFILE_THREAD(name) ((void)0)
+#endif
+
+namespace kalan::profiler {
+
+using Clock = std::chrono::steady_clock;
+
+// Кольцо одного потока; при переполнении старые зоны перезаписываются
+constexpr size_t ThreadBufferCapacity = 1 << 14;
+
+struct ZoneEvent {
+    const char* name = nullptr;
+    uint64_t startNs = 0;
+    uint64_t endNs = 0;
+};
+
+struct ThreadCapture {
+    uint32_t threadId = 0;          // порядковый номер регистрации
+    std::string name;
+    std::vector<ZoneEvent> events;  // в порядке завершения
+};
+
+[[nodiscard]] constexpr bool compiledIn() noexcept {
+#ifdef KALAN_PROFILER
+    return true;
+#else
+    return false;
+#endif
+}
+
+[[nodiscard]] inline uint64_t nowNs() noexcept {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+}
+
+[[nodiscard]] inline uint64_t toNs(Clock::time_point time) noexcept {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+}
+
+// Запись выключается без перекомпиляции; выключенная зона — одна атомарная загрузка
+void setEnabled(bool enabled) noexcept;
+[[nodiscard]] bool isEnabled() noexcept;
+
+// Имя текущего потока в трейсе (копируется)
+void setThreadName(const char* name);
+
+// Записать уже измеренную зону (этапы загрузчика меряются своими часами)
+void recordZone(const char* name, uint64_t startNs, uint64_t endNs) noexcept;
+
+// Снимок всех буферов. Зоны, начатые до последнего clear(), отбрасываются.
+// Можно вызывать во время записи: перезаписанные в процессе копирования зоны не попадут.
+[[nodiscard]] std::vector<ThreadCapture> capture();
+void clear() noexcept;
+
+// Снимок в формате Chrome trace event ("ph": "X")
+bool exportChromeTrace(const std::filesystem::path& path);
+
+class Zone {
+public:
+    explicit Zone(const char* name) noexcept
+        : name_(name), startNs_(isEnabled() ? nowNs() : 0) {}
+    ~Zone() {
+        if (startNs_) recordZone(name_, startNs_, nowNs());
+    }
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+private:
+    const char* name_;
+    uint64_t startNs_;
+};
+
+} // namespace kalan::profiler
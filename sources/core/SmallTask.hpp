@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace kalan {
+
+// Перемещаемая задача void() с замыканием внутри объекта.
+// Замыкания до Capacity байт не аллоцируют (std::function в libstdc++ хранит
+// на месте только 16 байт); крупнее — одна аллокация. Допускает move-only
+// замыкания (std::promise, std::packaged_task).
+class SmallTask {
+public:
+    static constexpr size_t Capacity = 96;
+
+    SmallTask() noexcept = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, SmallTask>>>
+    SmallTask(F&& fn) {
+        using Fn = std::decay_t<F>;
+        if constexpr (fitsInline<Fn>) {
+            new (buffer_) Fn(std::forward<F>(fn));
+            ops_ = &InlineOps<Fn>::ops;
+        } else {
+            *reinterpret_cast<Fn**>(buffer_) = new Fn(std::forward<F>(fn));
+            ops_ = &HeapOps<Fn>::ops;
+        }
+    }
+
+    SmallTask(SmallTask&& other) noexcept { moveFrom(other); }
+
+    SmallTask& operator=(SmallTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    SmallTask(const SmallTask&) = delete;
+    SmallTask& operator=(const SmallTask&) = delete;
+
+    ~SmallTask() { reset(); }
+
+    void operator()() { ops_->invoke(buffer_); }
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    void reset() noexcept {
+        if (ops_) ops_->destroy(buffer_);
+        ops_ = nullptr;
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src) noexcept;   // src после вызова пуст
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <typename Fn>
+    static constexpr bool fitsInline = sizeof(Fn) <= Capacity &&
+                                       alignof(Fn) <= alignof(std::max_align_t) &&
+                                       std::is_nothrow_move_constructible_v<Fn>;
+
+    template <typename Fn>
+    struct InlineOps {
+        static void invoke(void* p) { (*static_cast<Fn*>(p))(); }
+        static void move(void* dst, void* src) noexcept {
+            new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+            static_cast<Fn*>(src)->~Fn();
+        }
+        static void destroy(void* p) noexcept { static_cast<Fn*>(p)->~Fn(); }
+        static constexpr Ops ops{invoke, move, destroy};
+    };
+
+    template <typename Fn>
+    struct HeapOps {
+        static void invoke(void* p) { (**static_cast<Fn**>(p))(); }
+        static void move(void* dst, void* src) noexcept { *static_cast<Fn**>(dst) = *static_cast<Fn**>(src); }
+        static void destroy(void* p) noexcept { delete *static_cast<Fn**>(p); }
+        static constexpr Ops ops{invoke, move, destroy};
+    };
+
+    void moveFrom(SmallTask& other) noexcept {
+        if (!other.ops_) return;
+        other.ops_->move(buffer_, other.buffer_);
+        ops_ = other.ops_;
+        other.ops_ = nullptr;
+    }
+
+    alignas(std::max_align_t) unsigned char buffer_[Capacity];
+    const Ops* ops_ = nullptr;
+};
+
+template <typename Signature>
+class FunctionRef;
+
+// Невладеющая ссылка на вызываемый объект: два указателя, без аллокаций.
+// Объект должен жить, пока используется ссылка — подходит для синхронных
+// колбэков (parallelFor, прогресс загрузки).
+template <typename R, typename... Args>
+class FunctionRef<R(Args...)> {
+public:
+    FunctionRef() noexcept = default;
+    FunctionRef(std::nullptr_t) noexcept {}
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, FunctionRef> &&
+                                                      std::is_invocable_r_v<R, F&, Args...>>>
+    FunctionRef(F&& fn) noexcept
+        : object_(const_cast<void*>(static_cast<const void*>(std::addressof(fn)))),
+          invoke_([](void* object, Args... args) -> R {
+              return (*static_cast<std::remove_reference_t<F>*>(object))(std::forward<Args>(args)...);
+          }) {}
+
+    R operator()(Args... args) const { return invoke_(object_, std::forward<Args>(args)...); }
+    explicit operator bool() const noexcept { return invoke_ != nullptr; }
+
+private:
+    void* object_ = nullptr;
+    R (*invoke_)(void*, Args...) = nullptr;
+};
+
+} // namespace kalan
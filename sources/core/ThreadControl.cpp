@@ -0,0 +1,74 @@
+#include "ThreadControl.hpp"
+#include <thread>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace kalan {
+
+bool setCurrentThreadNice(int nice) {
+#if defined(_WIN32)
+    int priority = nice <= 0 ? THREAD_PRIORITY_NORMAL
+                 : nice < 10 ? THREAD_PRIORITY_BELOW_NORMAL
+                             : THREAD_PRIORITY_LOWEST;
+    return SetThreadPriority(GetCurrentThread(), priority) != 0;
+#elif defined(__linux__)
+    // На Linux nice — атрибут потока (tid), а не процесса
+    pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+    return setpriority(PRIO_PROCESS, static_cast<id_t>(tid), nice) == 0;
+#else
+    (void)nice;
+    return false;
+#endif
+}
+
+bool pinCurrentThreadToCpu(unsigned int cpu) {
+    if (cpu >= std::thread::hardware_concurrency()) return false;
+#if defined(_WIN32)
+    if (cpu >= sizeof(DWORD_PTR) * 8) return false;
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+bool excludeCurrentThreadFromCpu(unsigned int cpu) {
+    unsigned int count = std::thread::hardware_concurrency();
+    // На одноядерной машине исключать нечего — поток остался бы без ядер
+    if (count < 2 || cpu >= count) return false;
+#if defined(_WIN32)
+    DWORD_PTR processMask = 0;
+    DWORD_PTR systemMask = 0;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) return false;
+    DWORD_PTR mask = processMask;
+    if (cpu < sizeof(DWORD_PTR) * 8) mask &= ~(DWORD_PTR(1) << cpu);
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+    // Маску строим заново: поток мог унаследовать закрепление создателя
+    // (например, главного потока на ядре cpu)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (unsigned int i = 0; i < count && i < CPU_SETSIZE; ++i) {
+        if (i != cpu) CPU_SET(i, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+} // namespace kalan
@@ -0,0 +1,18 @@
+#pragma once
+
+namespace kalan {
+
+// Планирование потоков ОС. Функции действуют на вызывающий поток и возвращают
+// false, если платформа это не поддерживает или запрос отклонён (лимиты, права).
+
+// nice > 0 — ниже приоритет (Linux: nice потока; Windows: BELOW_NORMAL/LOWEST)
+bool setCurrentThreadNice(int nice);
+
+// Закрепить поток за одним логическим ядром
+bool pinCurrentThreadToCpu(unsigned int cpu);
+
+// Разрешить потоку все логические ядра, кроме cpu (в том числе снять
+// закрепление, унаследованное от создавшего поток)
+bool excludeCurrentThreadFromCpu(unsigned int cpu);
+
+} // namespace kalan
@@ -3,10 +3,26 @@
 #include "entt/entity/fwd.hpp"
 #include "entt/entt.hpp"
 #include "raylib-cpp.hpp"
+#include "core/AllocationCounter.hpp"
+#include "core/FrameArena.hpp"
+#include "core/FrameStats.hpp"
+#include "core/Profiler.hpp"
+#include "core/ThreadControl.hpp"
 #include "resources/AssetManager.hpp"
 #include "resources/ParallelLoader.hpp"
 #include "rendering/PBRMaterial.hpp"
 #include "rendering/Lighting.hpp"
+#include "rendering/DrawList.hpp"
+#include "rendering/InstancedRenderer.hpp"
+#include "rendering/TextureStreamer.hpp"
+#include "rendering/TextureUploader.hpp"
+#include "physics/PhysicsWorld.hpp"
+#include "scene/AnimationSystem.hpp"
+#include "scene/OcclusionSystem.hpp"
+#include "scene/RenderSystem.hpp"
+#include "scene/TransformSystem.hpp"
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <algorithm>
 #include <chrono>
 
 // Loading screen с анимацией
@@ -56,12 +72,15 @@ void DrawLoadingScreen(raylib::Window& window, const char* text, float progress
 
 int main() {
   raylib::Window window(1920, 1080, "Kalan");
+  KALAN_PROFILE_THREAD("Main");
   SetTraceLogLevel(LOG_INFO); // Временно для отладки
   DrawLoadingScreen(window, "Initializing");
 
   // Инициализация PBR системы
   kalan::PBRMaterial::initShader();
   kalan::LightingSystem::instance().init();
+  // Кольцо PBO для загрузки текстур; без GL 4.4 загрузка остаётся синхронной
+  kalan::TextureUploader::instance().init();
   
   kalan::LightingSystem::instance().addLight({
       .enabled = true,
@@ -71,7 +90,35 @@ int main() {
       .intensity = 2.0f
   });
 
+  // Один пул на кадр и загрузку. Задачи кадра (физика, трансформы) идут в Critical,
+  // их берут воркеры кадра с обычным приоритетом. Воркеры загрузки ниже приоритетом
+  // и не занимают ядро главного потока: фоновая загрузка не отнимает время у кадра.
+  // Пул создаётся до закрепления, иначе воркеры кадра унаследуют ядро 0.
+  const unsigned int cores = std::max(2u, std::thread::hardware_concurrency());
+  kalan::ParallelModelLoader& loader = kalan::ParallelModelLoader::instance();
+  loader.setThreadCount(cores);
+  loader.setWorkerSettings({.niceLevel = 10, .excludedCpu = 0, .frameWorkers = cores / 2});
+  kalan::ImageThreadPool& pool = loader.getThreadPool();
+  kalan::pinCurrentThreadToCpu(0);
+
   entt::registry registry;
+  kalan::TransformSystem transformSystem(registry);
+  kalan::PhysicsWorld physicsWorld(registry, pool);
+
+  // Статические коллайдеры пола и жёлтого куба
+  physicsWorld.addBody(
+      kalan::TransformSystem::createEntity(registry),
+      JPH::BodyCreationSettings(new JPH::BoxShape(JPH::Vec3(50.0f, 0.5f, 50.0f)),
+                                JPH::RVec3(0.0f, -0.5f, 0.0f), JPH::Quat::sIdentity(),
+                                JPH::EMotionType::Static, kalan::physics_layers::NonMoving),
+      JPH::EActivation::DontActivate);
+  physicsWorld.addBody(
+      kalan::TransformSystem::createEntity(registry),
+      JPH::BodyCreationSettings(new JPH::BoxShape(JPH::Vec3(1.0f, 1.0f, 1.0f)),
+                                JPH::RVec3(0.0f, 0.0f, 0.0f), JPH::Quat::sIdentity(),
+                                JPH::EMotionType::Static, kalan::physics_layers::NonMoving),
+      JPH::EActivation::DontActivate);
+  physicsWorld.optimizeBroadPhase();
 
   raylib::Camera camera({0.2f, 0.4f, 0.2f}, {0.0f, 0.0f, 0.0f},
                         {0.0f, 1.0f, 0.0f}, 45.0f);
@@ -81,9 +128,12 @@ int main() {
   
   auto loadStart = std::chrono::high_resolution_clock::now();
   
-  // Используем параллельный загрузчик с GPU-ускоренными mipmaps
-  auto handsModel = kalan::ParallelModelLoader::instance().loadModel(
-      "assets/models/nerf/nerf_retaliator.glb",
+  // Используем параллельный загрузчик с GPU-ускоренными mipmaps.
+  // Скелет и клипы рук импортируются, если они есть в ассете
+  kalan::LoadOptions handsOptions;
+  handsOptions.importAnimation = true;
+  auto handsLoaded = loader.loadModelEx(
+      "assets/models/nerf/nerf_retaliator.glb", handsOptions,
       [&window](const kalan::ParallelModelLoader::LoadProgress& progress) {
           DrawLoadingScreen(window, "Loading textures", progress.getUploadProgress());
       }
@@ -93,12 +143,34 @@ int main() {
   auto loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(loadEnd - loadStart).count();
   TraceLog(LOG_WARNING, "Model loaded in %lld ms", loadTime);
 
-  kalan::Player player(std::move(handsModel), &camera, {0.}, 10);
+  kalan::Player player(registry, physicsWorld, std::move(handsLoaded.model), &camera,
+                      {4.0f, 0.0f, 4.0f}, 5);
+  player.SetHandsAnimations(std::move(handsLoaded.animations));
+  kalan::AnimationSystem animationSystem(registry);
 
   kalan::Editor &editor = kalan::Editor::GetInstance(&player);
   SetExitKey(0);
 
+  kalan::DrawList drawList;
+  kalan::InstanceBatcher instanceBatcher;
+  kalan::RenderSystem renderSystem(registry);
+  // Повторяющиеся модели рисуются одним DrawMeshInstanced на меш
+  renderSystem.setInstancing(&instanceBatcher, &pool);
+  // Окклюдеры — сущности с Occluder (LoadOptions::buildOccluders); без них всё видимо
+  kalan::OcclusionSystem occlusionSystem(registry);
+  renderSystem.setOcclusion(&occlusionSystem.getBuffer());
+  // Работает только со сборкой KALAN_ALLOCATION_COUNTER
+  kalan::FrameAllocationCheck allocationCheck;
+  kalan::FrameStats frameStats;
+  editor.SetFrameStats(&frameStats);
+
   while (!window.ShouldClose()) {
+    kalan::FrameArena::nextFrame();
+    allocationCheck.beginFrame();
+    frameStats.beginFrame();
+    kalan::TextureUploader::instance().beginFrame();
+    KALAN_PROFILE_ZONE("Frame");
+
     // Updating
 
     // entity in InputSystem should update
@@ -114,9 +186,25 @@ int main() {
     //
 
     // entity with TrasformComponent should update
-    if (!editor.IsVisible())
-      camera.Update(CameraMode::CAMERA_FIRST_PERSON);
-    player.Update();
+    // Камера следует за персонажем, коллизии считаются на фиксированном шаге
+    {
+      kalan::FrameStats::Scope scope(frameStats, "Physics");
+      player.HandleInput(!editor.IsVisible());
+      auto physicsStats = physicsWorld.update(GetFrameTime());
+      player.Update(physicsStats.alpha);
+      frameStats.setCounter("Physics steps", physicsStats.steps);
+      frameStats.setCounter("Active bodies", static_cast<int64_t>(physicsStats.activeBodies));
+    }
+    {
+      kalan::FrameStats::Scope scope(frameStats, "Transforms");
+      transformSystem.update(&pool);
+    }
+    {
+      kalan::FrameStats::Scope scope(frameStats, "Animation");
+      auto animationStats = animationSystem.update(GetFrameTime(), &pool);
+      frameStats.setCounter("Animators", static_cast<int64_t>(animationStats.animators));
+      frameStats.setCounter("CPU skinned verts", static_cast<int64_t>(animationStats.cpuSkinnedVertices));
+    }
     //
 
     // Drawing
@@ -127,22 +215,68 @@ int main() {
       // entity with DrawableComponent 3d should update
       camera.BeginMode();
       {
-        // Обновить uniforms освещения
-        kalan::LightingSystem::instance().update(camera);
-        
-        player.Draw();
-        DrawGrid(100, 1);
-        DrawCube({0}, 2.0f, 2.0f, 2.0f, YELLOW);
+        {
+          // Обновить uniforms освещения
+          kalan::FrameStats::Scope scope(frameStats, "Lighting");
+          kalan::LightingSystem::instance().update(camera);
+        }
+
+        {
+          // Спрос на mip уровни по тем же матрицам, что и отсечение
+          kalan::FrameStats::Scope scope(frameStats, "Texture streaming");
+          kalan::TextureStreamer::instance().update(registry, camera.position);
+        }
+
+        {
+          // Буфер перекрытия по тем же матрицам, что и отсечение в RenderSystem
+          kalan::FrameStats::Scope scope(frameStats, "Occlusion");
+          auto occlusionStats = occlusionSystem.update(&pool);
+          frameStats.setCounter("Occluders", occlusionStats.occluders);
+        }
+
+        kalan::RenderSystem::Stats renderStats;
+        kalan::DrawList::Stats drawStats;
+        {
+          kalan::FrameStats::Scope scope(frameStats, "Render submit");
+          drawList.begin();
+          renderStats = renderSystem.submit(drawList);
+        }
+        {
+          kalan::FrameStats::Scope scope(frameStats, "Draw");
+          drawStats = drawList.flush();
+          auto instancedStats = kalan::InstancedRenderer::draw(instanceBatcher, renderSystem.getMinInstances());
+          drawStats.draws += instancedStats.drawCalls;
+          drawStats.triangles += instancedStats.triangles;
+          DrawGrid(100, 1);
+          DrawCube({0}, 2.0f, 2.0f, 2.0f, YELLOW);
+        }
+        frameStats.setCounter("Draw calls", drawStats.draws);
+        frameStats.setCounter("Triangles", drawStats.triangles);
+        frameStats.setCounter("Shader binds", drawStats.shaderBinds);
+        frameStats.setCounter("Culled", renderStats.culled);
+        frameStats.setCounter("Occluded", renderStats.occluded);
+        frameStats.setCounter("Instanced", renderStats.instanced);
+        frameStats.setCounter("Reduced LOD", renderStats.reducedLod);
       }
       camera.EndMode();
       //
 
       // entity with DrawableComponent 2d should update
       window.DrawFPS(0, 0);
-      editor.Draw();
+      {
+        kalan::FrameStats::Scope scope(frameStats, "Editor");
+        editor.Draw();
+      }
       //
     }
-    EndDrawing();
+    {
+      // Ожидание vsync и swap
+      kalan::FrameStats::Scope scope(frameStats, "Present");
+      EndDrawing();
+    }
+    allocationCheck.endFrame();
   }
+  kalan::TextureStreamer::instance().shutdown();
+  kalan::TextureUploader::instance().shutdown();
   return 0;
 }
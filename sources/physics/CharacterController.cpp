@@ -0,0 +1,102 @@
+#include "CharacterController.hpp"
+#include "PhysicsWorld.hpp"
+#include "../core/Profiler.hpp"
+#include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
+#include <Jolt/Physics/Collision/Shape/RotatedTranslatedShape.h>
+#include <algorithm>
+#include <chrono>
+
+namespace kalan {
+
+CharacterController::CharacterController(PhysicsWorld& physics, Vector3 position)
+    : CharacterController(physics, position, Settings{}) {}
+
+CharacterController::CharacterController(PhysicsWorld& physics, Vector3 position, const Settings& settings)
+    : physics_(physics), settings_(settings), prevPosition_(position), currPosition_(position)
+{
+    // Капсула поднята так, что начало координат персонажа — у ног
+    float halfHeight = 0.5f * settings_.height;
+    JPH::RotatedTranslatedShapeSettings shape(JPH::Vec3(0.0f, halfHeight + settings_.radius, 0.0f),
+                                              JPH::Quat::sIdentity(),
+                                              new JPH::CapsuleShape(halfHeight, settings_.radius));
+
+    JPH::CharacterVirtualSettings characterSettings;
+    characterSettings.mShape = shape.Create().Get();
+    characterSettings.mMaxSlopeAngle = JPH::DegreesToRadians(settings_.maxSlopeDegrees);
+    // Опора только нижней полусферой, боковые контакты не считаются землёй
+    characterSettings.mSupportingVolume = JPH::Plane(JPH::Vec3::sAxisY(), -settings_.radius);
+
+    character_ = new JPH::CharacterVirtual(&characterSettings, JPH::RVec3(toJolt(position)),
+                                           JPH::Quat::sIdentity(), 0, &physics_.getSystem());
+
+    physics_.onStep().connect<&CharacterController::fixedUpdate>(*this);
+}
+
+CharacterController::~CharacterController() {
+    physics_.onStep().disconnect(this);
+}
+
+void CharacterController::setInput(Vector3 horizontalVelocity, bool jump) {
+    wishVelocity_ = {horizontalVelocity.x, 0.0f, horizontalVelocity.z};
+    // Прыжок запоминается до ближайшего шага, даже если кадров между шагами несколько
+    jumpRequested_ = jumpRequested_ || jump;
+}
+
+void CharacterController::teleport(Vector3 position) {
+    character_->SetPosition(JPH::RVec3(toJolt(position)));
+    character_->SetLinearVelocity(JPH::Vec3::sZero());
+    prevPosition_ = currPosition_ = position;
+}
+
+Vector3 CharacterController::getInterpolatedPosition(float alpha) const {
+    return Vector3Lerp(prevPosition_, currPosition_, alpha);
+}
+
+bool CharacterController::isOnGround() const {
+    return character_->GetGroundState() == JPH::CharacterBase::EGroundState::OnGround;
+}
+
+void CharacterController::fixedUpdate(float dt) {
+    KALAN_PROFILE_ZONE("CharacterController::fixedUpdate");
+    auto start = std::chrono::steady_clock::now();
+    JPH::PhysicsSystem& system = physics_.getSystem();
+    JPH::Vec3 gravity = system.GetGravity();
+
+    // Вертикальная скорость сохраняется, горизонтальная задаётся вводом
+    character_->UpdateGroundVelocity();
+    JPH::Vec3 velocity = character_->GetLinearVelocity();
+    JPH::Vec3 vertical(0.0f, velocity.GetY(), 0.0f);
+    JPH::Vec3 groundVelocity = character_->GetGroundVelocity();
+
+    JPH::Vec3 newVelocity;
+    bool onGround = character_->GetGroundState() == JPH::CharacterBase::EGroundState::OnGround;
+    if (onGround && (vertical.GetY() - groundVelocity.GetY()) < 0.1f) {
+        newVelocity = groundVelocity;
+        if (jumpRequested_) newVelocity += JPH::Vec3(0.0f, settings_.jumpSpeed, 0.0f);
+    } else {
+        newVelocity = vertical;
+    }
+    jumpRequested_ = false;
+
+    newVelocity += gravity * dt;
+    newVelocity += toJolt(wishVelocity_);
+    character_->SetLinearVelocity(newVelocity);
+
+    // Персонаж сталкивается только с тем, с чем сталкиваются подвижные тела
+    JPH::CharacterVirtual::ExtendedUpdateSettings updateSettings;
+    character_->ExtendedUpdate(dt, gravity, updateSettings,
+                               system.GetDefaultBroadPhaseLayerFilter(physics_layers::Moving),
+                               system.GetDefaultLayerFilter(physics_layers::Moving),
+                               {}, {}, physics_.getTempAllocator());
+
+    prevPosition_ = currPosition_;
+    currPosition_ = toRaylib(JPH::Vec3(character_->GetPosition()));
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    ++stats_.ticks;
+    stats_.lastTickMs = ms;
+    stats_.maxTickMs = std::max(stats_.maxTickMs, ms);
+    stats_.totalMs += ms;
+}
+
+} // namespace kalan
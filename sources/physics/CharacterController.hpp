@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Character/CharacterVirtual.h>
+
+#include "raylib.h"
+#include <cstdint>
+
+namespace kalan {
+
+class PhysicsWorld;
+
+// Персонаж на Jolt CharacterVirtual. Move-and-slide выполняется только на фиксированном
+// шаге PhysicsWorld, а не каждый кадр: отрисовка берёт интерполированную позицию,
+// поэтому частота кадров не увеличивает число запросов коллизий.
+class CharacterController {
+public:
+    struct Settings {
+        float height = 1.2f;            // высота цилиндрической части капсулы
+        float radius = 0.3f;
+        float maxSlopeDegrees = 45.0f;
+        float jumpSpeed = 5.0f;
+    };
+
+    struct Stats {
+        uint64_t ticks = 0;
+        double lastTickMs = 0.0;        // move-and-slide за последний шаг
+        double maxTickMs = 0.0;
+        double totalMs = 0.0;
+
+        [[nodiscard]] double avgTickMs() const { return ticks ? totalMs / ticks : 0.0; }
+    };
+
+    // position — точка у ног персонажа
+    CharacterController(PhysicsWorld& physics, Vector3 position);
+    CharacterController(PhysicsWorld& physics, Vector3 position, const Settings& settings);
+    ~CharacterController();
+
+    CharacterController(const CharacterController&) = delete;
+    CharacterController& operator=(const CharacterController&) = delete;
+
+    // Желаемая горизонтальная скорость; применяется на ближайших шагах
+    void setInput(Vector3 horizontalVelocity, bool jump);
+    void teleport(Vector3 position);
+
+    [[nodiscard]] Vector3 getPosition() const noexcept { return currPosition_; }
+    // Между предыдущим и текущим шагом, alpha из PhysicsWorld::Stats
+    [[nodiscard]] Vector3 getInterpolatedPosition(float alpha) const;
+    [[nodiscard]] bool isOnGround() const;
+    [[nodiscard]] const Settings& getSettings() const noexcept { return settings_; }
+    [[nodiscard]] const Stats& getStats() const noexcept { return stats_; }
+    void resetStats() noexcept { stats_ = {}; }
+
+private:
+    void fixedUpdate(float dt);
+
+    PhysicsWorld& physics_;
+    Settings settings_;
+    JPH::Ref<JPH::CharacterVirtual> character_;
+
+    Vector3 wishVelocity_{0.0f, 0.0f, 0.0f};
+    bool jumpRequested_ = false;
+
+    Vector3 prevPosition_{0.0f, 0.0f, 0.0f};
+    Vector3 currPosition_{0.0f, 0.0f, 0.0f};
+    Stats stats_;
+};
+
+} // namespace kalan
@@ -0,0 +1,45 @@
+#include "JoltRuntime.hpp"
+#include "raylib.h"
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/Factory.h>
+#include <Jolt/RegisterTypes.h>
+#include <cstdarg>
+#include <cstdio>
+#include <mutex>
+
+namespace kalan {
+
+namespace {
+
+void JoltTrace(const char* fmt, ...) {
+    char buffer[1024];
+    va_list args;
+    va_start(args, fmt);
+    std::vsnprintf(buffer, sizeof(buffer), fmt, args);
+    va_end(args);
+    TraceLog(LOG_INFO, "Jolt: %s", buffer);
+}
+
+std::mutex joltMutex;
+int joltUsers = 0;
+
+} // anonymous namespace
+
+JoltRuntime::JoltRuntime() {
+    std::lock_guard lock(joltMutex);
+    if (joltUsers++ > 0) return;
+    JPH::RegisterDefaultAllocator();
+    JPH::Trace = JoltTrace;
+    JPH::Factory::sInstance = new JPH::Factory();
+    JPH::RegisterTypes();
+}
+
+JoltRuntime::~JoltRuntime() {
+    std::lock_guard lock(joltMutex);
+    if (--joltUsers > 0) return;
+    JPH::UnregisterTypes();
+    delete JPH::Factory::sInstance;
+    JPH::Factory::sInstance = nullptr;
+}
+
+} // namespace kalan
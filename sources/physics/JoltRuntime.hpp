@@ -0,0 +1,16 @@
+#pragma once
+
+namespace kalan {
+
+// Глобальное состояние Jolt: аллокатор, фабрика, зарегистрированные типы.
+// Регистрируется первым живым экземпляром и снимается последним.
+class JoltRuntime {
+public:
+    JoltRuntime();
+    ~JoltRuntime();
+
+    JoltRuntime(const JoltRuntime&) = delete;
+    JoltRuntime& operator=(const JoltRuntime&) = delete;
+};
+
+} // namespace kalan
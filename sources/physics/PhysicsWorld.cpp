@@ -0,0 +1,209 @@
+#include "PhysicsWorld.hpp"
+#include "../resources/ParallelLoader.hpp"
+#include "../core/Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace kalan {
+
+namespace {
+
+namespace broad_phase_layers {
+    constexpr JPH::BroadPhaseLayer NonMoving(0);
+    constexpr JPH::BroadPhaseLayer Moving(1);
+    constexpr JPH::uint Count = 2;
+}
+
+} // anonymous namespace
+
+PhysicsWorld::PhysicsWorld(entt::registry& registry, ImageThreadPool& pool)
+    : PhysicsWorld(registry, pool, Settings{}) {}
+
+PhysicsWorld::PhysicsWorld(entt::registry& registry, ImageThreadPool& pool, const Settings& settings)
+    : registry_(registry), pool_(pool), settings_(settings),
+      layerPairs_(physics_layers::Count),
+      broadPhaseLayers_(physics_layers::Count, broad_phase_layers::Count),
+      layerVsBroadPhase_(broadPhaseLayers_, broad_phase_layers::Count, layerPairs_, physics_layers::Count),
+      tempAllocator_(std::make_unique<JPH::TempAllocatorImpl>(settings.tempAllocatorBytes)),
+      jobSystem_(pool)
+{
+    layerPairs_.EnableCollision(physics_layers::Moving, physics_layers::NonMoving);
+    layerPairs_.EnableCollision(physics_layers::Moving, physics_layers::Moving);
+    broadPhaseLayers_.MapObjectToBroadPhaseLayer(physics_layers::NonMoving, broad_phase_layers::NonMoving);
+    broadPhaseLayers_.MapObjectToBroadPhaseLayer(physics_layers::Moving, broad_phase_layers::Moving);
+
+    system_.Init(settings_.maxBodies, 0, settings_.maxBodyPairs, settings_.maxContactConstraints,
+                 broadPhaseLayers_, layerVsBroadPhase_, layerPairs_);
+
+    registry_.on_destroy<RigidBody>().connect<&PhysicsWorld::onRigidBodyDestroy>(*this);
+
+    TraceLog(LOG_INFO, "PhysicsWorld: fixed step %.2f ms, %d job threads",
+             settings_.fixedDt * 1000.0f, jobSystem_.GetMaxConcurrency());
+}
+
+PhysicsWorld::~PhysicsWorld() {
+    registry_.on_destroy<RigidBody>().disconnect(this);
+
+    JPH::BodyInterface& bodies = system_.GetBodyInterface();
+    for (auto [entity, body] : registry_.view<RigidBody>().each()) {
+        if (body.id.IsInvalid()) continue;
+        bodies.RemoveBody(body.id);
+        bodies.DestroyBody(body.id);
+        body.id = JPH::BodyID();
+    }
+}
+
+// ============ Тела ============
+
+JPH::BodyID PhysicsWorld::addBody(entt::entity entity, const JPH::BodyCreationSettings& settings,
+                                  JPH::EActivation activation) {
+    JPH::BodyInterface& bodies = system_.GetBodyInterface();
+    JPH::Body* body = bodies.CreateBody(settings);
+    if (!body) {
+        TraceLog(LOG_WARNING, "PhysicsWorld: body limit (%u) reached", settings_.maxBodies);
+        return JPH::BodyID();
+    }
+    body->SetUserData(static_cast<JPH::uint64>(entt::to_integral(entity)));
+    bodies.AddBody(body->GetID(), activation);
+
+    Vector3 position = toRaylib(JPH::Vec3(settings.mPosition));
+    Quaternion rotation = toRaylib(settings.mRotation);
+    registry_.emplace_or_replace<RigidBody>(entity, RigidBody{
+        .id = body->GetID(),
+        .prevPosition = position,
+        .currPosition = position,
+        .prevRotation = rotation,
+        .currRotation = rotation,
+        .syncedStep = step_,
+    });
+
+    if (registry_.all_of<LocalTransform>(entity)) {
+        registry_.patch<LocalTransform>(entity, [&](LocalTransform& local) {
+            local.translation = position;
+            local.rotation = rotation;
+        });
+    } else {
+        registry_.emplace<LocalTransform>(entity, LocalTransform{.translation = position, .rotation = rotation});
+    }
+    return body->GetID();
+}
+
+void PhysicsWorld::optimizeBroadPhase() {
+    system_.OptimizeBroadPhase();
+}
+
+void PhysicsWorld::onRigidBodyDestroy(entt::registry& registry, entt::entity entity) {
+    RigidBody& body = registry.get<RigidBody>(entity);
+    if (body.id.IsInvalid()) return;
+    JPH::BodyInterface& bodies = system_.GetBodyInterface();
+    bodies.RemoveBody(body.id);
+    bodies.DestroyBody(body.id);
+    body.id = JPH::BodyID();
+}
+
+// ============ Симуляция ============
+
+PhysicsWorld::Stats PhysicsWorld::update(float frameDt) {
+    KALAN_PROFILE_ZONE("PhysicsWorld::update");
+    using Clock = std::chrono::steady_clock;
+    Stats stats;
+
+    accumulator_ += frameDt;
+    while (accumulator_ >= settings_.fixedDt && stats.steps < settings_.maxStepsPerFrame) {
+        auto stepStart = Clock::now();
+        {
+            KALAN_PROFILE_ZONE("Physics step");
+            onStep_.publish(settings_.fixedDt);
+            system_.Update(settings_.fixedDt, settings_.collisionSteps, tempAllocator_.get(), &jobSystem_);
+            ++step_;
+        }
+        auto syncStart = Clock::now();
+        syncBodies();
+        auto syncEnd = Clock::now();
+
+        stats.stepMs += std::chrono::duration<double, std::milli>(syncStart - stepStart).count();
+        stats.syncMs += std::chrono::duration<double, std::milli>(syncEnd - syncStart).count();
+        accumulator_ -= settings_.fixedDt;
+        ++stats.steps;
+    }
+    // Не догоняем бесконечно после долгого кадра
+    if (stats.steps == settings_.maxStepsPerFrame) {
+        accumulator_ = std::min(accumulator_, settings_.fixedDt);
+    }
+
+    stats.alpha = accumulator_ / settings_.fixedDt;
+    stats.activeBodies = activeBodies_.size();
+    interpolate(stats.alpha);
+
+    lastStats_ = stats;
+    return stats;
+}
+
+void PhysicsWorld::step() {
+    onStep_.publish(settings_.fixedDt);
+    system_.Update(settings_.fixedDt, settings_.collisionSteps, tempAllocator_.get(), &jobSystem_);
+    ++step_;
+    syncBodies();
+}
+
+void PhysicsWorld::syncBodies() {
+    KALAN_PROFILE_ZONE("Physics sync");
+    // Между шагами симуляция не идёт — можно читать тела без блокировок
+    system_.GetActiveBodies(JPH::EBodyType::RigidBody, activeBodies_);
+    const JPH::BodyLockInterfaceNoLock& locks = system_.GetBodyLockInterfaceNoLock();
+
+    // Хранилище берём заранее: поиск пула в registry из воркеров небезопасен
+    auto& storage = registry_.storage<RigidBody>();
+    const uint64_t step = step_;
+
+    auto syncRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const JPH::Body* body = locks.TryGetBody(activeBodies_[i]);
+            if (!body) continue;
+            auto entity = static_cast<entt::entity>(body->GetUserData());
+            if (!storage.contains(entity)) continue;
+
+            RigidBody& rb = storage.get(entity);
+            rb.prevPosition = rb.currPosition;
+            rb.prevRotation = rb.currRotation;
+            rb.currPosition = toRaylib(JPH::Vec3(body->GetPosition()));
+            rb.currRotation = toRaylib(body->GetRotation());
+            rb.syncedStep = step;
+            rb.settled = false;
+        }
+    };
+
+    if (activeBodies_.size() >= settings_.syncParallelThreshold) {
+        pool_.parallelFor(activeBodies_.size(), 512, syncRange);
+    } else {
+        syncRange(0, activeBodies_.size());
+    }
+}
+
+void PhysicsWorld::interpolate(float alpha) {
+    for (auto [entity, rb] : registry_.view<RigidBody>().each()) {
+        if (rb.settled) continue;
+
+        Vector3 position;
+        Quaternion rotation;
+        if (rb.syncedStep != step_) {
+            // Тело уснуло: фиксируем последнее состояние один раз
+            rb.prevPosition = rb.currPosition;
+            rb.prevRotation = rb.currRotation;
+            rb.settled = true;
+            position = rb.currPosition;
+            rotation = rb.currRotation;
+        } else {
+            position = Vector3Lerp(rb.prevPosition, rb.currPosition, alpha);
+            rotation = QuaternionNlerp(rb.prevRotation, rb.currRotation, alpha);
+        }
+
+        if (!registry_.all_of<LocalTransform>(entity)) continue;
+        registry_.patch<LocalTransform>(entity, [&](LocalTransform& local) {
+            local.translation = position;
+            local.rotation = rotation;
+        });
+    }
+}
+
+} // namespace kalan
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/TempAllocator.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Collision/BroadPhase/BroadPhaseLayerInterfaceTable.h>
+#include <Jolt/Physics/Collision/BroadPhase/ObjectVsBroadPhaseLayerFilterTable.h>
+#include <Jolt/Physics/Collision/ObjectLayerPairFilterTable.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+
+#include "JoltRuntime.hpp"
+#include "PoolJobSystem.hpp"
+#include "../scene/Components.hpp"
+#include <entt/entt.hpp>
+#include <memory>
+
+namespace kalan {
+
+class ImageThreadPool;
+
+namespace physics_layers {
+    constexpr JPH::ObjectLayer NonMoving = 0;
+    constexpr JPH::ObjectLayer Moving = 1;
+    constexpr JPH::uint Count = 2;
+}
+
+inline JPH::Vec3 toJolt(Vector3 v) { return JPH::Vec3(v.x, v.y, v.z); }
+inline JPH::Quat toJolt(Quaternion q) { return JPH::Quat(q.x, q.y, q.z, q.w); }
+inline Vector3 toRaylib(JPH::Vec3Arg v) { return {v.GetX(), v.GetY(), v.GetZ()}; }
+inline Quaternion toRaylib(JPH::QuatArg q) { return {q.GetX(), q.GetY(), q.GetZ(), q.GetW()}; }
+
+// Связь сущности с телом Jolt. Тело задаёт LocalTransform сущности,
+// поэтому сущность с RigidBody должна быть корнем иерархии.
+struct RigidBody {
+    JPH::BodyID id;
+    Vector3 prevPosition{0.0f, 0.0f, 0.0f};     // состояние на предыдущем и текущем шаге
+    Vector3 currPosition{0.0f, 0.0f, 0.0f};
+    Quaternion prevRotation{0.0f, 0.0f, 0.0f, 1.0f};
+    Quaternion currRotation{0.0f, 0.0f, 0.0f, 1.0f};
+    uint64_t syncedStep = 0;                    // последний шаг, на котором тело было активно
+    bool settled = false;                       // LocalTransform уже равен curr*
+};
+
+// Jolt PhysicsSystem с фиксированным шагом и интерполяцией трансформов.
+// Задачи Jolt выполняются на общем пуле воркеров (PoolJobSystem), после каждого шага
+// состояние активных тел одним проходом переносится в компоненты RigidBody.
+class PhysicsWorld {
+public:
+    struct Settings {
+        float fixedDt = 1.0f / 60.0f;
+        int maxStepsPerFrame = 4;       // остаток сверх лимита отбрасывается
+        int collisionSteps = 1;
+        JPH::uint maxBodies = 65536;
+        JPH::uint maxBodyPairs = 65536;
+        JPH::uint maxContactConstraints = 16384;
+        size_t tempAllocatorBytes = 16 * 1024 * 1024;
+        size_t syncParallelThreshold = 2048;
+    };
+
+    struct Stats {
+        int steps = 0;
+        double stepMs = 0.0;            // суммарно за кадр
+        double syncMs = 0.0;
+        size_t activeBodies = 0;
+        float alpha = 0.0f;
+    };
+
+    PhysicsWorld(entt::registry& registry, ImageThreadPool& pool);
+    PhysicsWorld(entt::registry& registry, ImageThreadPool& pool, const Settings& settings);
+    ~PhysicsWorld();
+
+    PhysicsWorld(const PhysicsWorld&) = delete;
+    PhysicsWorld& operator=(const PhysicsWorld&) = delete;
+
+    // Создать тело для сущности и выставить её LocalTransform.
+    // Тело удаляется вместе с компонентом RigidBody (или сущностью).
+    JPH::BodyID addBody(entt::entity entity, const JPH::BodyCreationSettings& settings,
+                        JPH::EActivation activation = JPH::EActivation::Activate);
+
+    // После массового добавления тел
+    void optimizeBroadPhase();
+
+    // Вызывается перед каждым фиксированным шагом с его dt (контроллеры персонажей и т.п.)
+    [[nodiscard]] auto onStep() { return entt::sink{onStep_}; }
+
+    // Накопить dt, сделать нужное число фиксированных шагов и интерполировать трансформы
+    Stats update(float frameDt);
+    // Один фиксированный шаг и синхронизация RigidBody, без интерполяции
+    void step();
+    // Записать в LocalTransform состояние между предыдущим и текущим шагом
+    void interpolate(float alpha);
+
+    [[nodiscard]] JPH::PhysicsSystem& getSystem() noexcept { return system_; }
+    [[nodiscard]] JPH::BodyInterface& getBodyInterface() noexcept { return system_.GetBodyInterface(); }
+    [[nodiscard]] JPH::TempAllocator& getTempAllocator() noexcept { return *tempAllocator_; }
+    [[nodiscard]] const Settings& getSettings() const noexcept { return settings_; }
+    [[nodiscard]] const Stats& getLastStats() const noexcept { return lastStats_; }
+    [[nodiscard]] uint64_t getStepCount() const noexcept { return step_; }
+
+private:
+    void syncBodies();
+    void onRigidBodyDestroy(entt::registry& registry, entt::entity entity);
+
+    JoltRuntime jolt_;      // первым полем: регистрируется до остальных, снимается после них
+    entt::registry& registry_;
+    ImageThreadPool& pool_;
+    Settings settings_;
+
+    JPH::ObjectLayerPairFilterTable layerPairs_;
+    JPH::BroadPhaseLayerInterfaceTable broadPhaseLayers_;
+    JPH::ObjectVsBroadPhaseLayerFilterTable layerVsBroadPhase_;
+
+    std::unique_ptr<JPH::TempAllocatorImpl> tempAllocator_;
+    PoolJobSystem jobSystem_;
+    JPH::PhysicsSystem system_;
+
+    entt::sigh<void(float)> onStep_;
+    JPH::BodyIDVector activeBodies_;
+    float accumulator_ = 0.0f;
+    uint64_t step_ = 0;
+    Stats lastStats_;
+};
+
+} // namespace kalan
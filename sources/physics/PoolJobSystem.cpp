@@ -0,0 +1,56 @@
+#include "PoolJobSystem.hpp"
+#include "../resources/ParallelLoader.hpp"
+#include <chrono>
+#include <thread>
+
+namespace kalan {
+
+PoolJobSystem::PoolJobSystem(ImageThreadPool& pool, JPH::uint maxJobs, JPH::uint maxBarriers)
+    : JPH::JobSystemWithBarrier(maxBarriers), pool_(pool)
+{
+    jobs_.Init(maxJobs, maxJobs);
+}
+
+int PoolJobSystem::GetMaxConcurrency() const {
+    // Воркеры пула, берущие Critical, + поток, ожидающий барьер
+    return static_cast<int>(pool_.getCriticalThreadCount()) + 1;
+}
+
+PoolJobSystem::JobHandle PoolJobSystem::CreateJob(const char* inName, JPH::ColorArg inColor,
+                                                  const JobFunction& inJobFunction,
+                                                  JPH::uint32 inNumDependencies) {
+    JPH::uint32 index;
+    for (;;) {
+        index = jobs_.ConstructObject(inName, inColor, this, inJobFunction, inNumDependencies);
+        if (index != AvailableJobs::cInvalidObjectIndex) break;
+        // Все слоты заняты — ждём, пока воркеры освободят задачи
+        TraceLog(LOG_WARNING, "PoolJobSystem: out of jobs (%s), waiting", inName);
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    Job* job = &jobs_.Get(index);
+
+    // Handle держит ссылку: задача может выполниться сразу после постановки в очередь
+    JobHandle handle(job);
+    if (inNumDependencies == 0) QueueJob(job);
+    return handle;
+}
+
+void PoolJobSystem::QueueJob(Job* inJob) {
+    inJob->AddRef();
+    // Шаг физики ждёт свои задачи — они впереди загрузки ассетов
+    pool_.post([inJob]() {
+        // Execute сам проверяет, не забрал ли задачу поток барьера
+        inJob->Execute();
+        inJob->Release();
+    }, JobPriority::Critical);
+}
+
+void PoolJobSystem::QueueJobs(Job** inJobs, JPH::uint inNumJobs) {
+    for (JPH::uint i = 0; i < inNumJobs; ++i) QueueJob(inJobs[i]);
+}
+
+void PoolJobSystem::FreeJob(Job* inJob) {
+    jobs_.DestructObject(inJob);
+}
+
+} // namespace kalan
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+
+namespace kalan {
+
+class ImageThreadPool;
+
+// JobSystem Jolt поверх общего пула воркеров движка — второй пул потоков не создаётся.
+// Поток, ждущий барьер (обычно главный), сам выполняет готовые задачи барьера,
+// поэтому шаг не встаёт, даже если воркеры заняты декодированием текстур.
+class PoolJobSystem final : public JPH::JobSystemWithBarrier {
+public:
+    explicit PoolJobSystem(ImageThreadPool& pool, JPH::uint maxJobs = 2048, JPH::uint maxBarriers = 8);
+    ~PoolJobSystem() override = default;
+
+    PoolJobSystem(const PoolJobSystem&) = delete;
+    PoolJobSystem& operator=(const PoolJobSystem&) = delete;
+
+    int GetMaxConcurrency() const override;
+    JobHandle CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction,
+                        JPH::uint32 inNumDependencies = 0) override;
+
+protected:
+    void QueueJob(Job* inJob) override;
+    void QueueJobs(Job** inJobs, JPH::uint inNumJobs) override;
+    void FreeJob(Job* inJob) override;
+
+private:
+    using AvailableJobs = JPH::FixedSizeFreeList<Job>;
+
+    ImageThreadPool& pool_;
+    AvailableJobs jobs_;
+};
+
+} // namespace kalan
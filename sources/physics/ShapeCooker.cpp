@@ -0,0 +1,174 @@
+#include "ShapeCooker.hpp"
+#include <Jolt/Core/StreamWrapper.h>
+#include <Jolt/Physics/Collision/Shape/ConvexHullShape.h>
+#include <Jolt/Physics/Collision/Shape/MeshShape.h>
+#include <cstdio>
+#include <fstream>
+
+namespace kalan {
+
+namespace {
+
+constexpr uint32_t CacheMagic = 0x4B534850;     // "KSHP"
+// Увеличивать при изменении построения форм или формата файла
+constexpr uint32_t CacheVersion = 1;
+
+constexpr uint64_t FnvOffset = 1469598103934665603ull;
+constexpr uint64_t FnvPrime = 1099511628211ull;
+
+uint64_t fnv1a(uint64_t hash, const unsigned char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= FnvPrime;
+    }
+    return hash;
+}
+
+uint32_t vertexIndex(const Mesh& mesh, int i) {
+    return mesh.indices ? mesh.indices[i] : static_cast<uint32_t>(i);
+}
+
+} // anonymous namespace
+
+// ============ Построение ============
+
+JPH::RefConst<JPH::Shape> cookMeshShape(const Mesh& mesh, CollisionShapeType type) {
+    if (!mesh.vertices || mesh.vertexCount == 0 || type == CollisionShapeType::None) return nullptr;
+
+    JPH::Shape::ShapeResult result;
+    if (type == CollisionShapeType::TriangleMesh) {
+        JPH::VertexList vertices;
+        vertices.reserve(mesh.vertexCount);
+        for (int i = 0; i < mesh.vertexCount; ++i) {
+            vertices.push_back(JPH::Float3(mesh.vertices[i * 3 + 0], mesh.vertices[i * 3 + 1], mesh.vertices[i * 3 + 2]));
+        }
+        JPH::IndexedTriangleList triangles;
+        triangles.reserve(mesh.triangleCount);
+        for (int t = 0; t < mesh.triangleCount; ++t) {
+            triangles.push_back(JPH::IndexedTriangle(vertexIndex(mesh, t * 3 + 0), vertexIndex(mesh, t * 3 + 1),
+                                                     vertexIndex(mesh, t * 3 + 2), 0));
+        }
+        JPH::MeshShapeSettings settings(std::move(vertices), std::move(triangles));
+        result = settings.Create();
+    } else {
+        JPH::Array<JPH::Vec3> points;
+        points.reserve(mesh.vertexCount);
+        for (int i = 0; i < mesh.vertexCount; ++i) {
+            points.push_back(JPH::Vec3(mesh.vertices[i * 3 + 0], mesh.vertices[i * 3 + 1], mesh.vertices[i * 3 + 2]));
+        }
+        JPH::ConvexHullShapeSettings settings(points);
+        result = settings.Create();
+    }
+
+    if (result.HasError()) {
+        TraceLog(LOG_WARNING, "ShapeCooker: %s", result.GetError().c_str());
+        return nullptr;
+    }
+    return result.Get();
+}
+
+// ============ Кэш ============
+
+uint64_t hashFileContents(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return 0;
+
+    uint64_t hash = FnvOffset;
+    std::vector<char> buffer(1 << 16);
+    while (file) {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        hash = fnv1a(hash, reinterpret_cast<const unsigned char*>(buffer.data()),
+                     static_cast<size_t>(file.gcount()));
+    }
+    return hash;
+}
+
+fs::path shapeCachePath(const fs::path& cacheDir, uint64_t assetHash,
+                        CollisionShapeType type, unsigned int importFlags) {
+    const unsigned char variant[] = {
+        static_cast<unsigned char>(type),
+        static_cast<unsigned char>(importFlags),
+        static_cast<unsigned char>(importFlags >> 8),
+        static_cast<unsigned char>(importFlags >> 16),
+        static_cast<unsigned char>(importFlags >> 24),
+        static_cast<unsigned char>(CacheVersion),
+    };
+    uint64_t key = fnv1a(assetHash, variant, sizeof(variant));
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.jshape", static_cast<unsigned long long>(key));
+    return cacheDir / name;
+}
+
+bool saveShapeCache(const fs::path& file, const CookedShapes& shapes) {
+    std::error_code ec;
+    fs::create_directories(file.parent_path(), ec);
+
+    fs::path temp = file;
+    temp += ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            TraceLog(LOG_WARNING, "ShapeCooker: cannot write %s", temp.string().c_str());
+            return false;
+        }
+        JPH::StreamOutWrapper stream(out);
+        stream.Write(CacheMagic);
+        stream.Write(CacheVersion);
+        stream.Write(static_cast<uint32_t>(shapes.type));
+        stream.Write(static_cast<uint32_t>(shapes.meshes.size()));
+
+        JPH::Shape::ShapeToIDMap shapeMap;
+        JPH::Shape::MaterialToIDMap materialMap;
+        for (const auto& shape : shapes.meshes) {
+            stream.Write(shape != nullptr);
+            if (shape) shape->SaveWithChildren(stream, shapeMap, materialMap);
+        }
+        if (stream.IsFailed()) {
+            out.close();
+            fs::remove(temp, ec);
+            return false;
+        }
+    }
+    fs::rename(temp, file, ec);
+    return !ec;
+}
+
+bool loadShapeCache(const fs::path& file, int meshCount, CookedShapes& shapes) {
+    std::ifstream in(file, std::ios::binary);
+    if (!in) return false;
+
+    JPH::StreamInWrapper stream(in);
+    uint32_t magic = 0, version = 0, type = 0, count = 0;
+    stream.Read(magic);
+    stream.Read(version);
+    stream.Read(type);
+    stream.Read(count);
+    if (stream.IsFailed() || magic != CacheMagic || version != CacheVersion ||
+        count != static_cast<uint32_t>(meshCount)) {
+        return false;
+    }
+
+    JPH::Shape::IDToShapeMap shapeMap;
+    JPH::Shape::IDToMaterialMap materialMap;
+    std::vector<JPH::RefConst<JPH::Shape>> restored(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        bool present = false;
+        stream.Read(present);
+        if (stream.IsFailed()) return false;
+        if (!present) continue;
+
+        JPH::Shape::ShapeResult result = JPH::Shape::sRestoreWithChildren(stream, shapeMap, materialMap);
+        if (result.HasError()) {
+            TraceLog(LOG_WARNING, "ShapeCooker: %s is corrupt: %s", file.string().c_str(), result.GetError().c_str());
+            return false;
+        }
+        restored[i] = result.Get();
+    }
+
+    shapes.type = static_cast<CollisionShapeType>(type);
+    shapes.meshes = std::move(restored);
+    return true;
+}
+
+} // namespace kalan
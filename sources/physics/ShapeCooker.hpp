@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+
+#include "raylib.h"
+#include "../resources/ParallelLoader.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace kalan {
+
+// Коллизионные формы модели по индексу меша (nullptr — меш без формы)
+struct CookedShapes {
+    CollisionShapeType type = CollisionShapeType::None;
+    std::vector<JPH::RefConst<JPH::Shape>> meshes;
+};
+
+// Построить форму по CPU данным меша. Потокобезопасно; нужен живой JoltRuntime.
+[[nodiscard]] JPH::RefConst<JPH::Shape> cookMeshShape(const Mesh& mesh, CollisionShapeType type);
+
+// Хэш содержимого файла (FNV-1a 64)
+[[nodiscard]] uint64_t hashFileContents(const fs::path& path);
+
+// Файл кэша: хэш ассета + всё, что влияет на геометрию форм. importFlags — флаги
+// постобработки Assimp (ImportReport::importFlags): сварка вершин, слияние мешей и
+// запекание иерархии меняют меши, по которым строятся формы.
+[[nodiscard]] fs::path shapeCachePath(const fs::path& cacheDir, uint64_t assetHash,
+                                      CollisionShapeType type, unsigned int importFlags);
+
+// Бинарное сохранение Jolt (SaveWithChildren); общие подформы пишутся один раз.
+// Запись через временный файл, чтобы прерванный процесс не оставил битый кэш.
+bool saveShapeCache(const fs::path& file, const CookedShapes& shapes);
+// false, если файла нет, он от другой версии или число мешей не совпадает
+bool loadShapeCache(const fs::path& file, int meshCount, CookedShapes& shapes);
+
+} // namespace kalan
@@ -0,0 +1,363 @@
+#include "DrawList.hpp"
+#include "PBRMaterial.hpp"
+#include "../resources/VertexQuantization.hpp"
+#include "../core/FrameArena.hpp"
+#include "../core/Profiler.hpp"
+#include "raymath.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+
+namespace kalan {
+
+namespace {
+
+bool IsCubemapSlot(int slot) {
+    return slot == MATERIAL_MAP_IRRADIANCE || slot == MATERIAL_MAP_PREFILTER || slot == MATERIAL_MAP_CUBEMAP;
+}
+
+uint32_t PackColor(Color c) {
+    return (static_cast<uint32_t>(c.r) << 24) | (static_cast<uint32_t>(c.g) << 16) |
+           (static_cast<uint32_t>(c.b) << 8) | c.a;
+}
+
+Color Modulate(Color c, Color tint) {
+    return {
+        static_cast<unsigned char>(c.r * tint.r / 255),
+        static_cast<unsigned char>(c.g * tint.g / 255),
+        static_cast<unsigned char>(c.b * tint.b / 255),
+        static_cast<unsigned char>(c.a * tint.a / 255)
+    };
+}
+
+// Текстуры всех слотов материала — ключ набора текстур
+using TextureSet = std::array<unsigned int, MAX_MATERIAL_MAPS>;
+
+// Uniform'ы материала: diffuse * tint | specular и флаг ORM
+struct MaterialParams {
+    uint64_t colors;
+    uint64_t ormPacked;
+};
+
+uint64_t HashKey(uint64_t key) {
+    // splitmix64 finalizer
+    key ^= key >> 30; key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27; key *= 0x94d049bb133111ebull;
+    return key ^ (key >> 31);
+}
+
+uint64_t HashKey(const MaterialParams& params) {
+    return HashKey(params.colors) ^ params.ormPacked;
+}
+
+uint64_t HashKey(const TextureSet& set) {
+    // FNV-1a по id текстур
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned int id : set) {
+        hash ^= id;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Открытая адресация с линейным пробированием поверх арены кадра.
+// Ёмкость фиксирована: не меньше удвоенного числа ключей, поэтому таблица не переполняется.
+template <typename Key>
+class InternTable {
+public:
+    InternTable(FrameArena& arena, size_t maxKeys) {
+        capacity_ = std::bit_ceil(std::max<size_t>(16, maxKeys * 2));
+        keys_ = arena.allocateArray<Key>(capacity_);
+        ids_ = arena.allocateArray<uint32_t>(capacity_);
+        std::fill_n(ids_, capacity_, UINT32_MAX);
+    }
+
+    uint32_t intern(const Key& key) {
+        size_t mask = capacity_ - 1;
+        for (size_t i = HashKey(key) & mask;; i = (i + 1) & mask) {
+            if (ids_[i] == UINT32_MAX) {
+                keys_[i] = key;
+                ids_[i] = size_;
+                return size_++;
+            }
+            if (std::memcmp(&keys_[i], &key, sizeof(Key)) == 0) return ids_[i];
+        }
+    }
+
+    [[nodiscard]] uint32_t size() const noexcept { return size_; }
+
+private:
+    Key* keys_ = nullptr;
+    uint32_t* ids_ = nullptr;
+    size_t capacity_ = 0;
+    uint32_t size_ = 0;
+};
+
+// Состояние GL, выставленное во время flush
+struct BindCache {
+    unsigned int shader = 0;
+    int ormLocation = -1;           // uniform ormPacked текущего шейдера
+    uint32_t materialId = UINT32_MAX;
+    std::array<unsigned int, MAX_MATERIAL_MAPS> textures{};
+
+    void invalidate() {
+        shader = 0;
+        ormLocation = -1;
+        materialId = UINT32_MAX;
+        textures.fill(0);
+    }
+};
+
+} // anonymous namespace
+
+// ============ Radix sort ============
+
+void radixSortDrawEntries(std::vector<DrawSortEntry>& entries, std::vector<DrawSortEntry>& scratch) {
+    const size_t count = entries.size();
+    if (count < 2) return;
+
+    // Все 8 гистограмм за один проход
+    size_t histograms[8][256] = {};
+    for (const auto& e : entries) {
+        for (int pass = 0; pass < 8; ++pass) {
+            ++histograms[pass][(e.key >> (pass * 8)) & 0xFF];
+        }
+    }
+
+    scratch.resize(count);
+    for (int pass = 0; pass < 8; ++pass) {
+        size_t* histogram = histograms[pass];
+        const int shift = pass * 8;
+
+        // Все ключи имеют одинаковый байт — проход ничего не меняет
+        if (histogram[(entries[0].key >> shift) & 0xFF] == count) continue;
+
+        size_t offset = 0;
+        for (int b = 0; b < 256; ++b) {
+            size_t c = histogram[b];
+            histogram[b] = offset;
+            offset += c;
+        }
+        for (const auto& e : entries) {
+            scratch[histogram[(e.key >> shift) & 0xFF]++] = e;
+        }
+        entries.swap(scratch);
+    }
+}
+
+// ============ DrawList ============
+
+void DrawList::begin() {
+    items_.clear();
+    entries_.clear();
+}
+
+void DrawList::submit(const Mesh& mesh, const Material& material, const Matrix& transform,
+                      Color tint, const PackedMeshInfo* packed, const Matrix* bones, int boneCount) {
+    items_.push_back({&mesh, &material, transform, tint, packed, bones, boneCount, 0, 0});
+}
+
+void DrawList::submitModel(const raylib::Model& model, const Matrix& transform,
+                           Color tint, const PackedModelInfo* packed, const Matrix* bones, int boneCount) {
+    Matrix world = MatrixMultiply(model.transform, transform);
+    for (int m = 0; m < model.meshCount; ++m) {
+        submit(model.meshes[m], model.materials[model.meshMaterial[m]], world, tint,
+               packed ? &packed->meshes[m] : nullptr, bones, boneCount);
+    }
+}
+
+uint32_t DrawList::buildSortKeys() {
+    FrameArena& arena = FrameArena::local();
+    InternTable<unsigned int> shaders(arena, items_.size());
+    InternTable<TextureSet> textureSets(arena, items_.size());
+    InternTable<MaterialParams> materials(arena, items_.size());
+
+    entries_.resize(items_.size());
+    for (size_t i = 0; i < items_.size(); ++i) {
+        Item& item = items_[i];
+        const Material& material = *item.material;
+
+        TextureSet set;
+        for (int m = 0; m < MAX_MATERIAL_MAPS; ++m) set[m] = material.maps[m].texture.id;
+
+        // DrawMesh грузит из материала только colDiffuse и colSpecular, ormPacked добавляет PBR
+        Color diffuse = Modulate(material.maps[MATERIAL_MAP_DIFFUSE].color, item.tint);
+        MaterialParams params{(static_cast<uint64_t>(PackColor(diffuse)) << 32) |
+                                  PackColor(material.maps[MATERIAL_MAP_SPECULAR].color),
+                              PBRMaterial::isOrmPacked(material) ? 1u : 0u};
+
+        item.shaderId = shaders.intern(material.shader.id);
+        item.materialId = materials.intern(params);
+        entries_[i] = {drawkey::make(item.shaderId, textureSets.intern(set), item.materialId),
+                       static_cast<uint32_t>(i)};
+    }
+    return shaders.size();
+}
+
+DrawList::Stats DrawList::flush() {
+    KALAN_PROFILE_ZONE("DrawList::flush");
+    Stats stats;
+
+    auto sortStart = std::chrono::steady_clock::now();
+    uint32_t shaderCount = buildSortKeys();
+    radixSortDrawEntries(entries_, scratch_);
+    stats.sortMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sortStart).count();
+
+    // Как в DrawMesh: view/projection берутся из текущего состояния rlgl
+    Matrix matView = rlGetMatrixModelview();
+    Matrix matProjection = rlGetMatrixProjection();
+    Matrix matTransform = rlGetMatrixTransform();
+    const bool stereo = rlIsStereoRenderEnabled();
+
+    BindCache cache;
+    // Шейдеры, у которых уже заданы слоты сэмплеров (по ID кадра)
+    uint8_t* samplersBound = FrameArena::local().allocateArray<uint8_t>(std::max<uint32_t>(1, shaderCount));
+    std::fill_n(samplersBound, shaderCount, uint8_t{0});
+    int baselineTextureBinds = 0;
+    int baselineUniforms = 0;
+
+    for (const auto& entry : entries_) {
+        const Item& item = items_[entry.index];
+        const Mesh& mesh = *item.mesh;
+        const Material& material = *item.material;
+        const Shader& shader = material.shader;
+
+        // Без VAO и в стерео рисуем штатным путём; он сам сбрасывает состояние
+        if (stereo || mesh.vaoId == 0) {
+            Material tinted = material;
+            tinted.maps[MATERIAL_MAP_DIFFUSE].color = Modulate(material.maps[MATERIAL_MAP_DIFFUSE].color, item.tint);
+            if (item.packed) setPackedMeshUniforms(shader, *item.packed);
+            PBRMaterial::applyOrmUniform(material);
+            if (item.bones && shader.locs[SHADER_LOC_BONE_MATRICES] != -1) {
+                // Uniform'ы — состояние программы, DrawMesh их не сбросит
+                rlEnableShader(shader.id);
+                rlSetUniformMatrices(shader.locs[SHADER_LOC_BONE_MATRICES], item.bones, item.boneCount);
+            }
+            DrawMesh(mesh, tinted, item.transform);
+            cache.invalidate();
+            ++stats.shaderBinds;
+            ++stats.draws;
+            stats.triangles += mesh.triangleCount;
+            continue;
+        }
+
+        if (cache.shader != shader.id) {
+            rlEnableShader(shader.id);
+            cache.shader = shader.id;
+            cache.ormLocation = PBRMaterial::getOrmLocation(shader);
+            cache.materialId = UINT32_MAX;
+            ++stats.shaderBinds;
+
+            // Номера слотов сэмплеров — состояние программы, задаём один раз
+            if (!samplersBound[item.shaderId]) {
+                for (int i = 0; i < MAX_MATERIAL_MAPS; ++i) {
+                    int loc = shader.locs[SHADER_LOC_MAP_DIFFUSE + i];
+                    if (loc < 0) continue;
+                    rlSetUniform(loc, &i, SHADER_UNIFORM_INT, 1);
+                    ++stats.uniformUploads;
+                }
+                samplersBound[item.shaderId] = 1;
+            }
+        }
+
+        if (cache.materialId != item.materialId) {
+            cache.materialId = item.materialId;
+            if (shader.locs[SHADER_LOC_COLOR_DIFFUSE] != -1) {
+                Color c = Modulate(material.maps[MATERIAL_MAP_DIFFUSE].color, item.tint);
+                float values[4] = { c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, c.a / 255.0f };
+                rlSetUniform(shader.locs[SHADER_LOC_COLOR_DIFFUSE], values, SHADER_UNIFORM_VEC4, 1);
+                ++stats.uniformUploads;
+            }
+            if (shader.locs[SHADER_LOC_COLOR_SPECULAR] != -1) {
+                Color c = material.maps[MATERIAL_MAP_SPECULAR].color;
+                float values[4] = { c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, c.a / 255.0f };
+                rlSetUniform(shader.locs[SHADER_LOC_COLOR_SPECULAR], values, SHADER_UNIFORM_VEC4, 1);
+                ++stats.uniformUploads;
+            }
+            if (cache.ormLocation != -1) {
+                int packed = PBRMaterial::isOrmPacked(material) ? 1 : 0;
+                rlSetUniform(cache.ormLocation, &packed, SHADER_UNIFORM_INT, 1);
+                ++stats.uniformUploads;
+            }
+        }
+
+        for (int i = 0; i < MAX_MATERIAL_MAPS; ++i) {
+            unsigned int id = material.maps[i].texture.id;
+            if (id > 0) {
+                ++baselineTextureBinds;
+                ++baselineUniforms;
+            }
+            if (cache.textures[i] == id) continue;
+
+            // Пустой слот тоже отвязываем — иначе шейдер увидит текстуру предыдущего материала
+            rlActiveTextureSlot(i);
+            if (IsCubemapSlot(i)) {
+                if (id > 0) rlEnableTextureCubemap(id); else rlDisableTextureCubemap();
+            } else {
+                if (id > 0) rlEnableTexture(id); else rlDisableTexture();
+            }
+            cache.textures[i] = id;
+            ++stats.textureBinds;
+        }
+
+        if (shader.locs[SHADER_LOC_COLOR_DIFFUSE] != -1) ++baselineUniforms;
+        if (shader.locs[SHADER_LOC_COLOR_SPECULAR] != -1) ++baselineUniforms;
+        if (cache.ormLocation != -1) ++baselineUniforms;
+
+        if (item.packed) {
+            setPackedMeshUniforms(shader, *item.packed);
+            stats.uniformUploads += 4;
+            baselineUniforms += 4;
+        }
+
+        if (item.bones && shader.locs[SHADER_LOC_BONE_MATRICES] != -1) {
+            rlSetUniformMatrices(shader.locs[SHADER_LOC_BONE_MATRICES], item.bones, item.boneCount);
+            ++stats.uniformUploads;
+            ++baselineUniforms;
+        }
+
+        // Матрицы — на каждый draw, как в DrawMesh
+        Matrix matModel = MatrixMultiply(item.transform, matTransform);
+        Matrix matModelView = MatrixMultiply(matModel, matView);
+        if (shader.locs[SHADER_LOC_MATRIX_VIEW] != -1) rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_VIEW], matView);
+        if (shader.locs[SHADER_LOC_MATRIX_PROJECTION] != -1) rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_PROJECTION], matProjection);
+        if (shader.locs[SHADER_LOC_MATRIX_MODEL] != -1) rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_MODEL], matModel);
+        if (shader.locs[SHADER_LOC_MATRIX_NORMAL] != -1) {
+            rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_NORMAL], MatrixTranspose(MatrixInvert(matModel)));
+        }
+        rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_MVP], MatrixMultiply(matModelView, matProjection));
+
+        rlEnableVertexArray(mesh.vaoId);
+        if (mesh.indices != nullptr) rlDrawVertexArrayElements(0, mesh.triangleCount * 3, 0);
+        else rlDrawVertexArray(0, mesh.vertexCount);
+
+        ++stats.draws;
+        stats.triangles += mesh.triangleCount;
+    }
+
+    // Вернуть rlgl в состояние, которое оставил бы DrawMesh
+    for (int i = 0; i < MAX_MATERIAL_MAPS; ++i) {
+        if (cache.textures[i] == 0) continue;
+        rlActiveTextureSlot(i);
+        if (IsCubemapSlot(i)) rlDisableTextureCubemap(); else rlDisableTexture();
+    }
+    rlActiveTextureSlot(0);
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+    rlDisableVertexBufferElement();
+    rlDisableShader();
+    rlSetMatrixModelview(matView);
+    rlSetMatrixProjection(matProjection);
+
+    // Сэкономлено относительно DrawMesh, который привязывает всё заново на каждый draw
+    stats.shaderBindsSaved = stats.draws - stats.shaderBinds;
+    stats.textureBindsSaved = std::max(0, baselineTextureBinds - stats.textureBinds);
+    stats.uniformUploadsSaved = std::max(0, baselineUniforms - stats.uniformUploads);
+
+    lastStats_ = stats;
+    return stats;
+}
+
+} // namespace kalan
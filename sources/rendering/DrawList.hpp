@@ -0,0 +1,99 @@
+#pragma once
+
+#include "raylib-cpp.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace kalan {
+
+struct PackedMeshInfo;
+struct PackedModelInfo;
+
+// Ключ сортировки отрисовки (старшие биты — самое дорогое переключение):
+//   [63..48] шейдер, [47..24] набор текстур, [23..0] параметры материала
+// ID выдаются DrawList заново каждый кадр, поэтому 16/24 бит хватает с запасом.
+namespace drawkey {
+    constexpr int ShaderBits = 16;
+    constexpr int TextureSetBits = 24;
+    constexpr int MaterialBits = 24;
+
+    constexpr uint64_t make(uint32_t shader, uint32_t textureSet, uint32_t material) {
+        return (static_cast<uint64_t>(shader) << (TextureSetBits + MaterialBits)) |
+               (static_cast<uint64_t>(textureSet & ((1u << TextureSetBits) - 1)) << MaterialBits) |
+               static_cast<uint64_t>(material & ((1u << MaterialBits) - 1));
+    }
+}
+
+struct DrawSortEntry {
+    uint64_t key;
+    uint32_t index;
+};
+
+// LSD radix sort по 8 бит; проходы, где у всех ключей одинаковый байт, пропускаются.
+// Стабильная: при равных ключах сохраняется порядок отправки.
+void radixSortDrawEntries(std::vector<DrawSortEntry>& entries, std::vector<DrawSortEntry>& scratch);
+
+// Список отрисовки кадра: меши собираются, сортируются по ключу и рисуются
+// через rlgl с кэшем привязок — повторные bind шейдера, текстур и uniform'ов
+// материала пропускаются. Матрицы считаются так же, как в DrawMesh.
+class DrawList {
+public:
+    struct Stats {
+        int draws = 0;
+        int64_t triangles = 0;
+        int shaderBinds = 0;
+        int shaderBindsSaved = 0;
+        int textureBinds = 0;
+        int textureBindsSaved = 0;
+        int uniformUploads = 0;
+        int uniformUploadsSaved = 0;
+        double sortMs = 0.0;
+    };
+
+    // Начать новый кадр (ёмкость буферов сохраняется между кадрами)
+    void begin();
+
+    // Меш и материал должны жить до flush(). Ключи сортировки считаются в flush().
+    // bones — палитра скиннинга (Animator::skinning) для шейдера с SHADER_LOC_BONE_MATRICES,
+    // тоже живёт до flush()
+    void submit(const Mesh& mesh, const Material& material, const Matrix& transform,
+                Color tint = WHITE, const PackedMeshInfo* packed = nullptr,
+                const Matrix* bones = nullptr, int boneCount = 0);
+    // Все меши модели, с учётом model.transform (как DrawModelEx)
+    void submitModel(const raylib::Model& model, const Matrix& transform,
+                     Color tint = WHITE, const PackedModelInfo* packed = nullptr,
+                     const Matrix* bones = nullptr, int boneCount = 0);
+
+    // Вызывать внутри BeginMode3D после LightingSystem::update
+    Stats flush();
+
+    [[nodiscard]] size_t size() const noexcept { return items_.size(); }
+    [[nodiscard]] const Stats& getLastStats() const noexcept { return lastStats_; }
+
+private:
+    struct Item {
+        const Mesh* mesh;
+        const Material* material;
+        Matrix transform;
+        Color tint;
+        const PackedMeshInfo* packed;
+        const Matrix* bones;
+        int boneCount;
+        uint32_t shaderId;          // ID кадра, выдаются в flush()
+        uint32_t materialId;
+    };
+
+    // Выдать ID кадра и построить entries_. Таблицы интернирования живут
+    // в FrameArena::local(), поэтому в установившемся режиме flush не аллоцирует.
+    // Возвращает число разных шейдеров.
+    uint32_t buildSortKeys();
+
+    std::vector<Item> items_;
+    std::vector<DrawSortEntry> entries_;
+    std::vector<DrawSortEntry> scratch_;
+
+    Stats lastStats_;
+};
+
+} // namespace kalan
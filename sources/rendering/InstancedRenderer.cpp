@@ -0,0 +1,97 @@
+#include "InstancedRenderer.hpp"
+#include "PBRMaterial.hpp"
+#include "../resources/ParallelLoader.hpp"
+#include "raymath.h"
+
+namespace kalan {
+
+// Меньше этого числа инстансов матрицы перемножаются в одном потоке
+static constexpr size_t ParallelBuildThreshold = 4096;
+static constexpr size_t ParallelBuildChunk = 1024;
+
+// ============ InstanceBatcher ============
+
+void InstanceBatcher::begin() {
+    submissions_.clear();
+    batches_.clear();
+    ++generation_;
+}
+
+void InstanceBatcher::submit(const Mesh& mesh, const Material& material, const Matrix& transform,
+                             const Matrix* base) {
+    BatchSlot& slot = batchIndex_[BatchKey{&mesh, &material}];
+    if (slot.generation != generation_) {
+        slot = {batches_.size(), generation_};
+        batches_.push_back({&mesh, &material, 0, 0});
+    }
+    ++batches_[slot.batch].count;
+    submissions_.push_back({base, transform, slot.batch});
+}
+
+void InstanceBatcher::build(ImageThreadPool* pool) {
+    // Префиксная сумма: где начинается каждый батч
+    size_t offset = 0;
+    for (auto& batch : batches_) {
+        batch.first = offset;
+        offset += batch.count;
+    }
+
+    // Последовательно раздаём слоты, чтобы параллельная часть писала без синхронизации
+    cursors_.resize(batches_.size());
+    for (size_t b = 0; b < batches_.size(); ++b) cursors_[b] = batches_[b].first;
+    
+    slots_.resize(submissions_.size());
+    for (size_t i = 0; i < submissions_.size(); ++i) {
+        slots_[i] = cursors_[submissions_[i].batch]++;
+    }
+
+    transforms_.resize(submissions_.size());
+
+    auto buildRange = [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Submission& s = submissions_[i];
+            // Как в DrawModelEx: сначала собственный transform модели, затем инстанс
+            transforms_[slots_[i]] = s.base ? MatrixMultiply(*s.base, s.transform) : s.transform;
+        }
+    };
+
+    if (pool && submissions_.size() >= ParallelBuildThreshold) {
+        pool->parallelFor(submissions_.size(), ParallelBuildChunk, buildRange);
+    } else {
+        buildRange(0, submissions_.size());
+    }
+}
+
+// ============ InstancedRenderer ============
+
+InstancedRenderer::Stats InstancedRenderer::draw(const InstanceBatcher& batcher, size_t minInstances) {
+    Stats stats;
+    bool instancing = PBRMaterial::isShaderLoaded(PBRShaderVariant::Instanced);
+
+    for (const auto& batch : batcher.getBatches()) {
+        if (batch.count < minInstances) continue;
+        const Mesh& mesh = *batch.mesh;
+        const Matrix* transforms = batcher.getTransforms(batch);
+        Material material = *batch.material;
+
+        if (instancing && batch.count > 1) {
+            material.shader = PBRMaterial::getShader(PBRShaderVariant::Instanced);
+            PBRMaterial::applyOrmUniform(material);
+            DrawMeshInstanced(mesh, material, transforms, static_cast<int>(batch.count));
+            ++stats.drawCalls;
+        } else {
+            // Одиночные инстансы и fallback без инстансного шейдера
+            PBRMaterial::applyOrmUniform(material);
+            for (size_t i = 0; i < batch.count; ++i) {
+                DrawMesh(mesh, material, transforms[i]);
+            }
+            stats.drawCalls += static_cast<int>(batch.count);
+        }
+        stats.triangles += mesh.triangleCount * static_cast<int>(batch.count);
+        stats.instances += static_cast<int>(batch.count);
+    }
+
+    return stats;
+}
+
+} // namespace kalan
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "raylib-cpp.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace kalan {
+
+class ImageThreadPool;
+
+// Группа инстансов одного меша с одним материалом. Уровни LOD — разные Mesh
+// (ModelLods::getMesh), поэтому инстансы разных уровней тоже в разных батчах
+struct InstanceBatch {
+    const Mesh* mesh = nullptr;
+    const Material* material = nullptr;
+    size_t first = 0;   // смещение в общем массиве трансформов
+    size_t count = 0;
+};
+
+// CPU-часть инстансинга: собирает отправленные за кадр меши в батчи
+// и строит массивы мировых матриц. Не трогает GPU, поэтому работает headless.
+class InstanceBatcher {
+public:
+    // Начать новый кадр (ёмкость буферов сохраняется между кадрами)
+    void begin();
+
+    // Меш, материал и base должны жить как минимум до конца кадра. base — собственный
+    // transform модели (Model::transform): как в DrawModelEx, он применяется до transform
+    // и перемножается в build. Батч определяется адресами меша и материала, так что узлы
+    // одной модели, заспавненные отдельными сущностями, собираются вместе.
+    void submit(const Mesh& mesh, const Material& material, const Matrix& transform,
+                const Matrix* base = nullptr);
+
+    // Построить батчи; при наличии пула перемножение матриц идёт параллельно
+    void build(ImageThreadPool* pool = nullptr);
+
+    [[nodiscard]] const std::vector<InstanceBatch>& getBatches() const noexcept { return batches_; }
+    [[nodiscard]] const Matrix* getTransforms(const InstanceBatch& batch) const noexcept {
+        return transforms_.data() + batch.first;
+    }
+    [[nodiscard]] size_t getInstanceCount() const noexcept { return submissions_.size(); }
+
+private:
+    struct Submission {
+        const Matrix* base;
+        Matrix transform;
+        size_t batch;
+    };
+
+    std::vector<Submission> submissions_;
+    std::vector<size_t> slots_;          // итоговая позиция каждой заявки в transforms_
+    std::vector<size_t> cursors_;
+    std::vector<Matrix> transforms_;     // мировые матрицы, сгруппированные по батчам
+    std::vector<InstanceBatch> batches_;
+
+    // (меш, материал) -> батч текущего кадра. Не очищается между кадрами (узлы не
+    // переаллоцируются): запись прошлого кадра узнаётся по generation.
+    struct BatchKey {
+        const Mesh* mesh;
+        const Material* material;
+        bool operator==(const BatchKey&) const = default;
+    };
+    struct BatchKeyHash {
+        size_t operator()(const BatchKey& key) const noexcept {
+            return std::hash<const void*>()(key.mesh) ^
+                   (std::hash<const void*>()(key.material) * 0x9e3779b97f4a7c15ull);
+        }
+    };
+    struct BatchSlot {
+        size_t batch = 0;
+        uint64_t generation = 0;
+    };
+    std::unordered_map<BatchKey, BatchSlot, BatchKeyHash> batchIndex_;
+    uint64_t generation_ = 0;
+};
+
+// Отрисовка батчей через DrawMeshInstanced с инстансным вариантом PBR шейдера
+class InstancedRenderer {
+public:
+    struct Stats {
+        int drawCalls = 0;
+        int instances = 0;
+        int triangles = 0;
+    };
+
+    // Вызывать внутри BeginMode3D после LightingSystem::update.
+    // Батчи меньше minInstances пропускаются — их рисует вызывающий (RenderSystem
+    // отправляет такие в DrawList).
+    static Stats draw(const InstanceBatcher& batcher, size_t minInstances = 1);
+};
+
+} // namespace kalan
@@ -1,5 +1,7 @@
 #include "Lighting.hpp"
-#include <format>
+#include "../core/Profiler.hpp"
+#include <algorithm>
+#include <cstdio>
 
 namespace kalan {
 
@@ -13,22 +15,40 @@ void LightingSystem::init() {
         PBRMaterial::initShader();
     }
     
-    Shader& shader = PBRMaterial::getShader();
+    shaderLocs_.clear();
+    for (size_t v = 0; v < PBRMaterial::ShaderVariantCount; ++v) {
+        auto variant = static_cast<PBRShaderVariant>(v);
+        if (PBRMaterial::isShaderLoaded(variant)) {
+            shaderLocs_.push_back(queryLocations(PBRMaterial::getShader(variant)));
+        }
+    }
+}
+
+LightingSystem::ShaderLocations LightingSystem::queryLocations(const Shader& shader) {
+    ShaderLocations locs;
+    locs.shader = shader;
+    
+    locs.lightCount = GetShaderLocation(shader, "lightCount");
+    locs.ambientColor = GetShaderLocation(shader, "ambientColor");
     
-    locLightCount_ = GetShaderLocation(shader, "lightCount");
-    locAmbientColor_ = GetShaderLocation(shader, "ambientColor");
+    // Имя собирается в стековом буфере — без временных строк
+    char name[64];
+    auto location = [&](int i, const char* field) {
+        std::snprintf(name, sizeof(name), "lights[%d].%s", i, field);
+        return GetShaderLocation(shader, name);
+    };
     
     for (int i = 0; i < MaxLights; ++i) {
-        std::string prefix = std::format("lights[{}].", i);
-        locEnabled_[i] = GetShaderLocation(shader, (prefix + "enabled").c_str());
-        locType_[i] = GetShaderLocation(shader, (prefix + "type").c_str());
-        locPosition_[i] = GetShaderLocation(shader, (prefix + "position").c_str());
-        locDirection_[i] = GetShaderLocation(shader, (prefix + "direction").c_str());
-        locColor_[i] = GetShaderLocation(shader, (prefix + "color").c_str());
-        locIntensity_[i] = GetShaderLocation(shader, (prefix + "intensity").c_str());
-        locCutoff_[i] = GetShaderLocation(shader, (prefix + "cutoff").c_str());
-        locOuterCutoff_[i] = GetShaderLocation(shader, (prefix + "outerCutoff").c_str());
+        locs.enabled[i] = location(i, "enabled");
+        locs.type[i] = location(i, "type");
+        locs.position[i] = location(i, "position");
+        locs.direction[i] = location(i, "direction");
+        locs.color[i] = location(i, "color");
+        locs.intensity[i] = location(i, "intensity");
+        locs.cutoff[i] = location(i, "cutoff");
+        locs.outerCutoff[i] = location(i, "outerCutoff");
     }
+    return locs;
 }
 
 int LightingSystem::addLight(const Light& light) {
@@ -70,49 +90,66 @@ void LightingSystem::setAmbientColor(Vector3 color) {
 }
 
 void LightingSystem::update(const raylib::Camera& camera) {
-    Shader& shader = PBRMaterial::getShader();
-    
-    // View position
+    KALAN_PROFILE_ZONE("LightingSystem::update");
     Vector3 viewPos = camera.GetPosition();
-    SetShaderValue(shader, shader.locs[SHADER_LOC_VECTOR_VIEW], &viewPos, SHADER_UNIFORM_VEC3);
-    
-    // Ambient
-    SetShaderValue(shader, locAmbientColor_, &ambientColor_, SHADER_UNIFORM_VEC3);
-    
-    // Light count
-    int count = static_cast<int>(lights_.size());
-    SetShaderValue(shader, locLightCount_, &count, SHADER_UNIFORM_INT);
-    
-    // Each light
-    for (int i = 0; i < count && i < MaxLights; ++i) {
+    packLights();
+    for (const auto& locs : shaderLocs_) {
+        uploadTo(locs, viewPos);
+    }
+}
+
+void LightingSystem::packLights() {
+    packedCount_ = std::min(static_cast<int>(lights_.size()), MaxLights);
+    for (int i = 0; i < packedCount_; ++i) {
         const Light& light = lights_[i];
+        PackedLight& packed = packed_[i];
         
-        int enabled = light.enabled ? 1 : 0;
-        int type = static_cast<int>(light.type);
-        Vector3 color = {
+        packed.enabled = light.enabled ? 1 : 0;
+        packed.type = static_cast<int>(light.type);
+        packed.position = light.position;
+        packed.direction = light.direction;
+        packed.color = {
             light.color.r / 255.0f,
             light.color.g / 255.0f,
             light.color.b / 255.0f
         };
+        packed.intensity = light.intensity;
         
         // Конвертировать cutoff из градусов в косинус
-        float cutoffCos = cosf(light.cutoff * DEG2RAD);
-        float outerCutoffCos = cosf(light.outerCutoff * DEG2RAD);
-        
-        SetShaderValue(shader, locEnabled_[i], &enabled, SHADER_UNIFORM_INT);
-        SetShaderValue(shader, locType_[i], &type, SHADER_UNIFORM_INT);
-        SetShaderValue(shader, locPosition_[i], &light.position, SHADER_UNIFORM_VEC3);
-        SetShaderValue(shader, locDirection_[i], &light.direction, SHADER_UNIFORM_VEC3);
-        SetShaderValue(shader, locColor_[i], &color, SHADER_UNIFORM_VEC3);
-        SetShaderValue(shader, locIntensity_[i], &light.intensity, SHADER_UNIFORM_FLOAT);
-        SetShaderValue(shader, locCutoff_[i], &cutoffCos, SHADER_UNIFORM_FLOAT);
-        SetShaderValue(shader, locOuterCutoff_[i], &outerCutoffCos, SHADER_UNIFORM_FLOAT);
+        packed.cutoffCos = cosf(light.cutoff * DEG2RAD);
+        packed.outerCutoffCos = cosf(light.outerCutoff * DEG2RAD);
+    }
+}
+
+void LightingSystem::uploadTo(const ShaderLocations& locs, const Vector3& viewPos) const {
+    const Shader& shader = locs.shader;
+    
+    // View position
+    SetShaderValue(shader, shader.locs[SHADER_LOC_VECTOR_VIEW], &viewPos, SHADER_UNIFORM_VEC3);
+    
+    // Ambient
+    SetShaderValue(shader, locs.ambientColor, &ambientColor_, SHADER_UNIFORM_VEC3);
+    
+    // Light count
+    SetShaderValue(shader, locs.lightCount, &packedCount_, SHADER_UNIFORM_INT);
+    
+    // Each light
+    for (int i = 0; i < packedCount_; ++i) {
+        const PackedLight& light = packed_[i];
+        SetShaderValue(shader, locs.enabled[i], &light.enabled, SHADER_UNIFORM_INT);
+        SetShaderValue(shader, locs.type[i], &light.type, SHADER_UNIFORM_INT);
+        SetShaderValue(shader, locs.position[i], &light.position, SHADER_UNIFORM_VEC3);
+        SetShaderValue(shader, locs.direction[i], &light.direction, SHADER_UNIFORM_VEC3);
+        SetShaderValue(shader, locs.color[i], &light.color, SHADER_UNIFORM_VEC3);
+        SetShaderValue(shader, locs.intensity[i], &light.intensity, SHADER_UNIFORM_FLOAT);
+        SetShaderValue(shader, locs.cutoff[i], &light.cutoffCos, SHADER_UNIFORM_FLOAT);
+        SetShaderValue(shader, locs.outerCutoff[i], &light.outerCutoffCos, SHADER_UNIFORM_FLOAT);
     }
     
     // Отключить неиспользуемые слоты
-    for (int i = count; i < MaxLights; ++i) {
-        int disabled = 0;
-        SetShaderValue(shader, locEnabled_[i], &disabled, SHADER_UNIFORM_INT);
+    const int disabled = 0;
+    for (int i = packedCount_; i < MaxLights; ++i) {
+        SetShaderValue(shader, locs.enabled[i], &disabled, SHADER_UNIFORM_INT);
     }
 }
 
@@ -61,17 +61,43 @@ private:
     std::vector<Light> lights_;
     Vector3 ambientColor_{0.03f, 0.03f, 0.03f};
     
-    // Shader locations
-    int locLightCount_ = -1;
-    int locAmbientColor_ = -1;
-    std::array<int, MaxLights> locEnabled_{};
-    std::array<int, MaxLights> locType_{};
-    std::array<int, MaxLights> locPosition_{};
-    std::array<int, MaxLights> locDirection_{};
-    std::array<int, MaxLights> locColor_{};
-    std::array<int, MaxLights> locIntensity_{};
-    std::array<int, MaxLights> locCutoff_{};
-    std::array<int, MaxLights> locOuterCutoff_{};
+    // Локации uniform'ов одного варианта PBR шейдера
+    struct ShaderLocations {
+        Shader shader{};
+        int lightCount = -1;
+        int ambientColor = -1;
+        std::array<int, MaxLights> enabled{};
+        std::array<int, MaxLights> type{};
+        std::array<int, MaxLights> position{};
+        std::array<int, MaxLights> direction{};
+        std::array<int, MaxLights> color{};
+        std::array<int, MaxLights> intensity{};
+        std::array<int, MaxLights> cutoff{};
+        std::array<int, MaxLights> outerCutoff{};
+    };
+    
+    // Свет в виде, готовом для SetShaderValue. Собирается один раз за update
+    // и переиспользуется всеми вариантами шейдера.
+    struct PackedLight {
+        int enabled = 0;
+        int type = 0;
+        Vector3 position{};
+        Vector3 direction{};
+        Vector3 color{};
+        float intensity = 0.0f;
+        float cutoffCos = 0.0f;
+        float outerCutoffCos = 0.0f;
+    };
+    
+    static ShaderLocations queryLocations(const Shader& shader);
+    void packLights();
+    void uploadTo(const ShaderLocations& locs, const Vector3& viewPos) const;
+    
+    std::array<PackedLight, MaxLights> packed_{};
+    int packedCount_ = 0;
+    
+    // По одному набору на каждый загруженный вариант PBR шейдера
+    std::vector<ShaderLocations> shaderLocs_;
 };
 
 } // namespace kalan
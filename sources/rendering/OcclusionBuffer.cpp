@@ -0,0 +1,440 @@
+#include "OcclusionBuffer.hpp"
+#include "../resources/ParallelLoader.hpp"
+#include "../core/Profiler.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define KALAN_OCCLUSION_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace kalan {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct ClipVertex {
+    float x, y, z, w;
+};
+
+ClipVertex ToClip(const Matrix& m, const float* p) {
+    return {m.m0 * p[0] + m.m4 * p[1] + m.m8 * p[2] + m.m12,
+            m.m1 * p[0] + m.m5 * p[1] + m.m9 * p[2] + m.m13,
+            m.m2 * p[0] + m.m6 * p[1] + m.m10 * p[2] + m.m14,
+            m.m3 * p[0] + m.m7 * p[1] + m.m11 * p[2] + m.m15};
+}
+
+// Плоскости отсечения окклюдеров: ближняя OpenGL (z >= -w) и guard band по x и y.
+// Guard band держит экранные координаты в пределах, где рёберные функции во float точны.
+constexpr float GuardBand = 2.0f;   // в NDC
+constexpr int ClipPlaneCount = 5;
+constexpr int MaxClippedVertices = 3 + ClipPlaneCount;
+constexpr int MaxClippedTriangles = MaxClippedVertices - 2;
+
+float PlaneDistance(const ClipVertex& v, int plane) {
+    switch (plane) {
+    case 0: return v.z + v.w;
+    case 1: return GuardBand * v.w - v.x;
+    case 2: return GuardBand * v.w + v.x;
+    case 3: return GuardBand * v.w - v.y;
+    default: return GuardBand * v.w + v.y;
+    }
+}
+
+ClipVertex Lerp(const ClipVertex& a, const ClipVertex& b, float t) {
+    return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t};
+}
+
+// Sutherland-Hodgman по одной плоскости; возвращает число вершин в out
+int ClipPolygon(const ClipVertex* polygon, int count, int plane, ClipVertex* out) {
+    int result = 0;
+    for (int i = 0; i < count; ++i) {
+        const ClipVertex& a = polygon[i];
+        const ClipVertex& b = polygon[(i + 1) % count];
+        const float da = PlaneDistance(a, plane);
+        const float db = PlaneDistance(b, plane);
+        if (da > 0.0f) out[result++] = a;
+        if ((da > 0.0f) != (db > 0.0f)) out[result++] = Lerp(a, b, da / (da - db));
+    }
+    return result;
+}
+
+int RoundUp(int value, int multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+// Треугольник в пикселях; false — вырожден или не накрывает ни одного центра пикселя
+bool SetupTriangle(const ClipVertex (&clip)[3], int width, int height, OcclusionBuffer::Triangle& out) {
+    float x[3], y[3], z[3];
+    for (int i = 0; i < 3; ++i) {
+        const float invW = 1.0f / clip[i].w;
+        x[i] = (clip[i].x * invW * 0.5f + 0.5f) * width;
+        y[i] = (0.5f - clip[i].y * invW * 0.5f) * height;     // строки сверху вниз
+        z[i] = invW;
+    }
+
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (std::fabs(area) < 1e-6f) return false;
+
+    // Центры пикселей px + 0.5, попадающие в bbox треугольника
+    const float minX = std::min({x[0], x[1], x[2]});
+    const float maxX = std::max({x[0], x[1], x[2]});
+    const float minY = std::min({y[0], y[1], y[2]});
+    const float maxY = std::max({y[0], y[1], y[2]});
+    if (maxX < 0.5f || maxY < 0.5f || minX > width - 0.5f || minY > height - 0.5f) return false;
+    out.minX = static_cast<int>(std::ceil(std::max(minX, 0.5f) - 0.5f));
+    out.minY = static_cast<int>(std::ceil(std::max(minY, 0.5f) - 0.5f));
+    out.maxX = static_cast<int>(std::floor(std::min(maxX, width - 0.5f) - 0.5f));
+    out.maxY = static_cast<int>(std::floor(std::min(maxY, height - 0.5f) - 0.5f));
+    if (out.minX > out.maxX || out.minY > out.maxY) return false;
+
+    // Ребро напротив вершины i; знак такой, чтобы внутренность была >= 0 при любом обходе
+    const float sign = area > 0.0f ? 1.0f : -1.0f;
+    for (int i = 0; i < 3; ++i) {
+        const int a = (i + 1) % 3;
+        const int b = (i + 2) % 3;
+        out.edgeA[i] = (y[a] - y[b]) * sign;
+        out.edgeB[i] = (x[b] - x[a]) * sign;
+        out.edgeC[i] = (x[a] * y[b] - x[b] * y[a]) * sign;
+    }
+
+    const float dzdx = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+    const float dzdy = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+    out.depthA = dzdx;
+    out.depthB = dzdy;
+    out.depthC = z[0] - dzdx * x[0] - dzdy * y[0];
+    out.maxDepth = std::max({z[0], z[1], z[2]});
+    return true;
+}
+
+// Пиксели строки, которые могут быть внутри треугольника: пересечение полуплоскостей
+// рёбер с [x0, x1], с запасом в пиксель на округление. Начало выровнено на блок из 4
+// пикселей — скалярный и SIMD пути проверяют одни и те же пиксели. false — пусто.
+bool RowSpan(const OcclusionBuffer::Triangle& tri, float py, int x0, int x1, int& begin, int& end) {
+    float lo = static_cast<float>(x0);
+    float hi = static_cast<float>(x1);
+    for (int i = 0; i < 3; ++i) {
+        const float a = tri.edgeA[i];
+        const float rest = tri.edgeB[i] * py + tri.edgeC[i];
+        if (a > 0.0f) lo = std::max(lo, -rest / a - 0.5f - 1.0f);
+        else if (a < 0.0f) hi = std::min(hi, -rest / a - 0.5f + 1.0f);
+        else if (rest < 0.0f) return false;
+    }
+    if (lo > hi) return false;
+    begin = static_cast<int>(lo) & ~3;
+    end = static_cast<int>(hi);
+    return true;
+}
+
+// Строки [y0, y1] и пиксели [x0, x1] внутри тайла (границы тайлов кратны 4)
+void RasterizeScalar(const OcclusionBuffer::Triangle& tri, float* depth, int pitch,
+                     int x0, int x1, int y0, int y1) {
+    for (int y = y0; y <= y1; ++y) {
+        const float py = y + 0.5f;
+        int begin, end;
+        if (!RowSpan(tri, py, x0, x1, begin, end)) continue;
+        end |= 3;                       // до конца последнего блока, как в SIMD пути
+        float* row = depth + static_cast<size_t>(y) * pitch;
+        for (int x = begin; x <= end; ++x) {
+            const float px = x + 0.5f;
+            if (tri.edgeA[0] * px + tri.edgeB[0] * py + tri.edgeC[0] < 0.0f) continue;
+            if (tri.edgeA[1] * px + tri.edgeB[1] * py + tri.edgeC[1] < 0.0f) continue;
+            if (tri.edgeA[2] * px + tri.edgeB[2] * py + tri.edgeC[2] < 0.0f) continue;
+            const float z = std::min(tri.depthA * px + tri.depthB * py + tri.depthC, tri.maxDepth);
+            row[x] = std::max(row[x], z);
+        }
+    }
+}
+
+#if KALAN_OCCLUSION_SSE
+
+void RasterizeSse(const OcclusionBuffer::Triangle& tri, float* depth, int pitch,
+                  int x0, int x1, int y0, int y1) {
+    const __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 maxDepth = _mm_set1_ps(tri.maxDepth);
+    __m128 a[3];
+    for (int i = 0; i < 3; ++i) a[i] = _mm_set1_ps(tri.edgeA[i]);
+    const __m128 depthA = _mm_set1_ps(tri.depthA);
+
+    for (int y = y0; y <= y1; ++y) {
+        const float py = y + 0.5f;
+        __m128 row[3];
+        for (int i = 0; i < 3; ++i) row[i] = _mm_set1_ps(tri.edgeB[i] * py + tri.edgeC[i]);
+        const __m128 depthRow = _mm_set1_ps(tri.depthB * py + tri.depthC);
+        float* out = depth + static_cast<size_t>(y) * pitch;
+        int begin, end;
+        if (!RowSpan(tri, py, x0, x1, begin, end)) continue;
+
+        for (int x = begin; x <= end; x += 4) {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+            __m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a[0], px), row[0]), zero);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a[1], px), row[1]), zero));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a[2], px), row[2]), zero));
+            if (_mm_movemask_ps(inside) == 0) continue;
+
+            const __m128 z = _mm_min_ps(_mm_add_ps(_mm_mul_ps(depthA, px), depthRow), maxDepth);
+            const __m128 old = _mm_loadu_ps(out + x);
+            const __m128 nearer = _mm_max_ps(old, z);
+            _mm_storeu_ps(out + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, old)));
+        }
+    }
+}
+
+#endif
+
+} // anonymous namespace
+
+OcclusionBuffer::OcclusionBuffer() : OcclusionBuffer(Settings{}) {}
+
+OcclusionBuffer::OcclusionBuffer(const Settings& settings) {
+    setSettings(settings);
+}
+
+void OcclusionBuffer::setSettings(const Settings& settings) {
+    settings_ = settings;
+    width_ = RoundUp(std::max(4, settings.width), 4);
+    height_ = std::max(1, settings.height);
+    tileWidth_ = std::min(width_, RoundUp(std::max(4, settings.tileWidth), 4));
+    tileHeight_ = std::min(height_, std::max(1, settings.tileHeight));
+    tilesX_ = (width_ + tileWidth_ - 1) / tileWidth_;
+    tilesY_ = (height_ + tileHeight_ - 1) / tileHeight_;
+    bins_.assign(static_cast<size_t>(tilesX_) * tilesY_, {});
+
+    levels_.clear();
+    levelWidths_.clear();
+    levelHeights_.clear();
+    int w = width_, h = height_;
+    while (true) {
+        levels_.emplace_back(static_cast<size_t>(w) * h, 0.0f);
+        levelWidths_.push_back(w);
+        levelHeights_.push_back(h);
+        if (w == 1 && h == 1) break;
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+    }
+    empty_ = true;
+}
+
+// ============ Растеризация ============
+
+void OcclusionBuffer::setupOccluder(const OccluderInstance& occluder, size_t index) {
+    const OccluderMesh& mesh = *occluder.mesh;
+    const Matrix m = MatrixMultiply(occluder.transform, viewProjection_);
+    Triangle* out = triangles_.data() + triangleOffsets_[index];
+    uint32_t count = 0;
+
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        ClipVertex v[3];
+        unsigned outside[3] = {0, 0, 0};    // плоскости, за которыми лежит вершина
+        for (int i = 0; i < 3; ++i) {
+            v[i] = ToClip(m, &mesh.positions[mesh.indices[t + i] * 3]);
+            for (int plane = 0; plane < ClipPlaneCount; ++plane) {
+                if (PlaneDistance(v[i], plane) <= 0.0f) outside[i] |= 1u << plane;
+            }
+        }
+        if (outside[0] & outside[1] & outside[2]) continue;
+        if ((outside[0] | outside[1] | outside[2]) == 0) {
+            count += SetupTriangle(v, width_, height_, out[count]);
+            continue;
+        }
+
+        ClipVertex polygon[MaxClippedVertices] = {v[0], v[1], v[2]};
+        ClipVertex clipped[MaxClippedVertices];
+        int corners = 3;
+        const unsigned planes = outside[0] | outside[1] | outside[2];
+        for (int plane = 0; plane < ClipPlaneCount && corners >= 3; ++plane) {
+            if (!(planes & (1u << plane))) continue;
+            corners = ClipPolygon(polygon, corners, plane, clipped);
+            std::copy_n(clipped, corners, polygon);
+        }
+        for (int i = 1; i + 1 < corners; ++i) {
+            const ClipVertex fan[3] = {polygon[0], polygon[i], polygon[i + 1]};
+            count += SetupTriangle(fan, width_, height_, out[count]);
+        }
+    }
+    triangleCounts_[index] = count;
+}
+
+void OcclusionBuffer::rasterizeTile(int tile) {
+    const int tileX0 = (tile % tilesX_) * tileWidth_;
+    const int tileY0 = (tile / tilesX_) * tileHeight_;
+    const int tileX1 = std::min(width_, tileX0 + tileWidth_) - 1;
+    const int tileY1 = std::min(height_, tileY0 + tileHeight_) - 1;
+
+    float* depth = levels_.front().data();
+    for (int y = tileY0; y <= tileY1; ++y) {
+        std::fill_n(depth + static_cast<size_t>(y) * width_ + tileX0, tileX1 - tileX0 + 1, 0.0f);
+    }
+
+    for (uint32_t index : bins_[tile]) {
+        const Triangle& tri = triangles_[index];
+        const int x0 = std::max(tri.minX, tileX0);
+        const int x1 = std::min(tri.maxX, tileX1);
+        const int y0 = std::max(tri.minY, tileY0);
+        const int y1 = std::min(tri.maxY, tileY1);
+#if KALAN_OCCLUSION_SSE
+        if (settings_.simd) {
+            RasterizeSse(tri, depth, width_, x0, x1, y0, y1);
+            continue;
+        }
+#endif
+        RasterizeScalar(tri, depth, width_, x0, x1, y0, y1);
+    }
+}
+
+void OcclusionBuffer::buildHierarchy() {
+    for (size_t level = 1; level < levels_.size(); ++level) {
+        const std::vector<float>& src = levels_[level - 1];
+        std::vector<float>& dst = levels_[level];
+        const int srcWidth = levelWidths_[level - 1];
+        const int srcHeight = levelHeights_[level - 1];
+        const int width = levelWidths_[level];
+        const int height = levelHeights_[level];
+        for (int y = 0; y < height; ++y) {
+            const float* row0 = &src[static_cast<size_t>(y * 2) * srcWidth];
+            const float* row1 = &src[static_cast<size_t>(std::min(y * 2 + 1, srcHeight - 1)) * srcWidth];
+            for (int x = 0; x < width; ++x) {
+                const int x0 = x * 2;
+                const int x1 = std::min(x0 + 1, srcWidth - 1);
+                // Самая дальняя глубина: тексель перекрывает только то, что дальше всех четырёх
+                dst[static_cast<size_t>(y) * width + x] = std::min({row0[x0], row0[x1], row1[x0], row1[x1]});
+            }
+        }
+    }
+}
+
+OcclusionBuffer::Stats OcclusionBuffer::render(const Matrix& viewProjection, const OccluderInstance* occluders,
+                                               size_t count, ImageThreadPool* pool) {
+    KALAN_PROFILE_ZONE("OcclusionBuffer::render");
+    Stats stats;
+    viewProjection_ = viewProjection;
+    empty_ = count == 0;
+    stats.occluders = static_cast<int>(count);
+    if (empty_) {
+        lastStats_ = stats;
+        return stats;
+    }
+
+    // Диапазон треугольников на окклюдер с запасом на отсечение
+    auto start = Clock::now();
+    triangleOffsets_.resize(count);
+    triangleCounts_.assign(count, 0);
+    size_t capacity = 0;
+    for (size_t i = 0; i < count; ++i) {
+        triangleOffsets_[i] = capacity;
+        capacity += occluders[i].mesh ? occluders[i].mesh->getTriangleCount() * MaxClippedTriangles : 0;
+    }
+    if (triangles_.size() < capacity) triangles_.resize(capacity);
+
+    auto setup = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (occluders[i].mesh) setupOccluder(occluders[i], i);
+        }
+    };
+    if (pool && count > settings_.transformChunk) {
+        pool->parallelFor(count, settings_.transformChunk, setup);
+    } else {
+        setup(0, count);
+    }
+
+    for (auto& bin : bins_) bin.clear();
+    for (size_t i = 0; i < count; ++i) {
+        for (uint32_t t = 0; t < triangleCounts_[i]; ++t) {
+            const uint32_t index = static_cast<uint32_t>(triangleOffsets_[i] + t);
+            const Triangle& tri = triangles_[index];
+            for (int ty = tri.minY / tileHeight_; ty <= tri.maxY / tileHeight_; ++ty) {
+                for (int tx = tri.minX / tileWidth_; tx <= tri.maxX / tileWidth_; ++tx) {
+                    bins_[static_cast<size_t>(ty) * tilesX_ + tx].push_back(index);
+                }
+            }
+        }
+        stats.triangles += static_cast<int>(triangleCounts_[i]);
+    }
+    stats.setupMs = MsSince(start);
+
+    start = Clock::now();
+    const size_t tiles = bins_.size();
+    auto rasterize = [&](size_t begin, size_t end) {
+        for (size_t tile = begin; tile < end; ++tile) rasterizeTile(static_cast<int>(tile));
+    };
+    if (pool) {
+        pool->parallelFor(tiles, 1, rasterize);
+    } else {
+        rasterize(0, tiles);
+    }
+    stats.rasterizeMs = MsSince(start);
+
+    start = Clock::now();
+    buildHierarchy();
+    stats.hierarchyMs = MsSince(start);
+
+    lastStats_ = stats;
+    return stats;
+}
+
+// ============ Проверка ============
+
+bool OcclusionBuffer::isVisible(const BoundingBox& box) const {
+    if (empty_) return true;
+
+    float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+    float nearest = 0.0f;
+    for (int i = 0; i < 8; ++i) {
+        const float corner[3] = {i & 1 ? box.max.x : box.min.x,
+                                 i & 2 ? box.max.y : box.min.y,
+                                 i & 4 ? box.max.z : box.min.z};
+        const ClipVertex v = ToClip(viewProjection_, corner);
+        if (PlaneDistance(v, 0) <= 0.0f || v.w <= 0.0f) return true;
+        const float invW = 1.0f / v.w;
+        const float x = (v.x * invW * 0.5f + 0.5f) * width_;
+        const float y = (0.5f - v.y * invW * 0.5f) * height_;
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        nearest = std::max(nearest, invW);
+    }
+    if (maxX <= 0.0f || maxY <= 0.0f || minX >= width_ || minY >= height_) return true;
+
+    // Тексели, которых касается прямоугольник
+    int x0 = static_cast<int>(std::max(minX, 0.0f));
+    int y0 = static_cast<int>(std::max(minY, 0.0f));
+    int x1 = static_cast<int>(std::min(maxX, width_ - 1.0f));
+    int y1 = static_cast<int>(std::min(maxY, height_ - 1.0f));
+
+    int level = 0;
+    while (level + 1 < getLevelCount() && ((x1 >> level) - (x0 >> level) > 3 || (y1 >> level) - (y0 >> level) > 3)) {
+        ++level;
+    }
+    x0 >>= level;
+    y0 >>= level;
+    x1 >>= level;
+    y1 >>= level;
+
+    const std::vector<float>& depth = levels_[level];
+    const int pitch = levelWidths_[level];
+    const float threshold = nearest / (1.0f - settings_.depthBias);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            if (depth[static_cast<size_t>(y) * pitch + x] <= threshold) return true;
+        }
+    }
+    return false;
+}
+
+#if KALAN_OCCLUSION_SSE
+bool isSimdOcclusionAvailable() noexcept { return true; }
+#else
+bool isSimdOcclusionAvailable() noexcept { return false; }
+#endif
+
+} // namespace kalan
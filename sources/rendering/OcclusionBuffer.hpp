@@ -0,0 +1,131 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace kalan {
+
+class ImageThreadPool;
+
+// Упрощённая геометрия окклюдера — только позиции и индексы
+// (строится при импорте, resources/OccluderBuilder.hpp)
+struct OccluderMesh {
+    std::vector<float> positions;       // xyz на вершину
+    std::vector<uint32_t> indices;
+    BoundingBox bounds{};
+
+    [[nodiscard]] bool isEmpty() const noexcept { return indices.empty(); }
+    [[nodiscard]] size_t getTriangleCount() const noexcept { return indices.size() / 3; }
+};
+
+// Окклюдеры модели по индексу меша; пустой OccluderMesh — меш не окклюдер
+struct ModelOccluders {
+    std::vector<OccluderMesh> meshes;
+};
+
+// Окклюдер в кадре: меш и его мировая матрица
+struct OccluderInstance {
+    const OccluderMesh* mesh = nullptr;
+    Matrix transform{};
+};
+
+// CPU буфер глубины низкого разрешения для отсечения перекрытых объектов. Только CPU,
+// без GL — бенчмарк occlusion гоняет его без окна.
+//
+// Глубина — 1/w: она линейна в экранном пространстве и не зависит от near/far.
+// Больше — ближе, 0 — пусто. Окклюдеры режутся ближней плоскостью, треугольники
+// раскладываются по тайлам, и тайлы растеризуются по задаче пула: каждая задача
+// пишет только свои пиксели. Строка тайла идёт блоками по 4 пикселя (SSE, если он
+// доступен при сборке). Пиксель покрыт, если покрыт его центр.
+//
+// По буферу строится иерархия: тексель уровня — самая дальняя глубина 2x2 ниже.
+// AABB проверяется на уровне, где его экранный прямоугольник занимает не больше
+// 4x4 текселей: объект перекрыт, если его ближайший угол дальше всех этих текселей.
+class OcclusionBuffer {
+public:
+    struct Settings {
+        int width = 320;                // округляется вверх до кратного 4
+        int height = 192;
+        int tileWidth = 64;             // округляется вверх до кратного 4
+        int tileHeight = 32;
+        // Запас теста: объект перекрыт, только если его 1/w меньше глубины
+        // окклюдеров хотя бы на эту долю (грань самого окклюдера не отсекается)
+        float depthBias = 0.001f;
+        size_t transformChunk = 4;      // окклюдеров на задачу подготовки треугольников
+        bool simd = true;               // false — скалярный путь (сравнение в бенчмарке)
+    };
+
+    struct Stats {
+        int occluders = 0;
+        int triangles = 0;              // после отсечения ближней плоскостью и экраном
+        double setupMs = 0.0;           // трансформация, отсечение, раскладка по тайлам
+        double rasterizeMs = 0.0;
+        double hierarchyMs = 0.0;
+    };
+
+    OcclusionBuffer();
+    explicit OcclusionBuffer(const Settings& settings);
+
+    // Очистить буфер, растеризовать окклюдеры под viewProjection и построить иерархию.
+    // pool == nullptr — однопоточно.
+    Stats render(const Matrix& viewProjection, const OccluderInstance* occluders, size_t count,
+                 ImageThreadPool* pool = nullptr);
+
+    // false — мировой AABB целиком за окклюдерами последнего render. AABB,
+    // пересекающие ближнюю плоскость или лежащие вне экрана, видимы.
+    // Только читает буфер — можно звать из нескольких потоков.
+    [[nodiscard]] bool isVisible(const BoundingBox& box) const;
+
+    void setSettings(const Settings& settings);
+    [[nodiscard]] const Settings& getSettings() const noexcept { return settings_; }
+    [[nodiscard]] const Stats& getLastStats() const noexcept { return lastStats_; }
+
+    // Уровень 0: width * height значений 1/w, строки сверху вниз
+    [[nodiscard]] const float* getDepth() const noexcept { return levels_.front().data(); }
+    [[nodiscard]] int getWidth() const noexcept { return width_; }
+    [[nodiscard]] int getHeight() const noexcept { return height_; }
+    [[nodiscard]] int getLevelCount() const noexcept { return static_cast<int>(levels_.size()); }
+
+    // Треугольник в пикселях: рёберные функции a*x + b*y + c >= 0 внутри
+    // и плоскость глубины
+    struct Triangle {
+        float edgeA[3], edgeB[3], edgeC[3];
+        float depthA, depthB, depthC;
+        float maxDepth;                 // глубина не выходит за вершины
+        int minX, minY, maxX, maxY;     // пиксели, включительно
+    };
+
+private:
+    void setupOccluder(const OccluderInstance& occluder, size_t index);
+    void rasterizeTile(int tile);
+    void buildHierarchy();
+
+    Settings settings_;
+    Stats lastStats_;
+    Matrix viewProjection_{};
+    bool empty_ = true;                 // окклюдеров не было — всё видимо
+
+    int width_ = 0;
+    int height_ = 0;
+    int tileWidth_ = 0;
+    int tileHeight_ = 0;
+    int tilesX_ = 0;
+    int tilesY_ = 0;
+
+    std::vector<std::vector<float>> levels_;    // [0] — сам буфер
+    std::vector<int> levelWidths_;
+    std::vector<int> levelHeights_;
+
+    // Рабочие буферы кадра — переиспользуются
+    std::vector<Triangle> triangles_;           // по диапазону на окклюдер
+    std::vector<size_t> triangleOffsets_;
+    std::vector<uint32_t> triangleCounts_;
+    std::vector<std::vector<uint32_t>> bins_;   // индексы треугольников по тайлам
+};
+
+// Собран ли SIMD путь растеризации
+[[nodiscard]] bool isSimdOcclusionAvailable() noexcept;
+
+} // namespace kalan
@@ -1,4 +1,5 @@
 #include "PBRMaterial.hpp"
+#include "rlgl.h"
 #include <iostream>
 
 namespace kalan {
@@ -6,35 +7,90 @@ namespace kalan {
 // ============ PBRMaterial Static Methods ============
 
 void PBRMaterial::initShader(const fs::path& vsPath, const fs::path& fsPath) {
-    if (shaderLoaded_) return;
+    initShader(PBRShaderVariant::Default, vsPath, fsPath);
+}
+
+void PBRMaterial::initShader(PBRShaderVariant variant, const fs::path& vsPath, const fs::path& fsPath) {
+    size_t idx = static_cast<size_t>(variant);
+    if (shadersLoaded_[idx]) return;
     
-    shader_ = LoadShader(vsPath.string().c_str(), fsPath.string().c_str());
+    Shader shader = LoadShader(vsPath.string().c_str(), fsPath.string().c_str());
+    if (variant != PBRShaderVariant::Default && shader.id == rlGetShaderIdDefault()) {
+        // Вариант не собрался — рендер откатится на обычный путь
+        TraceLog(LOG_WARNING, "PBRMaterial: failed to load shader variant %zu (%s)",
+                 idx, vsPath.string().c_str());
+        return;
+    }
     
     // Привязка локаций текстур
-    shader_.locs[SHADER_LOC_MAP_ALBEDO] = GetShaderLocation(shader_, "albedoMap");
-    shader_.locs[SHADER_LOC_MAP_NORMAL] = GetShaderLocation(shader_, "normalMap");
-    shader_.locs[SHADER_LOC_MAP_METALNESS] = GetShaderLocation(shader_, "metallicMap");
-    shader_.locs[SHADER_LOC_MAP_ROUGHNESS] = GetShaderLocation(shader_, "roughnessMap");
-    shader_.locs[SHADER_LOC_MAP_OCCLUSION] = GetShaderLocation(shader_, "aoMap");
+    shader.locs[SHADER_LOC_MAP_ALBEDO] = GetShaderLocation(shader, "albedoMap");
+    shader.locs[SHADER_LOC_MAP_NORMAL] = GetShaderLocation(shader, "normalMap");
+    shader.locs[SHADER_LOC_MAP_METALNESS] = GetShaderLocation(shader, "metallicMap");
+    shader.locs[SHADER_LOC_MAP_ROUGHNESS] = GetShaderLocation(shader, "roughnessMap");
+    shader.locs[SHADER_LOC_MAP_OCCLUSION] = GetShaderLocation(shader, "aoMap");
     
     // MVP и view
-    shader_.locs[SHADER_LOC_MATRIX_MVP] = GetShaderLocation(shader_, "mvp");
-    shader_.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocation(shader_, "matModel");
-    shader_.locs[SHADER_LOC_VECTOR_VIEW] = GetShaderLocation(shader_, "viewPos");
+    shader.locs[SHADER_LOC_MATRIX_MVP] = GetShaderLocation(shader, "mvp");
+    shader.locs[SHADER_LOC_VECTOR_VIEW] = GetShaderLocation(shader, "viewPos");
+    
+    if (variant == PBRShaderVariant::Instanced) {
+        // DrawMeshInstanced передаёт матрицы инстансов через атрибут в слоте MATRIX_MODEL
+        shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(shader, "instanceTransform");
+    } else {
+        shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocation(shader, "matModel");
+    }
+    if (variant == PBRShaderVariant::Skinned) {
+        shader.locs[SHADER_LOC_BONE_MATRICES] = GetShaderLocation(shader, "boneMatrices");
+    }
+    ormLocs_[idx] = GetShaderLocation(shader, "ormPacked");
     
-    shaderLoaded_ = true;
+    shaders_[idx] = shader;
+    shadersLoaded_[idx] = true;
 }
 
 void PBRMaterial::initShader() {
-    initShader("assets/shaders/pbr.vs", "assets/shaders/pbr.fs");
+    initShader(PBRShaderVariant::Default, "assets/shaders/pbr.vs", "assets/shaders/pbr.fs");
+    initShader(PBRShaderVariant::Instanced, "assets/shaders/pbr_instanced.vs", "assets/shaders/pbr.fs");
+    initShader(PBRShaderVariant::Packed, "assets/shaders/pbr_packed.vs", "assets/shaders/pbr.fs");
+    initShader(PBRShaderVariant::Skinned, "assets/shaders/pbr_skinned.vs", "assets/shaders/pbr.fs");
 }
 
 Shader& PBRMaterial::getShader() noexcept {
-    return shader_;
+    return shaders_[static_cast<size_t>(PBRShaderVariant::Default)];
+}
+
+Shader& PBRMaterial::getShader(PBRShaderVariant variant) noexcept {
+    return shaders_[static_cast<size_t>(variant)];
 }
 
 bool PBRMaterial::isShaderLoaded() noexcept {
-    return shaderLoaded_;
+    return shadersLoaded_[static_cast<size_t>(PBRShaderVariant::Default)];
+}
+
+bool PBRMaterial::isShaderLoaded(PBRShaderVariant variant) noexcept {
+    return shadersLoaded_[static_cast<size_t>(variant)];
+}
+
+void PBRMaterial::setOrmPacked(Material& material, bool packed) noexcept {
+    material.params[OrmParam] = packed ? 1.0f : 0.0f;
+}
+
+bool PBRMaterial::isOrmPacked(const Material& material) noexcept {
+    return material.params[OrmParam] != 0.0f;
+}
+
+int PBRMaterial::getOrmLocation(const Shader& shader) noexcept {
+    for (size_t i = 0; i < ShaderVariantCount; ++i) {
+        if (shadersLoaded_[i] && shaders_[i].id == shader.id) return ormLocs_[i];
+    }
+    return -1;
+}
+
+void PBRMaterial::applyOrmUniform(const Material& material) {
+    int loc = getOrmLocation(material.shader);
+    if (loc < 0) return;
+    int packed = isOrmPacked(material) ? 1 : 0;
+    SetShaderValue(material.shader, loc, &packed, SHADER_UNIFORM_INT);
 }
 
 void PBRMaterial::initDefaults() {
@@ -55,15 +111,10 @@ void PBRMaterial::initDefaults() {
     defaultMetallic_ = LoadTextureFromImage(imgMetallic);
     UnloadImage(imgMetallic);
     
-    // Roughness: 1 (полностью шероховатый)
-    Image imgRoughness = GenImageColor(1, 1, WHITE);
-    defaultRoughness_ = LoadTextureFromImage(imgRoughness);
-    UnloadImage(imgRoughness);
-    
-    // AO: 1 (нет окклюзии)
-    Image imgAO = GenImageColor(1, 1, WHITE);
-    defaultAO_ = LoadTextureFromImage(imgAO);
-    UnloadImage(imgAO);
+    // Roughness: 1 (полностью шероховатый), AO: 1 (нет окклюзии).
+    // Та же белая текстура, что и albedo: меньше разных наборов текстур — меньше bind'ов в DrawList
+    defaultRoughness_ = defaultAlbedo_;
+    defaultAO_ = defaultAlbedo_;
     
     defaultsLoaded_ = true;
 }
@@ -124,7 +175,7 @@ Texture2D PBRMaterial::getTexture(PBRTextureType type) const {
 
 Material PBRMaterial::toRaylibMaterial() const {
     Material mat = LoadMaterialDefault();
-    mat.shader = shader_;
+    mat.shader = getShader();
     
     mat.maps[MATERIAL_MAP_ALBEDO].texture = getTexture(PBRTextureType::Albedo);
     mat.maps[MATERIAL_MAP_NORMAL].texture = getTexture(PBRTextureType::Normal);
@@ -143,13 +194,13 @@ Material PBRMaterial::toRaylibMaterial() const {
 }
 
 void PBRMaterial::applyShaderToModel(raylib::Model& model) {
-    if (!shaderLoaded_) return;
+    if (!isShaderLoaded()) return;
     
     for (int i = 0; i < model.GetMaterialCount(); ++i) {
         Material& mat = model.materials[i];
         
         // Применить PBR шейдер
-        mat.shader = shader_;
+        mat.shader = getShader();
         
         // Если текстуры отсутствуют — подставить дефолтные
         if (mat.maps[MATERIAL_MAP_ALBEDO].texture.id == 0) {
@@ -161,10 +212,11 @@ void PBRMaterial::applyShaderToModel(raylib::Model& model) {
         if (mat.maps[MATERIAL_MAP_METALNESS].texture.id == 0) {
             mat.maps[MATERIAL_MAP_METALNESS].texture = getDefaultMetallic();
         }
-        if (mat.maps[MATERIAL_MAP_ROUGHNESS].texture.id == 0) {
+        // С ORM roughness и AO читаются из слота metalness — их слоты остаются пустыми
+        if (mat.maps[MATERIAL_MAP_ROUGHNESS].texture.id == 0 && !isOrmPacked(mat)) {
             mat.maps[MATERIAL_MAP_ROUGHNESS].texture = getDefaultRoughness();
         }
-        if (mat.maps[MATERIAL_MAP_OCCLUSION].texture.id == 0) {
+        if (mat.maps[MATERIAL_MAP_OCCLUSION].texture.id == 0 && !isOrmPacked(mat)) {
             mat.maps[MATERIAL_MAP_OCCLUSION].texture = getDefaultAO();
         }
         
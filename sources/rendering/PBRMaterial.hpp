@@ -20,16 +20,40 @@ enum class PBRTextureType : size_t {
     Count
 };
 
+// Варианты PBR шейдера (общий fragment shader, разные vertex shaders)
+enum class PBRShaderVariant : size_t {
+    Default = 0,
+    Instanced,   // трансформы берутся из атрибута instanceTransform
+    Packed,      // сжатый interleaved формат вершин (VertexFormat::Packed)
+    Skinned,     // скиннинг на GPU по boneMatrices (LoadOptions::importAnimation)
+    Count
+};
+
 // PBR материал — хранит текстуры и применяет шейдер
 class PBRMaterial {
 public:
     static constexpr size_t TextureCount = static_cast<size_t>(PBRTextureType::Count);
+    static constexpr size_t ShaderVariantCount = static_cast<size_t>(PBRShaderVariant::Count);
     
     // Инициализация глобального PBR шейдера (вызвать один раз после InitWindow)
     static void initShader(const fs::path& vsPath, const fs::path& fsPath);
-    static void initShader(); // использует дефолтные пути assets/shaders/pbr.vs, pbr.fs
+    static void initShader(PBRShaderVariant variant, const fs::path& vsPath, const fs::path& fsPath);
+    static void initShader(); // использует дефолтные пути assets/shaders/pbr*.vs, pbr.fs
     static Shader& getShader() noexcept;
+    static Shader& getShader(PBRShaderVariant variant) noexcept;
     static bool isShaderLoaded() noexcept;
+    static bool isShaderLoaded(PBRShaderVariant variant) noexcept;
+    
+    // ORM (R = AO, G = roughness, B = metallic) одной текстурой в слоте MATERIAL_MAP_METALNESS,
+    // слоты roughness и AO пустые. Флаг хранится в Material::params[OrmParam],
+    // шейдер получает его через uniform int ormPacked
+    static constexpr int OrmParam = 0;
+    static void setOrmPacked(Material& material, bool packed) noexcept;
+    [[nodiscard]] static bool isOrmPacked(const Material& material) noexcept;
+    // Локация ormPacked у PBR шейдера; -1 — шейдер не PBR или ORM не поддерживает
+    [[nodiscard]] static int getOrmLocation(const Shader& shader) noexcept;
+    // Выставить ormPacked для шейдера материала перед DrawMesh / DrawMeshInstanced
+    static void applyOrmUniform(const Material& material);
     
     // Дефолтные текстуры (1x1 пиксель)
     static void initDefaults();
@@ -58,8 +82,9 @@ private:
     std::array<Texture2D, TextureCount> textures_{};
     std::array<std::shared_ptr<raylib::Texture>, TextureCount> textureOwners_{}; // shared ownership
     
-    static inline Shader shader_{};
-    static inline bool shaderLoaded_ = false;
+    static inline std::array<Shader, ShaderVariantCount> shaders_{};
+    static inline std::array<bool, ShaderVariantCount> shadersLoaded_{};
+    static inline std::array<int, ShaderVariantCount> ormLocs_{};
     
     static inline Texture2D defaultAlbedo_{};
     static inline Texture2D defaultNormal_{};
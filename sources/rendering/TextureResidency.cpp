@@ -0,0 +1,232 @@
+#include "TextureResidency.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace kalan {
+
+// ============ Оценка спроса ============
+
+int TextureResidency::mipCountFor(int width, int height) noexcept {
+    int largest = std::max(1, std::max(width, height));
+    int count = 1;
+    while (largest > 1 && count < MaxMipCount) {
+        largest >>= 1;
+        ++count;
+    }
+    return count;
+}
+
+int TextureResidency::tailMipFor(int width, int height, int tailSize) noexcept {
+    const int last = mipCountFor(width, height) - 1;
+    const int largest = std::max(width, height);
+    int level = 0;
+    while (level < last && (largest >> level) > tailSize) ++level;
+    return level;
+}
+
+size_t TextureResidency::chainBytes(int width, int height, int format, int fromMip) {
+    size_t total = 0;
+    for (int level = std::max(0, fromMip); level < mipCountFor(width, height); ++level) {
+        total += static_cast<size_t>(GetPixelDataSize(std::max(1, width >> level), std::max(1, height >> level), format));
+    }
+    return total;
+}
+
+float TextureResidency::screenMipLevel(float texelsPerUnit, float pixelsPerUnit) noexcept {
+    // Без UV плотность неизвестна — не экономим на такой текстуре
+    if (texelsPerUnit <= 0.0f) return 0.0f;
+    if (pixelsPerUnit <= 0.0f) return static_cast<float>(MaxMipCount);
+    return std::log2(texelsPerUnit / pixelsPerUnit);
+}
+
+float TextureResidency::meshTexelDensity(const Mesh& mesh) {
+    if (!mesh.vertices || !mesh.texcoords || mesh.vertexCount < 3) return 0.0f;
+
+    double surfaceArea = 0.0;
+    double uvArea = 0.0;
+    const int triangles = mesh.indices ? mesh.triangleCount : mesh.vertexCount / 3;
+    for (int t = 0; t < triangles; ++t) {
+        int idx[3];
+        for (int k = 0; k < 3; ++k) idx[k] = mesh.indices ? mesh.indices[t * 3 + k] : t * 3 + k;
+
+        const float* p0 = &mesh.vertices[idx[0] * 3];
+        const float* p1 = &mesh.vertices[idx[1] * 3];
+        const float* p2 = &mesh.vertices[idx[2] * 3];
+        const double e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+        const double e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+        const double cx = e1[1] * e2[2] - e1[2] * e2[1];
+        const double cy = e1[2] * e2[0] - e1[0] * e2[2];
+        const double cz = e1[0] * e2[1] - e1[1] * e2[0];
+        surfaceArea += 0.5 * std::sqrt(cx * cx + cy * cy + cz * cz);
+
+        const float* t0 = &mesh.texcoords[idx[0] * 2];
+        const float* t1 = &mesh.texcoords[idx[1] * 2];
+        const float* t2 = &mesh.texcoords[idx[2] * 2];
+        uvArea += 0.5 * std::fabs((t1[0] - t0[0]) * (t2[1] - t0[1]) - (t2[0] - t0[0]) * (t1[1] - t0[1]));
+    }
+    if (surfaceArea <= 0.0 || uvArea <= 0.0) return 0.0f;
+    return static_cast<float>(std::sqrt(uvArea / surfaceArea));
+}
+
+// ============ Текстуры ============
+
+TextureResidency::Handle TextureResidency::add(int width, int height, int format, int residentMip) {
+    Handle handle;
+    if (!freeHandles_.empty()) {
+        handle = freeHandles_.back();
+        freeHandles_.pop_back();
+    } else {
+        handle = static_cast<Handle>(entries_.size());
+        entries_.emplace_back();
+    }
+
+    Entry& entry = entries_[handle];
+    entry = Entry{};
+    const int count = mipCountFor(width, height);
+    for (int level = count - 1; level >= 0; --level) {
+        entry.chainBytes[level] = entry.chainBytes[level + 1] +
+            static_cast<size_t>(GetPixelDataSize(std::max(1, width >> level), std::max(1, height >> level), format));
+    }
+    entry.tailMip = tailMipFor(width, height, settings_.tailSize);
+    entry.residentMip = std::clamp(residentMip, 0, count - 1);
+    entry.targetMip = entry.residentMip;
+    entry.desiredMip = entry.residentMip;
+    entry.alive = true;
+    return handle;
+}
+
+void TextureResidency::remove(Handle handle) {
+    if (handle >= entries_.size() || !entries_[handle].alive) return;
+    entries_[handle].alive = false;
+    freeHandles_.push_back(handle);
+}
+
+int TextureResidency::getResidentMip(Handle handle) const {
+    return handle < entries_.size() ? entries_[handle].residentMip : 0;
+}
+
+int TextureResidency::getTailMip(Handle handle) const {
+    return handle < entries_.size() ? entries_[handle].tailMip : 0;
+}
+
+void TextureResidency::beginFrame() {
+    ++frame_;
+    for (Entry& entry : entries_) {
+        entry.demanded = false;
+        entry.demandMip = static_cast<float>(MaxMipCount);
+        entry.screenSize = 0.0f;
+    }
+}
+
+void TextureResidency::addDemand(Handle handle, float mipLevel, float screenSize) {
+    if (handle >= entries_.size()) return;
+    Entry& entry = entries_[handle];
+    entry.demanded = true;
+    entry.lastDemandFrame = frame_;
+    entry.demandMip = std::min(entry.demandMip, mipLevel);
+    entry.screenSize = std::max(entry.screenSize, screenSize);
+}
+
+// ============ Планирование ============
+
+void TextureResidency::plan(std::vector<Request>& out, int maxLoads) {
+    out.clear();
+    order_.clear();
+    targetBytes_ = 0;
+    budgetLimited_ = 0;
+
+    const uint64_t delay = static_cast<uint64_t>(std::max(0, settings_.evictDelayFrames));
+    for (Handle handle = 0; handle < entries_.size(); ++handle) {
+        Entry& entry = entries_[handle];
+        if (!entry.alive) continue;
+        if (entry.pending) {
+            // Цель уже отдана на выполнение
+            targetBytes_ += entry.chainBytes[entry.targetMip];
+            continue;
+        }
+
+        const bool recent = entry.lastDemandFrame != 0 && entry.lastDemandFrame + delay >= frame_;
+        if (entry.demanded) {
+            float level = std::floor(entry.demandMip + settings_.mipBias);
+            entry.desiredMip = static_cast<int>(std::clamp(level, 0.0f, static_cast<float>(entry.tailMip)));
+        } else if (!recent) {
+            entry.desiredMip = entry.tailMip;
+        }
+
+        int target = entry.desiredMip;
+        if (recent && target > entry.residentMip && target - entry.residentMip <= settings_.hysteresisLevels) {
+            target = entry.residentMip;
+        }
+        entry.targetMip = target;
+        targetBytes_ += entry.chainBytes[target];
+        if (target < entry.tailMip) order_.push_back(handle);
+    }
+
+    if (targetBytes_ > settings_.budgetBytes) {
+        // По уровню за проход, начиная с самых мелких на экране, пока не влезем
+        std::sort(order_.begin(), order_.end(), [this](Handle a, Handle b) {
+            return entries_[a].screenSize < entries_[b].screenSize;
+        });
+        bool progress = true;
+        while (targetBytes_ > settings_.budgetBytes && progress) {
+            progress = false;
+            for (Handle handle : order_) {
+                Entry& entry = entries_[handle];
+                if (entry.targetMip >= entry.tailMip) continue;
+                targetBytes_ -= entry.chainBytes[entry.targetMip] - entry.chainBytes[entry.targetMip + 1];
+                ++entry.targetMip;
+                progress = true;
+                if (targetBytes_ <= settings_.budgetBytes) break;
+            }
+        }
+    }
+
+    order_.clear();
+    for (Handle handle = 0; handle < entries_.size(); ++handle) {
+        Entry& entry = entries_[handle];
+        if (!entry.alive || entry.pending) continue;
+        if (entry.targetMip > entry.desiredMip) ++budgetLimited_;
+        if (entry.targetMip > entry.residentMip) {
+            // Выгрузки сразу: они освобождают место под догрузки
+            out.push_back({handle, entry.residentMip, entry.targetMip, entry.screenSize});
+            entry.pending = true;
+        } else if (entry.targetMip < entry.residentMip) {
+            order_.push_back(handle);
+        }
+    }
+
+    const size_t loads = std::min(order_.size(), static_cast<size_t>(std::max(0, maxLoads)));
+    std::partial_sort(order_.begin(), order_.begin() + loads, order_.end(), [this](Handle a, Handle b) {
+        return entries_[a].screenSize > entries_[b].screenSize;
+    });
+    for (size_t i = 0; i < loads; ++i) {
+        Entry& entry = entries_[order_[i]];
+        out.push_back({order_[i], entry.residentMip, entry.targetMip, entry.screenSize});
+        entry.pending = true;
+    }
+}
+
+void TextureResidency::commit(Handle handle, int residentMip) {
+    if (handle >= entries_.size()) return;
+    Entry& entry = entries_[handle];
+    entry.residentMip = std::clamp(residentMip, 0, entry.tailMip);
+    entry.targetMip = entry.residentMip;
+    entry.pending = false;
+}
+
+TextureResidency::Stats TextureResidency::getStats() const {
+    Stats stats;
+    stats.targetBytes = targetBytes_;
+    stats.budgetBytes = settings_.budgetBytes;
+    stats.budgetLimited = budgetLimited_;
+    for (const Entry& entry : entries_) {
+        if (!entry.alive) continue;
+        ++stats.textures;
+        stats.residentBytes += entry.chainBytes[entry.residentMip];
+        stats.demanded += entry.demanded;
+        stats.pending += entry.pending;
+    }
+    return stats;
+}
+
+} // namespace kalan
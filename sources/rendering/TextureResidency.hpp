@@ -0,0 +1,117 @@
+#pragma once
+
+#include "raylib.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace kalan {
+
+// Решения о резидентности mip уровней стримящихся текстур. Только CPU, без GL —
+// TextureStreamer выполняет решения, бенчмарк texstream гоняет их без окна.
+//
+// Текстура резидентна от уровня residentMip до конца цепочки. Хвост — уровни,
+// большая сторона которых не больше Settings::tailSize, — резидентен всегда,
+// с него модель и появляется после загрузки.
+//
+// Спрос набирается за кадр (addDemand): желаемый уровень из экранной плотности
+// текселов и экранный размер объекта. plan() выбирает целевые уровни в пределах
+// бюджета: при нехватке по уровню теряют сначала текстуры с меньшим экранным размером.
+// Без спроса Settings::evictDelayFrames кадров текстура уходит в хвост.
+class TextureResidency {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle InvalidHandle = UINT32_MAX;
+    static constexpr int MaxMipCount = 16;         // до 32768 по стороне
+
+    struct Settings {
+        size_t budgetBytes = 512 * 1024 * 1024;    // резидентные цепочки всех текстур
+        int tailSize = 64;
+        float mipBias = 0.0f;                       // > 0 — грубее
+        int evictDelayFrames = 90;
+        // Выгружать на уровень грубее, только когда спрос грубее резидентного больше чем
+        // на столько уровней: камера, качающаяся у границы уровня, не гоняет загрузки
+        int hysteresisLevels = 1;
+    };
+
+    // Смена residentMip: toMip < fromMip — догрузить, иначе выгрузить
+    struct Request {
+        Handle handle = InvalidHandle;
+        int fromMip = 0;
+        int toMip = 0;
+        float screenSize = 0.0f;
+    };
+
+    struct Stats {
+        size_t textures = 0;
+        size_t residentBytes = 0;
+        size_t targetBytes = 0;     // цели последнего plan
+        size_t budgetBytes = 0;
+        int demanded = 0;           // со спросом в последнем кадре
+        int pending = 0;            // запросы без commit
+        int budgetLimited = 0;      // бюджет не дал желаемый уровень
+    };
+
+    // Число уровней полной цепочки (до 1x1)
+    [[nodiscard]] static int mipCountFor(int width, int height) noexcept;
+    // Первый уровень, большая сторона которого не больше tailSize
+    [[nodiscard]] static int tailMipFor(int width, int height, int tailSize) noexcept;
+    // Байты уровней от fromMip до конца цепочки
+    [[nodiscard]] static size_t chainBytes(int width, int height, int format, int fromMip);
+    // Уровень, на котором тексел примерно равен пикселю: texelsPerUnit — плотность
+    // уровня 0 на единицу мира, pixelsPerUnit — пикселей экрана на единицу мира у объекта
+    [[nodiscard]] static float screenMipLevel(float texelsPerUnit, float pixelsPerUnit) noexcept;
+    // Единиц UV на единицу длины меша: sqrt(площадь UV / площадь поверхности).
+    // 0 — нет UV или площади
+    [[nodiscard]] static float meshTexelDensity(const Mesh& mesh);
+
+    void setSettings(const Settings& settings) noexcept { settings_ = settings; }
+    [[nodiscard]] const Settings& getSettings() const noexcept { return settings_; }
+
+    // residentMip — уровень, который уже лежит в GPU (обычно хвост)
+    Handle add(int width, int height, int format, int residentMip);
+    void remove(Handle handle);
+    [[nodiscard]] int getResidentMip(Handle handle) const;
+    [[nodiscard]] int getTailMip(Handle handle) const;
+
+    // Раз в кадр перед addDemand
+    void beginFrame();
+    // mipLevel — из screenMipLevel, screenSize — размер объекта на экране в пикселях.
+    // Несколько вызовов за кадр: берётся самый детальный уровень и наибольший размер.
+    void addDemand(Handle handle, float mipLevel, float screenSize);
+
+    // Цели для всех текстур и запросы на смену уровня: сначала выгрузки, затем не больше
+    // maxLoads догрузок по убыванию экранного размера. Вернувшиеся запросы ждут commit,
+    // до него текстура в новых запросах не участвует.
+    void plan(std::vector<Request>& out, int maxLoads);
+    // Запрос выполнен (residentMip = toMip) или брошен (residentMip прежний)
+    void commit(Handle handle, int residentMip);
+
+    [[nodiscard]] Stats getStats() const;
+
+private:
+    struct Entry {
+        std::array<size_t, MaxMipCount + 1> chainBytes{};  // от уровня до конца цепочки
+        int tailMip = 0;
+        int residentMip = 0;
+        int targetMip = 0;
+        int desiredMip = 0;             // по спросу, до бюджета
+        float demandMip = 0.0f;
+        float screenSize = 0.0f;
+        uint64_t lastDemandFrame = 0;
+        bool demanded = false;          // спрос в текущем кадре
+        bool pending = false;
+        bool alive = false;
+    };
+
+    Settings settings_;
+    std::vector<Entry> entries_;
+    std::vector<Handle> freeHandles_;
+    std::vector<Handle> order_;         // временный, для бюджета и догрузок
+    uint64_t frame_ = 0;
+    size_t targetBytes_ = 0;
+    int budgetLimited_ = 0;
+};
+
+} // namespace kalan
@@ -0,0 +1,248 @@
+#include "TextureStreamer.hpp"
+#include "TextureUploader.hpp"
+#include "../scene/Components.hpp"
+#include "../scene/RenderSystem.hpp"
+#include "../core/Profiler.hpp"
+#include "raymath.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace kalan {
+
+namespace {
+
+bool isReady(const std::future<PreloadedImage>& future) {
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+// Наибольший масштаб по осям 3x3 части матрицы
+float maxScale(const Matrix& m) {
+    float x = m.m0 * m.m0 + m.m1 * m.m1 + m.m2 * m.m2;
+    float y = m.m4 * m.m4 + m.m5 * m.m5 + m.m6 * m.m6;
+    float z = m.m8 * m.m8 + m.m9 * m.m9 + m.m10 * m.m10;
+    return std::sqrt(std::max(x, std::max(y, z)));
+}
+
+} // anonymous namespace
+
+TextureStreamer& TextureStreamer::instance() noexcept {
+    static TextureStreamer streamer;
+    return streamer;
+}
+
+void TextureStreamer::setSettings(const Settings& settings) {
+    settings_ = settings;
+    residency_.setSettings(settings.residency);
+}
+
+void TextureStreamer::addModel(const std::shared_ptr<raylib::Model>& model, std::vector<TextureDesc> textures,
+                               std::vector<MeshDesc> meshes) {
+    if (!model || textures.empty()) {
+        for (TextureDesc& desc : textures) UnloadImage(desc.tail);
+        return;
+    }
+
+    // Адрес мог остаться от выгруженной модели, которую update ещё не убрал
+    if (auto it = models_.find(model.get()); it != models_.end()) {
+        removeModel(*it->second);
+        models_.erase(it);
+    }
+
+    auto streamed = std::make_unique<StreamedModel>();
+    streamed->model = model;
+    streamed->meshes = std::move(meshes);
+    streamed->materialTextures.resize(model->materialCount);
+    streamed->textures.resize(textures.size());
+    for (size_t i = 0; i < textures.size(); ++i) {
+        StreamedTexture& texture = streamed->textures[i];
+        texture.desc = std::move(textures[i]);
+        texture.handle = residency_.add(texture.desc.width, texture.desc.height, texture.desc.format,
+                                        texture.desc.tailMip);
+        if (texture.handle >= byHandle_.size()) byHandle_.resize(texture.handle + 1, {nullptr, 0});
+        byHandle_[texture.handle] = {streamed.get(), i};
+        for (const auto& [material, map] : texture.desc.slots) {
+            if (material >= 0 && material < model->materialCount) {
+                streamed->materialTextures[material].push_back(static_cast<int>(i));
+            }
+        }
+    }
+
+    TraceLog(LOG_INFO, "TextureStreamer: %zu textures of %d materials streamed",
+             streamed->textures.size(), model->materialCount);
+    models_.emplace(model.get(), std::move(streamed));
+}
+
+void TextureStreamer::removeModel(StreamedModel& streamed) {
+    // Текстуры в GPU выгрузила сама модель; остаются задачи и хвосты в RAM
+    for (StreamedTexture& texture : streamed.textures) {
+        if (texture.job.valid()) {
+            texture.token.cancel();
+            orphans_.push_back(std::move(texture.job));
+            --inFlight_;
+        }
+        residency_.remove(texture.handle);
+        byHandle_[texture.handle] = {nullptr, 0};
+        UnloadImage(texture.desc.tail);
+        texture.desc.tail = {};
+    }
+}
+
+void TextureStreamer::update(const entt::registry& registry, Vector3 cameraPosition) {
+    KALAN_PROFILE_FUNCTION();
+    for (auto it = models_.begin(); it != models_.end();) {
+        if (it->second->model.expired()) {
+            removeModel(*it->second);
+            it = models_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    std::erase_if(orphans_, [](const std::future<PreloadedImage>& job) { return isReady(job); });
+    if (models_.empty()) return;
+
+    collectJobs();
+    gatherDemand(registry, cameraPosition);
+
+    residency_.plan(requests_, settings_.maxInFlight - inFlight_);
+    for (const TextureResidency::Request& request : requests_) execute(request);
+}
+
+void TextureStreamer::collectJobs() {
+    TextureUploader& uploader = TextureUploader::instance();
+    for (auto& [key, streamed] : models_) {
+        std::shared_ptr<raylib::Model> model = streamed->model.lock();
+        if (!model) continue;
+        for (StreamedTexture& texture : streamed->textures) {
+            // Бюджет upload кончился — остальное в следующих кадрах
+            if (!uploader.hasFrameBudget()) return;
+            if (!texture.job.valid() || !isReady(texture.job)) continue;
+
+            PreloadedImage image = texture.job.get();
+            --inFlight_;
+            int residentMip = residency_.getResidentMip(texture.handle);
+            if (image.valid && image.image.data) {
+                const int level = image.mipLevel;
+                Texture2D replacement = gpu::uploadPreloaded(image, true);
+                if (replacement.id != 0) {
+                    if (level < residentMip) ++streamedIn_;
+                    else ++evicted_;
+                    replaceTexture(*model, texture, replacement);
+                    residentMip = level;
+                }
+            } else {
+                ++failed_;
+            }
+            residency_.commit(texture.handle, residentMip);
+        }
+    }
+}
+
+void TextureStreamer::gatherDemand(const entt::registry& registry, Vector3 cameraPosition) {
+    residency_.beginFrame();
+
+    const Matrix projection = rlGetMatrixProjection();
+    const Frustum frustum = Frustum::fromMatrix(MatrixMultiply(rlGetMatrixModelview(), projection));
+    // Пикселей на единицу мира на расстоянии 1 (для ортографии — на любом)
+    const float pixelsAtUnit = 0.5f * static_cast<float>(GetScreenHeight()) * projection.m5;
+    const bool orthographic = projection.m15 == 1.0f;
+
+    auto view = registry.view<const MeshRenderer, const WorldTransform>();
+    for (auto [entity, renderer, world] : view.each()) {
+        if (!renderer.visible || !renderer.model) continue;
+        auto it = models_.find(renderer.model.get());
+        if (it == models_.end()) continue;
+        const StreamedModel& streamed = *it->second;
+        const raylib::Model& model = *renderer.model;
+
+        const Matrix transform = MatrixMultiply(model.transform, world.matrix);
+        const float scale = std::max(maxScale(transform), 1e-6f);
+        const int meshCount = std::min(model.meshCount, static_cast<int>(streamed.meshes.size()));
+        const int first = renderer.meshIndex < 0 ? 0 : renderer.meshIndex;
+        const int last = renderer.meshIndex < 0 ? meshCount : std::min(renderer.meshIndex + 1, meshCount);
+
+        for (int i = first; i < last; ++i) {
+            const int material = model.meshMaterial[i];
+            if (material < 0 || material >= static_cast<int>(streamed.materialTextures.size())) continue;
+            if (streamed.materialTextures[material].empty()) continue;
+
+            const BoundingBox box = transformBounds(streamed.meshes[i].bounds, transform);
+            if (!frustum.intersects(box)) continue;
+
+            // Ближайшая к камере точка bounds: крупный меш рядом нужен в полном разрешении
+            const Vector3 closest = Vector3Clamp(cameraPosition, box.min, box.max);
+            const float distance = std::max(Vector3Distance(cameraPosition, closest), 0.01f);
+            const float pixelsPerUnit = orthographic ? pixelsAtUnit : pixelsAtUnit / distance;
+            const float screenSize = Vector3Distance(box.min, box.max) * pixelsPerUnit;
+            const float uvPerUnit = streamed.meshes[i].texelDensity / scale;
+
+            for (int index : streamed.materialTextures[material]) {
+                const StreamedTexture& texture = streamed.textures[index];
+                const float texels = std::sqrt(static_cast<float>(texture.desc.width) * texture.desc.height);
+                residency_.addDemand(texture.handle,
+                                     TextureResidency::screenMipLevel(uvPerUnit * texels, pixelsPerUnit),
+                                     screenSize);
+            }
+        }
+    }
+}
+
+void TextureStreamer::execute(const TextureResidency::Request& request) {
+    auto [streamed, index] = byHandle_[request.handle];
+    StreamedTexture& texture = streamed->textures[index];
+
+    if (request.toMip >= texture.desc.tailMip) {
+        // Хвост всегда в RAM — выгрузка без декодирования
+        std::shared_ptr<raylib::Model> model = streamed->model.lock();
+        Texture2D replacement = model ? TextureUploader::instance().upload(texture.desc.tail, 0, true) : Texture2D{0};
+        if (replacement.id == 0) {
+            residency_.commit(request.handle, request.fromMip);
+            return;
+        }
+        replaceTexture(*model, texture, replacement);
+        residency_.commit(request.handle, texture.desc.tailMip);
+        ++evicted_;
+        return;
+    }
+
+    ImageThreadPool& pool = ParallelModelLoader::instance().getThreadPool();
+    texture.token = JobToken::create(JobPriority::Prefetch);
+    texture.job = pool.submit([source = texture.desc.source, level = request.toMip, token = texture.token]() {
+        if (token.isCancelled()) return PreloadedImage{};
+        return decodeImageLevel(source, level, 0, true);
+    }, JobPriority::Prefetch, texture.token);
+    ++inFlight_;
+}
+
+void TextureStreamer::replaceTexture(raylib::Model& model, const StreamedTexture& texture, Texture2D replacement) {
+    // Все слоты делят один id (загрузчик грузит изображение один раз)
+    unsigned int previous = 0;
+    for (const auto& [material, map] : texture.desc.slots) {
+        Texture2D& slot = model.materials[material].maps[map].texture;
+        previous = slot.id;
+        slot = replacement;
+    }
+    if (previous > 1 && previous != replacement.id) rlUnloadTexture(previous);
+}
+
+void TextureStreamer::shutdown() {
+    for (auto& [key, streamed] : models_) removeModel(*streamed);
+    models_.clear();
+    for (auto& job : orphans_) job.wait();
+    orphans_.clear();
+    inFlight_ = 0;
+}
+
+TextureStreamer::Stats TextureStreamer::getStats() const {
+    Stats stats;
+    stats.residency = residency_.getStats();
+    stats.models = static_cast<int>(models_.size());
+    stats.inFlight = inFlight_;
+    stats.streamedIn = streamedIn_;
+    stats.evicted = evicted_;
+    stats.failed = failed_;
+    return stats;
+}
+
+} // namespace kalan
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "TextureResidency.hpp"
+#include "../resources/ParallelLoader.hpp"
+#include "raylib-cpp.hpp"
+#include <entt/entt.hpp>
+#include <future>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace kalan {
+
+// Стриминг mip уровней текстур моделей (LoadOptions::streamTextures).
+//
+// После загрузки в GPU лежит только хвост цепочки. Раз в кадр update() оценивает
+// по видимым MeshRenderer экранную плотность текселов, TextureResidency выбирает
+// уровни в пределах бюджета, а недостающие декодируются заново из источника на
+// воркерах загрузчика (JobPriority::Prefetch) и подменяют текстуру в материалах модели.
+// Выгрузка до хвоста мгновенная — из копии хвоста в RAM, до остальных уровней
+// идёт тем же путём, что и догрузка.
+//
+// Только главный поток.
+class TextureStreamer {
+public:
+    struct Settings {
+        TextureResidency::Settings residency;
+        int maxInFlight = 4;            // декодирований уровней одновременно
+    };
+
+    struct Stats {
+        TextureResidency::Stats residency;
+        int models = 0;
+        int inFlight = 0;
+        uint64_t streamedIn = 0;        // уровни, поднятые догрузкой
+        uint64_t evicted = 0;
+        uint64_t failed = 0;            // источник не декодировался
+    };
+
+    // Стримящаяся текстура модели: сжатый источник, размер уровня 0 и слоты материалов,
+    // где она стоит. tail — копия резидентного уровня tailMip, владение переходит стримеру.
+    struct TextureDesc {
+        ImageSource source;
+        int width = 0;
+        int height = 0;
+        int format = 0;
+        Image tail{};
+        int tailMip = 0;
+        std::vector<std::pair<int, int>> slots;     // (материал, MATERIAL_MAP_*)
+    };
+
+    // Локальные bounds и плотность UV меша (TextureResidency::meshTexelDensity);
+    // считаются по float вершинам, до квантования
+    struct MeshDesc {
+        BoundingBox bounds{};
+        float texelDensity = 0.0f;
+    };
+
+    static TextureStreamer& instance() noexcept;
+
+    void setSettings(const Settings& settings);
+    [[nodiscard]] const Settings& getSettings() const noexcept { return settings_; }
+
+    // Модель выгружается как обычно; её текстуры снимаются со стриминга в следующем update
+    void addModel(const std::shared_ptr<raylib::Model>& model, std::vector<TextureDesc> textures,
+                  std::vector<MeshDesc> meshes);
+
+    // Раз в кадр внутри BeginMode3D, до RenderSystem::submit: фрустум и проекция
+    // берутся из текущих матриц rlgl, как у RenderSystem
+    void update(const entt::registry& registry, Vector3 cameraPosition);
+
+    // Отменить загрузки и забыть модели; до закрытия окна
+    void shutdown();
+
+    [[nodiscard]] Stats getStats() const;
+
+private:
+    TextureStreamer() = default;
+
+    struct StreamedTexture {
+        TextureDesc desc;
+        TextureResidency::Handle handle = TextureResidency::InvalidHandle;
+        std::future<PreloadedImage> job;
+        JobToken token;
+    };
+
+    struct StreamedModel {
+        std::weak_ptr<raylib::Model> model;
+        std::vector<StreamedTexture> textures;
+        std::vector<MeshDesc> meshes;
+        std::vector<std::vector<int>> materialTextures;    // индексы в textures по материалам
+    };
+
+    void removeModel(StreamedModel& streamed);
+    void collectJobs();
+    void gatherDemand(const entt::registry& registry, Vector3 cameraPosition);
+    void execute(const TextureResidency::Request& request);
+    static void replaceTexture(raylib::Model& model, const StreamedTexture& texture, Texture2D replacement);
+
+    Settings settings_;
+    TextureResidency residency_;
+    std::unordered_map<const raylib::Model*, std::unique_ptr<StreamedModel>> models_;
+    // Handle -> модель и индекс текстуры в ней
+    std::vector<std::pair<StreamedModel*, size_t>> byHandle_;
+    std::vector<TextureResidency::Request> requests_;
+    // Задачи выгруженных моделей: отменены, ждут завершения
+    std::vector<std::future<PreloadedImage>> orphans_;
+
+    int inFlight_ = 0;
+    uint64_t streamedIn_ = 0;
+    uint64_t evicted_ = 0;
+    uint64_t failed_ = 0;
+};
+
+} // namespace kalan
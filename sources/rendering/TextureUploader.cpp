@@ -0,0 +1,291 @@
+#include "TextureUploader.hpp"
+#include "../core/Profiler.hpp"
+#include "rlgl.h"
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+// raylib на десктопе собран с GLFW; указатели на функции GL 4.4, которых нет в rlgl,
+// берём у него же
+using GLFWglproc = void (*)();
+extern "C" GLFWglproc glfwGetProcAddress(const char* procname);
+
+namespace kalan {
+
+namespace {
+
+#if defined(_WIN32)
+#define KALAN_GL_APIENTRY __stdcall
+#else
+#define KALAN_GL_APIENTRY
+#endif
+
+// Константы GL, которых нет среди констант rlgl
+constexpr unsigned int GlPixelUnpackBuffer = 0x88EC;
+constexpr unsigned int GlMapWriteBit = 0x0002;
+constexpr unsigned int GlMapPersistentBit = 0x0040;
+constexpr unsigned int GlMapCoherentBit = 0x0080;
+constexpr unsigned int GlSyncGpuCommandsComplete = 0x9117;
+constexpr unsigned int GlAlreadySignaled = 0x911A;
+constexpr unsigned int GlConditionSatisfied = 0x911C;
+constexpr unsigned int GlSyncFlushCommandsBit = 0x0001;
+constexpr unsigned int GlMajorVersion = 0x821B;
+constexpr unsigned int GlMinorVersion = 0x821C;
+constexpr unsigned int GlNumExtensions = 0x821D;
+constexpr unsigned int GlExtensions = 0x1F03;
+constexpr unsigned int GlUnpackAlignment = 0x0CF5;
+
+constexpr size_t RegionAlignment = 64;
+
+struct GlFunctions {
+    void (KALAN_GL_APIENTRY* GenBuffers)(int, unsigned int*) = nullptr;
+    void (KALAN_GL_APIENTRY* DeleteBuffers)(int, const unsigned int*) = nullptr;
+    void (KALAN_GL_APIENTRY* BindBuffer)(unsigned int, unsigned int) = nullptr;
+    void (KALAN_GL_APIENTRY* BufferStorage)(unsigned int, ptrdiff_t, const void*, unsigned int) = nullptr;
+    void* (KALAN_GL_APIENTRY* MapBufferRange)(unsigned int, ptrdiff_t, ptrdiff_t, unsigned int) = nullptr;
+    unsigned char (KALAN_GL_APIENTRY* UnmapBuffer)(unsigned int) = nullptr;
+    void* (KALAN_GL_APIENTRY* FenceSync)(unsigned int, unsigned int) = nullptr;
+    unsigned int (KALAN_GL_APIENTRY* ClientWaitSync)(void*, unsigned int, uint64_t) = nullptr;
+    void (KALAN_GL_APIENTRY* DeleteSync)(void*) = nullptr;
+    void (KALAN_GL_APIENTRY* GetIntegerv)(unsigned int, int*) = nullptr;
+    const unsigned char* (KALAN_GL_APIENTRY* GetStringi)(unsigned int, unsigned int) = nullptr;
+    void (KALAN_GL_APIENTRY* PixelStorei)(unsigned int, int) = nullptr;
+
+    bool load() {
+        auto get = [](auto& fn, const char* name) {
+            fn = reinterpret_cast<std::remove_reference_t<decltype(fn)>>(glfwGetProcAddress(name));
+            return fn != nullptr;
+        };
+        return get(GenBuffers, "glGenBuffers") && get(DeleteBuffers, "glDeleteBuffers") &&
+               get(BindBuffer, "glBindBuffer") && get(BufferStorage, "glBufferStorage") &&
+               get(MapBufferRange, "glMapBufferRange") && get(UnmapBuffer, "glUnmapBuffer") &&
+               get(FenceSync, "glFenceSync") && get(ClientWaitSync, "glClientWaitSync") &&
+               get(DeleteSync, "glDeleteSync") && get(GetIntegerv, "glGetIntegerv") &&
+               get(GetStringi, "glGetStringi") && get(PixelStorei, "glPixelStorei");
+    }
+
+    // glBufferStorage может найтись и без поддержки — проверяем версию и расширение
+    [[nodiscard]] bool hasBufferStorage() const {
+        int major = 0;
+        int minor = 0;
+        GetIntegerv(GlMajorVersion, &major);
+        GetIntegerv(GlMinorVersion, &minor);
+        if (major > 4 || (major == 4 && minor >= 4)) return true;
+
+        int count = 0;
+        GetIntegerv(GlNumExtensions, &count);
+        for (int i = 0; i < count; ++i) {
+            const auto* name = reinterpret_cast<const char*>(GetStringi(GlExtensions, static_cast<unsigned int>(i)));
+            if (name && std::string_view(name) == "GL_ARB_buffer_storage") return true;
+        }
+        return false;
+    }
+};
+
+GlFunctions gl;
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+Texture2D uploadDirect(const Image& image, bool genMipmaps) {
+    Texture2D texture = LoadTextureFromImage(image);
+    if (genMipmaps && texture.id != 0) {
+        GenTextureMipmaps(&texture);
+        SetTextureFilter(texture, TEXTURE_FILTER_TRILINEAR);
+    }
+    return texture;
+}
+
+} // anonymous namespace
+
+TextureUploader& TextureUploader::instance() noexcept {
+    static TextureUploader uploader;
+    return uploader;
+}
+
+bool TextureUploader::init(const Settings& settings) {
+    shutdown();
+    settings_ = settings;
+    settings_.ringBytes = alignUp(settings_.ringBytes, RegionAlignment);
+
+    if (!gl.load() || !gl.hasBufferStorage()) {
+        TraceLog(LOG_WARNING, "TextureUploader: GL_ARB_buffer_storage unavailable, uploads stay synchronous");
+        return false;
+    }
+
+    gl.GenBuffers(1, &buffer_);
+    gl.BindBuffer(GlPixelUnpackBuffer, buffer_);
+    const unsigned int flags = GlMapWriteBit | GlMapPersistentBit | GlMapCoherentBit;
+    gl.BufferStorage(GlPixelUnpackBuffer, static_cast<ptrdiff_t>(settings_.ringBytes), nullptr, flags);
+    mapped_ = static_cast<unsigned char*>(
+        gl.MapBufferRange(GlPixelUnpackBuffer, 0, static_cast<ptrdiff_t>(settings_.ringBytes), flags));
+    gl.BindBuffer(GlPixelUnpackBuffer, 0);
+
+    if (!mapped_) {
+        TraceLog(LOG_WARNING, "TextureUploader: failed to map %zu byte staging ring", settings_.ringBytes);
+        gl.DeleteBuffers(1, &buffer_);
+        buffer_ = 0;
+        return false;
+    }
+
+    TraceLog(LOG_INFO, "TextureUploader: %.0f MB persistent staging ring",
+             static_cast<double>(settings_.ringBytes) / (1024.0 * 1024.0));
+    return true;
+}
+
+void TextureUploader::shutdown() {
+    if (!buffer_) return;
+    std::lock_guard lock(mutex_);
+    // Ждём GPU: буфер нельзя удалять, пока из него копируют
+    retireLocked(true);
+    for (Region& region : regions_) {
+        if (region.fence) gl.DeleteSync(region.fence);
+    }
+    regions_.clear();
+    head_ = 0;
+
+    gl.BindBuffer(GlPixelUnpackBuffer, buffer_);
+    gl.UnmapBuffer(GlPixelUnpackBuffer);
+    gl.BindBuffer(GlPixelUnpackBuffer, 0);
+    gl.DeleteBuffers(1, &buffer_);
+    buffer_ = 0;
+    mapped_ = nullptr;
+}
+
+TextureUploader::Staged TextureUploader::stage(const Image& image) {
+    if (!mapped_ || !image.data || image.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB) return {};
+    // Без mip уровней: их строит GPU после копии
+    const size_t bytes = static_cast<size_t>(GetPixelDataSize(image.width, image.height, image.format));
+    const size_t reserved = alignUp(bytes, RegionAlignment);
+
+    Region* region = nullptr;
+    {
+        std::lock_guard lock(mutex_);
+        const size_t ring = settings_.ringBytes;
+        const size_t tail = regions_.empty() ? 0 : regions_.front().offset;
+        if (regions_.empty()) head_ = 0;
+
+        // tail < head — занятое не переходит через конец кольца, иначе переходит
+        size_t offset = ring;
+        if (regions_.empty() || tail < head_) {
+            if (head_ + reserved <= ring) offset = head_;
+            else if (reserved <= tail) offset = 0;
+        } else if (head_ + reserved <= tail) {
+            offset = head_;
+        }
+        if (offset == ring) {
+            ++stageFailures_;
+            return {};
+        }
+
+        region = &regions_.emplace_back();
+        region->id = nextId_++;
+        region->offset = offset;
+        region->bytes = reserved;
+        head_ = offset + reserved;
+    }
+
+    // Ссылки на элементы deque не меняются при добавлении в конец и удалении из начала,
+    // а этот участок не освободится до upload/discard
+    std::memcpy(mapped_ + region->offset, image.data, bytes);
+    return {region->id, mapped_ + region->offset};
+}
+
+void TextureUploader::discard(uint64_t id) {
+    if (id == 0) return;
+    std::lock_guard lock(mutex_);
+    if (Region* region = findLocked(id)) region->state = RegionState::Free;
+}
+
+TextureUploader::Region* TextureUploader::findLocked(uint64_t id) {
+    for (Region& region : regions_) {
+        if (region.id == id) return &region;
+    }
+    return nullptr;
+}
+
+Texture2D TextureUploader::upload(const Image& image, uint64_t staging, bool genMipmaps) {
+    KALAN_PROFILE_FUNCTION();
+    if (!image.data) return {};
+    frameBytes_ += static_cast<size_t>(GetPixelDataSize(image.width, image.height, image.format));
+
+    std::unique_lock lock(mutex_);
+    if (buffer_) retireLocked(false);
+    Region* region = staging ? findLocked(staging) : nullptr;
+    if (!region) {
+        ++directUploads_;
+        lock.unlock();
+        return uploadDirect(image, genMipmaps);
+    }
+
+    // Хранилище без данных, затем копия из PBO: offset передаётся вместо указателя
+    Texture2D texture{};
+    texture.id = rlLoadTexture(nullptr, image.width, image.height, image.format, 1);
+    texture.width = image.width;
+    texture.height = image.height;
+    texture.mipmaps = 1;
+    texture.format = image.format;
+    if (texture.id == 0) {
+        region->state = RegionState::Free;
+        return texture;
+    }
+
+    gl.PixelStorei(GlUnpackAlignment, 1);
+    gl.BindBuffer(GlPixelUnpackBuffer, buffer_);
+    rlUpdateTexture(texture.id, 0, 0, image.width, image.height, image.format,
+                    reinterpret_cast<const void*>(region->offset));
+    gl.BindBuffer(GlPixelUnpackBuffer, 0);
+
+    region->fence = gl.FenceSync(GlSyncGpuCommandsComplete, 0);
+    region->state = RegionState::Submitted;
+    ++stagedUploads_;
+    lock.unlock();
+
+    if (genMipmaps) {
+        GenTextureMipmaps(&texture);
+        SetTextureFilter(texture, TEXTURE_FILTER_TRILINEAR);
+    }
+    return texture;
+}
+
+void TextureUploader::retireLocked(bool wait) {
+    // Участки освобождаются по порядку: кольцо сдвигается только с начала
+    while (!regions_.empty()) {
+        Region& region = regions_.front();
+        if (region.state == RegionState::Staged) {
+            if (!wait) break;
+            region.state = RegionState::Free;   // shutdown: upload уже не придёт
+        }
+        if (region.state == RegionState::Submitted) {
+            const uint64_t timeout = wait ? UINT64_MAX : 0;
+            unsigned int status = gl.ClientWaitSync(region.fence, wait ? GlSyncFlushCommandsBit : 0, timeout);
+            if (status != GlAlreadySignaled && status != GlConditionSatisfied) break;
+            gl.DeleteSync(region.fence);
+            region.fence = nullptr;
+        }
+        regions_.pop_front();
+    }
+}
+
+void TextureUploader::beginFrame() {
+    frameBytes_ = 0;
+    if (!buffer_) return;
+    std::lock_guard lock(mutex_);
+    retireLocked(false);
+}
+
+TextureUploader::Stats TextureUploader::getStats() const {
+    Stats stats;
+    stats.persistent = isPersistent();
+    stats.ringBytes = mapped_ ? settings_.ringBytes : 0;
+    stats.frameBytes = frameBytes_;
+    std::lock_guard lock(mutex_);
+    for (const Region& region : regions_) stats.ringUsed += region.bytes;
+    stats.stagedUploads = stagedUploads_;
+    stats.directUploads = directUploads_;
+    stats.stageFailures = stageFailures_;
+    return stats;
+}
+
+} // namespace kalan
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace kalan {
+
+// Асинхронная загрузка текстур через кольцо постоянно отображённого PBO
+// (GL_ARB_buffer_storage, persistent + coherent).
+//
+// Воркер декодирования копирует пиксели в кольцо (stage), главный поток только
+// создаёт текстуру и ставит glTexSubImage из PBO — драйвер не копирует пиксели
+// внутри вызова. Участок кольца освобождается, когда GPU прошёл fence после копии.
+//
+// Без буфера (нет GL 4.4/расширения, init не вызывали) stage всегда отказывает,
+// а upload грузит синхронно через LoadTextureFromImage.
+class TextureUploader {
+public:
+    struct Settings {
+        size_t ringBytes = 64 * 1024 * 1024;
+        // Сколько байт upload за кадр; стриминг проверяет hasFrameBudget()
+        size_t frameBudgetBytes = 32 * 1024 * 1024;
+    };
+
+    struct Stats {
+        bool persistent = false;
+        size_t ringBytes = 0;
+        size_t ringUsed = 0;            // занято участками, ждущими upload или fence
+        uint64_t stagedUploads = 0;     // из PBO
+        uint64_t directUploads = 0;     // синхронно, мимо кольца
+        uint64_t stageFailures = 0;     // кольцо было заполнено
+        size_t frameBytes = 0;          // отправлено в текущем кадре
+    };
+
+    // Участок кольца с пикселями одного изображения
+    struct Staged {
+        uint64_t id = 0;                // 0 — не удалось
+        void* data = nullptr;
+    };
+
+    static TextureUploader& instance() noexcept;
+
+    // После создания окна (нужен GL контекст); false — остаётся синхронный путь
+    bool init(const Settings& settings);
+    bool init() { return init(Settings{}); }
+    // До закрытия окна
+    void shutdown();
+    [[nodiscard]] bool isPersistent() const noexcept { return mapped_ != nullptr; }
+
+    // Любой поток: скопировать пиксели несжатого изображения в кольцо.
+    // Не блокирует: при нехватке места возвращает пустой Staged.
+    [[nodiscard]] Staged stage(const Image& image);
+    // Любой поток: участок больше не нужен (загрузка отменена)
+    void discard(uint64_t id);
+
+    // Главный поток: создать текстуру. staging == 0 — синхронно из image.data.
+    // Данные участка нельзя трогать после вызова.
+    Texture2D upload(const Image& image, uint64_t staging, bool genMipmaps);
+
+    // Главный поток, раз в кадр: освободить пройденные GPU участки, сбросить бюджет
+    void beginFrame();
+    [[nodiscard]] bool hasFrameBudget() const noexcept { return frameBytes_ < settings_.frameBudgetBytes; }
+
+    [[nodiscard]] Stats getStats() const;
+
+private:
+    TextureUploader() = default;
+
+    enum class RegionState : uint8_t {
+        Staged,     // пишется или ждёт upload
+        Submitted,  // копия в текстуру поставлена, ждём fence
+        Free,       // отброшен, освободится вместе с предыдущими
+    };
+
+    struct Region {
+        uint64_t id = 0;
+        size_t offset = 0;
+        size_t bytes = 0;
+        RegionState state = RegionState::Staged;
+        void* fence = nullptr;          // GLsync
+    };
+
+    void retireLocked(bool wait);       // под mutex_, только главный поток
+    Region* findLocked(uint64_t id);
+
+    Settings settings_;
+    unsigned int buffer_ = 0;
+    unsigned char* mapped_ = nullptr;
+
+    mutable std::mutex mutex_;
+    std::deque<Region> regions_;        // в порядке выделения
+    size_t head_ = 0;                   // конец последнего участка
+    uint64_t nextId_ = 1;
+
+    size_t frameBytes_ = 0;
+    uint64_t stagedUploads_ = 0;
+    uint64_t directUploads_ = 0;
+    uint64_t stageFailures_ = 0;
+};
+
+} // namespace kalan
@@ -0,0 +1,228 @@
+#include "AnimationImport.hpp"
+#include "AssimpConvert.hpp"
+#include "raymath.h"
+#include <assimp/scene.h>
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace kalan {
+
+namespace {
+
+JointTransform DecomposeNode(const aiNode* node) {
+    aiVector3D scaling, position;
+    aiQuaternion rotation;
+    node->mTransformation.Decompose(scaling, rotation, position);
+    JointTransform joint;
+    joint.translation = {position.x, position.y, position.z};
+    joint.rotation = {rotation.x, rotation.y, rotation.z, rotation.w};
+    joint.scale = {scaling.x, scaling.y, scaling.z};
+    return joint;
+}
+
+// Нужен ли узел скелету: сам он кость, меш или анимирован, либо такой есть среди потомков
+bool MarkJointNodes(const aiNode* node, const std::unordered_set<std::string>& referenced,
+                    std::unordered_set<const aiNode*>& marked) {
+    bool needed = node->mNumMeshes > 0 || referenced.count(node->mName.C_Str()) > 0;
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        needed |= MarkJointNodes(node->mChildren[i], referenced, marked);
+    }
+    if (needed) marked.insert(node);
+    return needed;
+}
+
+void CollectJoints(const aiNode* node, int parent, const std::unordered_set<const aiNode*>& marked,
+                   Skeleton& skeleton, std::vector<int>& meshJoints) {
+    if (!marked.count(node)) return;
+
+    const int index = skeleton.getJointCount();
+    skeleton.names.emplace_back(node->mName.C_Str());
+    skeleton.parents.push_back(parent);
+    skeleton.bindPose.push_back(DecomposeNode(node));
+    for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+        const unsigned int mesh = node->mMeshes[i];
+        if (mesh < meshJoints.size() && meshJoints[mesh] < 0) meshJoints[mesh] = index;
+    }
+
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        CollectJoints(node->mChildren[i], index, marked, skeleton, meshJoints);
+    }
+}
+
+void CollectMeshTransforms(const aiNode* node, const aiMatrix4x4& parent,
+                           std::vector<Matrix>& out, std::vector<bool>& assigned) {
+    const aiMatrix4x4 global = parent * node->mTransformation;
+    for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+        const unsigned int mesh = node->mMeshes[i];
+        if (mesh < out.size() && !assigned[mesh]) {
+            out[mesh] = ConvertAssimpMatrix(global);
+            assigned[mesh] = true;
+        }
+    }
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        CollectMeshTransforms(node->mChildren[i], global, out, assigned);
+    }
+}
+
+} // anonymous namespace
+
+// ============ Skeleton ============
+
+bool buildSkeleton(const aiScene* scene, Skeleton& out, std::vector<int>& meshJoints) {
+    out = Skeleton{};
+    meshJoints.assign(scene->mNumMeshes, -1);
+
+    // Узлы, на которые ссылаются кости и каналы анимаций
+    std::unordered_set<std::string> referenced;
+    bool hasBones = false;
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh* mesh = scene->mMeshes[m];
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            referenced.insert(mesh->mBones[b]->mName.C_Str());
+            hasBones = true;
+        }
+    }
+    for (unsigned int a = 0; a < scene->mNumAnimations; ++a) {
+        const aiAnimation* anim = scene->mAnimations[a];
+        for (unsigned int c = 0; c < anim->mNumChannels; ++c) {
+            referenced.insert(anim->mChannels[c]->mNodeName.C_Str());
+        }
+    }
+    if (!hasBones && scene->mNumAnimations == 0) return false;
+
+    std::unordered_set<const aiNode*> marked;
+    MarkJointNodes(scene->mRootNode, referenced, marked);
+    if (marked.size() > static_cast<size_t>(MaxSkeletonJoints)) return false;
+    CollectJoints(scene->mRootNode, -1, marked, out, meshJoints);
+
+    // Суставы без кости: inverseBind — обратная к матрице покоя
+    std::vector<Matrix> bindModel(out.getJointCount());
+    computeModelMatrices(out, out.bindPose, bindModel.data());
+    out.inverseBind.resize(bindModel.size());
+    for (size_t i = 0; i < bindModel.size(); ++i) {
+        out.inverseBind[i] = MatrixInvert(bindModel[i]);
+    }
+
+    // Кости: offset matrix ассета (первая встреченная, если кость общая у нескольких мешей)
+    std::vector<bool> fromBone(out.getJointCount(), false);
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh* mesh = scene->mMeshes[m];
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            const int joint = out.findJoint(mesh->mBones[b]->mName.C_Str());
+            if (joint < 0 || fromBone[joint]) continue;
+            out.inverseBind[joint] = ConvertAssimpMatrix(mesh->mBones[b]->mOffsetMatrix);
+            fromBone[joint] = true;
+        }
+    }
+    return true;
+}
+
+// ============ Clips ============
+
+std::vector<AnimationClip> convertAnimations(const aiScene* scene, const Skeleton& skeleton) {
+    std::vector<AnimationClip> clips;
+    clips.reserve(scene->mNumAnimations);
+
+    for (unsigned int a = 0; a < scene->mNumAnimations; ++a) {
+        const aiAnimation* anim = scene->mAnimations[a];
+        // Тики в секунду не всегда заданы (часть форматов пишет 0)
+        const double ticksPerSecond = anim->mTicksPerSecond > 0.0 ? anim->mTicksPerSecond : 25.0;
+        auto seconds = [ticksPerSecond](double ticks) { return static_cast<float>(ticks / ticksPerSecond); };
+
+        AnimationClip clip;
+        clip.name = anim->mName.length > 0 ? anim->mName.C_Str() : "clip_" + std::to_string(a);
+        clip.duration = seconds(anim->mDuration);
+
+        for (unsigned int c = 0; c < anim->mNumChannels; ++c) {
+            const aiNodeAnim* channel = anim->mChannels[c];
+            AnimationTrack track;
+            track.joint = skeleton.findJoint(channel->mNodeName.C_Str());
+            if (track.joint < 0) continue;
+
+            for (unsigned int k = 0; k < channel->mNumPositionKeys; ++k) {
+                const aiVectorKey& key = channel->mPositionKeys[k];
+                track.translationTimes.push_back(seconds(key.mTime));
+                track.translations.push_back({key.mValue.x, key.mValue.y, key.mValue.z});
+            }
+            for (unsigned int k = 0; k < channel->mNumRotationKeys; ++k) {
+                const aiQuatKey& key = channel->mRotationKeys[k];
+                track.rotationTimes.push_back(seconds(key.mTime));
+                track.rotations.push_back({key.mValue.x, key.mValue.y, key.mValue.z, key.mValue.w});
+            }
+            for (unsigned int k = 0; k < channel->mNumScalingKeys; ++k) {
+                const aiVectorKey& key = channel->mScalingKeys[k];
+                track.scaleTimes.push_back(seconds(key.mTime));
+                track.scales.push_back({key.mValue.x, key.mValue.y, key.mValue.z});
+            }
+            clip.tracks.push_back(std::move(track));
+        }
+
+        // Дорожки по порядку суставов: сэмплинг идёт по скелету сверху вниз
+        std::sort(clip.tracks.begin(), clip.tracks.end(),
+                  [](const AnimationTrack& l, const AnimationTrack& r) { return l.joint < r.joint; });
+        clips.push_back(std::move(clip));
+    }
+    return clips;
+}
+
+// ============ Skin ============
+
+void convertMeshSkin(const aiMesh* aiM, const Skeleton& skeleton, int rigidJoint, Mesh& mesh) {
+    const int vertexCount = mesh.vertexCount;
+    rigidJoint = std::clamp(rigidJoint, 0, std::max(skeleton.getJointCount() - 1, 0));
+
+    mesh.boneIds = (unsigned char*)MemAlloc(vertexCount * 4 * sizeof(unsigned char));
+    mesh.boneWeights = (float*)MemAlloc(vertexCount * 4 * sizeof(float));
+    mesh.boneCount = skeleton.getJointCount();
+
+    if (aiM->mNumBones == 0) {
+        // Жёсткий меш узла: вершины в пространство модели покоя, весь вес — суставу узла
+        if (rigidJoint < static_cast<int>(skeleton.inverseBind.size())) {
+            TransformMeshVertices(mesh, MatrixInvert(skeleton.inverseBind[rigidJoint]));
+        }
+        for (int v = 0; v < vertexCount; ++v) {
+            mesh.boneIds[v * 4] = static_cast<unsigned char>(rigidJoint);
+            mesh.boneWeights[v * 4] = 1.0f;
+        }
+        return;
+    }
+
+    // Четыре наибольших веса на вершину (LimitBoneWeights уже обрезал, но не все форматы)
+    for (unsigned int b = 0; b < aiM->mNumBones; ++b) {
+        const aiBone* bone = aiM->mBones[b];
+        const int joint = skeleton.findJoint(bone->mName.C_Str());
+        if (joint < 0) continue;
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            const aiVertexWeight& weight = bone->mWeights[w];
+            if (weight.mVertexId >= static_cast<unsigned int>(vertexCount) || weight.mWeight <= 0.0f) continue;
+            float* weights = &mesh.boneWeights[weight.mVertexId * 4];
+            const int slot = static_cast<int>(std::min_element(weights, weights + 4) - weights);
+            if (weights[slot] >= weight.mWeight) continue;
+            weights[slot] = weight.mWeight;
+            mesh.boneIds[weight.mVertexId * 4 + slot] = static_cast<unsigned char>(joint);
+        }
+    }
+
+    for (int v = 0; v < vertexCount; ++v) {
+        float* weights = &mesh.boneWeights[v * 4];
+        const float sum = weights[0] + weights[1] + weights[2] + weights[3];
+        if (sum <= 0.0f) {
+            // Вершина без весов иначе схлопнется в начало координат
+            mesh.boneIds[v * 4] = static_cast<unsigned char>(rigidJoint);
+            weights[0] = 1.0f;
+            continue;
+        }
+        for (int k = 0; k < 4; ++k) weights[k] /= sum;
+    }
+}
+
+std::vector<Matrix> meshNodeTransforms(const aiScene* scene) {
+    std::vector<Matrix> transforms(scene->mNumMeshes, MatrixIdentity());
+    std::vector<bool> assigned(scene->mNumMeshes, false);
+    CollectMeshTransforms(scene->mRootNode, aiMatrix4x4(), transforms, assigned);
+    return transforms;
+}
+
+} // namespace kalan
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "raylib.h"
+#include "../animation/AnimationClip.hpp"
+#include <vector>
+
+struct aiMesh;
+struct aiScene;
+
+namespace kalan {
+
+// Индекс сустава в вершине — unsigned char (raylib Mesh::boneIds)
+constexpr int MaxSkeletonJoints = 256;
+
+// Скелет по узлам сцены: узлы костей и мешей вместе со всеми предками до корня.
+// meshJoints — сустав узла, который первым ссылается на меш (-1 — ни один).
+// false — у сцены нет ни костей, ни анимаций, или суставов больше MaxSkeletonJoints.
+bool buildSkeleton(const aiScene* scene, Skeleton& out, std::vector<int>& meshJoints);
+
+// Клипы aiAnimation в секундах; каналы узлов вне скелета пропускаются
+[[nodiscard]] std::vector<AnimationClip> convertAnimations(const aiScene* scene, const Skeleton& skeleton);
+
+// Веса костей меша в boneIds/boneWeights (до 4 на вершину, сумма 1).
+// Меш без костей привязывается целиком к суставу rigidJoint и переводится
+// в пространство, которое ожидает inverseBind этого сустава.
+void convertMeshSkin(const aiMesh* aiM, const Skeleton& skeleton, int rigidJoint, Mesh& mesh);
+
+// Мировые трансформации узлов, первыми ссылающихся на каждый меш (identity — ни один).
+// Для импорта без PreTransformVertices, когда скелета не оказалось.
+[[nodiscard]] std::vector<Matrix> meshNodeTransforms(const aiScene* scene);
+
+} // namespace kalan
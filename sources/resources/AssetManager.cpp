@@ -1,6 +1,9 @@
 #include "resources/AssetManager.hpp"
 #include "rendering/PBRMaterial.hpp"
+#include "resources/MeshRetention.hpp"
+#include "rlgl.h"
 
+#include <algorithm>
 #include <iostream>
 
 namespace kalan {
@@ -93,6 +96,29 @@ std::shared_ptr<T> AssetManager::loadCached(std::unordered_map<std::string, std:
     }
 }
 
+template<typename T>
+std::shared_ptr<T> AssetManager::findCached(const std::unordered_map<std::string, std::weak_ptr<T>>& cache,
+                                            const std::string& key) {
+    if (auto it = cache.find(key); it != cache.end()) return it->second.lock();
+    return nullptr;
+}
+
+std::shared_ptr<raylib::Model> AssetManager::findModel(const fs::path& pathOrName) const {
+    auto resolved = resolveModelPath(pathOrName);
+    if (!resolved) return nullptr;
+
+    std::lock_guard lock(mutex_);
+    return findCached(modelCache_, resolved->string());
+}
+
+std::shared_ptr<raylib::Texture> AssetManager::findTexture(const fs::path& pathOrName) const {
+    auto resolved = resolveTexturePath(pathOrName);
+    if (!resolved) return nullptr;
+
+    std::lock_guard lock(mutex_);
+    return findCached(textureCache_, resolved->string());
+}
+
 std::shared_ptr<raylib::Model> AssetManager::getModel(fs::path pathOrName) {
     auto resolved = resolveModelPath(pathOrName);
     if (!resolved) return nullptr;
@@ -139,6 +165,79 @@ std::shared_ptr<raylib::Sound> AssetManager::getSound(fs::path pathOrName) {
     return loadCached<raylib::Sound>(soundCache_, *resolved);
 }
 
+// По VBO, а не по CPU массивам: после загрузки они могут быть освобождены (MeshRetention)
+static size_t meshGpuBytes(const Mesh& mesh) {
+    if (mesh.vaoId == 0) return 0;
+    size_t perVertex = 0;
+    if (mesh.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION]) perVertex += 3 * sizeof(float);
+    if (mesh.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD]) perVertex += 2 * sizeof(float);
+    if (mesh.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL]) perVertex += 3 * sizeof(float);
+    if (mesh.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR]) perVertex += 4;
+    if (mesh.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_TANGENT]) perVertex += 4 * sizeof(float);
+    if (mesh.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD2]) perVertex += 2 * sizeof(float);
+    size_t indexBytes = mesh.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_INDICES]
+        ? static_cast<size_t>(mesh.triangleCount) * 3 * sizeof(unsigned short) : 0;
+    return perVertex * static_cast<size_t>(mesh.vertexCount) + indexBytes;
+}
+
+static size_t textureBytes(const Texture& texture) {
+    if (texture.id == 0) return 0;
+    size_t total = 0;
+    int width = texture.width;
+    int height = texture.height;
+    for (int level = 0; level < std::max(1, texture.mipmaps); ++level) {
+        total += static_cast<size_t>(GetPixelDataSize(width, height, texture.format));
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    return total;
+}
+
+AssetManager::MemoryStats AssetManager::getMemoryStats() const {
+    std::lock_guard lock(mutex_);
+    MemoryStats stats;
+
+    for (const auto& [key, weak] : modelCache_) {
+        auto model = weak.lock();
+        if (!model) continue;
+        ++stats.models;
+        for (int m = 0; m < model->meshCount; ++m) {
+            stats.cpuBytes += meshCpuBytes(model->meshes[m]);
+            stats.gpuBytes += meshGpuBytes(model->meshes[m]);
+        }
+        // Текстуры материалов без повторов внутри модели
+        for (int i = 0; i < model->materialCount; ++i) {
+            for (int slot = 0; slot < MAX_MATERIAL_MAPS; ++slot) {
+                const Texture& texture = model->materials[i].maps[slot].texture;
+                bool seen = false;
+                for (int j = 0; j <= i && !seen; ++j) {
+                    int slots = j == i ? slot : MAX_MATERIAL_MAPS;
+                    for (int s = 0; s < slots && !seen; ++s) {
+                        seen = model->materials[j].maps[s].texture.id == texture.id;
+                    }
+                }
+                if (!seen) stats.gpuBytes += textureBytes(texture);
+            }
+        }
+    }
+
+    for (const auto& [key, weak] : textureCache_) {
+        auto texture = weak.lock();
+        if (!texture) continue;
+        ++stats.textures;
+        stats.gpuBytes += textureBytes(*texture);
+    }
+
+    for (const auto& [key, weak] : soundCache_) {
+        auto sound = weak.lock();
+        if (!sound) continue;
+        ++stats.sounds;
+        stats.cpuBytes += static_cast<size_t>(sound->frameCount) * sound->stream.channels *
+                          sound->stream.sampleSize / 8;
+    }
+    return stats;
+}
+
 void AssetManager::clearCache() noexcept {
     std::lock_guard lock(mutex_);
     modelCache_.clear();
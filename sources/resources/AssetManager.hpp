@@ -18,6 +18,16 @@ namespace kalan {
 
 class AssetManager {
 public:
+  // Память живых записей кэшей. Модели считаются по отдельности: текстура,
+  // общая для двух моделей, учитывается дважды.
+  struct MemoryStats {
+    size_t models = 0;
+    size_t textures = 0;
+    size_t sounds = 0;
+    size_t cpuBytes = 0; // CPU копии вершин мешей и PCM звуков
+    size_t gpuBytes = 0; // буферы мешей и текстуры с mip уровнями
+  };
+
   static AssetManager &instance() noexcept;
 
   void setAssetsRoot(fs::path root) noexcept;
@@ -37,8 +47,17 @@ public:
   getTexture(fs::path pathOrName);
   [[nodiscard]] std::shared_ptr<raylib::Sound> getSound(fs::path pathOrName);
 
+  // Уже загруженный ассет или nullptr; сам ничего не загружает
+  [[nodiscard]] std::shared_ptr<raylib::Model>
+  findModel(const fs::path &pathOrName) const;
+  [[nodiscard]] std::shared_ptr<raylib::Texture>
+  findTexture(const fs::path &pathOrName) const;
+
   void clearCache() noexcept;
 
+  // Без аллокаций, можно вызывать каждый кадр
+  [[nodiscard]] MemoryStats getMemoryStats() const;
+
 private:
   AssetManager() = default;
 
@@ -51,6 +70,11 @@ private:
   loadCached(std::unordered_map<std::string, std::weak_ptr<T>> &cache,
              const fs::path &absolutePath);
 
+  template <typename T>
+  static std::shared_ptr<T>
+  findCached(const std::unordered_map<std::string, std::weak_ptr<T>> &cache,
+             const std::string &key);
+
   void applyPBRToModel(raylib::Model &model, const fs::path &modelPath);
 
   mutable std::mutex mutex_;
@@ -0,0 +1,162 @@
+#include "AssimpConvert.hpp"
+#include "raymath.h"
+#include <assimp/mesh.h>
+#include <assimp/postprocess.h>
+
+namespace kalan {
+
+// Тангенты не считаются импортером (aiProcess_CalcTangentSpace идёт последовательно
+// и без знака бивектора) — их строит generateTangents на воркерах загрузчика
+unsigned int assimpImportFlags(bool keepHierarchy, const ImportSteps& steps) {
+    unsigned int flags = 
+        aiProcess_Triangulate |
+        aiProcess_FlipUVs;
+    if (steps.genNormals) flags |= aiProcess_GenSmoothNormals;
+    if (steps.joinVertices) flags |= aiProcess_JoinIdenticalVertices;
+    if (steps.optimizeMeshes) flags |= aiProcess_OptimizeMeshes;
+    if (!keepHierarchy) {
+        flags |= aiProcess_PreTransformVertices; // Применяет все трансформации к вершинам
+    }
+    return flags;
+}
+
+// Конвертация aiMatrix4x4 в raylib Matrix
+Matrix ConvertAssimpMatrix(const aiMatrix4x4& m) {
+    // Assimp хранит по строкам, raylib — по столбцам, но поля Matrix объявлены
+    // построчно (m0, m4, m8, m12 — первая строка), поэтому порядок совпадает
+    return Matrix{
+        m.a1, m.a2, m.a3, m.a4,
+        m.b1, m.b2, m.b3, m.b4,
+        m.c1, m.c2, m.c3, m.c4,
+        m.d1, m.d2, m.d3, m.d4
+    };
+}
+
+// Трансформировать вершины меша по матрице
+void TransformMeshVertices(Mesh& mesh, const Matrix& transform) {
+    // Вычисляем нормальную матрицу (для нормалей)
+    Matrix normalMatrix = MatrixTranspose(MatrixInvert(transform));
+    // Тангент лежит в поверхности и переносится самой матрицей; зеркальная
+    // трансформация меняет ориентацию базиса, и знак бивектора переворачивается
+    Matrix tangentMatrix = transform;
+    tangentMatrix.m12 = tangentMatrix.m13 = tangentMatrix.m14 = 0.0f;
+    const float handedness = MatrixDeterminant(transform) < 0.0f ? -1.0f : 1.0f;
+    
+    for (int i = 0; i < mesh.vertexCount; ++i) {
+        // Трансформируем позицию
+        Vector3 pos = {
+            mesh.vertices[i*3 + 0],
+            mesh.vertices[i*3 + 1],
+            mesh.vertices[i*3 + 2]
+        };
+        pos = Vector3Transform(pos, transform);
+        mesh.vertices[i*3 + 0] = pos.x;
+        mesh.vertices[i*3 + 1] = pos.y;
+        mesh.vertices[i*3 + 2] = pos.z;
+        
+        // Трансформируем нормали
+        if (mesh.normals) {
+            Vector3 normal = {
+                mesh.normals[i*3 + 0],
+                mesh.normals[i*3 + 1],
+                mesh.normals[i*3 + 2]
+            };
+            normal = Vector3Normalize(Vector3Transform(normal, normalMatrix));
+            mesh.normals[i*3 + 0] = normal.x;
+            mesh.normals[i*3 + 1] = normal.y;
+            mesh.normals[i*3 + 2] = normal.z;
+        }
+        
+        // Трансформируем тангенты
+        if (mesh.tangents) {
+            Vector3 tangent = {
+                mesh.tangents[i*4 + 0],
+                mesh.tangents[i*4 + 1],
+                mesh.tangents[i*4 + 2]
+            };
+            tangent = Vector3Normalize(Vector3Transform(tangent, tangentMatrix));
+            mesh.tangents[i*4 + 0] = tangent.x;
+            mesh.tangents[i*4 + 1] = tangent.y;
+            mesh.tangents[i*4 + 2] = tangent.z;
+            mesh.tangents[i*4 + 3] *= handedness;
+        }
+    }
+}
+
+// Конвертация aiMesh в raylib Mesh (без upload)
+Mesh ConvertAssimpMesh(const aiMesh* aiM, bool tangents) {
+    Mesh mesh = {0};
+    
+    mesh.vertexCount = aiM->mNumVertices;
+    mesh.triangleCount = aiM->mNumFaces;
+    
+    // Vertices
+    mesh.vertices = (float*)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
+    for (unsigned int i = 0; i < aiM->mNumVertices; i++) {
+        mesh.vertices[i*3 + 0] = aiM->mVertices[i].x;
+        mesh.vertices[i*3 + 1] = aiM->mVertices[i].y;
+        mesh.vertices[i*3 + 2] = aiM->mVertices[i].z;
+    }
+    
+    // Normals
+    if (aiM->HasNormals()) {
+        mesh.normals = (float*)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
+        for (unsigned int i = 0; i < aiM->mNumVertices; i++) {
+            mesh.normals[i*3 + 0] = aiM->mNormals[i].x;
+            mesh.normals[i*3 + 1] = aiM->mNormals[i].y;
+            mesh.normals[i*3 + 2] = aiM->mNormals[i].z;
+        }
+    }
+    
+    // Tangents: только авторские (glTF TANGENT, FBX); w — знак бивектора,
+    // B = cross(N, T) * w, как в шейдерах
+    if (tangents && aiM->HasTangentsAndBitangents() && aiM->HasNormals()) {
+        mesh.tangents = (float*)MemAlloc(mesh.vertexCount * 4 * sizeof(float));
+        for (unsigned int i = 0; i < aiM->mNumVertices; i++) {
+            const aiVector3D& n = aiM->mNormals[i];
+            const aiVector3D& t = aiM->mTangents[i];
+            const aiVector3D& b = aiM->mBitangents[i];
+            const aiVector3D nxt = n ^ t;
+            mesh.tangents[i*4 + 0] = t.x;
+            mesh.tangents[i*4 + 1] = t.y;
+            mesh.tangents[i*4 + 2] = t.z;
+            mesh.tangents[i*4 + 3] = (nxt * b) < 0.0f ? -1.0f : 1.0f;
+        }
+    }
+    
+    // Texture coordinates
+    if (aiM->HasTextureCoords(0)) {
+        mesh.texcoords = (float*)MemAlloc(mesh.vertexCount * 2 * sizeof(float));
+        for (unsigned int i = 0; i < aiM->mNumVertices; i++) {
+            mesh.texcoords[i*2 + 0] = aiM->mTextureCoords[0][i].x;
+            mesh.texcoords[i*2 + 1] = aiM->mTextureCoords[0][i].y;
+        }
+    }
+    
+    // Vertex colors
+    if (aiM->HasVertexColors(0)) {
+        mesh.colors = (unsigned char*)MemAlloc(mesh.vertexCount * 4 * sizeof(unsigned char));
+        for (unsigned int i = 0; i < aiM->mNumVertices; i++) {
+            mesh.colors[i*4 + 0] = (unsigned char)(aiM->mColors[0][i].r * 255);
+            mesh.colors[i*4 + 1] = (unsigned char)(aiM->mColors[0][i].g * 255);
+            mesh.colors[i*4 + 2] = (unsigned char)(aiM->mColors[0][i].b * 255);
+            mesh.colors[i*4 + 3] = (unsigned char)(aiM->mColors[0][i].a * 255);
+        }
+    }
+    
+    // Indices
+    mesh.indices = (unsigned short*)MemAlloc(mesh.triangleCount * 3 * sizeof(unsigned short));
+    for (unsigned int i = 0; i < aiM->mNumFaces; i++) {
+        const aiFace& face = aiM->mFaces[i];
+        if (face.mNumIndices == 3) {
+            mesh.indices[i*3 + 0] = (unsigned short)face.mIndices[0];
+            mesh.indices[i*3 + 1] = (unsigned short)face.mIndices[1];
+            mesh.indices[i*3 + 2] = (unsigned short)face.mIndices[2];
+        }
+    }
+    
+    // НЕ делаем UploadMesh здесь - сначала применим трансформации
+    return mesh;
+}
+
+} // namespace kalan
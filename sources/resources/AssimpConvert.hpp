@@ -0,0 +1,36 @@
+#pragma once
+
+#include "raylib.h"
+#include <assimp/matrix4x4.h>
+
+struct aiMesh;
+
+namespace kalan {
+
+// Отключаемые шаги постобработки Assimp. Для ассетов, где нормали уже есть,
+// а вершины сварены при экспорте, genNormals и joinVertices — самые дорогие шаги
+// импорта, которые ничего не меняют.
+struct ImportSteps {
+    bool genNormals = true;         // aiProcess_GenSmoothNormals (только меши без нормалей)
+    bool joinVertices = true;       // aiProcess_JoinIdenticalVertices
+    bool optimizeMeshes = true;     // aiProcess_OptimizeMeshes: слияние мешей с общим материалом
+};
+
+// Флаги постобработки Assimp, с которыми импортирует ParallelModelLoader.
+// keepHierarchy == false — трансформации узлов запекаются в вершины.
+[[nodiscard]] unsigned int assimpImportFlags(bool keepHierarchy, const ImportSteps& steps = {});
+
+// aiMatrix4x4 (row-major) в raylib Matrix (column-major)
+[[nodiscard]] Matrix ConvertAssimpMatrix(const aiMatrix4x4& m);
+
+// Трансформировать позиции, нормали и тангенты меша (нормали — обратной транспонированной,
+// тангенты — самой матрицей; при отрицательном детерминанте знак w меняется)
+void TransformMeshVertices(Mesh& mesh, const Matrix& transform);
+
+// Конвертация aiMesh в raylib Mesh без upload. Буферы выделяются MemAlloc
+// и освобождаются UnloadMesh. Индексы 16-битные.
+// tangents == false — авторские тангенты не копируются (материал без normal map).
+// Импортер тангенты не считает: если их нет, их строит generateTangents (MeshTangents.hpp).
+[[nodiscard]] Mesh ConvertAssimpMesh(const aiMesh* aiM, bool tangents = true);
+
+} // namespace kalan
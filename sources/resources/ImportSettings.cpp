@@ -0,0 +1,138 @@
+#include "ImportSettings.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace kalan {
+
+namespace {
+
+std::string_view trim(std::string_view s) {
+    const char* spaces = " \t\r";
+    size_t first = s.find_first_not_of(spaces);
+    if (first == std::string_view::npos) return {};
+    size_t last = s.find_last_not_of(spaces);
+    return s.substr(first, last - first + 1);
+}
+
+bool parseBool(std::string_view value, bool& out) {
+    if (value == "true" || value == "on" || value == "1") { out = true; return true; }
+    if (value == "false" || value == "off" || value == "0") { out = false; return true; }
+    return false;
+}
+
+bool parsePositiveFloat(std::string_view value, float& out) {
+    const std::string text(value);
+    char* end = nullptr;
+    const float parsed = std::strtof(text.c_str(), &end);
+    if (end == text.c_str() || *end != '\0' || !(parsed > 0.0f)) return false;
+    out = parsed;
+    return true;
+}
+
+bool applyKey(std::string_view key, std::string_view value, LoadOptions& options) {
+    if (key == "gen_normals") return parseBool(value, options.importSteps.genNormals);
+    if (key == "join_vertices") return parseBool(value, options.importSteps.joinVertices);
+    if (key == "optimize_meshes") return parseBool(value, options.importSteps.optimizeMeshes);
+    if (key == "keep_hierarchy") return parseBool(value, options.keepHierarchy);
+    if (key == "animation") return parseBool(value, options.importAnimation);
+    if (key == "compress_animation") return parseBool(value, options.compressAnimation);
+    if (key == "animation_tolerance") return parsePositiveFloat(value, options.animationCompression.tolerance);
+    if (key == "reorder") return parseBool(value, options.optimizeMeshes);
+    if (key == "lods") return parseBool(value, options.generateLods);
+    if (key == "occluders") return parseBool(value, options.buildOccluders);
+    if (key == "pack_textures") return parseBool(value, options.packTextures);
+    if (key == "stream_textures") return parseBool(value, options.streamTextures);
+
+    if (key == "tangents") {
+        if (value == "generate") options.tangents = TangentMode::Generate;
+        else if (value == "authored") options.tangents = TangentMode::Authored;
+        else if (value == "none") options.tangents = TangentMode::None;
+        else return false;
+        return true;
+    }
+    if (key == "vertex_format") {
+        if (value == "float32") options.vertexFormat = VertexFormat::Float32;
+        else if (value == "packed") options.vertexFormat = VertexFormat::Packed;
+        else return false;
+        return true;
+    }
+    if (key == "texcoords") {
+        if (value == "unorm16") options.texcoordEncoding = TexcoordEncoding::Unorm16;
+        else if (value == "half") options.texcoordEncoding = TexcoordEncoding::Half;
+        else return false;
+        return true;
+    }
+    if (key == "retention") {
+        if (value == "full") options.meshRetention = MeshRetention::Full;
+        else if (value == "positions") options.meshRetention = MeshRetention::Positions;
+        else if (value == "draw") options.meshRetention = MeshRetention::DrawOnly;
+        else return false;
+        return true;
+    }
+    if (key == "collision") {
+        if (value == "none") options.collisionShapes = CollisionShapeType::None;
+        else if (value == "mesh") options.collisionShapes = CollisionShapeType::TriangleMesh;
+        else if (value == "convex") options.collisionShapes = CollisionShapeType::ConvexHull;
+        else return false;
+        return true;
+    }
+    return false;
+}
+
+bool readFile(const fs::path& path, std::string& text) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    text = stream.str();
+    return true;
+}
+
+} // anonymous namespace
+
+int parseImportSettings(std::string_view text, const std::string& source, LoadOptions& options) {
+    int applied = 0;
+    int lineNumber = 0;
+    while (!text.empty()) {
+        size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        text = end == std::string_view::npos ? std::string_view{} : text.substr(end + 1);
+        ++lineNumber;
+
+        if (size_t comment = line.find('#'); comment != std::string_view::npos) line = line.substr(0, comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        size_t eq = line.find('=');
+        if (eq == std::string_view::npos) {
+            TraceLog(LOG_WARNING, "ImportSettings: %s:%d: expected key = value", source.c_str(), lineNumber);
+            continue;
+        }
+        std::string_view key = trim(line.substr(0, eq));
+        std::string_view value = trim(line.substr(eq + 1));
+        if (applyKey(key, value, options)) {
+            ++applied;
+        } else {
+            TraceLog(LOG_WARNING, "ImportSettings: %s:%d: unknown setting '%.*s = %.*s'", source.c_str(), lineNumber,
+                     static_cast<int>(key.size()), key.data(), static_cast<int>(value.size()), value.data());
+        }
+    }
+    return applied;
+}
+
+std::vector<std::string> applyImportSettings(const fs::path& modelPath, LoadOptions& options) {
+    std::vector<std::string> files;
+    fs::path asset = modelPath;
+    asset += ".import";
+    for (const fs::path& path : {modelPath.parent_path() / ".import", asset}) {
+        std::string text;
+        if (!readFile(path, text)) continue;
+        std::string name = path.string();
+        parseImportSettings(text, name, options);
+        files.push_back(std::move(name));
+    }
+    return files;
+}
+
+} // namespace kalan
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ParallelLoader.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kalan {
+
+// Файлы настроек импорта рядом с ассетами. Настройки каталога лежат в
+// <каталог>/.import, настройки ассета — в <файл>.import (model.glb.import);
+// ключи ассета перекрывают ключи каталога, и оба — LoadOptions из кода.
+//
+//   # ассет из DCC уже со сглаженными нормалями и сваренными вершинами
+//   gen_normals = false
+//   join_vertices = false
+//   tangents = authored         # generate | authored | none
+//   vertex_format = packed      # float32 | packed
+//   texcoords = unorm16         # unorm16 | half
+//   pack_textures = true
+//   stream_textures = false
+//
+// Остальные ключи: optimize_meshes, keep_hierarchy, reorder (LoadOptions::optimizeMeshes),
+// lods, occluders, animation, compress_animation, animation_tolerance (смещение вершины
+// в единицах ассета), collision (none | mesh | convex), retention (full | positions | draw).
+// Незнакомые ключи и значения пишутся в лог и пропускаются.
+//
+// Всё, что меняет геометрию, входит в ключ кэша форм через report.importFlags.
+
+// Разобрать текст одного файла поверх options. source — имя для сообщений.
+// Возвращает число применённых ключей.
+int parseImportSettings(std::string_view text, const std::string& source, LoadOptions& options);
+
+// Применить файлы каталога и ассета, если они есть. Возвращает прочитанные пути.
+std::vector<std::string> applyImportSettings(const fs::path& modelPath, LoadOptions& options);
+
+} // namespace kalan
@@ -0,0 +1,374 @@
+#include "MeshOptimizer.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace kalan {
+
+namespace {
+
+// Параметры Forsyth
+constexpr int CacheSize = 32;
+constexpr float CacheDecayPower = 1.5f;
+constexpr float LastTriScore = 0.75f;
+constexpr float ValenceBoostScale = 2.0f;
+constexpr float ValenceBoostPower = 0.5f;
+constexpr int MaxValence = 64;
+
+struct ScoreTables {
+    float cache[CacheSize + 3];
+    float valence[MaxValence + 1];
+
+    ScoreTables() {
+        for (int i = 0; i < CacheSize + 3; ++i) {
+            if (i < 3) {
+                // Вершины последнего треугольника: намеренно невысокий вес,
+                // иначе алгоритм зацикливается на веере вокруг одной вершины
+                cache[i] = LastTriScore;
+            } else if (i < CacheSize) {
+                float scaler = 1.0f / (CacheSize - 3);
+                cache[i] = std::pow(1.0f - (i - 3) * scaler, CacheDecayPower);
+            } else {
+                cache[i] = 0.0f;
+            }
+        }
+        valence[0] = 0.0f;
+        for (int i = 1; i <= MaxValence; ++i) {
+            valence[i] = ValenceBoostScale * std::pow(static_cast<float>(i), -ValenceBoostPower);
+        }
+    }
+};
+
+const ScoreTables& scoreTables() {
+    static const ScoreTables tables;
+    return tables;
+}
+
+float vertexScore(int cachePos, unsigned int remaining) {
+    if (remaining == 0) return -1.0f;
+    const ScoreTables& t = scoreTables();
+    float score = cachePos >= 0 ? t.cache[cachePos] : 0.0f;
+    return score + t.valence[std::min<unsigned int>(remaining, MaxValence)];
+}
+
+} // anonymous namespace
+
+// ============ Анализ ============
+
+VertexCacheStats analyzeVertexCache(
+    const uint32_t* indices, size_t indexCount, size_t vertexCount, unsigned int cacheSize)
+{
+    VertexCacheStats stats;
+    if (indexCount < 3 || vertexCount == 0) return stats;
+
+    // FIFO: вершина в кэше, если её "время входа" не старше cacheSize промахов
+    std::vector<size_t> timestamps(vertexCount, 0);
+    std::vector<uint8_t> used(vertexCount, 0);
+    size_t time = cacheSize + 1;
+    size_t misses = 0;
+    size_t usedCount = 0;
+
+    for (size_t i = 0; i < indexCount; ++i) {
+        uint32_t v = indices[i];
+        if (time - timestamps[v] > cacheSize) {
+            timestamps[v] = time++;
+            ++misses;
+        }
+        if (!used[v]) {
+            used[v] = 1;
+            ++usedCount;
+        }
+    }
+
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(indexCount / 3);
+    stats.atvr = usedCount ? static_cast<float>(misses) / static_cast<float>(usedCount) : 0.0f;
+    return stats;
+}
+
+// ============ Кэш вершин ============
+
+void optimizeVertexCache(uint32_t* destination, const uint32_t* indices, size_t indexCount, size_t vertexCount) {
+    size_t triCount = indexCount / 3;
+    if (triCount == 0) return;
+
+    // Копия входа: destination может совпадать с indices
+    std::vector<uint32_t> source(indices, indices + indexCount);
+
+    // Треугольники каждой вершины (CSR), живые — в начале диапазона
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (uint32_t v : source) ++offsets[v + 1];
+    for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] += offsets[v];
+    std::vector<uint32_t> remaining(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) remaining[v] = offsets[v + 1] - offsets[v];
+
+    std::vector<uint32_t> adjacency(indexCount);
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < triCount; ++t) {
+            for (int k = 0; k < 3; ++k) adjacency[fill[source[t * 3 + k]]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    std::vector<int> cachePos(vertexCount, -1);
+    std::vector<float> vScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) vScore[v] = vertexScore(-1, remaining[v]);
+
+    std::vector<float> tScore(triCount);
+    std::vector<uint8_t> emitted(triCount, 0);
+    for (size_t t = 0; t < triCount; ++t) {
+        tScore[t] = vScore[source[t * 3]] + vScore[source[t * 3 + 1]] + vScore[source[t * 3 + 2]];
+    }
+
+    uint32_t cache[CacheSize + 3];
+    uint32_t newCache[CacheSize + 6];
+    int cacheCount = 0;
+
+    size_t best = std::max_element(tScore.begin(), tScore.end()) - tScore.begin();
+    size_t cursor = 0;
+    size_t written = 0;
+
+    while (best != SIZE_MAX) {
+        emitted[best] = 1;
+        const uint32_t* tri = &source[best * 3];
+        for (int k = 0; k < 3; ++k) destination[written++] = tri[k];
+
+        // Убрать треугольник из списков его вершин
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = tri[k];
+            uint32_t* begin = &adjacency[offsets[v]];
+            uint32_t* end = begin + remaining[v];
+            uint32_t* it = std::find(begin, end, static_cast<uint32_t>(best));
+            if (it != end) {
+                *it = *(end - 1);
+                --remaining[v];
+            }
+        }
+
+        // Новый LRU: вершины треугольника в начало
+        int newCount = 0;
+        for (int k = 0; k < 3; ++k) newCache[newCount++] = tri[k];
+        for (int i = 0; i < cacheCount; ++i) {
+            uint32_t v = cache[i];
+            if (v != tri[0] && v != tri[1] && v != tri[2]) newCache[newCount++] = v;
+        }
+
+        // Пересчитать очки вершин (включая вытесненные) и их треугольников
+        for (int i = 0; i < newCount; ++i) {
+            uint32_t v = newCache[i];
+            cachePos[v] = i < CacheSize ? i : -1;
+            vScore[v] = vertexScore(cachePos[v], remaining[v]);
+        }
+        for (int i = 0; i < newCount; ++i) {
+            uint32_t v = newCache[i];
+            for (uint32_t j = 0; j < remaining[v]; ++j) {
+                uint32_t t = adjacency[offsets[v] + j];
+                tScore[t] = vScore[source[t * 3]] + vScore[source[t * 3 + 1]] + vScore[source[t * 3 + 2]];
+            }
+        }
+
+        cacheCount = std::min(newCount, CacheSize);
+        std::memcpy(cache, newCache, cacheCount * sizeof(uint32_t));
+
+        // Следующий — лучший среди треугольников вершин в кэше
+        best = SIZE_MAX;
+        float bestScore = -1.0f;
+        for (int i = 0; i < cacheCount; ++i) {
+            uint32_t v = cache[i];
+            for (uint32_t j = 0; j < remaining[v]; ++j) {
+                uint32_t t = adjacency[offsets[v] + j];
+                if (tScore[t] > bestScore) {
+                    bestScore = tScore[t];
+                    best = t;
+                }
+            }
+        }
+
+        // Кэш опустел — берём первый ещё не выданный треугольник
+        if (best == SIZE_MAX) {
+            while (cursor < triCount && emitted[cursor]) ++cursor;
+            if (cursor < triCount) best = cursor;
+        }
+    }
+}
+
+// ============ Overdraw ============
+
+void optimizeOverdraw(uint32_t* destination, const uint32_t* indices, size_t indexCount,
+                      const float* positions, size_t vertexCount, float threshold)
+{
+    size_t triCount = indexCount / 3;
+    std::vector<uint32_t> source(indices, indices + indexCount);
+    if (triCount < 2) {
+        std::memcpy(destination, source.data(), indexCount * sizeof(uint32_t));
+        return;
+    }
+
+    // Жёсткие границы кластеров: треугольник, у которого все три вершины промахнулись
+    // мимо кэша, всё равно начинает "с нуля", перестановка на нём не ухудшает ACMR
+    constexpr unsigned int SimCacheSize = 16;
+    std::vector<size_t> timestamps(vertexCount, 0);
+    size_t time = SimCacheSize + 1;
+    std::vector<uint32_t> clusters; // начала кластеров (в треугольниках)
+    for (size_t t = 0; t < triCount; ++t) {
+        int misses = 0;
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = source[t * 3 + k];
+            if (time - timestamps[v] > SimCacheSize) {
+                timestamps[v] = time++;
+                ++misses;
+            }
+        }
+        if (t == 0 || misses == 3) clusters.push_back(static_cast<uint32_t>(t));
+    }
+    clusters.push_back(static_cast<uint32_t>(triCount));
+    size_t clusterCount = clusters.size() - 1;
+
+    auto pos = [positions](uint32_t v) {
+        return std::array<float, 3>{positions[v * 3], positions[v * 3 + 1], positions[v * 3 + 2]};
+    };
+
+    // Центроид и нормаль кластера (взвешенные по площади)
+    struct ClusterInfo {
+        float centroid[3];
+        float normal[3];
+        float area;
+        float sortKey;
+    };
+    std::vector<ClusterInfo> info(clusterCount);
+    float meshCenter[3] = {0, 0, 0};
+    float meshArea = 0.0f;
+
+    for (size_t c = 0; c < clusterCount; ++c) {
+        ClusterInfo ci{};
+        for (uint32_t t = clusters[c]; t < clusters[c + 1]; ++t) {
+            auto p0 = pos(source[t * 3]), p1 = pos(source[t * 3 + 1]), p2 = pos(source[t * 3 + 2]);
+            float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+            float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+            float area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            for (int k = 0; k < 3; ++k) {
+                ci.centroid[k] += (p0[k] + p1[k] + p2[k]) * (area / 3.0f);
+                ci.normal[k] += n[k];
+            }
+            ci.area += area;
+        }
+        if (ci.area > 0.0f) {
+            for (int k = 0; k < 3; ++k) ci.centroid[k] /= ci.area;
+        }
+        for (int k = 0; k < 3; ++k) meshCenter[k] += ci.centroid[k] * ci.area;
+        meshArea += ci.area;
+        info[c] = ci;
+    }
+    if (meshArea > 0.0f) {
+        for (int k = 0; k < 3; ++k) meshCenter[k] /= meshArea;
+    }
+
+    // Кластеры, смотрящие наружу от центра, рисуем первыми
+    std::vector<uint32_t> order(clusterCount);
+    for (size_t c = 0; c < clusterCount; ++c) {
+        ClusterInfo& ci = info[c];
+        float len = std::sqrt(ci.normal[0] * ci.normal[0] + ci.normal[1] * ci.normal[1] + ci.normal[2] * ci.normal[2]);
+        float key = 0.0f;
+        if (len > 0.0f) {
+            for (int k = 0; k < 3; ++k) key += (ci.centroid[k] - meshCenter[k]) * ci.normal[k] / len;
+        }
+        ci.sortKey = key;
+        order[c] = static_cast<uint32_t>(c);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&info](uint32_t a, uint32_t b) { return info[a].sortKey > info[b].sortKey; });
+
+    std::vector<uint32_t> result;
+    result.reserve(indexCount);
+    for (uint32_t c : order) {
+        result.insert(result.end(), source.begin() + clusters[c] * 3, source.begin() + clusters[c + 1] * 3);
+    }
+
+    // Если перестановка заметно испортила кэш — оставляем исходный порядок
+    float acmrBefore = analyzeVertexCache(source.data(), indexCount, vertexCount).acmr;
+    float acmrAfter = analyzeVertexCache(result.data(), indexCount, vertexCount).acmr;
+    const std::vector<uint32_t>& chosen = acmrAfter <= acmrBefore * threshold ? result : source;
+    std::memcpy(destination, chosen.data(), indexCount * sizeof(uint32_t));
+}
+
+// ============ Vertex fetch ============
+
+size_t optimizeVertexFetchRemap(std::vector<uint32_t>& remap, const uint32_t* indices,
+                                size_t indexCount, size_t vertexCount)
+{
+    remap.assign(vertexCount, ~0u);
+    uint32_t next = 0;
+    for (size_t i = 0; i < indexCount; ++i) {
+        uint32_t v = indices[i];
+        if (remap[v] == ~0u) remap[v] = next++;
+    }
+    return next;
+}
+
+// ============ Стадия импорта ============
+
+namespace {
+
+template <typename T>
+void RemapStream(T*& data, int components, const std::vector<uint32_t>& remap, size_t newCount) {
+    if (!data) return;
+    T* result = (T*)MemAlloc(static_cast<unsigned int>(newCount * components * sizeof(T)));
+    for (size_t v = 0; v < remap.size(); ++v) {
+        if (remap[v] == ~0u) continue;
+        std::memcpy(result + remap[v] * components, data + v * components, components * sizeof(T));
+    }
+    MemFree(data);
+    data = result;
+}
+
+} // anonymous namespace
+
+MeshOptimizeStats optimizeMesh(Mesh& mesh, const MeshOptimizeSettings& settings) {
+    MeshOptimizeStats stats;
+    if (!mesh.indices || !mesh.vertices || mesh.triangleCount == 0) return stats;
+
+    auto start = std::chrono::steady_clock::now();
+    size_t indexCount = static_cast<size_t>(mesh.triangleCount) * 3;
+    size_t vertexCount = static_cast<size_t>(mesh.vertexCount);
+
+    std::vector<uint32_t> indices(mesh.indices, mesh.indices + indexCount);
+    stats.before = analyzeVertexCache(indices.data(), indexCount, vertexCount);
+
+    if (settings.vertexCache) {
+        optimizeVertexCache(indices.data(), indices.data(), indexCount, vertexCount);
+    }
+    if (settings.overdraw) {
+        optimizeOverdraw(indices.data(), indices.data(), indexCount,
+                         mesh.vertices, vertexCount, settings.overdrawThreshold);
+    }
+
+    if (settings.vertexFetch) {
+        std::vector<uint32_t> remap;
+        size_t newCount = optimizeVertexFetchRemap(remap, indices.data(), indexCount, vertexCount);
+
+        RemapStream(mesh.vertices, 3, remap, newCount);
+        RemapStream(mesh.normals, 3, remap, newCount);
+        RemapStream(mesh.tangents, 4, remap, newCount);
+        RemapStream(mesh.texcoords, 2, remap, newCount);
+        RemapStream(mesh.texcoords2, 2, remap, newCount);
+        RemapStream(mesh.colors, 4, remap, newCount);
+        RemapStream(mesh.boneIds, 4, remap, newCount);
+        RemapStream(mesh.boneWeights, 4, remap, newCount);
+
+        for (auto& i : indices) i = remap[i];
+        mesh.vertexCount = static_cast<int>(newCount);
+        vertexCount = newCount;
+    }
+
+    for (size_t i = 0; i < indexCount; ++i) {
+        mesh.indices[i] = static_cast<unsigned short>(indices[i]);
+    }
+
+    stats.after = analyzeVertexCache(indices.data(), indexCount, vertexCount);
+    stats.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+} // namespace kalan
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace kalan {
+
+// Статистика пост-трансформ кэша вершин (FIFO симуляция)
+struct VertexCacheStats {
+    float acmr = 0.0f;  // промахи на треугольник: 0.5 — идеал, 3 — худший случай
+    float atvr = 0.0f;  // промахи на используемую вершину: 1 — идеал
+};
+
+[[nodiscard]] VertexCacheStats analyzeVertexCache(
+    const uint32_t* indices, size_t indexCount, size_t vertexCount, unsigned int cacheSize = 16);
+
+// Порядок треугольников под кэш вершин (Forsyth, linear-speed vertex cache optimisation)
+void optimizeVertexCache(uint32_t* destination, const uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+// Переупорядочить кластеры треугольников так, чтобы внешние (вероятно видимые первыми)
+// рисовались раньше. threshold — допустимый рост ACMR, например 1.05 = +5%.
+// Вход должен быть уже оптимизирован под кэш.
+void optimizeOverdraw(uint32_t* destination, const uint32_t* indices, size_t indexCount,
+                      const float* positions, size_t vertexCount, float threshold);
+
+// Ремап вершин в порядке первого использования (локальность выборки).
+// Возвращает новое число вершин; неиспользуемые вершины получают ~0u.
+size_t optimizeVertexFetchRemap(std::vector<uint32_t>& remap, const uint32_t* indices,
+                                size_t indexCount, size_t vertexCount);
+
+// Стадия импорта: применяется к CPU-мешу raylib до UploadMesh
+struct MeshOptimizeSettings {
+    bool vertexCache = true;
+    bool overdraw = false;
+    float overdrawThreshold = 1.05f;
+    bool vertexFetch = true;
+};
+
+struct MeshOptimizeStats {
+    int meshIndex = -1;
+    VertexCacheStats before;
+    VertexCacheStats after;
+    double ms = 0.0;
+};
+
+// Переставляет индексы и все атрибуты меша на месте. GPU не трогает.
+MeshOptimizeStats optimizeMesh(Mesh& mesh, const MeshOptimizeSettings& settings);
+
+} // namespace kalan
@@ -0,0 +1,46 @@
+#include "MeshRetention.hpp"
+
+namespace kalan {
+
+namespace {
+
+template <typename T>
+void release(T*& data) {
+    MemFree(data);
+    data = nullptr;
+}
+
+} // anonymous namespace
+
+size_t meshCpuBytes(const Mesh& mesh) {
+    size_t perVertex = 0;
+    if (mesh.vertices) perVertex += 3 * sizeof(float);
+    if (mesh.texcoords) perVertex += 2 * sizeof(float);
+    if (mesh.texcoords2) perVertex += 2 * sizeof(float);
+    if (mesh.normals) perVertex += 3 * sizeof(float);
+    if (mesh.tangents) perVertex += 4 * sizeof(float);
+    if (mesh.colors) perVertex += 4;
+    if (mesh.animVertices) perVertex += 3 * sizeof(float);
+    if (mesh.animNormals) perVertex += 3 * sizeof(float);
+    if (mesh.boneIds) perVertex += 4;
+    if (mesh.boneWeights) perVertex += 4 * sizeof(float);
+    size_t indexBytes = mesh.indices ? static_cast<size_t>(mesh.triangleCount) * 3 * sizeof(unsigned short) : 0;
+    return perVertex * static_cast<size_t>(mesh.vertexCount) + indexBytes;
+}
+
+size_t releaseMeshCpuData(Mesh& mesh, MeshRetention retention) {
+    if (retention == MeshRetention::Full || mesh.vaoId == 0) return 0;
+    // Анимированный меш перезаливает VBO из CPU массивов (UpdateModelAnimation)
+    if (mesh.animVertices || mesh.boneIds) return 0;
+
+    const size_t before = meshCpuBytes(mesh);
+    release(mesh.texcoords);
+    release(mesh.texcoords2);
+    release(mesh.normals);
+    release(mesh.tangents);
+    release(mesh.colors);
+    if (retention == MeshRetention::DrawOnly) release(mesh.vertices);
+    return before - meshCpuBytes(mesh);
+}
+
+} // namespace kalan
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace kalan {
+
+// Что из CPU копии меша остаётся в RAM после UploadMesh. raylib держит все
+// массивы до UnloadMesh, хотя отрисовка читает только VBO.
+enum class MeshRetention : uint8_t {
+    Full,           // всё, как оставляет raylib
+    Positions,      // vertices и indices: физика, пикинг (GetRayCollisionMesh), bounds
+    DrawOnly,       // только indices: по ним DrawMesh выбирает индексированную отрисовку
+};
+
+// Байт в CPU массивах меша (по ненулевым указателям)
+[[nodiscard]] size_t meshCpuBytes(const Mesh& mesh);
+
+// Освободить CPU массивы, не нужные при retention. Меш должен быть уже в GPU
+// (vaoId != 0) — иначе ничего не делает. Возвращает освобождённые байты.
+size_t releaseMeshCpuData(Mesh& mesh, MeshRetention retention);
+
+} // namespace kalan
@@ -0,0 +1,391 @@
+#include "MeshSimplifier.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace kalan {
+
+namespace {
+
+struct Vec3 {
+    float x, y, z;
+};
+
+inline Vec3 sub(const Vec3& a, const Vec3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+inline float dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline Vec3 cross(const Vec3& a, const Vec3& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+inline float length(const Vec3& a) { return std::sqrt(dot(a, a)); }
+
+inline uint64_t edgeKey(uint32_t a, uint32_t b) {
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+// Симметричная квадрика плоскостей: Q(v) = v^T A v + 2 b^T v + c
+struct Quadric {
+    float a00 = 0, a11 = 0, a22 = 0, a01 = 0, a02 = 0, a12 = 0;
+    float b0 = 0, b1 = 0, b2 = 0;
+    float c = 0;
+    float w = 0;
+
+    void addPlane(const Vec3& n, float d, float weight) {
+        a00 += weight * n.x * n.x;
+        a11 += weight * n.y * n.y;
+        a22 += weight * n.z * n.z;
+        a01 += weight * n.x * n.y;
+        a02 += weight * n.x * n.z;
+        a12 += weight * n.y * n.z;
+        b0 += weight * n.x * d;
+        b1 += weight * n.y * d;
+        b2 += weight * n.z * d;
+        c += weight * d * d;
+        w += weight;
+    }
+
+    void add(const Quadric& q) {
+        a00 += q.a00; a11 += q.a11; a22 += q.a22;
+        a01 += q.a01; a02 += q.a02; a12 += q.a12;
+        b0 += q.b0; b1 += q.b1; b2 += q.b2;
+        c += q.c;
+        w += q.w;
+    }
+
+    // Квадрат расстояния до плоскостей, усреднённый по весу
+    [[nodiscard]] float eval(const Vec3& v) const {
+        float rx = a00 * v.x + a01 * v.y + a02 * v.z;
+        float ry = a01 * v.x + a11 * v.y + a12 * v.z;
+        float rz = a02 * v.x + a12 * v.y + a22 * v.z;
+        float e = rx * v.x + ry * v.y + rz * v.z;
+        e += 2.0f * (b0 * v.x + b1 * v.y + b2 * v.z);
+        e += c;
+        return w > 0.0f ? std::fabs(e) / w : 0.0f;
+    }
+};
+
+enum class VertexKind : uint8_t {
+    Manifold,   // внутренняя вершина, одна копия
+    Border,     // на открытой границе
+    Seam,       // две копии с разными атрибутами
+    Locked      // не двигается
+};
+
+// Вес плоскостей, удерживающих открытую границу
+constexpr float BorderWeight = 10.0f;
+
+struct Collapse {
+    uint32_t from;  // каноническая вершина, которая исчезает
+    uint32_t to;
+    float cost;
+};
+
+} // anonymous namespace
+
+float computeMeshExtent(const float* positions, size_t vertexCount) {
+    if (vertexCount == 0) return 0.0f;
+    Vec3 mn{positions[0], positions[1], positions[2]};
+    Vec3 mx = mn;
+    for (size_t i = 1; i < vertexCount; ++i) {
+        const float* p = positions + i * 3;
+        mn = {std::min(mn.x, p[0]), std::min(mn.y, p[1]), std::min(mn.z, p[2])};
+        mx = {std::max(mx.x, p[0]), std::max(mx.y, p[1]), std::max(mx.z, p[2])};
+    }
+    return length(sub(mx, mn));
+}
+
+SimplifyResult simplifyMesh(
+    const float* positions, size_t vertexCount,
+    const uint32_t* indices, size_t indexCount,
+    size_t targetIndexCount, float targetError)
+{
+    SimplifyResult result;
+    result.indices.assign(indices, indices + indexCount);
+    if (vertexCount == 0 || indexCount < 3 || indexCount <= targetIndexCount) {
+        return result;
+    }
+
+    auto pos = [positions](uint32_t v) {
+        return Vec3{positions[v * 3 + 0], positions[v * 3 + 1], positions[v * 3 + 2]};
+    };
+
+    // ---------- Канонические вершины: копии с одинаковой позицией ----------
+    std::vector<uint32_t> canon(vertexCount);
+    std::vector<uint32_t> wedge(vertexCount); // кольцевой список копий
+    {
+        struct PosHash {
+            size_t operator()(const Vec3& p) const noexcept {
+                uint32_t h[3];
+                std::memcpy(h, &p, sizeof(h));
+                return (h[0] * 73856093u) ^ (h[1] * 19349663u) ^ (h[2] * 83492791u);
+            }
+        };
+        struct PosEq {
+            bool operator()(const Vec3& a, const Vec3& b) const noexcept {
+                return a.x == b.x && a.y == b.y && a.z == b.z;
+            }
+        };
+        std::unordered_map<Vec3, uint32_t, PosHash, PosEq> first;
+        first.reserve(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; ++v) {
+            auto [it, inserted] = first.try_emplace(pos(v), v);
+            canon[v] = it->second;
+            if (inserted) {
+                wedge[v] = v;
+            } else {
+                uint32_t c = it->second;
+                wedge[v] = wedge[c];
+                wedge[c] = v;
+            }
+        }
+    }
+
+    // ---------- Классификация вершин ----------
+    std::vector<VertexKind> kind(vertexCount, VertexKind::Manifold);
+    {
+        std::unordered_map<uint64_t, int> edgeUse;
+        edgeUse.reserve(indexCount);
+        for (size_t t = 0; t < indexCount; t += 3) {
+            for (int e = 0; e < 3; ++e) {
+                uint32_t a = canon[result.indices[t + e]];
+                uint32_t b = canon[result.indices[t + (e + 1) % 3]];
+                ++edgeUse[edgeKey(a, b)];
+            }
+        }
+
+        std::vector<uint8_t> border(vertexCount, 0);
+        std::vector<uint8_t> complex(vertexCount, 0);
+        for (const auto& [key, count] : edgeUse) {
+            uint32_t a = static_cast<uint32_t>(key >> 32);
+            uint32_t b = static_cast<uint32_t>(key & 0xffffffffu);
+            auto rev = edgeUse.find(edgeKey(b, a));
+            int revCount = rev != edgeUse.end() ? rev->second : 0;
+            if (count > 1 || revCount > 1) {
+                complex[a] = complex[b] = 1; // неманифолдное ребро
+            } else if (revCount == 0) {
+                border[a] = border[b] = 1;
+            }
+        }
+
+        for (uint32_t v = 0; v < vertexCount; ++v) {
+            if (canon[v] != v) continue;
+            int wedges = 1;
+            for (uint32_t w = wedge[v]; w != v; w = wedge[w]) ++wedges;
+
+            VertexKind k = VertexKind::Locked;
+            if (!complex[v]) {
+                if (wedges == 1) k = border[v] ? VertexKind::Border : VertexKind::Manifold;
+                else if (wedges == 2 && !border[v]) k = VertexKind::Seam;
+            }
+            kind[v] = k;
+        }
+    }
+
+    // ---------- Квадрики ----------
+    std::vector<Quadric> quadrics(vertexCount);
+    {
+        std::unordered_set<uint64_t> directed;
+        directed.reserve(indexCount);
+        for (size_t t = 0; t < indexCount; t += 3) {
+            for (int e = 0; e < 3; ++e) {
+                directed.insert(edgeKey(canon[result.indices[t + e]],
+                                        canon[result.indices[t + (e + 1) % 3]]));
+            }
+        }
+
+        for (size_t t = 0; t < indexCount; t += 3) {
+            uint32_t c[3] = {canon[result.indices[t]], canon[result.indices[t + 1]],
+                             canon[result.indices[t + 2]]};
+            Vec3 p0 = pos(c[0]), p1 = pos(c[1]), p2 = pos(c[2]);
+            Vec3 n = cross(sub(p1, p0), sub(p2, p0));
+            float len = length(n);
+            if (len <= 0.0f) continue;
+            n = {n.x / len, n.y / len, n.z / len};
+            float area = len * 0.5f;
+            float d = -dot(n, p0);
+            for (uint32_t v : c) quadrics[v].addPlane(n, d, area);
+
+            // Открытые рёбра удерживаем плоскостью, перпендикулярной треугольнику
+            for (int e = 0; e < 3; ++e) {
+                uint32_t a = c[e], b = c[(e + 1) % 3];
+                if (directed.count(edgeKey(b, a))) continue;
+                Vec3 edge = sub(pos(b), pos(a));
+                float edgeLen = length(edge);
+                if (edgeLen <= 0.0f) continue;
+                Vec3 en = cross(edge, n);
+                float enLen = length(en);
+                if (enLen <= 0.0f) continue;
+                en = {en.x / enLen, en.y / enLen, en.z / enLen};
+                float ed = -dot(en, pos(a));
+                quadrics[a].addPlane(en, ed, edgeLen * edgeLen * BorderWeight);
+                quadrics[b].addPlane(en, ed, edgeLen * edgeLen * BorderWeight);
+            }
+        }
+    }
+
+    // ---------- Итеративные проходы схлопывания ----------
+    std::vector<uint32_t>& idx = result.indices;
+    std::vector<uint32_t> triOffsets(vertexCount + 1);
+    std::vector<uint32_t> triList;
+    std::vector<Collapse> candidates;
+    std::vector<uint8_t> locked(vertexCount);
+    std::vector<uint32_t> remap(vertexCount);
+    std::unordered_set<uint64_t> edges;        // рёбра исходной индексации (для швов)
+    std::unordered_set<uint64_t> canonDirected; // направленные канонические рёбра (для границ)
+
+    // Треугольники, прилегающие к канонической вершине
+    auto trianglesOf = [&](uint32_t c) {
+        return std::pair{triList.data() + triOffsets[c], triList.data() + triOffsets[c + 1]};
+    };
+
+    auto isBorderEdge = [&](uint32_t a, uint32_t b) {
+        return !canonDirected.count(edgeKey(a, b)) || !canonDirected.count(edgeKey(b, a));
+    };
+
+    // Найти копию w, соединённую ребром с копией u (для швов и переноса индексов)
+    auto findWedgeEdge = [&](uint32_t u, uint32_t wCanon) -> uint32_t {
+        uint32_t w = wCanon;
+        do {
+            if (edges.count(edgeKey(u, w)) || edges.count(edgeKey(w, u))) return w;
+            w = wedge[w];
+        } while (w != wCanon);
+        return UINT32_MAX;
+    };
+
+    while (idx.size() > targetIndexCount) {
+        size_t triCount = idx.size() / 3;
+
+        // CSR список треугольников по каноническим вершинам
+        std::fill(triOffsets.begin(), triOffsets.end(), 0);
+        for (uint32_t v : idx) ++triOffsets[canon[v] + 1];
+        for (size_t i = 0; i < vertexCount; ++i) triOffsets[i + 1] += triOffsets[i];
+        triList.resize(idx.size());
+        {
+            std::vector<uint32_t> fill(triOffsets.begin(), triOffsets.end() - 1);
+            for (size_t t = 0; t < triCount; ++t) {
+                for (int k = 0; k < 3; ++k) triList[fill[canon[idx[t * 3 + k]]]++] = static_cast<uint32_t>(t);
+            }
+        }
+
+        edges.clear();
+        canonDirected.clear();
+        for (size_t t = 0; t < triCount; ++t) {
+            for (int e = 0; e < 3; ++e) {
+                uint32_t a = idx[t * 3 + e], b = idx[t * 3 + (e + 1) % 3];
+                edges.insert(edgeKey(a, b));
+                canonDirected.insert(edgeKey(canon[a], canon[b]));
+            }
+        }
+
+        // Лучшее схлопывание для каждой вершины
+        candidates.clear();
+        for (uint32_t u = 0; u < vertexCount; ++u) {
+            if (canon[u] != u || triOffsets[u] == triOffsets[u + 1]) continue;
+            VertexKind ku = kind[u];
+            if (ku == VertexKind::Locked) continue;
+
+            Collapse best{u, u, INFINITY};
+            auto [tb, te] = trianglesOf(u);
+            for (const uint32_t* t = tb; t != te; ++t) {
+                for (int k = 0; k < 3; ++k) {
+                    uint32_t w = canon[idx[*t * 3 + k]];
+                    if (w == u) continue;
+
+                    if (ku == VertexKind::Border) {
+                        if (!isBorderEdge(u, w)) continue;
+                    } else if (ku == VertexKind::Seam) {
+                        if (kind[w] != VertexKind::Seam && kind[w] != VertexKind::Locked) continue;
+                        uint32_t a = findWedgeEdge(u, w);
+                        uint32_t b = findWedgeEdge(wedge[u], w);
+                        if (a == UINT32_MAX || b == UINT32_MAX || a == b) continue;
+                    }
+
+                    Quadric q = quadrics[u];
+                    q.add(quadrics[w]);
+                    float cost = q.eval(pos(w));
+                    if (cost < best.cost) best = {u, w, cost};
+                }
+            }
+            if (best.to != u && std::sqrt(best.cost) <= targetError) {
+                candidates.push_back(best);
+            }
+        }
+
+        if (candidates.empty()) break;
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+        // Каждое схлопывание убирает примерно два треугольника
+        size_t trianglesToRemove = (idx.size() - targetIndexCount) / 3;
+        size_t removed = 0;
+        std::fill(locked.begin(), locked.end(), 0);
+        for (uint32_t v = 0; v < vertexCount; ++v) remap[v] = v;
+        size_t collapsed = 0;
+
+        for (const Collapse& c : candidates) {
+            if (removed >= trianglesToRemove) break;
+            if (locked[c.from] || locked[c.to]) continue;
+
+            // Проверка на переворот треугольников вокруг исчезающей вершины
+            Vec3 target = pos(c.to);
+            bool flips = false;
+            int shared = 0;
+            auto [tb, te] = trianglesOf(c.from);
+            for (const uint32_t* t = tb; t != te && !flips; ++t) {
+                uint32_t v[3] = {canon[idx[*t * 3]], canon[idx[*t * 3 + 1]], canon[idx[*t * 3 + 2]]};
+                if (v[0] == c.to || v[1] == c.to || v[2] == c.to) {
+                    ++shared;
+                    continue;
+                }
+                Vec3 p[3] = {pos(v[0]), pos(v[1]), pos(v[2])};
+                Vec3 before = cross(sub(p[1], p[0]), sub(p[2], p[0]));
+                for (int k = 0; k < 3; ++k) {
+                    if (v[k] == c.from) p[k] = target;
+                }
+                Vec3 after = cross(sub(p[1], p[0]), sub(p[2], p[0]));
+                flips = dot(before, after) <= 0.0f;
+            }
+            if (flips) continue;
+
+            // Перенос индексов: каждая копия исчезающей вершины уходит в копию цели
+            if (kind[c.from] == VertexKind::Seam) {
+                uint32_t other = wedge[c.from];
+                remap[c.from] = findWedgeEdge(c.from, c.to);
+                remap[other] = findWedgeEdge(other, c.to);
+            } else {
+                uint32_t w = findWedgeEdge(c.from, c.to);
+                remap[c.from] = w != UINT32_MAX ? w : c.to;
+            }
+
+            quadrics[c.to].add(quadrics[c.from]);
+            result.error = std::max(result.error, std::sqrt(c.cost));
+
+            // Соседи исчезающей вершины меняют треугольники — до следующего прохода не трогаем
+            locked[c.from] = locked[c.to] = 1;
+            for (const uint32_t* t = tb; t != te; ++t) {
+                for (int k = 0; k < 3; ++k) locked[canon[idx[*t * 3 + k]]] = 1;
+            }
+
+            removed += std::max(shared, 1);
+            ++collapsed;
+        }
+
+        if (collapsed == 0) break;
+
+        // Переписать индексы и выкинуть вырожденные треугольники
+        size_t write = 0;
+        for (size_t t = 0; t < triCount; ++t) {
+            uint32_t a = remap[idx[t * 3]], b = remap[idx[t * 3 + 1]], cc = remap[idx[t * 3 + 2]];
+            if (canon[a] == canon[b] || canon[b] == canon[cc] || canon[a] == canon[cc]) continue;
+            idx[write++] = a;
+            idx[write++] = b;
+            idx[write++] = cc;
+        }
+        idx.resize(write);
+    }
+
+    return result;
+}
+
+} // namespace kalan
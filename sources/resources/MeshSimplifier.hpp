@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace kalan {
+
+// Упрощение меша схлопыванием рёбер по quadric error metric (Garland-Heckbert).
+// Используется half-edge collapse: вершина переезжает в соседнюю, новых вершин
+// не появляется, поэтому результат индексирует исходный вершинный буфер.
+//
+// Швы по атрибутам (вершины с одинаковой позицией, но разными UV/нормалями)
+// схлопываются только вдоль шва обеими копиями сразу, границы — только вдоль
+// границы. Вершины со сложной топологией не двигаются.
+struct SimplifyResult {
+    std::vector<uint32_t> indices;
+    float error = 0.0f; // максимальное отклонение от исходной поверхности, в единицах меша
+};
+
+// positions — xyz float на вершину.
+// targetError — абсолютный предел ошибки; упрощение останавливается,
+// если достигнуто targetIndexCount или следующий collapse превысит предел.
+[[nodiscard]] SimplifyResult simplifyMesh(
+    const float* positions, size_t vertexCount,
+    const uint32_t* indices, size_t indexCount,
+    size_t targetIndexCount, float targetError);
+
+// Диагональ AABB — масштаб для перевода относительной ошибки в абсолютную
+[[nodiscard]] float computeMeshExtent(const float* positions, size_t vertexCount);
+
+} // namespace kalan
@@ -0,0 +1,133 @@
+#include "MeshTangents.hpp"
+#include "../core/Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+namespace kalan {
+
+namespace {
+
+struct Vec3 {
+    float x, y, z;
+};
+
+Vec3 sub(Vec3 a, Vec3 b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+Vec3 scale(Vec3 a, float s) { return {a.x * s, a.y * s, a.z * s}; }
+float dot(Vec3 a, Vec3 b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+Vec3 cross(Vec3 a, Vec3 b) { return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x}; }
+
+Vec3 normalizeOr(Vec3 a, Vec3 fallback) {
+    float len = std::sqrt(dot(a, a));
+    return len > 1e-20f ? scale(a, 1.0f / len) : fallback;
+}
+
+// Проекция на плоскость с нормалью n (Gram-Schmidt)
+Vec3 orthogonalize(Vec3 t, Vec3 n) {
+    return sub(t, scale(n, dot(n, t)));
+}
+
+// Любой единичный вектор, перпендикулярный n
+Vec3 anyPerpendicular(Vec3 n) {
+    Vec3 axis = std::fabs(n.x) < 0.9f ? Vec3{1.0f, 0.0f, 0.0f} : Vec3{0.0f, 1.0f, 0.0f};
+    return normalizeOr(orthogonalize(axis, n), Vec3{1.0f, 0.0f, 0.0f});
+}
+
+// Накопленные касательные вершины: [0] — правый базис (w = 1), [1] — зеркальный (w = -1)
+struct Accumulator {
+    Vec3 tangent[2] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float weight[2] = {0.0f, 0.0f};
+};
+
+} // anonymous namespace
+
+bool generateTangents(Mesh& mesh, TangentStats* stats) {
+    KALAN_PROFILE_FUNCTION();
+    auto start = std::chrono::steady_clock::now();
+    if (!mesh.vertices || !mesh.normals || !mesh.texcoords || mesh.vertexCount <= 0) return false;
+
+    const int vertexCount = mesh.vertexCount;
+    const int triangleCount = mesh.indices ? mesh.triangleCount : vertexCount / 3;
+    auto position = [&](int v) { return Vec3{mesh.vertices[v * 3], mesh.vertices[v * 3 + 1], mesh.vertices[v * 3 + 2]}; };
+    auto normal = [&](int v) { return Vec3{mesh.normals[v * 3], mesh.normals[v * 3 + 1], mesh.normals[v * 3 + 2]}; };
+
+    TangentStats local;
+    std::vector<Accumulator> accum(vertexCount);
+    for (int t = 0; t < triangleCount; ++t) {
+        int idx[3];
+        for (int k = 0; k < 3; ++k) idx[k] = mesh.indices ? mesh.indices[t * 3 + k] : t * 3 + k;
+        if (idx[0] >= vertexCount || idx[1] >= vertexCount || idx[2] >= vertexCount) continue;
+
+        const Vec3 p[3] = {position(idx[0]), position(idx[1]), position(idx[2])};
+        const float* uv0 = &mesh.texcoords[idx[0] * 2];
+        const float* uv1 = &mesh.texcoords[idx[1] * 2];
+        const float* uv2 = &mesh.texcoords[idx[2] * 2];
+        const float du1 = uv1[0] - uv0[0];
+        const float dv1 = uv1[1] - uv0[1];
+        const float du2 = uv2[0] - uv0[0];
+        const float dv2 = uv2[1] - uv0[1];
+
+        // Удвоенная знаковая площадь в UV: ноль — касательная не определена
+        const float area = du1 * dv2 - du2 * dv1;
+        if (std::fabs(area) <= 1e-20f) {
+            ++local.degenerateTriangles;
+            continue;
+        }
+
+        // dP/du и dP/dv с точностью до положительного множителя (vOs и vOt в MikkTSpace)
+        const Vec3 e1 = sub(p[1], p[0]);
+        const Vec3 e2 = sub(p[2], p[0]);
+        const float areaSign = area > 0.0f ? 1.0f : -1.0f;
+        const Vec3 faceTangent = scale(sub(scale(e1, dv2), scale(e2, dv1)), areaSign);
+        const Vec3 faceBitangent = scale(sub(scale(e2, du1), scale(e1, du2)), areaSign);
+
+        for (int k = 0; k < 3; ++k) {
+            const int v = idx[k];
+            const Vec3 n = normal(v);
+            const Vec3 tangent = normalizeOr(orthogonalize(faceTangent, n), Vec3{0.0f, 0.0f, 0.0f});
+            // Ориентация базиса относительно нормали вершины: зеркальный остров даёт -1
+            const int orientation = dot(cross(n, faceTangent), faceBitangent) < 0.0f ? 1 : 0;
+
+            // Угол при вершине между рёбрами, спроецированными на плоскость нормали
+            const Vec3 a = normalizeOr(orthogonalize(sub(p[(k + 1) % 3], p[k]), n), Vec3{0.0f, 0.0f, 0.0f});
+            const Vec3 b = normalizeOr(orthogonalize(sub(p[(k + 2) % 3], p[k]), n), Vec3{0.0f, 0.0f, 0.0f});
+            const float angle = std::acos(std::clamp(dot(a, b), -1.0f, 1.0f));
+
+            Accumulator& acc = accum[v];
+            acc.tangent[orientation].x += tangent.x * angle;
+            acc.tangent[orientation].y += tangent.y * angle;
+            acc.tangent[orientation].z += tangent.z * angle;
+            acc.weight[orientation] += angle;
+        }
+    }
+
+    if (!mesh.tangents) {
+        mesh.tangents = static_cast<float*>(MemAlloc(static_cast<unsigned int>(vertexCount * 4 * sizeof(float))));
+    }
+    for (int v = 0; v < vertexCount; ++v) {
+        const Accumulator& acc = accum[v];
+        if (acc.weight[0] > 0.0f && acc.weight[1] > 0.0f) ++local.conflictVertices;
+        const int orientation = acc.weight[1] > acc.weight[0] ? 1 : 0;
+
+        // Вершина только на вырожденных треугольниках — любой базис, лишь бы ортогональный
+        const Vec3 n = normalizeOr(normal(v), Vec3{0.0f, 1.0f, 0.0f});
+        const Vec3 tangent = normalizeOr(orthogonalize(acc.tangent[orientation], n), anyPerpendicular(n));
+        const float sign = orientation == 0 ? 1.0f : -1.0f;
+        local.mirroredVertices += orientation;
+
+        mesh.tangents[v * 4 + 0] = tangent.x;
+        mesh.tangents[v * 4 + 1] = tangent.y;
+        mesh.tangents[v * 4 + 2] = tangent.z;
+        mesh.tangents[v * 4 + 3] = sign;
+    }
+
+    if (stats) {
+        local.meshIndex = stats->meshIndex;
+        local.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        *stats = local;
+    }
+    return true;
+}
+
+} // namespace kalan
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "raylib.h"
+
+namespace kalan {
+
+// Статистика генерации тангентов одного меша
+struct TangentStats {
+    int meshIndex = -1;
+    int mirroredVertices = 0;       // вершины с w = -1 (левый базис)
+    int degenerateTriangles = 0;    // нулевая площадь в UV, в тангенты не вошли
+    int conflictVertices = 0;       // вершина на треугольниках с разной ориентацией UV
+    double ms = 0.0;
+};
+
+// Тангенты по схеме MikkTSpace: касательная каждого треугольника (dP/du) проецируется
+// на плоскость нормали вершины и суммируется с весом угла при вершине, раздельно для
+// треугольников с прямой и зеркальной ориентацией UV. w — знак бивектора:
+// B = cross(N, T) * w, как читают шейдеры PBR.
+//
+// В отличие от полной MikkTSpace вершины не расщепляются: вершина, где сходятся обе
+// ориентации (редкий случай — после JoinIdenticalVertices у шва разные UV), берёт
+// ту, что набрала больший вес.
+//
+// Нужны vertices, normals и texcoords; tangents выделяется MemAlloc, если его нет.
+// false — данных не хватает, меш не изменён.
+bool generateTangents(Mesh& mesh, TangentStats* stats = nullptr);
+
+} // namespace kalan
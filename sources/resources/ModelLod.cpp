@@ -0,0 +1,248 @@
+#include "ModelLod.hpp"
+#include "MeshSimplifier.hpp"
+#include "../rendering/PBRMaterial.hpp"
+#include "rlgl.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+namespace kalan {
+
+namespace {
+
+// Скопировать в новый меш только вершины, на которые ссылаются indices
+Mesh CompactMesh(const Mesh& src, const std::vector<uint32_t>& indices) {
+    std::vector<int> remap(src.vertexCount, -1);
+    std::vector<uint32_t> order;
+    order.reserve(src.vertexCount);
+    for (uint32_t v : indices) {
+        if (remap[v] < 0) {
+            remap[v] = static_cast<int>(order.size());
+            order.push_back(v);
+        }
+    }
+
+    Mesh mesh = {0};
+    mesh.vertexCount = static_cast<int>(order.size());
+    mesh.triangleCount = static_cast<int>(indices.size() / 3);
+
+    auto copyStream = [&order](auto* srcData, int components) {
+        using T = std::remove_pointer_t<decltype(srcData)>;
+        if (!srcData) return static_cast<T*>(nullptr);
+        T* dst = (T*)MemAlloc(static_cast<unsigned int>(order.size() * components * sizeof(T)));
+        for (size_t i = 0; i < order.size(); ++i) {
+            std::memcpy(dst + i * components, srcData + order[i] * components, components * sizeof(T));
+        }
+        return dst;
+    };
+
+    mesh.vertices = copyStream(src.vertices, 3);
+    mesh.normals = copyStream(src.normals, 3);
+    mesh.tangents = copyStream(src.tangents, 4);
+    mesh.texcoords = copyStream(src.texcoords, 2);
+    mesh.texcoords2 = copyStream(src.texcoords2, 2);
+    mesh.colors = copyStream(src.colors, 4);
+
+    mesh.indices = (unsigned short*)MemAlloc(static_cast<unsigned int>(indices.size() * sizeof(unsigned short)));
+    for (size_t i = 0; i < indices.size(); ++i) {
+        mesh.indices[i] = static_cast<unsigned short>(remap[indices[i]]);
+    }
+    return mesh;
+}
+
+} // anonymous namespace
+
+// ============ Генерация ============
+
+MeshLodChain generateMeshLods(const Mesh& source, int meshIndex, const LodSettings& settings) {
+    MeshLodChain chain;
+    if (!source.vertices || !source.indices || source.triangleCount <= settings.minTriangles) {
+        return chain;
+    }
+
+    float extent = computeMeshExtent(source.vertices, source.vertexCount);
+    float maxError = settings.maxRelativeError * extent;
+
+    std::vector<uint32_t> indices(source.indices, source.indices + source.triangleCount * 3);
+    float accumulatedError = 0.0f;
+
+    for (int level = 1; level <= settings.maxLevels; ++level) {
+        auto start = std::chrono::steady_clock::now();
+
+        size_t prevTriangles = indices.size() / 3;
+        size_t target = static_cast<size_t>(prevTriangles * settings.reductionPerLevel);
+        target = std::max<size_t>(target, settings.minTriangles);
+        if (target >= prevTriangles) break;
+
+        // Каждый уровень упрощается из предыдущего — ошибка накапливается
+        SimplifyResult res = simplifyMesh(source.vertices, source.vertexCount,
+                                          indices.data(), indices.size(),
+                                          target * 3, maxError - accumulatedError);
+
+        // Упрощение упёрлось в предел ошибки — следующие уровни тоже не получатся
+        if (res.indices.size() >= indices.size() * 0.95f) break;
+
+        indices = std::move(res.indices);
+        accumulatedError += res.error;
+
+        chain.levels.push_back(CompactMesh(source, indices));
+        chain.errors.push_back(accumulatedError);
+
+        LodLevelStats stats;
+        stats.meshIndex = meshIndex;
+        stats.level = level;
+        stats.sourceTriangles = source.triangleCount;
+        stats.triangles = static_cast<int>(indices.size() / 3);
+        stats.error = accumulatedError;
+        stats.relativeError = extent > 0.0f ? accumulatedError / extent : 0.0f;
+        stats.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        chain.stats.push_back(stats);
+    }
+
+    return chain;
+}
+
+// ============ ModelLods ============
+
+ModelLods::ModelLods(int meshCount)
+    : meshLevels_(meshCount), pendingPacked_(meshCount), packedInfo_(meshCount) {}
+
+ModelLods::~ModelLods() {
+    for (auto& levels : meshLevels_) {
+        for (auto& mesh : levels) UnloadMesh(mesh);
+    }
+}
+
+void ModelLods::setMeshChain(int meshIndex, MeshLodChain&& chain) {
+    auto& levels = meshLevels_.at(meshIndex);
+    levels = std::move(chain.levels);
+    pendingPacked_.at(meshIndex) = std::move(chain.packed);
+
+    int count = static_cast<int>(levels.size()) + 1;
+    if (count > levelCount_) {
+        levelCount_ = count;
+        levelErrors_.resize(count, 0.0f);
+    }
+    for (size_t i = 0; i < chain.errors.size(); ++i) {
+        levelErrors_[i + 1] = std::max(levelErrors_[i + 1], chain.errors[i]);
+    }
+}
+
+void ModelLods::remapTexcoords(int meshIndex, const UvTransform& transform) {
+    for (auto& data : pendingPacked_.at(meshIndex)) {
+        UvTransform t = combineUvTransform({data.info.texcoordOffset, data.info.texcoordScale}, transform);
+        data.info.texcoordOffset = t.offset;
+        data.info.texcoordScale = t.scale;
+    }
+    for (auto& info : packedInfo_[meshIndex]) {
+        UvTransform t = combineUvTransform({info.texcoordOffset, info.texcoordScale}, transform);
+        info.texcoordOffset = t.offset;
+        info.texcoordScale = t.scale;
+    }
+    if (!pendingPacked_[meshIndex].empty() || !packedInfo_[meshIndex].empty()) return;
+
+    for (auto& mesh : meshLevels_[meshIndex]) {
+        if (!mesh.texcoords) continue;
+        kalan::remapTexcoords(mesh.texcoords, mesh.vertexCount, transform);
+        if (mesh.vaoId != 0) {
+            UpdateMeshBuffer(mesh, RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD, mesh.texcoords, mesh.vertexCount * 2 * sizeof(float), 0);
+        }
+    }
+}
+
+void ModelLods::upload() {
+    for (size_t m = 0; m < meshLevels_.size(); ++m) {
+        auto& levels = meshLevels_[m];
+        auto& pending = pendingPacked_[m];
+        if (!pending.empty()) {
+            // CPU-уровни заменяются сжатыми: float-массивы больше не нужны
+            for (auto& mesh : levels) UnloadMesh(mesh);
+            levels.clear();
+            packedInfo_[m].clear();
+            for (const auto& data : pending) {
+                levels.push_back(uploadPackedMesh(data));
+                packedInfo_[m].push_back(data.info);
+            }
+            pending.clear();
+            continue;
+        }
+        for (auto& mesh : levels) {
+            if (mesh.vaoId == 0) UploadMesh(&mesh, false);
+        }
+    }
+}
+
+size_t ModelLods::releaseCpuData(MeshRetention retention) {
+    if (retention == MeshRetention::Full) return 0;
+    size_t released = 0;
+    for (auto& levels : meshLevels_) {
+        for (auto& mesh : levels) released += releaseMeshCpuData(mesh, MeshRetention::DrawOnly);
+    }
+    return released;
+}
+
+float ModelLods::getLevelError(int level) const noexcept {
+    if (level <= 0) return 0.0f;
+    return levelErrors_[std::min(level, levelCount_ - 1)];
+}
+
+const Mesh& ModelLods::getMesh(const raylib::Model& model, int meshIndex, int level) const {
+    const auto& levels = meshLevels_[meshIndex];
+    if (level <= 0 || levels.empty()) return model.meshes[meshIndex];
+    return levels[std::min<size_t>(level, levels.size()) - 1];
+}
+
+const PackedMeshInfo* ModelLods::getPackedInfo(int meshIndex, int level, const PackedModelInfo* base) const {
+    const auto& levels = meshLevels_[meshIndex];
+    if (level <= 0 || levels.empty()) return base ? &base->meshes[meshIndex] : nullptr;
+    if (packedInfo_[meshIndex].empty()) return nullptr;
+    return &packedInfo_[meshIndex][std::min<size_t>(level, levels.size()) - 1];
+}
+
+void ModelLods::draw(const raylib::Model& model, int level, const Matrix& transform,
+                     const PackedModelInfo* packed) const {
+    Matrix world = MatrixMultiply(model.transform, transform);
+    for (int m = 0; m < model.meshCount; ++m) {
+        const Material& material = model.materials[model.meshMaterial[m]];
+        if (const PackedMeshInfo* info = getPackedInfo(m, level, packed)) {
+            setPackedMeshUniforms(material.shader, *info);
+        }
+        PBRMaterial::applyOrmUniform(material);
+        DrawMesh(getMesh(model, m, level), material, world);
+    }
+}
+
+// ============ Выбор уровня ============
+
+float projectLodError(float worldError, float distance, const LodSelectParams& params) {
+    float d = std::max(distance, 1e-3f);
+    float halfFov = params.fovY * 0.5f * DEG2RAD;
+    return worldError * params.screenHeight / (2.0f * d * std::tan(halfFov));
+}
+
+int selectLod(const ModelLods& lods, float distance, float scale,
+              const LodSelectParams& params, int currentLevel) {
+    int levelCount = lods.getLevelCount();
+    currentLevel = std::clamp(currentLevel, 0, levelCount - 1);
+
+    auto pixels = [&](int level) {
+        return projectLodError(lods.getLevelError(level) * scale, distance, params);
+    };
+
+    // Текущий уровень стал слишком грубым — уточняем до первого подходящего
+    if (pixels(currentLevel) > params.thresholdPixels) {
+        int level = currentLevel;
+        while (level > 0 && pixels(level) > params.thresholdPixels) --level;
+        return level;
+    }
+
+    // Огрубляем, только если новый уровень укладывается в порог с запасом
+    float strict = params.thresholdPixels * (1.0f - params.hysteresis);
+    int level = currentLevel;
+    while (level + 1 < levelCount && pixels(level + 1) <= strict) ++level;
+    return level;
+}
+
+} // namespace kalan
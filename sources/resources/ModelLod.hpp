@@ -0,0 +1,100 @@
+#pragma once
+
+#include "raylib-cpp.hpp"
+#include "MeshRetention.hpp"
+#include "VertexQuantization.hpp"
+#include "TexturePacker.hpp"
+#include <vector>
+
+namespace kalan {
+
+// Параметры генерации дискретных LOD
+struct LodSettings {
+    int maxLevels = 3;                // без учёта исходного уровня 0
+    float reductionPerLevel = 0.5f;   // доля треугольников от предыдущего уровня
+    float maxRelativeError = 0.05f;   // предел ошибки относительно диагонали AABB меша
+    int minTriangles = 32;            // меньше не упрощаем
+};
+
+// Отчёт по одному уровню одного меша
+struct LodLevelStats {
+    int meshIndex = -1;
+    int level = 0;
+    int sourceTriangles = 0;
+    int triangles = 0;
+    float error = 0.0f;          // в единицах меша
+    float relativeError = 0.0f;  // относительно диагонали AABB
+    double ms = 0.0;
+};
+
+// Цепочка LOD одного меша, посчитанная на CPU (без upload)
+struct MeshLodChain {
+    std::vector<Mesh> levels;     // уровни 1..N
+    std::vector<float> errors;    // накопленная ошибка каждого уровня
+    std::vector<LodLevelStats> stats;
+    std::vector<PackedMeshData> packed; // если не пусто — уровни загружаются в формате Packed
+};
+
+// Упростить меш в несколько уровней. Потокобезопасно, GPU не трогает.
+[[nodiscard]] MeshLodChain generateMeshLods(const Mesh& source, int meshIndex, const LodSettings& settings);
+
+// LOD уровни всех мешей модели. Уровень 0 — меши самой модели.
+class ModelLods {
+public:
+    explicit ModelLods(int meshCount);
+    ~ModelLods();
+
+    ModelLods(const ModelLods&) = delete;
+    ModelLods& operator=(const ModelLods&) = delete;
+
+    void setMeshChain(int meshIndex, MeshLodChain&& chain);
+
+    // Перевести UV всех уровней меша (например, в прямоугольник атласа)
+    void remapTexcoords(int meshIndex, const UvTransform& transform);
+
+    // Загрузить все уровни в GPU (главный поток)
+    void upload();
+
+    // После upload: уровни не нужны ни физике, ни пикингу, поэтому при любом
+    // retention, кроме Full, остаются только индексы. Возвращает освобождённые байты.
+    size_t releaseCpuData(MeshRetention retention);
+
+    [[nodiscard]] int getLevelCount() const noexcept { return levelCount_; }
+    // Максимальная ошибка уровня по всем мешам (0 для уровня 0)
+    [[nodiscard]] float getLevelError(int level) const noexcept;
+
+    // Меш нужного уровня; если у меша уровней меньше, берётся самый грубый из имеющихся
+    [[nodiscard]] const Mesh& getMesh(const raylib::Model& model, int meshIndex, int level) const;
+    // Деквантизация того же меша; base — уровня 0 (LoadedModel::packed).
+    // nullptr — меш этого уровня в формате Float32
+    [[nodiscard]] const PackedMeshInfo* getPackedInfo(int meshIndex, int level, const PackedModelInfo* base) const;
+
+    // packed — деквантизация мешей уровня 0, если модель загружена в формате Packed
+    void draw(const raylib::Model& model, int level, const Matrix& transform,
+              const PackedModelInfo* packed = nullptr) const;
+
+private:
+    std::vector<std::vector<Mesh>> meshLevels_; // [meshIndex][level - 1]
+    std::vector<std::vector<PackedMeshData>> pendingPacked_; // ждут upload
+    std::vector<std::vector<PackedMeshInfo>> packedInfo_;    // пусто для float-уровней
+    std::vector<float> levelErrors_{0.0f};
+    int levelCount_ = 1;
+};
+
+// Выбор уровня по экранной ошибке
+struct LodSelectParams {
+    float screenHeight = 1080.0f;
+    float fovY = 45.0f;             // в градусах
+    float thresholdPixels = 1.0f;   // допустимая ошибка на экране
+    float hysteresis = 0.25f;       // на сколько строже порог при огрублении
+};
+
+// Ошибка worldError, спроецированная на экран с расстояния distance, в пикселях
+[[nodiscard]] float projectLodError(float worldError, float distance, const LodSelectParams& params);
+
+// Уровень для объекта на расстоянии distance (scale — масштаб модели в мире).
+// Огрубление требует запаса по порогу, уточнение происходит сразу — так LOD не мигает на границе.
+[[nodiscard]] int selectLod(const ModelLods& lods, float distance, float scale,
+                            const LodSelectParams& params, int currentLevel);
+
+} // namespace kalan
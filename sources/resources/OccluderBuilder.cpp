@@ -0,0 +1,65 @@
+#include "OccluderBuilder.hpp"
+#include "MeshSimplifier.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <vector>
+
+namespace kalan {
+
+OccluderMesh buildOccluderMesh(const Mesh& mesh, int meshIndex, const OccluderSettings& settings,
+                               OccluderStats* stats) {
+    auto start = std::chrono::steady_clock::now();
+    OccluderStats local;
+    local.meshIndex = meshIndex;
+    local.sourceTriangles = mesh.triangleCount;
+    OccluderMesh occluder;
+
+    auto finish = [&]() {
+        local.triangles = static_cast<int>(occluder.getTriangleCount());
+        local.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (stats) *stats = local;
+        return std::move(occluder);
+    };
+
+    if (!mesh.vertices || mesh.vertexCount < 3 || mesh.triangleCount <= 0 || mesh.boneIds) return finish();
+    const float extent = computeMeshExtent(mesh.vertices, mesh.vertexCount);
+    if (extent < settings.minExtent) return finish();
+
+    std::vector<uint32_t> indices(static_cast<size_t>(mesh.triangleCount) * 3);
+    if (mesh.indices) {
+        std::copy(mesh.indices, mesh.indices + indices.size(), indices.begin());
+    } else {
+        std::iota(indices.begin(), indices.end(), 0u);
+    }
+
+    const size_t target = static_cast<size_t>(settings.maxTriangles) * 3;
+    if (indices.size() > target) {
+        SimplifyResult result = simplifyMesh(mesh.vertices, mesh.vertexCount, indices.data(), indices.size(),
+                                             target, settings.maxRelativeError * extent);
+        if (result.indices.size() > target) return finish();
+        indices = std::move(result.indices);
+        local.error = result.error;
+    }
+
+    // Только вершины, на которые ссылаются оставшиеся треугольники
+    std::vector<int> remap(mesh.vertexCount, -1);
+    occluder.indices.reserve(indices.size());
+    Vector3 lo = {mesh.vertices[indices[0] * 3], mesh.vertices[indices[0] * 3 + 1], mesh.vertices[indices[0] * 3 + 2]};
+    Vector3 hi = lo;
+    for (uint32_t v : indices) {
+        if (remap[v] < 0) {
+            remap[v] = static_cast<int>(occluder.positions.size() / 3);
+            const Vector3 p = {mesh.vertices[v * 3], mesh.vertices[v * 3 + 1], mesh.vertices[v * 3 + 2]};
+            occluder.positions.insert(occluder.positions.end(), {p.x, p.y, p.z});
+            lo = Vector3Min(lo, p);
+            hi = Vector3Max(hi, p);
+        }
+        occluder.indices.push_back(static_cast<uint32_t>(remap[v]));
+    }
+    occluder.bounds = {lo, hi};
+    return finish();
+}
+
+} // namespace kalan
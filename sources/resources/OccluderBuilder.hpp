@@ -0,0 +1,33 @@
+#pragma once
+
+#include "raylib.h"
+#include "../rendering/OcclusionBuffer.hpp"
+
+namespace kalan {
+
+// Параметры упрощения мешей в окклюдеры
+struct OccluderSettings {
+    int maxTriangles = 256;             // на меш; сложнее — не окклюдер
+    // Предел ошибки относительно диагонали AABB меша. Упрощённая поверхность может
+    // выйти за исходную на эту величину — и перекрыть то, что видно по краю.
+    float maxRelativeError = 0.01f;
+    float minExtent = 0.5f;             // диагональ AABB, единицы ассета; мельче — не окклюдер
+};
+
+// Отчёт по одному мешу
+struct OccluderStats {
+    int meshIndex = -1;
+    int sourceTriangles = 0;
+    int triangles = 0;                  // 0 — меш не стал окклюдером
+    float error = 0.0f;                 // в единицах меша
+    double ms = 0.0;
+};
+
+// Окклюдер меша: упрощение по quadric error metric (resources/MeshSimplifier.hpp)
+// до maxTriangles и компактная копия позиций. Меши со скиннингом, мелкие и те, что
+// не упрощаются до maxTriangles в пределах ошибки (листва, решётки), пропускаются —
+// результат пустой. Потокобезопасно, GPU не трогает.
+[[nodiscard]] OccluderMesh buildOccluderMesh(const Mesh& mesh, int meshIndex, const OccluderSettings& settings,
+                                             OccluderStats* stats = nullptr);
+
+} // namespace kalan
@@ -1,25 +1,165 @@
 #include "ParallelLoader.hpp"
+#include "AssimpConvert.hpp"
+#include "AnimationImport.hpp"
+#include "../animation/Skinning.hpp"
+#include "ImportSettings.hpp"
+#include "PooledImageDecoder.hpp"
 #include "../rendering/PBRMaterial.hpp"
+#include "../rendering/TextureStreamer.hpp"
+#include "../physics/JoltRuntime.hpp"
+#include "../physics/ShapeCooker.hpp"
+#include "../core/Profiler.hpp"
+#include "../core/ThreadControl.hpp"
+#include "rlgl.h"
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <iostream>
 #include <fstream>
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <unordered_map>
 #include <unordered_set>
 
 namespace kalan {
 
+// ============ JobToken ============
+
+JobToken JobToken::create(JobPriority priority) {
+    JobToken token;
+    token.state_ = std::make_shared<State>();
+    token.state_->priority.store(priority, std::memory_order_relaxed);
+    return token;
+}
+
+void JobToken::cancel() const noexcept {
+    if (state_) state_->cancelled.store(true, std::memory_order_relaxed);
+}
+
+bool JobToken::isCancelled() const noexcept {
+    return state_ && state_->cancelled.load(std::memory_order_relaxed);
+}
+
+JobPriority JobToken::getPriority(JobPriority fallback) const noexcept {
+    return state_ ? state_->priority.load(std::memory_order_relaxed) : fallback;
+}
+
 // ============ ImageThreadPool ============
 
-ImageThreadPool::ImageThreadPool(size_t threads) {
+namespace {
+
+const char* imageExtension(const std::string& hint) {
+    // Определяем формат по hint, по умолчанию PNG
+    if (hint.find(".jpg") != std::string::npos || 
+        hint.find(".jpeg") != std::string::npos) {
+        return ".jpg";
+    } else if (hint.find(".tga") != std::string::npos) {
+        return ".tga";
+    } else if (hint.find(".bmp") != std::string::npos) {
+        return ".bmp";
+    } else if (hint.find(".dds") != std::string::npos) {
+        return ".dds";
+    } else if (hint.find(".qoi") != std::string::npos) {
+        return ".qoi";
+    } else if (hint.find(".gif") != std::string::npos) {
+        return ".gif";
+    }
+    return ".png";
+}
+
+// PNG/JPEG/TGA/BMP — в буфер пула, прочее (DDS, QOI, 16-битные PNG) — через raylib
+// Копия в кольцо здесь, на воркере: главному потоку остаётся только glTexSubImage
+void stageDecoded(PreloadedImage& result) {
+    if (!result.valid) return;
+    TextureUploader::Staged staged = TextureUploader::instance().stage(result.image);
+    if (!staged.id) return;
+    Image decoded = result.image;
+    result.reset();
+    result.image = decoded;
+    result.image.data = staged.data;
+    result.valid = true;
+    result.pooled = false;
+    result.staging = staged.id;
+}
+
+PreloadedImage decodeImage(const unsigned char* data, int size, const std::string& path, bool stage) {
+    PreloadedImage result;
+    result.path = path;
+    if (!data) return result;
+    if (decodeImagePooled(data, size, result.image)) {
+        result.pooled = true;
+    } else {
+        result.image = LoadImageFromMemory(imageExtension(path), data, size);
+    }
+    result.valid = (result.image.data != nullptr);
+    if (stage) stageDecoded(result);
+    return result;
+}
+
+PreloadedImage cancelledImage(const std::string& path) {
+    PreloadedImage result;
+    result.path = path;
+    result.cancelled = true;
+    return result;
+}
+
+} // anonymous namespace
+
+PreloadedImage decodeImageLevel(const ImageSource& source, int level, int maxDimension, bool stageForUpload) {
+    KALAN_PROFILE_FUNCTION();
+    PreloadedImage result;
+    if (source.data) {
+        result = decodeImage(source.data->data(), static_cast<int>(source.data->size()), source.path, false);
+    } else {
+        int size = 0;
+        unsigned char* fileData = readFilePooled(source.path, size);
+        result = decodeImage(fileData, size, source.path, false);
+        PixelBufferPool::instance().release(fileData);
+    }
+    if (!result.valid) return result;
+    
+    const int width = result.image.width;
+    const int height = result.image.height;
+    result.sourceWidth = width;
+    result.sourceHeight = height;
+    
+    // Последний уровень цепочки — 1x1
+    int lastLevel = 0;
+    while ((std::max(width, height) >> lastLevel) > 1) ++lastLevel;
+    int target = std::clamp(level, 0, lastLevel);
+    if (maxDimension > 0) {
+        while (target < lastLevel && (std::max(width, height) >> target) > maxDimension) ++target;
+    }
+    
+    if (target > 0 && isDownsampleFormat(result.image.format)) {
+        Image reduced = downsampleImage(result.image, target);
+        if (reduced.data) {
+            result.reset();
+            result.image = reduced;
+            result.valid = true;
+            result.pooled = false;
+            result.mipLevel = target;
+        }
+    }
+    if (stageForUpload) stageDecoded(result);
+    return result;
+}
+
+ImageThreadPool::ImageThreadPool(size_t threads)
+    : ImageThreadPool(threads, WorkerSettings{}) {}
+
+ImageThreadPool::ImageThreadPool(size_t threads, const WorkerSettings& settings)
+    : workerSettings_(settings)
+{
     if (threads == 0) {
         threads = std::max(1u, std::thread::hardware_concurrency());
     }
+    // Хотя бы один воркер должен остаться загрузке
+    workerSettings_.frameWorkers = std::min(workerSettings_.frameWorkers, threads - 1);
     
     for (size_t i = 0; i < threads; ++i) {
-        workers_.emplace_back(&ImageThreadPool::workerLoop, this);
+        workers_.emplace_back(&ImageThreadPool::workerLoop, this, i);
     }
 }
 
@@ -29,95 +169,337 @@ ImageThreadPool::~ImageThreadPool() {
         stop_ = true;
     }
     cv_.notify_all();
+    frameCv_.notify_all();
     
     for (auto& worker : workers_) {
         if (worker.joinable()) worker.join();
     }
 }
 
-void ImageThreadPool::workerLoop() {
+void ImageThreadPool::TaskRing::grow() {
+    // Кольцо заполнено — переносим задачи по порядку в буфер вдвое больше
+    std::vector<QueuedTask> grown(std::max<size_t>(64, items.size() * 2));
+    for (size_t i = 0; i < count; ++i) {
+        grown[i] = std::move(at(i));
+    }
+    items = std::move(grown);
+    head = 0;
+}
+
+void ImageThreadPool::TaskRing::push(QueuedTask&& task) {
+    if (count == items.size()) grow();
+    items[(head + count) % items.size()] = std::move(task);
+    ++count;
+}
+
+void ImageThreadPool::TaskRing::pushFront(QueuedTask&& task) {
+    if (count == items.size()) grow();
+    head = (head + items.size() - 1) % items.size();
+    items[head] = std::move(task);
+    ++count;
+}
+
+ImageThreadPool::QueuedTask ImageThreadPool::TaskRing::pop() {
+    QueuedTask task = std::move(items[head]);
+    head = (head + 1) % items.size();
+    --count;
+    return task;
+}
+
+void ImageThreadPool::pushLocked(SmallTask&& task, JobPriority priority, const JobToken& token, bool decode) {
+    queues_[static_cast<size_t>(priority)].push({std::move(task), token, decode});
+    ++queuedCount_;
+}
+
+void ImageThreadPool::moveTokenTasksLocked(const JobToken& token, JobPriority target, bool front, bool decodeOnly) {
+    TaskRing& dst = queues_[static_cast<size_t>(target)];
+    size_t moved = 0;
+    
+    // Стабильно уплотняем остальные кольца, задачи токена уходят в конец target
+    for (TaskRing& ring : queues_) {
+        if (&ring == &dst) continue;
+        size_t kept = 0;
+        for (size_t i = 0; i < ring.count; ++i) {
+            QueuedTask& task = ring.at(i);
+            if (task.token.state_ == token.state_ && (task.decode || !decodeOnly)) {
+                dst.push(std::move(task));
+                ++moved;
+            } else {
+                if (kept != i) ring.at(kept) = std::move(task);
+                ++kept;
+            }
+        }
+        for (size_t i = kept; i < ring.count; ++i) ring.at(i) = {};
+        ring.count = kept;
+    }
+    
+    if (front) {
+        // Переносим хвост в начало с конца, порядок перенесённых сохраняется
+        for (size_t i = 0; i < moved; ++i) {
+            QueuedTask task = std::move(dst.at(dst.count - 1));
+            --dst.count;
+            dst.pushFront(std::move(task));
+        }
+    }
+}
+
+bool ImageThreadPool::hasTaskLocked(bool frameWorker) const {
+    const size_t critical = queues_[static_cast<size_t>(JobPriority::Critical)].count;
+    if (frameWorker) return critical > 0;
+    if (workerSettings_.frameWorkers == 0) return queuedCount_ > 0;
+    return queuedCount_ > critical;
+}
+
+void ImageThreadPool::notify(JobPriority priority, bool all) {
+    const bool frame = priority == JobPriority::Critical && workerSettings_.frameWorkers > 0;
+    std::condition_variable& cv = frame ? frameCv_ : cv_;
+    if (all) cv.notify_all();
+    else cv.notify_one();
+}
+
+void ImageThreadPool::workerLoop(size_t index) {
+    const bool frameWorker = index < workerSettings_.frameWorkers;
+    char threadName[32];
+    std::snprintf(threadName, sizeof(threadName), frameWorker ? "Frame worker %zu" : "Pool worker %zu", index);
+    KALAN_PROFILE_THREAD(threadName);
+    
+    // Пониженный приоритет и ядра — только для воркеров загрузки
+    if (!frameWorker) {
+        if (workerSettings_.niceLevel != 0 && !setCurrentThreadNice(workerSettings_.niceLevel) &&
+            index == workerSettings_.frameWorkers) {
+            TraceLog(LOG_WARNING, "ImageThreadPool: cannot set worker priority %d", workerSettings_.niceLevel);
+        }
+        if (workerSettings_.excludedCpu >= 0) {
+            excludeCurrentThreadFromCpu(static_cast<unsigned int>(workerSettings_.excludedCpu));
+        }
+    }
+    
+    // Воркер кадра берёт только Critical; воркер загрузки при делённом пуле — остальные классы
+    const size_t firstQueue = !frameWorker && workerSettings_.frameWorkers > 0 ? 1 : 0;
+    const size_t lastQueue = frameWorker ? 1 : JobPriorityCount;
+    std::condition_variable& cv = frameWorker ? frameCv_ : cv_;
+    
     while (true) {
-        std::function<void()> task;
+        SmallTask task;
         
         {
             std::unique_lock lock(mutex_);
-            cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+            cv.wait(lock, [this, frameWorker] { return stop_ || hasTaskLocked(frameWorker); });
             
-            if (stop_ && tasks_.empty()) return;
+            if (stop_ && !hasTaskLocked(frameWorker)) return;
             
-            task = std::move(tasks_.front());
-            tasks_.pop();
+            for (size_t q = firstQueue; q < lastQueue; ++q) {
+                if (queues_[q].count > 0) {
+                    task = std::move(queues_[q].pop().task);
+                    break;
+                }
+            }
+            --queuedCount_;
         }
         
-        task();
+        auto start = std::chrono::steady_clock::now();
+        {
+            KALAN_PROFILE_ZONE("Pool task");
+            task();
+            task.reset();   // замыкание разрушается до уменьшения счётчика
+        }
+        busyNs_.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start).count()),
+                          std::memory_order_relaxed);
+        completedCount_.fetch_add(1, std::memory_order_relaxed);
         --pendingCount_;
     }
 }
 
-std::future<PreloadedImage> ImageThreadPool::decodeAsync(const std::string& path) {
-    auto promise = std::make_shared<std::promise<PreloadedImage>>();
-    auto future = promise->get_future();
+std::future<PreloadedImage> ImageThreadPool::decodeAsync(
+    const std::string& path, JobPriority priority, const JobToken& token, bool stageForUpload)
+{
+    std::promise<PreloadedImage> promise;
+    auto future = promise.get_future();
+    const JobPriority target = token.getPriority(priority);
     
     {
         std::lock_guard lock(mutex_);
         ++pendingCount_;
         
-        tasks_.push([promise, path]() {
-            PreloadedImage result;
-            result.path = path;
+        pushLocked([promise = std::move(promise), path, token, stageForUpload]() mutable {
+            if (token.isCancelled()) {
+                promise.set_value(cancelledImage(path));
+                return;
+            }
             
-            // Декодирование в рабочем потоке (без OpenGL!)
-            result.image = LoadImage(path.c_str());
-            result.valid = (result.image.data != nullptr);
+            // Чтение и распаковка раздельно: между ними можно бросить отменённую задачу
+            int size = 0;
+            unsigned char* fileData = readFilePooled(path, size);
+            if (token.isCancelled()) {
+                PixelBufferPool::instance().release(fileData);
+                promise.set_value(cancelledImage(path));
+                return;
+            }
             
-            promise->set_value(std::move(result));
-        });
+            // Декодирование в рабочем потоке (без OpenGL!)
+            PreloadedImage result = decodeImage(fileData, size, path, stageForUpload);
+            PixelBufferPool::instance().release(fileData);
+            promise.set_value(std::move(result));
+        }, target, token, true);
     }
     
-    cv_.notify_one();
+    notify(target);
     return future;
 }
 
 std::future<PreloadedImage> ImageThreadPool::decodeFromMemoryAsync(
     std::shared_ptr<std::vector<unsigned char>> data,
-    const std::string& hint) 
+    const std::string& hint,
+    JobPriority priority,
+    const JobToken& token,
+    bool stageForUpload) 
 {
-    auto promise = std::make_shared<std::promise<PreloadedImage>>();
-    auto future = promise->get_future();
+    std::promise<PreloadedImage> promise;
+    auto future = promise.get_future();
+    const JobPriority target = token.getPriority(priority);
     
     {
         std::lock_guard lock(mutex_);
         ++pendingCount_;
         
-        tasks_.push([promise, data, hint]() {
-            PreloadedImage result;
-            result.path = hint;
-            
-            // Определяем формат по hint или пробуем PNG/JPG
-            const char* ext = ".png";
-            if (hint.find(".jpg") != std::string::npos || 
-                hint.find(".jpeg") != std::string::npos) {
-                ext = ".jpg";
-            } else if (hint.find(".png") != std::string::npos) {
-                ext = ".png";
-            } else if (hint.find(".tga") != std::string::npos) {
-                ext = ".tga";
-            } else if (hint.find(".bmp") != std::string::npos) {
-                ext = ".bmp";
+        pushLocked([promise = std::move(promise), data = std::move(data), hint, token, stageForUpload]() mutable {
+            if (token.isCancelled()) {
+                promise.set_value(cancelledImage(hint));
+                return;
             }
             
-            result.image = LoadImageFromMemory(ext, data->data(), 
-                                                static_cast<int>(data->size()));
-            result.valid = (result.image.data != nullptr);
-            
-            promise->set_value(std::move(result));
-        });
+            PreloadedImage result = decodeImage(data->data(), static_cast<int>(data->size()), hint, stageForUpload);
+            promise.set_value(std::move(result));
+        }, target, token, true);
     }
     
-    cv_.notify_one();
+    notify(target);
     return future;
 }
 
+void ImageThreadPool::post(SmallTask task, JobPriority priority) {
+    {
+        std::lock_guard lock(mutex_);
+        ++pendingCount_;
+        pushLocked(std::move(task), priority);
+    }
+    notify(priority);
+}
+
+void ImageThreadPool::reprioritize(const JobToken& token, JobPriority priority) {
+    if (!token.valid()) return;
+    {
+        std::lock_guard lock(mutex_);
+        token.state_->priority.store(priority, std::memory_order_relaxed);
+        moveTokenTasksLocked(token, priority, false);
+    }
+    // При делённом пуле задачи сменили и набор воркеров, которые их возьмут
+    notify(priority, true);
+}
+
+void ImageThreadPool::cancel(const JobToken& token) {
+    if (!token.valid()) return;
+    token.cancel();
+    {
+        // Отменённое декодирование завершается мгновенно — ставим его перед всеми.
+        // Приоритет токена не меняется: остальные его задачи не обгоняют работу кадра
+        std::lock_guard lock(mutex_);
+        moveTokenTasksLocked(token, JobPriority::Critical, true, true);
+    }
+    notify(JobPriority::Critical, true);
+}
+
+void ImageThreadPool::runChunks(ParallelState& state) {
+    KALAN_PROFILE_ZONE("parallelFor");
+    for (;;) {
+        size_t chunk = state.next.fetch_add(1);
+        if (chunk >= state.chunkCount) return;
+        size_t begin = chunk * state.chunkSize;
+        state.fn(begin, std::min(begin + state.chunkSize, state.count));
+        state.done.fetch_add(1, std::memory_order_release);
+    }
+}
+
+void ImageThreadPool::releaseState(ParallelState* state) {
+    if (state->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    std::lock_guard lock(mutex_);
+    freeParallelStates_.push_back(state);
+}
+
+void ImageThreadPool::parallelFor(
+    size_t count, size_t minChunk,
+    FunctionRef<void(size_t begin, size_t end)> fn)
+{
+    if (count == 0) return;
+    
+    minChunk = std::max<size_t>(1, minChunk);
+    size_t chunkCount = (count + minChunk - 1) / minChunk;
+    chunkCount = std::min(chunkCount, getCriticalThreadCount() * 4);
+    size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    chunkCount = (count + chunkSize - 1) / chunkSize;
+    
+    if (chunkCount <= 1) {
+        fn(0, count);
+        return;
+    }
+    
+    size_t helpers = std::min(chunkCount - 1, getCriticalThreadCount());
+    ParallelState* state;
+    {
+        std::lock_guard lock(mutex_);
+        if (freeParallelStates_.empty()) {
+            parallelStates_.push_back(std::make_unique<ParallelState>());
+            freeParallelStates_.reserve(parallelStates_.size());
+            state = parallelStates_.back().get();
+        } else {
+            state = freeParallelStates_.back();
+            freeParallelStates_.pop_back();
+        }
+        
+        state->next.store(0, std::memory_order_relaxed);
+        state->done.store(0, std::memory_order_relaxed);
+        state->refs.store(helpers + 1, std::memory_order_relaxed);
+        state->fn = fn;
+        state->count = count;
+        state->chunkSize = chunkSize;
+        state->chunkCount = chunkCount;
+        
+        for (size_t i = 0; i < helpers; ++i) {
+            ++pendingCount_;
+            // fn вызывается только пока есть невыданные чанки,
+            // а мы не вернёмся, пока все чанки не отработают
+            pushLocked([this, state]() {
+                runChunks(*state);
+                releaseState(state);
+            }, JobPriority::Critical);
+        }
+    }
+    notify(JobPriority::Critical, true);
+    
+    runChunks(*state);
+    while (state->done.load(std::memory_order_acquire) < chunkCount) {
+        std::this_thread::yield();
+    }
+    releaseState(state);
+}
+
+ImageThreadPool::Stats ImageThreadPool::getStats() const {
+    Stats stats;
+    stats.threads = workers_.size();
+    {
+        std::lock_guard lock(mutex_);
+        stats.queued = queuedCount_;
+        for (size_t q = 0; q < JobPriorityCount; ++q) {
+            stats.queuedByPriority[q] = queues_[q].count;
+        }
+    }
+    stats.pending = pendingCount_.load();
+    stats.completed = completedCount_.load(std::memory_order_relaxed);
+    stats.busyNs = busyNs_.load(std::memory_order_relaxed);
+    return stats;
+}
+
 void ImageThreadPool::waitAll() {
     while (pendingCount_.load() > 0) {
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
@@ -129,19 +511,20 @@ void ImageThreadPool::waitAll() {
 namespace gpu {
 
 Texture2D uploadTextureGPU(Image image, bool genMipmaps) {
-    if (!image.data) return {0};
-    
-    // Загрузить текстуру в GPU
-    Texture2D texture = LoadTextureFromImage(image);
-    
-    if (genMipmaps && texture.id != 0) {
-        // GPU-ускоренная генерация mipmaps через raylib
-        GenTextureMipmaps(&texture);
-        
-        // Установить фильтрацию для mipmaps
-        SetTextureFilter(texture, TEXTURE_FILTER_TRILINEAR);
+    // Синхронно (LoadTextureFromImage), с mipmaps на GPU; учитывается в бюджете кадра
+    return TextureUploader::instance().upload(image, 0, genMipmaps);
+}
+
+Texture2D uploadPreloaded(PreloadedImage& image, bool genMipmaps) {
+    if (!image.valid || !image.image.data) return {0};
+    Texture2D texture = TextureUploader::instance().upload(image.image, image.staging, genMipmaps);
+    if (image.staging) {
+        // Участок освободит сам TextureUploader, когда GPU пройдёт fence
+        image.staging = 0;
+        image.image = {};
+        image.valid = false;
     }
-    
+    image.reset();
     return texture;
 }
 
@@ -162,157 +545,27 @@ std::vector<Texture2D> uploadTexturesBatchGPU(std::vector<Image>& images, bool g
 
 namespace {
 
-// Конвертация aiMatrix4x4 в raylib Matrix
-Matrix ConvertAssimpMatrix(const aiMatrix4x4& m) {
-    // Assimp использует row-major, raylib использует column-major
-    return Matrix{
-        m.a1, m.b1, m.c1, m.d1,
-        m.a2, m.b2, m.c2, m.d2,
-        m.a3, m.b3, m.c3, m.d3,
-        m.a4, m.b4, m.c4, m.d4
-    };
-}
-
-// Трансформировать вершины меша по матрице
-void TransformMeshVertices(Mesh& mesh, const Matrix& transform) {
-    // Вычисляем нормальную матрицу (для нормалей)
-    Matrix normalMatrix = MatrixTranspose(MatrixInvert(transform));
+// Рекурсивный обход дерева узлов: узел добавляется раньше своих детей
+void CollectSceneNodes(const aiNode* node, int parent, ModelScene& scene) {
+    ModelSceneNode out;
+    out.name = node->mName.C_Str();
+    out.parent = parent;
     
-    for (int i = 0; i < mesh.vertexCount; ++i) {
-        // Трансформируем позицию
-        Vector3 pos = {
-            mesh.vertices[i*3 + 0],
-            mesh.vertices[i*3 + 1],
-            mesh.vertices[i*3 + 2]
-        };
-        pos = Vector3Transform(pos, transform);
-        mesh.vertices[i*3 + 0] = pos.x;
-        mesh.vertices[i*3 + 1] = pos.y;
-        mesh.vertices[i*3 + 2] = pos.z;
-        
-        // Трансформируем нормали
-        if (mesh.normals) {
-            Vector3 normal = {
-                mesh.normals[i*3 + 0],
-                mesh.normals[i*3 + 1],
-                mesh.normals[i*3 + 2]
-            };
-            normal = Vector3Normalize(Vector3Transform(normal, normalMatrix));
-            mesh.normals[i*3 + 0] = normal.x;
-            mesh.normals[i*3 + 1] = normal.y;
-            mesh.normals[i*3 + 2] = normal.z;
-        }
-        
-        // Трансформируем тангенты
-        if (mesh.tangents) {
-            Vector3 tangent = {
-                mesh.tangents[i*4 + 0],
-                mesh.tangents[i*4 + 1],
-                mesh.tangents[i*4 + 2]
-            };
-            tangent = Vector3Normalize(Vector3Transform(tangent, normalMatrix));
-            mesh.tangents[i*4 + 0] = tangent.x;
-            mesh.tangents[i*4 + 1] = tangent.y;
-            mesh.tangents[i*4 + 2] = tangent.z;
-        }
-    }
-}
-
-// Конвертация aiMesh в raylib Mesh (без upload)
-Mesh ConvertAssimpMesh(const aiMesh* aiM) {
-    Mesh mesh = {0};
-    
-    mesh.vertexCount = aiM->mNumVertices;
-    mesh.triangleCount = aiM->mNumFaces;
-    
-    // Vertices
-    mesh.vertices = (float*)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
-    for (unsigned int i = 0; i < aiM->mNumVertices; i++) {
-        mesh.vertices[i*3 + 0] = aiM->mVertices[i].x;
-        mesh.vertices[i*3 + 1] = aiM->mVertices[i].y;
-        mesh.vertices[i*3 + 2] = aiM->mVertices[i].z;
-    }
+    aiVector3D scaling, position;
+    aiQuaternion rotation;
+    node->mTransformation.Decompose(scaling, rotation, position);
+    out.translation = {position.x, position.y, position.z};
+    out.rotation = {rotation.x, rotation.y, rotation.z, rotation.w};
+    out.scale = {scaling.x, scaling.y, scaling.z};
     
-    // Normals
-    if (aiM->HasNormals()) {
-        mesh.normals = (float*)MemAlloc(mesh.vertexCount * 3 * sizeof(float));
-        for (unsigned int i = 0; i < aiM->mNumVertices; i++) {
-            mesh.normals[i*3 + 0] = aiM->mNormals[i].x;
-            mesh.normals[i*3 + 1] = aiM->mNormals[i].y;
-            mesh.normals[i*3 + 2] = aiM->mNormals[i].z;
-        }
-    }
+    out.meshes.assign(node->mMeshes, node->mMeshes + node->mNumMeshes);
+    scene.meshInstances += static_cast<int>(node->mNumMeshes);
     
-    // Tangents
-    if (aiM->HasTangentsAndBitangents()) {
-        mesh.tangents = (float*)MemAlloc(mesh.vertexCount * 4 * sizeof(float));
-        for (unsigned int i = 0; i < aiM->mNumVertices; i++) {
-            mesh.tangents[i*4 + 0] = aiM->mTangents[i].x;
-            mesh.tangents[i*4 + 1] = aiM->mTangents[i].y;
-            mesh.tangents[i*4 + 2] = aiM->mTangents[i].z;
-            mesh.tangents[i*4 + 3] = 1.0f; // w component
-        }
-    }
-    
-    // Texture coordinates
-    if (aiM->HasTextureCoords(0)) {
-        mesh.texcoords = (float*)MemAlloc(mesh.vertexCount * 2 * sizeof(float));
-        for (unsigned int i = 0; i < aiM->mNumVertices; i++) {
-            mesh.texcoords[i*2 + 0] = aiM->mTextureCoords[0][i].x;
-            mesh.texcoords[i*2 + 1] = aiM->mTextureCoords[0][i].y;
-        }
-    }
-    
-    // Vertex colors
-    if (aiM->HasVertexColors(0)) {
-        mesh.colors = (unsigned char*)MemAlloc(mesh.vertexCount * 4 * sizeof(unsigned char));
-        for (unsigned int i = 0; i < aiM->mNumVertices; i++) {
-            mesh.colors[i*4 + 0] = (unsigned char)(aiM->mColors[0][i].r * 255);
-            mesh.colors[i*4 + 1] = (unsigned char)(aiM->mColors[0][i].g * 255);
-            mesh.colors[i*4 + 2] = (unsigned char)(aiM->mColors[0][i].b * 255);
-            mesh.colors[i*4 + 3] = (unsigned char)(aiM->mColors[0][i].a * 255);
-        }
-    }
-    
-    // Indices
-    mesh.indices = (unsigned short*)MemAlloc(mesh.triangleCount * 3 * sizeof(unsigned short));
-    for (unsigned int i = 0; i < aiM->mNumFaces; i++) {
-        const aiFace& face = aiM->mFaces[i];
-        if (face.mNumIndices == 3) {
-            mesh.indices[i*3 + 0] = (unsigned short)face.mIndices[0];
-            mesh.indices[i*3 + 1] = (unsigned short)face.mIndices[1];
-            mesh.indices[i*3 + 2] = (unsigned short)face.mIndices[2];
-        }
-    }
+    int index = static_cast<int>(scene.nodes.size());
+    scene.nodes.push_back(std::move(out));
     
-    // НЕ делаем UploadMesh здесь - сначала применим трансформации
-    return mesh;
-}
-
-// Информация о меше с его трансформацией
-struct MeshInstance {
-    unsigned int meshIndex;
-    Matrix transform;
-};
-
-// Рекурсивный обход дерева узлов для сбора мешей с трансформациями
-void CollectMeshInstances(
-    const aiNode* node, 
-    const Matrix& parentTransform,
-    std::vector<MeshInstance>& instances) 
-{
-    // Комбинируем трансформацию родителя с локальной
-    Matrix localTransform = ConvertAssimpMatrix(node->mTransformation);
-    Matrix globalTransform = MatrixMultiply(localTransform, parentTransform);
-    
-    // Добавляем все меши этого узла
-    for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
-        instances.push_back({node->mMeshes[i], globalTransform});
-    }
-    
-    // Рекурсивно обходим детей
     for (unsigned int i = 0; i < node->mNumChildren; ++i) {
-        CollectMeshInstances(node->mChildren[i], globalTransform, instances);
+        CollectSceneNodes(node->mChildren[i], index, scene);
     }
 }
 
@@ -340,6 +593,23 @@ struct TextureLoadInfo {
     int mapType; // MATERIAL_MAP_* enum
 };
 
+// Слоты материалов разделяют Texture2D (одно изображение — одна загрузка),
+// поэтому каждый уникальный id выгружается ровно один раз
+void UnloadMaterialTextures(Model& model) {
+    std::vector<unsigned int> ids;
+    for (int m = 0; m < model.materialCount; ++m) {
+        if (!model.materials[m].maps) continue;
+        for (int map = 0; map < MAX_MATERIAL_MAPS; ++map) {
+            Texture2D& texture = model.materials[m].maps[map].texture;
+            if (texture.id > 1) ids.push_back(texture.id);
+            texture = Texture2D{};
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    for (unsigned int id : ids) rlUnloadTexture(id);
+}
+
 // Маппинг aiTextureType -> raylib MATERIAL_MAP_*
 int AssimpToRaylibMapType(aiTextureType type) {
     switch (type) {
@@ -366,6 +636,74 @@ int AssimpToRaylibMapType(aiTextureType type) {
 
 } // anonymous namespace
 
+// ============ ImportReport ============
+
+void ImportReport::addStage(std::string name, double ms) {
+    stages.push_back({std::move(name), ms});
+}
+
+void ImportReport::log() const {
+    TraceLog(LOG_INFO, "Import %s: %.1f ms", path.c_str(), totalMs);
+    for (const auto& file : settingsFiles) {
+        TraceLog(LOG_INFO, "  settings %s", file.c_str());
+    }
+    TraceLog(LOG_INFO, "  assimp flags 0x%08x", importFlags);
+    for (const auto& stage : stages) {
+        TraceLog(LOG_INFO, "  %-10s %8.2f ms", stage.name.c_str(), stage.ms);
+    }
+    for (const auto& opt : meshOptimizations) {
+        TraceLog(LOG_INFO, "  mesh %d: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, %.2f ms",
+                 opt.meshIndex, opt.before.acmr, opt.after.acmr,
+                 opt.before.atvr, opt.after.atvr, opt.ms);
+    }
+    for (const auto& tangent : tangents) {
+        TraceLog(LOG_INFO, "  mesh %d tangents: %d mirrored, %d seam conflicts, %d degenerate tris, %.2f ms",
+                 tangent.meshIndex, tangent.mirroredVertices, tangent.conflictVertices,
+                 tangent.degenerateTriangles, tangent.ms);
+    }
+    for (const auto& lod : lods) {
+        TraceLog(LOG_INFO, "  mesh %d LOD%d: %d -> %d tris (%.0f%%), error %.4f (%.2f%%), %.2f ms",
+                 lod.meshIndex, lod.level, lod.sourceTriangles, lod.triangles,
+                 100.0f * lod.triangles / std::max(1, lod.sourceTriangles),
+                 lod.error, lod.relativeError * 100.0f, lod.ms);
+    }
+    for (const auto& occluder : occluders) {
+        if (occluder.triangles == 0) continue;
+        TraceLog(LOG_INFO, "  mesh %d occluder: %d -> %d tris, error %.4f, %.2f ms",
+                 occluder.meshIndex, occluder.sourceTriangles, occluder.triangles, occluder.error, occluder.ms);
+    }
+    for (size_t i = 0; i < quantization.size(); ++i) {
+        const auto& q = quantization[i];
+        TraceLog(LOG_INFO, "  mesh %zu packed: position %.6f, normal %.3f deg, tangent %.3f deg, uv %.6f",
+                 i, q.position, q.normalDegrees, q.tangentDegrees, q.texcoord);
+    }
+    if (sceneNodes > 0) {
+        TraceLog(LOG_INFO, "  scene: %d nodes, %d mesh instances share %d meshes",
+                 sceneNodes, meshInstances, uniqueMeshes);
+    }
+    if (meshCpuReleased > 0) {
+        TraceLog(LOG_INFO, "  mesh RAM: %.2f MB released after upload, %.2f MB retained",
+                 meshCpuReleased / (1024.0 * 1024.0), meshCpuRetained / (1024.0 * 1024.0));
+    }
+    if (joints > 0) {
+        TraceLog(LOG_INFO, "  animation: %d joints, %d clips, %d keys", joints, clips, animationKeys);
+    }
+    for (const auto& clip : animationCompression) {
+        TraceLog(LOG_INFO, "  clip %s: %d -> %d keys, %.1f -> %.1f KB (x%.1f), max error %.5f at joint %d, %.2f ms",
+                 clip.clip.c_str(), clip.rawKeys, clip.keys, clip.rawBytes / 1024.0, clip.compressedBytes / 1024.0,
+                 clip.getRatio(), clip.maxError, clip.maxErrorJoint, clip.ms);
+    }
+    if (collisionShapes > 0) {
+        TraceLog(LOG_INFO, "  collision: %d shapes (%s)", collisionShapes,
+                 shapesFromCache ? "restored from cache" : "cooked");
+    }
+    if (texturePack.sourceImages > 0) {
+        TraceLog(LOG_INFO, "  textures: %d -> %d (%d duplicates, %d ORM, %d materials in %d atlas pages)",
+                 texturePack.sourceImages, texturePack.resultImages, texturePack.duplicatesRemoved,
+                 texturePack.ormPacked, texturePack.atlasedMaterials, texturePack.atlasPages);
+    }
+}
+
 // ============ ParallelModelLoader ============
 
 ParallelModelLoader& ParallelModelLoader::instance() {
@@ -381,38 +719,110 @@ void ParallelModelLoader::setThreadCount(size_t count) {
     threadPool_.reset();
 }
 
+void ParallelModelLoader::setWorkerSettings(const ImageThreadPool::WorkerSettings& settings) {
+    workerSettings_ = settings;
+    threadPool_.reset();
+}
+
+ImageThreadPool& ParallelModelLoader::getThreadPool() {
+    if (!threadPool_) {
+        threadPool_ = std::make_unique<ImageThreadPool>(threadCount_, workerSettings_);
+    }
+    return *threadPool_;
+}
+
 std::shared_ptr<raylib::Model> ParallelModelLoader::loadModel(
     const fs::path& modelPath,
-    std::function<void(const LoadProgress&)> progressCallback) 
+    FunctionRef<void(const LoadProgress&)> progressCallback) 
 {
+    return loadModelEx(modelPath, LoadOptions{}, progressCallback).model;
+}
+
+LoadedModel ParallelModelLoader::loadModelEx(
+    const fs::path& modelPath,
+    const LoadOptions& requestedOptions,
+    FunctionRef<void(const LoadProgress&)> progressCallback) 
+{
+    KALAN_PROFILE_ZONE("loadModel");
+    
+    using Clock = std::chrono::steady_clock;
+    auto msSince = [](Clock::time_point t) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t).count();
+    };
+    
+    LoadedModel loaded;
+    ImportReport& report = loaded.report;
+    report.path = modelPath.string();
+    auto loadStart = Clock::now();
+    
+    LoadOptions options = requestedOptions;
+    if (options.readImportSettings) report.settingsFiles = applyImportSettings(modelPath, options);
+    if (options.importAnimation &&
+        (options.vertexFormat != VertexFormat::Float32 || options.generateLods || options.keepHierarchy)) {
+        TraceLog(LOG_INFO, "ParallelModelLoader: %s is animated, packed vertices, LODs and hierarchy are off",
+                 report.path.c_str());
+        options.vertexFormat = VertexFormat::Float32;
+        options.generateLods = false;
+        options.keepHierarchy = false;
+    }
+    
     LoadProgress progress;
     
     // Создаём thread pool если нужно
-    if (!threadPool_) {
-        threadPool_ = std::make_unique<ImageThreadPool>(threadCount_);
-    }
+    ImageThreadPool& pool = getThreadPool();
     
     fs::path modelDir = modelPath.parent_path();
+    auto stageStart = Clock::now();
+    // Этап в отчёт импорта и зоной в профайлер (name — литерал)
+    auto finishStage = [&](const char* name) {
+        auto now = Clock::now();
+#ifdef KALAN_PROFILER
+        profiler::recordZone(name, profiler::toNs(stageStart), profiler::toNs(now));
+#endif
+        report.addStage(name, std::chrono::duration<double, std::milli>(now - stageStart).count());
+    };
+    
+    // Задачи загрузки в классе токена (или options.priority без токена)
+    const JobToken& token = options.token;
+    const JobPriority priority = options.priority;
+    
+    // Брошенная загрузка: дожидаемся поставленных декодирований (отменённые
+    // завершаются сразу) и освобождаем CPU меши, в GPU ещё ничего не ушло
+    Model model = {0};
+    std::vector<std::future<PreloadedImage>> futures;
+    auto abandon = [&](const char* stage) {
+        for (auto& f : futures) f.get();    // ~PreloadedImage вернёт буфер
+        for (int i = 0; i < model.meshCount; ++i) UnloadMesh(model.meshes[i]);
+        MemFree(model.meshes);
+        MemFree(model.meshMaterial);
+        loaded.scene.reset();
+        loaded.shapes.reset();
+        loaded.animations.reset();
+        
+        report.cancelled = true;
+        report.totalMs = msSince(loadStart);
+        TraceLog(LOG_INFO, "ParallelModelLoader: %s cancelled after %s (%.1f ms)",
+                 report.path.c_str(), stage, report.totalMs);
+        rememberReport(report);
+        return std::move(loaded);
+    };
     
     // ========== ШАГ 1: Загрузка модели через Assimp ==========
     Assimp::Importer importer;
     
-    unsigned int flags = 
-        aiProcess_Triangulate |
-        aiProcess_GenSmoothNormals |
-        aiProcess_CalcTangentSpace |
-        aiProcess_JoinIdenticalVertices |
-        aiProcess_FlipUVs |
-        aiProcess_OptimizeMeshes |
-        aiProcess_PreTransformVertices; // Применяет все трансформации к вершинам
-    
-    const aiScene* scene = importer.ReadFile(modelPath.string(), flags);
+    // Анимированной модели узлы нужны для скелета: вершины не запекаются
+    report.importFlags = assimpImportFlags(options.keepHierarchy || options.importAnimation, options.importSteps);
+    if (options.importAnimation) report.importFlags |= aiProcess_LimitBoneWeights;
+    const aiScene* scene = importer.ReadFile(modelPath.string(), report.importFlags);
     
     if (!scene || !scene->HasMeshes()) {
         std::cerr << "ParallelModelLoader: Failed to load " << modelPath 
                   << ": " << importer.GetErrorString() << "\n";
-        return nullptr;
+        return loaded;
     }
+    finishStage("import");
+    if (token.isCancelled()) return abandon("import");
+    stageStart = Clock::now();
     
     // ========== ШАГ 2: Собираем информацию о текстурах для параллельной загрузки ==========
     std::vector<TextureLoadInfo> texturesToLoad;
@@ -484,71 +894,113 @@ std::shared_ptr<raylib::Model> ParallelModelLoader::loadModel(
     if (progressCallback) progressCallback(progress);
     
     // ========== ШАГ 3: Параллельное декодирование текстур ==========
-    struct TextureFuture {
-        std::future<PreloadedImage> future;
+    // Один файл, на который ссылаются несколько слотов (metallicRoughness в glTF,
+    // общие текстуры материалов), декодируется один раз
+    struct TextureSlotRef {
         int materialIndex;
         int mapType;
+        int image;      // индекс в decodeSources
+    };
+    struct DecodeSource {
+        std::string path;
+        const aiTexture* embedded = nullptr;
     };
-    std::vector<TextureFuture> futures;
+    std::vector<TextureSlotRef> slotRefs;
+    std::vector<DecodeSource> decodeSources;
+    std::unordered_map<std::string, int> imageBySource;
     
     for (const auto& texInfo : texturesToLoad) {
-        TextureFuture tf;
-        tf.materialIndex = texInfo.materialIndex;
-        tf.mapType = texInfo.mapType;
+        std::string sourceKey = (texInfo.embedded ? "embedded:" : "file:") + texInfo.path;
+        auto [known, inserted] = imageBySource.try_emplace(sourceKey, static_cast<int>(decodeSources.size()));
+        slotRefs.push_back({texInfo.materialIndex, texInfo.mapType, known->second});
+        if (inserted) decodeSources.push_back({texInfo.path, texInfo.embedded});
+    }
+    
+    // Стриминг: декодируется только хвост, источник остаётся для догрузки уровней
+    const bool streamTextures = options.streamTextures && !options.packTextures;
+    const int streamTailSize = TextureStreamer::instance().getSettings().residency.tailSize;
+    std::vector<ImageSource> streamSources(streamTextures ? decodeSources.size() : 0);
+    
+    auto dispatchDecode = [&](size_t index) {
+        const DecodeSource& source = decodeSources[index];
+        auto dispatchLevel = [&](const ImageSource& encoded) {
+            streamSources[index] = encoded;
+            return pool.submit([encoded, streamTailSize, token]() {
+                if (token.isCancelled()) return cancelledImage(encoded.path);
+                return decodeImageLevel(encoded, 0, streamTailSize, true);
+            }, priority, token);
+        };
         
-        if (texInfo.embedded) {
-            // Embedded текстура
-            const aiTexture* embTex = texInfo.embedded;
-            
-            if (embTex->mHeight == 0) {
-                // Сжатый формат (PNG/JPG и т.д.)
-                auto data = std::make_shared<std::vector<unsigned char>>(
-                    reinterpret_cast<const unsigned char*>(embTex->pcData),
-                    reinterpret_cast<const unsigned char*>(embTex->pcData) + embTex->mWidth
-                );
-                // achFormatHint это "jpg", "png" и т.д. без точки
-                std::string hint = ".";
-                hint += embTex->achFormatHint;
-                tf.future = threadPool_->decodeFromMemoryAsync(data, hint);
-            } else {
-                // Raw RGBA данные - создаём Image напрямую
-                auto data = std::make_shared<std::vector<unsigned char>>(
-                    embTex->mWidth * embTex->mHeight * 4
-                );
-                const aiTexel* texels = embTex->pcData;
-                for (unsigned int i = 0; i < embTex->mWidth * embTex->mHeight; ++i) {
-                    // aiTexel хранит BGRA, конвертируем в RGBA
-                    (*data)[i*4 + 0] = texels[i].r;
-                    (*data)[i*4 + 1] = texels[i].g;
-                    (*data)[i*4 + 2] = texels[i].b;
-                    (*data)[i*4 + 3] = texels[i].a;
-                }
-                // Для raw данных создаём promise напрямую
-                auto promise = std::make_shared<std::promise<PreloadedImage>>();
-                tf.future = promise->get_future();
-                
-                PreloadedImage result;
-                result.path = "<raw>";
-                result.image.data = MemAlloc(data->size());
-                memcpy(result.image.data, data->data(), data->size());
-                result.image.width = embTex->mWidth;
-                result.image.height = embTex->mHeight;
-                result.image.mipmaps = 1;
-                result.image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
-                result.valid = true;
-                
-                promise->set_value(std::move(result));
-            }
-        } else {
+        if (!source.embedded) {
             // Внешний файл
-            tf.future = threadPool_->decodeAsync(texInfo.path);
+            if (streamTextures) return dispatchLevel({source.path, nullptr});
+            return pool.decodeAsync(source.path, priority, token, !options.packTextures);
         }
         
-        futures.push_back(std::move(tf));
-    }
+        const aiTexture* embTex = source.embedded;
+        if (embTex->mHeight == 0) {
+            // Сжатый формат (PNG/JPG и т.д.)
+            auto data = std::make_shared<std::vector<unsigned char>>(
+                reinterpret_cast<const unsigned char*>(embTex->pcData),
+                reinterpret_cast<const unsigned char*>(embTex->pcData) + embTex->mWidth
+            );
+            // achFormatHint это "jpg", "png" и т.д. без точки
+            std::string hint = ".";
+            hint += embTex->achFormatHint;
+            if (streamTextures) return dispatchLevel({hint, data});
+            return pool.decodeFromMemoryAsync(data, hint, priority, token, !options.packTextures);
+        }
+        
+        // Raw данные - конвертируем сразу в буфер пула
+        std::promise<PreloadedImage> promise;
+        auto future = promise.get_future();
+        
+        PreloadedImage result;
+        result.path = "<raw>";
+        size_t texelCount = static_cast<size_t>(embTex->mWidth) * embTex->mHeight;
+        auto* pixels = static_cast<unsigned char*>(PixelBufferPool::instance().acquire(texelCount * 4));
+        if (pixels) {
+            const aiTexel* texels = embTex->pcData;
+            for (size_t i = 0; i < texelCount; ++i) {
+                // aiTexel хранит BGRA, конвертируем в RGBA
+                pixels[i*4 + 0] = texels[i].r;
+                pixels[i*4 + 1] = texels[i].g;
+                pixels[i*4 + 2] = texels[i].b;
+                pixels[i*4 + 3] = texels[i].a;
+            }
+            result.image.data = pixels;
+            result.image.width = embTex->mWidth;
+            result.image.height = embTex->mHeight;
+            result.image.mipmaps = 1;
+            result.image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+            result.valid = true;
+            result.pooled = true;
+        }
+        
+        promise.set_value(std::move(result));
+        return future;
+    };
+    
+    // Бюджет пикселей: пока выданные буферы пула выше бюджета, новые декодирования
+    // ждут, пока готовые не уйдут в GPU. Следующее нужное изображение ставится всегда,
+    // поэтому загрузка не зависает; пик — бюджет плюс окно задач в полёте.
+    // Упаковке нужны все изображения сразу — для неё окно не ограничено.
+    PixelBufferPool& pixelPool = PixelBufferPool::instance();
+    const size_t decodeWindow = options.packTextures ? decodeSources.size()
+                                                     : std::max<size_t>(2, pool.getThreadCount() * 2);
+    size_t collected = 0;
+    auto dispatchDecodes = [&]() {
+        while (futures.size() < decodeSources.size()) {
+            size_t inFlight = futures.size() - collected;
+            if (inFlight > 0 && (inFlight >= decodeWindow || pixelPool.overBudget())) break;
+            futures.push_back(dispatchDecode(futures.size()));
+        }
+    };
+    dispatchDecodes();
+    progress.totalImages = static_cast<int>(decodeSources.size());
+    finishStage("dispatch");
     
     // ========== ШАГ 4: Создаём raylib Model со всеми mesh ==========
-    Model model = {0};
     model.transform = MatrixIdentity();
     
     // Meshes
@@ -556,12 +1008,242 @@ std::shared_ptr<raylib::Model> ParallelModelLoader::loadModel(
     model.meshes = (Mesh*)MemAlloc(model.meshCount * sizeof(Mesh));
     model.meshMaterial = (int*)MemAlloc(model.meshCount * sizeof(int));
     
+    // Тангенты нужны только мешам, чей материал читает normal map
+    std::vector<bool> normalMapped(scene->mNumMaterials, false);
+    for (const auto& texInfo : texturesToLoad) {
+        if (texInfo.mapType == MATERIAL_MAP_NORMAL) normalMapped[texInfo.materialIndex] = true;
+    }
+    auto needsTangents = [&](const aiMesh* mesh) {
+        return options.tangents != TangentMode::None &&
+               mesh->mMaterialIndex < normalMapped.size() && normalMapped[mesh->mMaterialIndex];
+    };
+    
+    stageStart = Clock::now();
     for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
-        model.meshes[i] = ConvertAssimpMesh(scene->mMeshes[i]);
+        model.meshes[i] = ConvertAssimpMesh(scene->mMeshes[i], needsTangents(scene->mMeshes[i]));
         model.meshMaterial[i] = scene->mMeshes[i]->mMaterialIndex;
+    }
+    
+    if (options.keepHierarchy) {
+        auto modelScene = std::make_shared<ModelScene>();
+        CollectSceneNodes(scene->mRootNode, -1, *modelScene);
+        // Bounds по float-вершинам, до квантования
+        for (int i = 0; i < model.meshCount; ++i) {
+            modelScene->meshBounds.push_back(GetMeshBoundingBox(model.meshes[i]));
+        }
+        report.sceneNodes = static_cast<int>(modelScene->nodes.size());
+        report.meshInstances = modelScene->meshInstances;
+        report.uniqueMeshes = model.meshCount;
+        loaded.scene = std::move(modelScene);
+    }
+    finishStage("convert");
+    if (token.isCancelled()) return abandon("convert");
+    
+    // Скелет и клипы; веса костей идут в меши до оптимизации (она их переставляет)
+    if (options.importAnimation) {
+        stageStart = Clock::now();
+        auto animations = std::make_shared<ModelAnimations>();
+        std::vector<int> meshJoints;
+        if (buildSkeleton(scene, animations->skeleton, meshJoints)) {
+            for (int i = 0; i < model.meshCount; ++i) {
+                convertMeshSkin(scene->mMeshes[i], animations->skeleton, meshJoints[i], model.meshes[i]);
+            }
+            animations->clips = convertAnimations(scene, animations->skeleton);
+            report.joints = animations->skeleton.getJointCount();
+            report.clips = static_cast<int>(animations->clips.size());
+            for (const AnimationClip& clip : animations->clips) {
+                for (const AnimationTrack& track : clip.tracks) {
+                    report.animationKeys += static_cast<int>(track.translations.size() +
+                                                             track.rotations.size() + track.scales.size());
+                }
+            }
+            loaded.animations = std::move(animations);
+        } else {
+            // Скелета нет (или суставов больше, чем вмещает boneIds): статическая модель,
+            // трансформации узлов запекаются, как это сделал бы PreTransformVertices
+            TraceLog(LOG_INFO, "ParallelModelLoader: %s has no usable skeleton, importing as static",
+                     report.path.c_str());
+            std::vector<Matrix> transforms = meshNodeTransforms(scene);
+            for (int i = 0; i < model.meshCount; ++i) TransformMeshVertices(model.meshes[i], transforms[i]);
+        }
+        finishStage("skeleton");
+    }
+    
+    // Сжатие клипов — по задаче на клип; скелет только читается, каждая задача
+    // пишет в свой клип
+    if (loaded.animations && options.compressAnimation && !loaded.animations->clips.empty()) {
+        stageStart = Clock::now();
+        const Skeleton& skeleton = loaded.animations->skeleton;
+        std::vector<std::future<ClipCompressionStats>> clipFutures;
+        for (AnimationClip& clip : loaded.animations->clips) {
+            clipFutures.push_back(pool.submit(
+                [&clip, &skeleton, settings = options.animationCompression]() {
+                    ClipCompressionStats stats;
+                    clip.compressed = std::make_shared<const CompressedClip>(
+                        compressClip(clip, skeleton, settings, &stats));
+                    clip.tracks.clear();
+                    clip.tracks.shrink_to_fit();
+                    return stats;
+                }, priority, token));
+        }
+        for (auto& f : clipFutures) report.animationCompression.push_back(f.get());
+        finishStage("clips");
+        if (token.isCancelled()) return abandon("clips");
+    }
+    
+    // Тангенты MikkTSpace со знаком бивектора — на воркерах, до оптимизации
+    // (она переставляет вершины вместе с тангентами)
+    if (options.tangents == TangentMode::Generate) {
+        stageStart = Clock::now();
+        std::vector<std::future<TangentStats>> tangentFutures;
+        for (int i = 0; i < model.meshCount; ++i) {
+            const Mesh& mesh = model.meshes[i];
+            if (mesh.tangents || !mesh.texcoords || !mesh.normals) continue;
+            if (!needsTangents(scene->mMeshes[i])) continue;
+            tangentFutures.push_back(pool.submit(
+                [mesh = &model.meshes[i], i]() {
+                    TangentStats stats;
+                    stats.meshIndex = i;
+                    generateTangents(*mesh, &stats);
+                    return stats;
+                }, priority, token));
+        }
+        for (auto& f : tangentFutures) report.tangents.push_back(f.get());
+        if (!tangentFutures.empty()) finishStage("tangents");
+        if (token.isCancelled()) return abandon("tangents");
+    }
+    
+    // Оптимизация порядка треугольников/вершин — на воркерах, до upload и LOD
+    if (options.optimizeMeshes) {
+        stageStart = Clock::now();
+        std::vector<std::future<MeshOptimizeStats>> optFutures;
+        for (int i = 0; i < model.meshCount; ++i) {
+            optFutures.push_back(pool.submit(
+                [mesh = &model.meshes[i], i, settings = options.optimizeSettings]() {
+                    MeshOptimizeStats stats = optimizeMesh(*mesh, settings);
+                    stats.meshIndex = i;
+                    return stats;
+                }, priority, token));
+        }
+        for (auto& f : optFutures) report.meshOptimizations.push_back(f.get());
+        finishStage("optimize");
+        if (token.isCancelled()) return abandon("optimize");
+    }
+    
+    // Коллизионные формы: из дискового кэша или построение на воркерах.
+    // Строятся по float-мешам до квантования.
+    if (options.collisionShapes != CollisionShapeType::None) {
+        stageStart = Clock::now();
+        JoltRuntime jolt;
+        auto shapes = std::make_shared<CookedShapes>();
+        shapes->type = options.collisionShapes;
+        
+        fs::path cacheFile;
+        if (!options.shapeCacheDir.empty()) {
+            cacheFile = shapeCachePath(options.shapeCacheDir, hashFileContents(modelPath),
+                                       options.collisionShapes, report.importFlags);
+        }
         
+        if (!cacheFile.empty() && loadShapeCache(cacheFile, model.meshCount, *shapes)) {
+            report.shapesFromCache = true;
+            finishStage("restore");
+        } else {
+            std::vector<std::future<JPH::RefConst<JPH::Shape>>> shapeFutures;
+            for (int i = 0; i < model.meshCount; ++i) {
+                shapeFutures.push_back(pool.submit(
+                    [mesh = model.meshes[i], type = options.collisionShapes]() {
+                        return cookMeshShape(mesh, type);
+                    }, priority, token));
+            }
+            for (auto& f : shapeFutures) shapes->meshes.push_back(f.get());
+            finishStage("cook");
+            
+            if (!cacheFile.empty()) {
+                stageStart = Clock::now();
+                if (!saveShapeCache(cacheFile, *shapes)) {
+                    TraceLog(LOG_WARNING, "ParallelModelLoader: failed to cache shapes for %s",
+                             report.path.c_str());
+                }
+                finishStage("shapesave");
+            }
+        }
+        for (const auto& shape : shapes->meshes) report.collisionShapes += shape != nullptr;
+        loaded.shapes = std::move(shapes);
+        if (token.isCancelled()) return abandon("shapes");
+    }
+    
+    // Дальше меши уходят в GPU и загрузка доводится до конца. Отменённые после этого
+    // декодирования вернутся пустыми — такие слоты остаются без текстуры.
+    
+    // LOD и окклюдеры отменённой загрузки не строятся (future получает пустой результат).
+    // LOD считаются на воркерах параллельно с декодированием текстур.
+    // Воркеры только читают CPU-массивы мешей: upload их не меняет, а UV атласа
+    // переписываются только после сбора этих задач (ШАГ 5.1).
+    stageStart = Clock::now();
+    std::vector<std::future<MeshLodChain>> lodFutures;
+    std::vector<Mesh> packedMeshes;
+    if (options.generateLods) {
+        for (int i = 0; i < model.meshCount; ++i) {
+            lodFutures.push_back(pool.submit(
+                [mesh = model.meshes[i], i, &options]() {
+                    MeshLodChain chain = generateMeshLods(mesh, i, options.lodSettings);
+                    if (options.optimizeMeshes) {
+                        for (Mesh& level : chain.levels) optimizeMesh(level, options.optimizeSettings);
+                    }
+                    if (options.vertexFormat == VertexFormat::Packed) {
+                        for (const Mesh& level : chain.levels) {
+                            chain.packed.push_back(packMesh(level, options.texcoordEncoding));
+                        }
+                    }
+                    return chain;
+                }, priority, token));
+        }
+    }
+    
+    // Окклюдеры — так же, по задаче на меш; каждая пишет только свой элемент
+    std::shared_ptr<ModelOccluders> occluders;
+    std::vector<std::future<OccluderStats>> occluderFutures;
+    if (options.buildOccluders) {
+        occluders = std::make_shared<ModelOccluders>();
+        occluders->meshes.resize(model.meshCount);
+        for (int i = 0; i < model.meshCount; ++i) {
+            occluderFutures.push_back(pool.submit(
+                [mesh = model.meshes[i], i, out = &occluders->meshes[i], &options]() {
+                    OccluderStats stats;
+                    *out = buildOccluderMesh(mesh, i, options.occluderSettings, &stats);
+                    return stats;
+                }, priority, token));
+        }
+    }
+    
+    const bool packVertices = options.vertexFormat == VertexFormat::Packed;
+    if (packVertices) {
+        // Квантование на воркерах; float-меши остаются на CPU, пока их читают LOD задачи.
+        // Без токена: отменённая задача вернула бы пустой меш, а загрузка уже доводится до конца
+        std::vector<std::future<PackedMeshData>> packFutures;
+        for (int i = 0; i < model.meshCount; ++i) {
+            packFutures.push_back(pool.submit(
+                [mesh = model.meshes[i], encoding = options.texcoordEncoding]() {
+                    return packMesh(mesh, encoding);
+                }, token.getPriority(priority)));
+        }
+        
+        auto packed = std::make_shared<PackedModelInfo>();
+        for (auto& f : packFutures) {
+            PackedMeshData data = f.get();
+            packed->meshes.push_back(data.info);
+            packed->errors.push_back(data.error);
+            packedMeshes.push_back(uploadPackedMesh(data));
+        }
+        report.quantization = packed->errors;
+        loaded.packed = std::move(packed);
+        finishStage("pack");
+    } else {
         // Upload to GPU после конвертации
-        UploadMesh(&model.meshes[i], false);
+        for (int i = 0; i < model.meshCount; ++i) {
+            UploadMesh(&model.meshes[i], false);
+        }
+        finishStage("upload");
     }
     
     // Materials - создаём дефолтные
@@ -594,54 +1276,265 @@ std::shared_ptr<raylib::Model> ParallelModelLoader::loadModel(
     }
     
     // ========== ШАГ 5: Собираем декодированные текстуры и загружаем в GPU ==========
-    int successCount = 0;
-    int failCount = 0;
+    stageStart = Clock::now();
+    TextureUploader& uploader = TextureUploader::instance();
+    std::vector<Image> images(decodeSources.size());
+    std::vector<std::string> imageSources(decodeSources.size());
+    std::vector<Texture2D> textures(decodeSources.size(), Texture2D{0});
+    std::vector<TextureStreamer::TextureDesc> streamedTextures(streamTextures ? decodeSources.size() : 0);
     
-    for (auto& tf : futures) {
-        PreloadedImage img = tf.future.get();
+    auto uploadImage = [&](size_t i) {
+        if (!images[i].data) return;
+        textures[i] = gpu::uploadTextureGPU(images[i], true);
+        UnloadImage(images[i]);
+        images[i] = {};
+        ++progress.texturesUploaded;
+        if (progressCallback) progressCallback(progress);
+    };
+    
+    for (size_t i = 0; i < decodeSources.size(); ++i) {
+        dispatchDecodes();
+        PreloadedImage img = futures[i].get();
+        collected = i + 1;
+        imageSources[i] = img.path;
         ++progress.imagesDecoded;
         
+        if (options.packTextures) {
+            // Упаковщик владеет изображениями сам (UnloadImage) — забираем копию
+            if (img.valid && img.image.data) images[i] = img.takeImage();
+            if (progressCallback) progressCallback(progress);
+            continue;
+        }
+        
+        // Стримящейся текстуре нужна копия хвоста: до него она выгружается без декодирования
+        if (streamTextures && img.valid && img.mipLevel > 0 && isDownsampleFormat(img.image.format)) {
+            TextureStreamer::TextureDesc& desc = streamedTextures[i];
+            desc.source = std::move(streamSources[i]);
+            desc.width = img.sourceWidth;
+            desc.height = img.sourceHeight;
+            desc.format = img.image.format;
+            desc.tail = ImageCopy(img.image);
+            desc.tailMip = img.mipLevel;
+        }
+        
+        // Без упаковки загружаем сразу, пока остальные ещё декодируются,
+        // и возвращаем буфер в пул до следующих декодирований
         if (img.valid && img.image.data) {
-            // Загружаем в GPU с mipmaps
-            Texture2D tex = gpu::uploadTextureGPU(img.image, true);
+            textures[i] = gpu::uploadPreloaded(img, true);
+            ++progress.texturesUploaded;
+        }
+        img.reset();
+        
+        // Колбэк обычно рисует кадр экрана загрузки: отдаём кадр, когда upload
+        // исчерпал его бюджет, а не после каждой текстуры
+        if (!uploader.hasFrameBudget()) {
+            if (progressCallback) progressCallback(progress);
+            uploader.beginFrame();
+        }
+    }
+    if (!options.packTextures && progressCallback) progressCallback(progress);
+    
+    std::vector<MaterialTextureSlots> materialSlots(model.materialCount);
+    for (auto& slots : materialSlots) slots.fill(-1);
+    for (const auto& ref : slotRefs) {
+        if (ref.materialIndex < model.materialCount) {
+            materialSlots[ref.materialIndex][ref.mapType] = ref.image;
+        }
+    }
+    
+    // Вариант шейдера нужен до упаковки: ORM собирается, только если шейдер читает его
+    // одним сэмплером. Без скиннинг шейдера (или со скелетом крупнее его палитры)
+    // анимированная модель остаётся на Default: AnimationSystem скиннит её вершины на CPU
+    PBRShaderVariant variant = packVertices ? PBRShaderVariant::Packed : PBRShaderVariant::Default;
+    if (loaded.animations && loaded.animations->skeleton.getJointCount() <= MaxGpuSkinningJoints &&
+        PBRMaterial::isShaderLoaded(PBRShaderVariant::Skinned)) {
+        variant = PBRShaderVariant::Skinned;
+    }
+    
+    std::vector<UvTransform> materialUv;
+    std::vector<bool> materialOrm;
+    if (options.packTextures) {
+        finishStage("decode");
+        stageStart = Clock::now();
+        
+        // В атлас идут только материалы, все меши которых не тайлят UV
+        std::vector<bool> atlasable(model.materialCount, true);
+        for (int i = 0; i < model.meshCount; ++i) {
+            const Mesh& mesh = model.meshes[i];
+            int mat = model.meshMaterial[i];
+            if (mat >= 0 && mat < model.materialCount &&
+                !texcoordsInUnitRange(mesh.texcoords, mesh.vertexCount)) {
+                atlasable[mat] = false;
+            }
+        }
+        
+        TexturePackSettings packSettings = options.texturePackSettings;
+        if (packSettings.packOrm && (!PBRMaterial::isShaderLoaded(variant) ||
+                                     PBRMaterial::getOrmLocation(PBRMaterial::getShader(variant)) < 0)) {
+            TraceLog(LOG_WARNING, "ParallelModelLoader: shader has no ormPacked uniform, ORM packing skipped for %s",
+                     report.path.c_str());
+            packSettings.packOrm = false;
+        }
+        
+        TexturePackResult packed = packMaterialTextures(images, materialSlots, atlasable, packSettings);
+        report.texturePack = packed.stats;
+        materialUv = std::move(packed.materialUv);
+        materialOrm = std::move(packed.materialOrm);
+        imageSources.resize(images.size(), "<packed>");
+        progress.totalImages = packed.stats.resultImages;
+        finishStage("texpack");
+        stageStart = Clock::now();
+    }
+    
+    // Каждое уникальное изображение загружается один раз, слоты разделяют Texture2D.
+    // Выгружает их deleter модели — по одному разу на id (UnloadMaterialTextures)
+    textures.resize(images.size(), Texture2D{0});
+    for (size_t i = 0; i < images.size(); ++i) uploadImage(i);
+    
+    int successCount = 0;
+    int failCount = 0;
+    for (int m = 0; m < model.materialCount; ++m) {
+        for (int mapType = 0; mapType < MAX_MATERIAL_MAPS; ++mapType) {
+            int idx = materialSlots[m][mapType];
+            if (idx < 0) continue;
             
-            if (tex.id != 0 && tex.id != 1 && tf.materialIndex < model.materialCount) {
-                // Выгружаем старую текстуру если была (но не дефолтную)
-                Texture2D& oldTex = model.materials[tf.materialIndex].maps[tf.mapType].texture;
-                if (oldTex.id > 1) {
-                    UnloadTexture(oldTex);
-                }
-                model.materials[tf.materialIndex].maps[tf.mapType].texture = tex;
-                
-                // Для albedo сбрасываем цвет на белый, чтобы текстура отображалась корректно
-                if (tf.mapType == MATERIAL_MAP_ALBEDO) {
-                    model.materials[tf.materialIndex].maps[MATERIAL_MAP_ALBEDO].color = WHITE;
-                }
-                
-                ++successCount;
-                TraceLog(LOG_DEBUG, "  Texture mat %d map %d: %dx%d -> ID %d", 
-                         tf.materialIndex, tf.mapType, img.image.width, img.image.height, tex.id);
-            } else {
+            const Texture2D& tex = textures[idx];
+            if (tex.id == 0 || tex.id == 1) {
                 ++failCount;
-                TraceLog(LOG_WARNING, "  FAIL upload mat %d map %d: tex.id=%d", 
-                         tf.materialIndex, tf.mapType, tex.id);
+                TraceLog(LOG_WARNING, "  FAIL mat %d map %d: %s",
+                         m, mapType, imageSources[idx].c_str());
+                continue;
             }
-        } else {
-            ++failCount;
-            TraceLog(LOG_WARNING, "  FAIL decode mat %d map %d: path=%s", 
-                     tf.materialIndex, tf.mapType, img.path.c_str());
+            
+            // Выгружаем старую текстуру если была (но не дефолтную)
+            Texture2D& oldTex = model.materials[m].maps[mapType].texture;
+            if (oldTex.id > 1) {
+                UnloadTexture(oldTex);
+            }
+            model.materials[m].maps[mapType].texture = tex;
+            if (streamTextures && streamedTextures[idx].tail.data) {
+                streamedTextures[idx].slots.emplace_back(m, mapType);
+            }
+            
+            // Для albedo сбрасываем цвет на белый, чтобы текстура отображалась корректно
+            if (mapType == MATERIAL_MAP_ALBEDO) {
+                model.materials[m].maps[MATERIAL_MAP_ALBEDO].color = WHITE;
+            }
+            
+            ++successCount;
+            TraceLog(LOG_DEBUG, "  Texture mat %d map %d: %dx%d -> ID %d",
+                     m, mapType, tex.width, tex.height, tex.id);
         }
-        
-        ++progress.texturesUploaded;
-        if (progressCallback) progressCallback(progress);
     }
     
     TraceLog(LOG_INFO, "ParallelModelLoader: %d textures loaded, %d failed", successCount, failCount);
     
+    // Bounds и плотность UV для оценки спроса — по float вершинам, до квантования
+    std::vector<TextureStreamer::MeshDesc> streamedMeshes;
+    if (streamTextures) {
+        std::erase_if(streamedTextures, [](TextureStreamer::TextureDesc& desc) {
+            if (!desc.slots.empty()) return false;
+            UnloadImage(desc.tail);
+            return true;
+        });
+        if (!streamedTextures.empty()) {
+            streamedMeshes.resize(model.meshCount);
+            for (int i = 0; i < model.meshCount; ++i) {
+                streamedMeshes[i].bounds = GetMeshBoundingBox(model.meshes[i]);
+                streamedMeshes[i].texelDensity = TextureResidency::meshTexelDensity(model.meshes[i]);
+            }
+        }
+    }
+    finishStage("textures");
+    
+    // ========== ШАГ 5.1: Забираем LOD ==========
+    if (!lodFutures.empty()) {
+        stageStart = Clock::now();
+        auto lods = std::make_shared<ModelLods>(model.meshCount);
+        for (auto& f : lodFutures) {
+            MeshLodChain chain = f.get();
+            if (chain.stats.empty()) continue;
+            int meshIndex = chain.stats.front().meshIndex;
+            report.lods.insert(report.lods.end(), chain.stats.begin(), chain.stats.end());
+            lods->setMeshChain(meshIndex, std::move(chain));
+        }
+        loaded.lods = std::move(lods);
+        finishStage("lods");
+    }
+    
+    if (!occluderFutures.empty()) {
+        stageStart = Clock::now();
+        for (auto& f : occluderFutures) report.occluders.push_back(f.get());
+        loaded.occluders = std::move(occluders);
+        finishStage("occluders");
+    }
+    
+    // Атлас: UV мешей и их LOD уровней переводятся в прямоугольник материала.
+    // Только после сбора LOD и окклюдеров: их задачи держат копии Mesh с теми же
+    // texcoords, и запись на месте гонялась бы с чтением (а уровни, построенные из
+    // уже сдвинутых UV, получили бы преобразование дважды)
+    if (!materialUv.empty()) {
+        for (int i = 0; i < model.meshCount; ++i) {
+            int mat = model.meshMaterial[i];
+            if (mat < 0 || mat >= model.materialCount) continue;
+            const UvTransform& uv = materialUv[mat];
+            if (uv.scale.x == 1.0f && uv.scale.y == 1.0f && uv.offset.x == 0.0f && uv.offset.y == 0.0f) continue;
+            
+            Mesh& mesh = model.meshes[i];
+            remapTexcoords(mesh.texcoords, mesh.vertexCount, uv);
+            if (packVertices) {
+                // Сжатые меши: UV деквантуются в шейдере, достаточно поправить offset/scale
+                PackedMeshInfo& info = loaded.packed->meshes[i];
+                UvTransform t = combineUvTransform({info.texcoordOffset, info.texcoordScale}, uv);
+                info.texcoordOffset = t.offset;
+                info.texcoordScale = t.scale;
+            } else {
+                UpdateMeshBuffer(mesh, RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD, mesh.texcoords,
+                                 mesh.vertexCount * 2 * sizeof(float), 0);
+            }
+            if (loaded.lods) loaded.lods->remapTexcoords(i, uv);
+        }
+    }
+    // Уровни грузятся в GPU уже с итоговыми UV
+    if (loaded.lods) loaded.lods->upload();
+    
+    // LOD и окклюдеры готовы — float-меши можно заменить сжатыми
+    if (packVertices) {
+        for (int i = 0; i < model.meshCount; ++i) {
+            // Позиции для пикинга переходят в сжатый меш (квантование вершины не сливает)
+            Mesh& source = model.meshes[i];
+            if (options.meshRetention != MeshRetention::DrawOnly &&
+                packedMeshes[i].vertexCount == source.vertexCount && !packedMeshes[i].vertices) {
+                packedMeshes[i].vertices = source.vertices;
+                source.vertices = nullptr;
+            }
+            UnloadMesh(source);
+            model.meshes[i] = packedMeshes[i];
+        }
+    }
+    
+    // Всё, что читало CPU массивы (LOD, атлас, стриминг, формы), уже отработало
+    for (int i = 0; i < model.meshCount; ++i) {
+        report.meshCpuReleased += releaseMeshCpuData(model.meshes[i], options.meshRetention);
+        report.meshCpuRetained += meshCpuBytes(model.meshes[i]);
+    }
+    if (loaded.lods) report.meshCpuReleased += loaded.lods->releaseCpuData(options.meshRetention);
+    
     // ========== ШАГ 6: Применяем PBR шейдер ==========
-    if (PBRMaterial::isShaderLoaded()) {
+    if (PBRMaterial::isShaderLoaded(variant)) {
         for (int i = 0; i < model.materialCount; ++i) {
-            model.materials[i].shader = PBRMaterial::getShader();
+            model.materials[i].shader = PBRMaterial::getShader(variant);
+        }
+    } else if (packVertices) {
+        TraceLog(LOG_WARNING, "ParallelModelLoader: packed shader is not loaded, %s will not render",
+                 report.path.c_str());
+    }
+    
+    // ORM упаковывался только под шейдер с uniform ormPacked (см. выбор варианта выше)
+    for (size_t i = 0; i < materialOrm.size(); ++i) {
+        Material& material = model.materials[i];
+        if (materialOrm[i] && material.maps[MATERIAL_MAP_METALNESS].texture.id > 1) {
+            PBRMaterial::setOrmPacked(material, true);
         }
     }
     
@@ -649,15 +1542,37 @@ std::shared_ptr<raylib::Model> ParallelModelLoader::loadModel(
     if (progressCallback) progressCallback(progress);
     
     // Оборачиваем в shared_ptr с кастомным deleter
-    auto result = std::shared_ptr<raylib::Model>(
+    loaded.model = std::shared_ptr<raylib::Model>(
         new raylib::Model(model),
         [](raylib::Model* m) {
-            // raylib::Model деструктор сам выгрузит ресурсы
+            // Меши выгрузит деструктор raylib::Model, текстуры UnloadModel не трогает
+            UnloadMaterialTextures(*m);
             delete m;
         }
     );
     
-    return result;
+    if (streamTextures) {
+        TextureStreamer::instance().addModel(loaded.model, std::move(streamedTextures), std::move(streamedMeshes));
+    }
+    
+    report.totalMs = msSince(loadStart);
+    report.log();
+    rememberReport(report);
+    return loaded;
+}
+
+void ParallelModelLoader::rememberReport(const ImportReport& report) {
+    std::lock_guard lock(reportsMutex_);
+    if (recentReports_.size() == RecentReportCount) {
+        recentReports_.erase(recentReports_.begin());
+    }
+    recentReports_.push_back(report);
+    ++reportsVersion_;
+}
+
+std::vector<ImportReport> ParallelModelLoader::getRecentReports() const {
+    std::lock_guard lock(reportsMutex_);
+    return recentReports_;
 }
 
 } // namespace kalan
@@ -1,6 +1,19 @@
 #pragma once
 
 #include "raylib-cpp.hpp"
+#include "AssimpConvert.hpp"
+#include "../animation/AnimationClip.hpp"
+#include "../animation/ClipCompression.hpp"
+#include "MeshOptimizer.hpp"
+#include "MeshRetention.hpp"
+#include "MeshTangents.hpp"
+#include "OccluderBuilder.hpp"
+#include "ModelLod.hpp"
+#include "VertexQuantization.hpp"
+#include "TexturePacker.hpp"
+#include "../core/PixelBufferPool.hpp"
+#include "../core/SmallTask.hpp"
+#include "../rendering/TextureUploader.hpp"
 #include <filesystem>
 #include <vector>
 #include <future>
@@ -8,38 +21,83 @@
 #include <thread>
 #include <mutex>
 #include <functional>
+#include <array>
 #include <atomic>
+#include <condition_variable>
+#include <type_traits>
 #include <unordered_map>
 
 namespace fs = std::filesystem;
 
 namespace kalan {
 
-// Предзагруженное изображение (в RAM, без GPU)
+// Предзагруженное изображение (в RAM, без GPU).
+// pooled — пиксели в PixelBufferPool, staging — уже скопированы в кольцо
+// TextureUploader (image.data указывает в него). В обоих случаях пиксели
+// освобождает деструктор, takeImage() или gpu::uploadPreloaded, не UnloadImage.
 struct PreloadedImage {
     Image image{};
     std::string path;
     bool valid = false;
+    bool pooled = false;
+    bool cancelled = false;     // задача снята токеном, image пустой
+    uint64_t staging = 0;       // участок TextureUploader, 0 — нет
+    int mipLevel = 0;           // image — этот mip уровень исходного изображения
+    int sourceWidth = 0;        // размер уровня 0 (decodeImageLevel)
+    int sourceHeight = 0;
     
     PreloadedImage() = default;
     PreloadedImage(PreloadedImage&& other) noexcept 
-        : image(other.image), path(std::move(other.path)), valid(other.valid) {
+        : image(other.image), path(std::move(other.path)), valid(other.valid),
+          pooled(other.pooled), cancelled(other.cancelled), staging(other.staging),
+          mipLevel(other.mipLevel), sourceWidth(other.sourceWidth), sourceHeight(other.sourceHeight) {
         other.image = {};
         other.valid = false;
+        other.staging = 0;
     }
     PreloadedImage& operator=(PreloadedImage&& other) noexcept {
         if (this != &other) {
-            if (valid && image.data) UnloadImage(image);
+            reset();
             image = other.image;
             path = std::move(other.path);
             valid = other.valid;
+            pooled = other.pooled;
+            cancelled = other.cancelled;
+            staging = other.staging;
+            mipLevel = other.mipLevel;
+            sourceWidth = other.sourceWidth;
+            sourceHeight = other.sourceHeight;
             other.image = {};
             other.valid = false;
+            other.staging = 0;
         }
         return *this;
     }
-    ~PreloadedImage() {
-        if (valid && image.data) UnloadImage(image);
+    ~PreloadedImage() { reset(); }
+    
+    // Забрать изображение во владение вызывающего (освобождать UnloadImage).
+    // Пиксели пула и кольца копируются, исходный буфер сразу освобождается.
+    [[nodiscard]] Image takeImage() {
+        Image result = image;
+        if ((pooled || staging) && image.data) {
+            result = ImageCopy(image);
+            reset();
+        }
+        image = {};
+        valid = false;
+        return result;
+    }
+    
+    void reset() noexcept {
+        if (staging) {
+            TextureUploader::instance().discard(staging);
+            staging = 0;
+        } else if (valid && image.data) {
+            if (pooled) PixelBufferPool::instance().release(image.data);
+            else UnloadImage(image);
+        }
+        image = {};
+        valid = false;
     }
     
     // Запрет копирования
@@ -47,35 +105,225 @@ struct PreloadedImage {
     PreloadedImage& operator=(const PreloadedImage&) = delete;
 };
 
+// Сжатый источник изображения для повторного декодирования (стриминг mip уровней):
+// файл path или байты data в памяти, тогда path — подсказка формата (".png")
+struct ImageSource {
+    std::string path;
+    std::shared_ptr<const std::vector<unsigned char>> data;
+};
+
+// Рабочий поток: декодировать источник и уменьшить до mip уровня не мельче level,
+// большая сторона которого не больше maxDimension (0 — без ограничения).
+// mipLevel результата — полученный уровень, sourceWidth/sourceHeight — размер уровня 0.
+// Форматы, которые не умеет downsampleImage, остаются уровнем 0.
+// stageForUpload — как в ImageThreadPool::decodeAsync.
+PreloadedImage decodeImageLevel(const ImageSource& source, int level, int maxDimension,
+                                bool stageForUpload = false);
+
+// Классы приоритета задач пула: воркер берёт задачу из самого срочного непустого класса,
+// внутри класса — FIFO. Prefetch выполняется, только когда срочнее ничего нет.
+enum class JobPriority : uint8_t {
+    Critical,       // кадр ждёт результат (физика, parallelFor)
+    Visible,        // нужно на экране в ближайшие кадры
+    Prefetch,       // может понадобиться позже
+};
+constexpr size_t JobPriorityCount = 3;
+
+// Общее состояние группы задач (например, одной загрузки): отмена и текущий приоритет.
+// Копии разделяют состояние; пустой токен (по умолчанию) никогда не отменяется.
+class JobToken {
+public:
+    JobToken() = default;
+    [[nodiscard]] static JobToken create(JobPriority priority = JobPriority::Visible);
+    
+    // Задачи проверяют флаг между стадиями; уже выполненная работа не откатывается
+    void cancel() const noexcept;
+    [[nodiscard]] bool isCancelled() const noexcept;
+    [[nodiscard]] JobPriority getPriority(JobPriority fallback = JobPriority::Visible) const noexcept;
+    [[nodiscard]] bool valid() const noexcept { return state_ != nullptr; }
+    
+private:
+    friend class ImageThreadPool;
+    
+    struct State {
+        std::atomic<bool> cancelled{false};
+        std::atomic<JobPriority> priority{JobPriority::Visible};
+    };
+    std::shared_ptr<State> state_;
+};
+
 // Thread pool для параллельного декодирования
 class ImageThreadPool {
 public:
+    // Счётчики для панели производительности; загрузка = busyNs / (время * потоки)
+    struct Stats {
+        size_t threads = 0;
+        size_t queued = 0;              // ждут свободного воркера
+        std::array<size_t, JobPriorityCount> queuedByPriority{};
+        size_t pending = 0;             // в очереди и выполняются
+        uint64_t completed = 0;
+        uint64_t busyNs = 0;            // суммарное время выполнения задач
+    };
+    
+    // Планирование воркеров в ОС (core/ThreadControl.hpp).
+    // frameWorkers > 0 делит пул: первые frameWorkers воркеров берут только Critical
+    // (задачи кадра) и работают с обычным приоритетом на любых ядрах, остальные —
+    // воркеры загрузки — берут Visible и Prefetch. niceLevel и excludedCpu применяются
+    // только к воркерам загрузки. Без frameWorkers все воркеры одинаковы.
+    struct WorkerSettings {
+        int niceLevel = 0;              // > 0 — уступать потокам с обычным приоритетом
+        int excludedCpu = -1;           // не занимать это ядро (например, ядро главного потока)
+        size_t frameWorkers = 0;        // не больше threads - 1
+    };
+    
     explicit ImageThreadPool(size_t threads = 0);
+    ImageThreadPool(size_t threads, const WorkerSettings& settings);
     ~ImageThreadPool();
     
-    // Добавить задачу декодирования
-    std::future<PreloadedImage> decodeAsync(const std::string& path);
+    // Добавить задачу декодирования. PNG/JPEG/TGA/BMP декодируются в PixelBufferPool
+    // (pooled = true), остальные форматы — через raylib.
+    // stageForUpload — сразу скопировать пиксели в кольцо TextureUploader, если есть место.
+    // Отменённая задача завершается с cancelled = true,
+    // длинное декодирование прерывается между чтением файла и распаковкой.
+    std::future<PreloadedImage> decodeAsync(const std::string& path,
+                                            JobPriority priority = JobPriority::Visible,
+                                            const JobToken& token = {},
+                                            bool stageForUpload = false);
     std::future<PreloadedImage> decodeFromMemoryAsync(
         std::shared_ptr<std::vector<unsigned char>> data, 
-        const std::string& hint);
+        const std::string& hint,
+        JobPriority priority = JobPriority::Visible,
+        const JobToken& token = {},
+        bool stageForUpload = false);
+    
+    // Добавить произвольную задачу (физика, батчинг инстансов и т.п.).
+    // Токен проверяется, когда воркер берёт задачу: отменённая не запускается,
+    // future сразу получает R() (для void — просто готов). Исключение fn уходит в future.
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& fn, JobPriority priority = JobPriority::Visible,
+                                                const JobToken& token = {});
+    
+    // Задача без результата: без packaged_task и future (job system физики)
+    void post(SmallTask task, JobPriority priority = JobPriority::Visible);
+    
+    // Разбить [0, count) на чанки и выполнить их параллельно (класс Critical).
+    // Вызывающий поток тоже обрабатывает чанки, поэтому вызов из воркера безопасен.
+    void parallelFor(size_t count, size_t minChunk,
+                     FunctionRef<void(size_t begin, size_t end)> fn);
+    
+    // Перенести ещё не начатые задачи токена в другой класс (игрок развернулся —
+    // prefetch стал visible). Новые задачи с этим токеном тоже берут новый класс.
+    void reprioritize(const JobToken& token, JobPriority priority);
+    // Отменить токен. Его декодирования (decodeAsync, decodeFromMemoryAsync) поднимаются
+    // в начало очереди — отменённые они завершаются сразу, и ожидающие future не стоят
+    // за чужой работой. Остальные задачи токена остаются на своём месте в своём классе
+    // и при выдаче воркеру завершаются без запуска.
+    void cancel(const JobToken& token);
     
     // Ожидать завершения всех задач
     void waitAll();
     
     size_t getThreadCount() const { return workers_.size(); }
+    // Воркеры, которые берут Critical (parallelFor, физика)
+    size_t getCriticalThreadCount() const {
+        return workerSettings_.frameWorkers > 0 ? workerSettings_.frameWorkers : workers_.size();
+    }
     size_t getPendingCount() const { return pendingCount_.load(); }
+    [[nodiscard]] Stats getStats() const;
 
 private:
-    void workerLoop();
+    // Состояние одного parallelFor. Хелпер может проснуться уже после выхода
+    // из parallelFor, поэтому состояние живёт до последней ссылки и затем
+    // возвращается в пул (без аллокаций в установившемся режиме).
+    struct ParallelState {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::atomic<size_t> refs{0};
+        FunctionRef<void(size_t, size_t)> fn;
+        size_t count = 0;
+        size_t chunkSize = 0;
+        size_t chunkCount = 0;
+    };
+    
+    struct QueuedTask {
+        SmallTask task;
+        JobToken token;                 // для reprioritize/cancel; пустой у post и parallelFor
+        bool decode = false;            // decodeAsync: cancel поднимает в начало Critical
+    };
+    
+    // Кольцевая очередь одного класса: ёмкость только растёт, push/pop не аллоцируют
+    struct TaskRing {
+        std::vector<QueuedTask> items;
+        size_t head = 0;
+        size_t count = 0;
+        
+        void push(QueuedTask&& task);
+        void pushFront(QueuedTask&& task);
+        QueuedTask pop();
+        QueuedTask& at(size_t i) { return items[(head + i) % items.size()]; }
+        void grow();
+    };
+    
+    void workerLoop(size_t index);
+    // Есть ли в очереди задача для воркера кадра / загрузки (под mutex_)
+    bool hasTaskLocked(bool frameWorker) const;
+    // Разбудить воркеры, которые берут класс priority
+    void notify(JobPriority priority, bool all = false);
+    void pushLocked(SmallTask&& task, JobPriority priority, const JobToken& token = {},
+                    bool decode = false);   // под mutex_
+    // Вынуть задачи токена из остальных классов в target; front — в начало очереди,
+    // decodeOnly — только декодирования
+    void moveTokenTasksLocked(const JobToken& token, JobPriority target, bool front, bool decodeOnly = false);
+    void runChunks(ParallelState& state);
+    void releaseState(ParallelState* state);
     
     std::vector<std::thread> workers_;
-    std::queue<std::function<void()>> tasks_;
-    std::mutex mutex_;
-    std::condition_variable cv_;
+    WorkerSettings workerSettings_;
+    std::array<TaskRing, JobPriorityCount> queues_;
+    size_t queuedCount_ = 0;            // сумма по queues_
+    std::vector<std::unique_ptr<ParallelState>> parallelStates_;
+    std::vector<ParallelState*> freeParallelStates_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;        // воркеры загрузки (или все без frameWorkers)
+    std::condition_variable frameCv_;   // воркеры кадра
     std::atomic<bool> stop_{false};
     std::atomic<size_t> pendingCount_{0};
+    std::atomic<uint64_t> completedCount_{0};
+    std::atomic<uint64_t> busyNs_{0};
 };
 
+template <typename F>
+std::future<std::invoke_result_t<F>> ImageThreadPool::submit(F&& fn, JobPriority priority, const JobToken& token) {
+    using R = std::invoke_result_t<F>;
+    // promise и fn перемещаются в задачу целиком, без shared_ptr обёртки
+    std::promise<R> promise;
+    auto future = promise.get_future();
+    SmallTask task([promise = std::move(promise), fn = std::forward<F>(fn), token]() mutable {
+        try {
+            if constexpr (std::is_void_v<R>) {
+                if (!token.isCancelled()) fn();
+                promise.set_value();
+            } else if (token.isCancelled()) {
+                promise.set_value(R());
+            } else {
+                promise.set_value(fn());
+            }
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    });
+    
+    const JobPriority target = token.getPriority(priority);
+    {
+        std::lock_guard lock(mutex_);
+        ++pendingCount_;
+        pushLocked(std::move(task), target, token);
+    }
+    
+    notify(target);
+    return future;
+}
+
 // Информация о декодированной текстуре
 struct DecodedTexture {
     Image image{};
@@ -84,6 +332,155 @@ struct DecodedTexture {
     bool valid = false;
 };
 
+// Коллизионные формы Jolt, строятся по мешам модели (physics/ShapeCooker.hpp)
+enum class CollisionShapeType : uint8_t {
+    None,
+    TriangleMesh,   // точная форма для статики
+    ConvexHull,     // выпуклая оболочка каждого меша — годится для динамических тел
+};
+
+struct CookedShapes;
+
+// Откуда берутся тангенты мешей с normal map
+enum class TangentMode : uint8_t {
+    Generate,       // авторские, а где их нет — generateTangents на воркерах
+    Authored,       // только из файла
+    None,
+};
+
+// Опциональные стадии импорта
+struct LoadOptions {
+    // Постобработка Assimp и тангенты
+    ImportSteps importSteps;
+    TangentMode tangents = TangentMode::Generate;
+    
+    // Поверх этих опций применяются файлы настроек импорта: <каталог>/.import,
+    // затем <файл>.import (resources/ImportSettings.hpp)
+    bool readImportSettings = true;
+    
+    // Переупорядочивание треугольников и вершин до upload (применяется и к LOD)
+    bool optimizeMeshes = true;
+    MeshOptimizeSettings optimizeSettings;
+    
+    // Уровень в кадре выбирает RenderSystem по MeshRenderer::lods (spawnModelScene)
+    bool generateLods = false;
+    LodSettings lodSettings;
+    
+    // Packed требует шейдер PBRShaderVariant::Packed и отрисовку через drawPackedModel
+    VertexFormat vertexFormat = VertexFormat::Float32;
+    TexcoordEncoding texcoordEncoding = TexcoordEncoding::Unorm16;
+    
+    // ORM и атласы мелких карт. Шейдер должен читать metallic из B, roughness из G,
+    // AO из R — как уже делается для metallicRoughness текстур glTF (assets/shaders/pbr.fs).
+    // ORM привязывается одним сэмплером в слоте metalness (PBRMaterial::isOrmPacked,
+    // uniform ormPacked); если у выбранного варианта шейдера uniform нет, ORM не собирается.
+    bool packTextures = false;
+    TexturePackSettings texturePackSettings;
+    
+    // Mip стриминг (rendering/TextureStreamer.hpp): в GPU сразу только хвост цепочки,
+    // старшие уровни догружаются по экранному спросу. С packTextures не сочетается.
+    bool streamTextures = false;
+    
+    // CPU копии мешей (и уровней LOD) после upload. Формы коллизий строятся при
+    // загрузке, поэтому позиции нужны только для пикинга и повторного построения.
+    MeshRetention meshRetention = MeshRetention::DrawOnly;
+    
+    // Сохранить граф узлов вместо запекания трансформаций в вершины.
+    // Меш, на который ссылаются несколько узлов, хранится один раз.
+    bool keepHierarchy = false;
+    
+    // Скелет и клипы ассета (LoadedModel::animations). Меши скиннятся по суставам,
+    // поэтому для анимированной модели keepHierarchy не действует, а формат вершин —
+    // всегда Float32 и без LOD (сжатый формат и LOD не несут весов костей).
+    bool importAnimation = false;
+    
+    // Клипы сжимаются на воркерах (по задаче на клип): удаление ключей в пределах
+    // допуска смещения вершин и квантование. Исходные дорожки после этого освобождаются.
+    bool compressAnimation = true;
+    ClipCompressionSettings animationCompression;
+    
+    // Окклюдеры для CPU отсечения перекрытых объектов (LoadedModel::occluders):
+    // упрощённые копии позиций мешей, строятся на воркерах параллельно с текстурами.
+    // Имеет смысл для крупной статической геометрии — стен, пола, зданий.
+    bool buildOccluders = false;
+    OccluderSettings occluderSettings;
+    
+    // Формы строятся на воркерах и кэшируются на диске по хэшу содержимого ассета.
+    // Пустой shapeCacheDir — без кэша.
+    CollisionShapeType collisionShapes = CollisionShapeType::None;
+    fs::path shapeCacheDir = "cache/shapes";
+    
+    // Класс задач загрузки в пуле; при заданном token берётся его текущий приоритет,
+    // так что ImageThreadPool::reprioritize поднимает и уже поставленные задачи.
+    // Отмена прерывает загрузку между стадиями до выгрузки в GPU (report.cancelled).
+    JobPriority priority = JobPriority::Visible;
+    JobToken token;
+};
+
+// Узел графа сцены ассета
+struct ModelSceneNode {
+    std::string name;
+    int parent = -1;                // индекс в ModelScene::nodes, -1 для корня
+    Vector3 translation{0.0f, 0.0f, 0.0f};
+    Quaternion rotation{0.0f, 0.0f, 0.0f, 1.0f};
+    Vector3 scale{1.0f, 1.0f, 1.0f};
+    std::vector<int> meshes;        // индексы в model.meshes
+};
+
+// Граф узлов в порядке обхода в глубину: родитель всегда раньше детей
+struct ModelScene {
+    std::vector<ModelSceneNode> nodes;
+    std::vector<BoundingBox> meshBounds;    // локальные bounds каждого меша модели
+    int meshInstances = 0;
+};
+
+// Что и сколько заняло при импорте одного ассета
+struct ImportReport {
+    struct Stage {
+        std::string name;
+        double ms = 0.0;
+    };
+    
+    std::string path;
+    std::vector<std::string> settingsFiles;     // применённые файлы .import
+    unsigned int importFlags = 0;               // aiPostProcessSteps
+    std::vector<Stage> stages;
+    std::vector<MeshOptimizeStats> meshOptimizations;
+    std::vector<TangentStats> tangents;         // меши, которым тангенты построены при импорте
+    std::vector<LodLevelStats> lods;
+    std::vector<OccluderStats> occluders;       // только для LoadOptions::buildOccluders
+    std::vector<QuantizationError> quantization; // по мешам, только для VertexFormat::Packed
+    TexturePackStats texturePack;
+    int sceneNodes = 0;         // только для LoadOptions::keepHierarchy
+    int meshInstances = 0;
+    int uniqueMeshes = 0;
+    int joints = 0;             // только для LoadOptions::importAnimation
+    int clips = 0;
+    int animationKeys = 0;      // ключей во всех дорожках всех клипов
+    std::vector<ClipCompressionStats> animationCompression; // по клипам, только для compressAnimation
+    int collisionShapes = 0;
+    bool shapesFromCache = false;
+    size_t meshCpuReleased = 0;     // байт CPU копий мешей, освобождённых после upload
+    size_t meshCpuRetained = 0;
+    bool cancelled = false;     // загрузка брошена по LoadOptions::token, модели нет
+    double totalMs = 0.0;
+    
+    void addStage(std::string name, double ms);
+    void log() const;
+};
+
+// Результат загрузки: модель и всё, что было посчитано при импорте
+struct LoadedModel {
+    std::shared_ptr<raylib::Model> model;
+    std::shared_ptr<ModelLods> lods;   // nullptr, если LOD не генерировались
+    std::shared_ptr<PackedModelInfo> packed; // nullptr для VertexFormat::Float32
+    std::shared_ptr<ModelScene> scene; // nullptr без keepHierarchy
+    std::shared_ptr<CookedShapes> shapes; // nullptr при CollisionShapeType::None
+    std::shared_ptr<ModelAnimations> animations; // nullptr без importAnimation или без скелета
+    std::shared_ptr<ModelOccluders> occluders; // nullptr без buildOccluders
+    ImportReport report;
+};
+
 // Параллельный загрузчик моделей (использует Assimp)
 class ParallelModelLoader {
 public:
@@ -105,20 +502,48 @@ public:
 
     static ParallelModelLoader& instance();
     
-    // Загрузить модель с параллельным декодированием текстур через Assimp
+    // Загрузить модель с параллельным декодированием текстур через Assimp.
+    // Колбэк вызывается синхронно, только на время загрузки.
     std::shared_ptr<raylib::Model> loadModel(
         const fs::path& modelPath,
-        std::function<void(const LoadProgress&)> progressCallback = nullptr
+        FunctionRef<void(const LoadProgress&)> progressCallback = nullptr
+    );
+    
+    // То же, но с опциональными стадиями импорта и отчётом
+    LoadedModel loadModelEx(
+        const fs::path& modelPath,
+        const LoadOptions& options,
+        FunctionRef<void(const LoadProgress&)> progressCallback = nullptr
     );
     
     // Установить количество потоков (по умолчанию = CPU cores)
     void setThreadCount(size_t count);
+    // Приоритет и ядра воркеров в ОС; как и setThreadCount, пересоздаёт пул
+    void setWorkerSettings(const ImageThreadPool::WorkerSettings& settings);
+    
+    // Общий пул воркеров загрузчика (создаётся лениво)
+    ImageThreadPool& getThreadPool();
+    // nullptr, пока пул не создан
+    [[nodiscard]] const ImageThreadPool* findThreadPool() const noexcept { return threadPool_.get(); }
+    
+    // Отчёты последних загрузок, новые в конце.
+    // Версия растёт с каждой загрузкой — копировать отчёты только при её смене.
+    static constexpr size_t RecentReportCount = 8;
+    [[nodiscard]] std::vector<ImportReport> getRecentReports() const;
+    [[nodiscard]] uint64_t getReportsVersion() const noexcept { return reportsVersion_.load(); }
 
 private:
     ParallelModelLoader();
     
+    void rememberReport(const ImportReport& report);
+    
     std::unique_ptr<ImageThreadPool> threadPool_;
     size_t threadCount_ = 0;
+    ImageThreadPool::WorkerSettings workerSettings_;
+    
+    mutable std::mutex reportsMutex_;
+    std::vector<ImportReport> recentReports_;
+    std::atomic<uint64_t> reportsVersion_{0};
 };
 
 // Утилиты для GPU-ускоренных операций
@@ -126,6 +551,10 @@ namespace gpu {
     // Загрузить текстуру из Image с GPU-генерацией mipmaps
     Texture2D uploadTextureGPU(Image image, bool genMipmaps = true);
     
+    // Загрузить декодированное изображение (из кольца TextureUploader, если оно
+    // туда скопировано) и освободить его пиксели. Только главный поток.
+    Texture2D uploadPreloaded(PreloadedImage& image, bool genMipmaps = true);
+    
     // Batch загрузка нескольких текстур
     std::vector<Texture2D> uploadTexturesBatchGPU(std::vector<Image>& images, bool genMipmaps = true);
 }
@@ -0,0 +1,154 @@
+#include "PooledImageDecoder.hpp"
+#include "../core/PixelBufferPool.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Своя статическая копия stb_image (из поставки raylib) с аллокатором пула.
+// raylib собирает свою с RL_MALLOC — символы не пересекаются.
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_NO_STDIO
+#define STBI_ONLY_PNG
+#define STBI_ONLY_JPEG
+#define STBI_ONLY_TGA
+#define STBI_ONLY_BMP
+#define STBI_MALLOC(size) ::kalan::PixelBufferPool::instance().acquire(size)
+#define STBI_REALLOC(p, size) ::kalan::PixelBufferPool::instance().reallocate(p, size)
+#define STBI_FREE(p) ::kalan::PixelBufferPool::instance().release(p)
+#include "external/stb_image.h"
+
+namespace kalan {
+
+bool decodeImagePooled(const unsigned char* data, int size, Image& out) {
+    out = {};
+    if (!data || size <= 0) return false;
+    // 16-битные PNG raylib грузит в 16-битные форматы — не сужаем их здесь
+    if (stbi_is_16_bit_from_memory(data, size)) return false;
+
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    unsigned char* pixels = stbi_load_from_memory(data, size, &width, &height, &channels, 0);
+    if (!pixels) return false;
+
+    // Те же форматы, что выбирает LoadImageFromMemory
+    int format = 0;
+    switch (channels) {
+        case 1: format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE; break;
+        case 2: format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA; break;
+        case 3: format = PIXELFORMAT_UNCOMPRESSED_R8G8B8; break;
+        case 4: format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8; break;
+        default:
+            stbi_image_free(pixels);
+            return false;
+    }
+
+    out.data = pixels;
+    out.width = width;
+    out.height = height;
+    out.mipmaps = 1;
+    out.format = format;
+    return true;
+}
+
+namespace {
+
+int channelCount(int format) {
+    switch (format) {
+        case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE: return 1;
+        case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA: return 2;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8: return 3;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8: return 4;
+        default: return 0;
+    }
+}
+
+} // anonymous namespace
+
+bool isDownsampleFormat(int format) {
+    return channelCount(format) > 0;
+}
+
+Image downsampleImage(const Image& source, int level) {
+    const int channels = channelCount(source.format);
+    if (!source.data || channels == 0 || level < 0 || source.width <= 0 || source.height <= 0) return {};
+
+    Image result{};
+    result.width = std::max(1, source.width >> std::min(level, 30));
+    result.height = std::max(1, source.height >> std::min(level, 30));
+    result.mipmaps = 1;
+    result.format = source.format;
+    const size_t dstRow = static_cast<size_t>(result.width) * channels;
+    auto* dst = static_cast<unsigned char*>(MemAlloc(static_cast<unsigned int>(dstRow * result.height)));
+    if (!dst) return {};
+    result.data = dst;
+
+    const auto* src = static_cast<const unsigned char*>(source.data);
+    const size_t srcRow = static_cast<size_t>(source.width) * channels;
+    if (result.width == source.width && result.height == source.height) {
+        std::memcpy(dst, src, dstRow * result.height);
+        return result;
+    }
+
+    // Границы блоков по x общие для всех строк; для размеров не степени двойки
+    // блоки соседних пикселей отличаются на один тексел
+    std::vector<int> columns(result.width + 1);
+    for (int x = 0; x <= result.width; ++x) {
+        columns[x] = static_cast<int>(static_cast<int64_t>(x) * source.width / result.width);
+    }
+
+    std::vector<uint32_t> sums(dstRow);
+    for (int y = 0; y < result.height; ++y) {
+        const int y0 = static_cast<int>(static_cast<int64_t>(y) * source.height / result.height);
+        const int y1 = static_cast<int>(static_cast<int64_t>(y + 1) * source.height / result.height);
+        std::fill(sums.begin(), sums.end(), 0u);
+
+        // Сначала складываем строки блока: источник читается подряд
+        for (int sy = y0; sy < y1; ++sy) {
+            const unsigned char* row = src + static_cast<size_t>(sy) * srcRow;
+            for (int x = 0; x < result.width; ++x) {
+                uint32_t* sum = &sums[static_cast<size_t>(x) * channels];
+                for (int sx = columns[x]; sx < columns[x + 1]; ++sx) {
+                    const unsigned char* texel = row + static_cast<size_t>(sx) * channels;
+                    for (int c = 0; c < channels; ++c) sum[c] += texel[c];
+                }
+            }
+        }
+
+        unsigned char* out = dst + static_cast<size_t>(y) * dstRow;
+        for (int x = 0; x < result.width; ++x) {
+            const uint32_t area = static_cast<uint32_t>((columns[x + 1] - columns[x]) * (y1 - y0));
+            for (int c = 0; c < channels; ++c) {
+                const size_t i = static_cast<size_t>(x) * channels + c;
+                out[i] = static_cast<unsigned char>((sums[i] + area / 2) / area);
+            }
+        }
+    }
+    return result;
+}
+
+unsigned char* readFilePooled(const std::string& path, int& size) {
+    size = 0;
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return nullptr;
+
+    unsigned char* data = nullptr;
+    if (std::fseek(file, 0, SEEK_END) == 0) {
+        long length = std::ftell(file);
+        if (length > 0 && std::fseek(file, 0, SEEK_SET) == 0) {
+            data = static_cast<unsigned char*>(PixelBufferPool::instance().acquire(static_cast<size_t>(length)));
+            if (data && std::fread(data, 1, static_cast<size_t>(length), file) == static_cast<size_t>(length)) {
+                size = static_cast<int>(length);
+            } else {
+                PixelBufferPool::instance().release(data);
+                data = nullptr;
+            }
+        }
+    }
+    std::fclose(file);
+    return data;
+}
+
+} // namespace kalan
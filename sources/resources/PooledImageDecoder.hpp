@@ -0,0 +1,26 @@
+#pragma once
+
+#include "raylib.h"
+#include <string>
+
+namespace kalan {
+
+// Декодирование PNG/JPEG/TGA/BMP через stb_image прямо в буферы PixelBufferPool
+// (все аллокации декодера, включая промежуточные, идут через пул).
+// Пиксели такого Image освобождаются PixelBufferPool::release, не UnloadImage.
+// Возвращает false для остальных форматов и 16-битных PNG — их грузит raylib.
+[[nodiscard]] bool decodeImagePooled(const unsigned char* data, int size, Image& out);
+
+// Форматы, которые умеет уменьшать downsampleImage: 8 бит на канал, 1-4 канала
+[[nodiscard]] bool isDownsampleFormat(int format);
+
+// Уменьшить изображение до mip уровня level усреднением блоков (размер уровня —
+// max(1, width >> level) x max(1, height >> level)). Источник не меняется и может
+// лежать в пуле; результат — в куче raylib (UnloadImage). Пустой Image, если формат
+// не подходит (isDownsampleFormat).
+[[nodiscard]] Image downsampleImage(const Image& source, int level);
+
+// Прочитать файл целиком в буфер пула; nullptr при ошибке
+[[nodiscard]] unsigned char* readFilePooled(const std::string& path, int& size);
+
+} // namespace kalan
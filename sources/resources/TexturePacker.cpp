@@ -0,0 +1,394 @@
+#include "TexturePacker.hpp"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <numeric>
+#include <unordered_map>
+
+namespace kalan {
+
+namespace {
+
+// RGBA8 копия изображения нужного размера (исходник не меняется)
+Image CopyAsRgba8(const Image& src, int width, int height) {
+    Image copy = ImageCopy(src);
+    if (copy.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+        ImageFormat(&copy, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    }
+    if (copy.width != width || copy.height != height) {
+        ImageResize(&copy, width, height);
+    }
+    return copy;
+}
+
+bool ValidImage(const Image& image) {
+    return image.data != nullptr && image.width > 0 && image.height > 0;
+}
+
+// Попытка уложить все элементы на страницы size x size.
+// singlePage — при переполнении первой страницы сразу неудача.
+bool ShelfPack(const std::vector<AtlasItem>& items, const std::vector<size_t>& order,
+               int size, int padding, bool singlePage, AtlasLayout& layout) {
+    layout.width = size;
+    layout.height = size;
+    layout.pageCount = 1;
+    layout.rects.assign(items.size(), {});
+
+    int page = 0, x = 0, y = 0, shelfHeight = 0;
+    for (size_t i : order) {
+        int w = items[i].width + padding * 2;
+        int h = items[i].height + padding * 2;
+        if (w > size || h > size) return false;
+
+        if (x + w > size) {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        if (y + h > size) {
+            if (singlePage) return false;
+            ++page;
+            x = y = shelfHeight = 0;
+        }
+
+        layout.rects[i] = {page, x + padding, y + padding, items[i].width, items[i].height};
+        x += w;
+        shelfHeight = std::max(shelfHeight, h);
+    }
+    layout.pageCount = page + 1;
+    return true;
+}
+
+// Значение по умолчанию для пустого слота атласа: то же, что у PBRMaterial::initDefaults
+Color DefaultSlotColor(int slot) {
+    switch (slot) {
+        case MATERIAL_MAP_NORMAL:    return {128, 128, 255, 255};
+        case MATERIAL_MAP_METALNESS: return {255, 255, 0, 255};     // ORM: AO 1, roughness 1, metal 0
+        case MATERIAL_MAP_EMISSION:  return BLACK;
+        default:                     return WHITE;
+    }
+}
+
+} // anonymous namespace
+
+// ============ ORM ============
+
+Image packOrmImage(const OrmChannel& ao, const OrmChannel& roughness, const OrmChannel& metallic) {
+    const OrmChannel* channels[3] = {&ao, &roughness, &metallic};
+
+    int width = 1, height = 1;
+    for (const OrmChannel* c : channels) {
+        if (c->image && ValidImage(*c->image)) {
+            width = std::max(width, c->image->width);
+            height = std::max(height, c->image->height);
+        }
+    }
+
+    Image result = GenImageColor(width, height, WHITE);
+    auto* dst = static_cast<unsigned char*>(result.data);
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+
+    for (int out = 0; out < 3; ++out) {
+        const OrmChannel& c = *channels[out];
+        if (!c.image || !ValidImage(*c.image)) {
+            auto value = static_cast<unsigned char>(std::clamp(c.fallback, 0.0f, 1.0f) * 255.0f + 0.5f);
+            for (size_t p = 0; p < pixelCount; ++p) dst[p * 4 + out] = value;
+            continue;
+        }
+
+        Image src = CopyAsRgba8(*c.image, width, height);
+        const auto* srcPixels = static_cast<const unsigned char*>(src.data);
+        int channel = std::clamp(c.channel, 0, 3);
+        for (size_t p = 0; p < pixelCount; ++p) dst[p * 4 + out] = srcPixels[p * 4 + channel];
+        UnloadImage(src);
+    }
+
+    return result;
+}
+
+uint64_t hashImage(const Image& image) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ull;
+    };
+    mix(static_cast<uint64_t>(image.width));
+    mix(static_cast<uint64_t>(image.height));
+    mix(static_cast<uint64_t>(image.format));
+    mix(static_cast<uint64_t>(image.mipmaps));
+    if (!image.data) return hash;
+
+    // По 8 байт за шаг — для мегабайтных текстур побайтовый FNV заметно медленнее
+    size_t size = static_cast<size_t>(GetPixelDataSize(image.width, image.height, image.format));
+    const auto* bytes = static_cast<const unsigned char*>(image.data);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        mix(word);
+    }
+    for (; i < size; ++i) mix(bytes[i]);
+    return hash;
+}
+
+bool imagesEqual(const Image& a, const Image& b) {
+    if (a.width != b.width || a.height != b.height || a.format != b.format || a.mipmaps != b.mipmaps) return false;
+    if (!a.data || !b.data) return a.data == b.data;
+    size_t size = static_cast<size_t>(GetPixelDataSize(a.width, a.height, a.format));
+    return std::memcmp(a.data, b.data, size) == 0;
+}
+
+// ============ Атлас ============
+
+AtlasLayout packAtlas(const std::vector<AtlasItem>& items, int maxSize, int padding) {
+    AtlasLayout layout;
+    if (items.empty()) return layout;
+
+    // Сначала высокие — полки заполняются плотнее
+    std::vector<size_t> order(items.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&items](size_t a, size_t b) {
+        if (items[a].height != items[b].height) return items[a].height > items[b].height;
+        return items[a].width > items[b].width;
+    });
+
+    for (int size = 64; size <= maxSize; size *= 2) {
+        if (ShelfPack(items, order, size, padding, true, layout)) return layout;
+    }
+    if (ShelfPack(items, order, maxSize, padding, false, layout)) return layout;
+
+    return AtlasLayout{};
+}
+
+Image buildAtlasImage(const AtlasLayout& layout, int page,
+                      const std::vector<const Image*>& tiles, int padding, Color fill) {
+    Image atlas = GenImageColor(layout.width, layout.height, fill);
+    auto* dst = static_cast<unsigned char*>(atlas.data);
+
+    for (size_t i = 0; i < layout.rects.size() && i < tiles.size(); ++i) {
+        const AtlasRect& rect = layout.rects[i];
+        if (rect.page != page || !tiles[i] || !ValidImage(*tiles[i])) continue;
+
+        Image tile = CopyAsRgba8(*tiles[i], rect.width, rect.height);
+        const auto* src = static_cast<const unsigned char*>(tile.data);
+
+        // Тайл вместе с рамкой padding: пиксели рамки берутся с ближайшего края
+        for (int y = -padding; y < rect.height + padding; ++y) {
+            int ay = rect.y + y;
+            if (ay < 0 || ay >= layout.height) continue;
+            int sy = std::clamp(y, 0, rect.height - 1);
+            for (int x = -padding; x < rect.width + padding; ++x) {
+                int ax = rect.x + x;
+                if (ax < 0 || ax >= layout.width) continue;
+                int sx = std::clamp(x, 0, rect.width - 1);
+                std::memcpy(dst + (static_cast<size_t>(ay) * layout.width + ax) * 4,
+                            src + (static_cast<size_t>(sy) * rect.width + sx) * 4, 4);
+            }
+        }
+        UnloadImage(tile);
+    }
+
+    return atlas;
+}
+
+UvTransform atlasUvTransform(const AtlasRect& rect, int atlasWidth, int atlasHeight) {
+    UvTransform t;
+    t.offset = {static_cast<float>(rect.x) / atlasWidth, static_cast<float>(rect.y) / atlasHeight};
+    t.scale = {static_cast<float>(rect.width) / atlasWidth, static_cast<float>(rect.height) / atlasHeight};
+    return t;
+}
+
+UvTransform combineUvTransform(const UvTransform& base, const UvTransform& atlas) {
+    UvTransform t;
+    t.offset = {atlas.offset.x + base.offset.x * atlas.scale.x, atlas.offset.y + base.offset.y * atlas.scale.y};
+    t.scale = {base.scale.x * atlas.scale.x, base.scale.y * atlas.scale.y};
+    return t;
+}
+
+bool texcoordsInUnitRange(const float* texcoords, int vertexCount, float epsilon) {
+    if (!texcoords) return false;
+    for (int i = 0; i < vertexCount * 2; ++i) {
+        if (texcoords[i] < -epsilon || texcoords[i] > 1.0f + epsilon) return false;
+    }
+    return true;
+}
+
+void remapTexcoords(float* texcoords, int vertexCount, const UvTransform& transform) {
+    if (!texcoords) return;
+    for (int i = 0; i < vertexCount; ++i) {
+        texcoords[i * 2 + 0] = transform.offset.x + texcoords[i * 2 + 0] * transform.scale.x;
+        texcoords[i * 2 + 1] = transform.offset.y + texcoords[i * 2 + 1] * transform.scale.y;
+    }
+}
+
+// ============ Упаковка материалов ============
+
+TexturePackResult packMaterialTextures(std::vector<Image>& images,
+                                       std::vector<MaterialTextureSlots>& materials,
+                                       const std::vector<bool>& atlasable,
+                                       const TexturePackSettings& settings) {
+    TexturePackResult result;
+    result.materialUv.assign(materials.size(), UvTransform{});
+    result.materialOrm.assign(materials.size(), false);
+    result.stats.sourceImages = static_cast<int>(std::count_if(images.begin(), images.end(), ValidImage));
+
+    // ---------- Дедупликация ----------
+    std::vector<int> canonical(images.size());
+    std::iota(canonical.begin(), canonical.end(), 0);
+    {
+        std::unordered_map<uint64_t, std::vector<int>> byHash;
+        for (int i = 0; i < static_cast<int>(images.size()); ++i) {
+            if (!ValidImage(images[i])) continue;
+            auto& bucket = byHash[hashImage(images[i])];
+            for (int other : bucket) {
+                if (imagesEqual(images[other], images[i])) {
+                    canonical[i] = other;
+                    ++result.stats.duplicatesRemoved;
+                    break;
+                }
+            }
+            if (canonical[i] == i) bucket.push_back(i);
+        }
+    }
+    for (auto& slots : materials) {
+        for (int& s : slots) if (s >= 0) s = canonical[s];
+    }
+
+    // ---------- ORM ----------
+    if (settings.packOrm) {
+        // Одинаковые тройки источников дают одну ORM текстуру
+        std::map<std::array<int, 3>, int> ormCache;
+        for (size_t m = 0; m < materials.size(); ++m) {
+            MaterialTextureSlots& slots = materials[m];
+            int metal = slots[MATERIAL_MAP_METALNESS];
+            int rough = slots[MATERIAL_MAP_ROUGHNESS];
+            int ao = slots[MATERIAL_MAP_OCCLUSION];
+
+            int distinct = (metal >= 0) + (rough >= 0 && rough != metal) + (ao >= 0 && ao != metal && ao != rough);
+            if (distinct < 2) continue;
+
+            std::array<int, 3> key{ao, rough, metal};
+            auto it = ormCache.find(key);
+            if (it == ormCache.end()) {
+                // Общая metallicRoughness текстура glTF: roughness в G, metallic в B.
+                // Отдельные карты считаются одноканальными — берём R.
+                bool shared = metal >= 0 && metal == rough;
+                OrmChannel aoChannel{ao >= 0 ? &images[ao] : nullptr, 0, 1.0f};
+                OrmChannel roughChannel{rough >= 0 ? &images[rough] : nullptr, shared ? 1 : 0, 1.0f};
+                OrmChannel metalChannel{metal >= 0 ? &images[metal] : nullptr, shared ? 2 : 0, 0.0f};
+
+                images.push_back(packOrmImage(aoChannel, roughChannel, metalChannel));
+                it = ormCache.emplace(key, static_cast<int>(images.size()) - 1).first;
+                ++result.stats.ormPacked;
+            }
+            // Один сэмплер на три канала: шейдер читает их по флагу материала
+            slots[MATERIAL_MAP_METALNESS] = it->second;
+            slots[MATERIAL_MAP_ROUGHNESS] = -1;
+            slots[MATERIAL_MAP_OCCLUSION] = -1;
+            result.materialOrm[m] = true;
+        }
+    }
+
+    // ---------- Атласы ----------
+    if (settings.atlas) {
+        // Кандидаты группируются по набору занятых слотов, чтобы в атласе не было
+        // заливок там, где у исходного материала текстуры не было вовсе
+        std::map<uint32_t, std::vector<size_t>> groups;
+        for (size_t m = 0; m < materials.size(); ++m) {
+            if (m >= atlasable.size() || !atlasable[m]) continue;
+
+            uint32_t mask = 0;
+            int width = -1, height = -1;
+            bool fits = true;
+            for (int slot = 0; slot < MAX_MATERIAL_MAPS && fits; ++slot) {
+                int idx = materials[m][slot];
+                if (idx < 0) continue;
+                if (slot == MATERIAL_MAP_CUBEMAP || slot == MATERIAL_MAP_IRRADIANCE ||
+                    slot == MATERIAL_MAP_PREFILTER) { fits = false; break; }
+                const Image& img = images[idx];
+                if (width < 0) { width = img.width; height = img.height; }
+                fits = img.width == width && img.height == height &&
+                       width <= settings.maxTileSize && height <= settings.maxTileSize;
+                mask |= 1u << slot;
+            }
+            if (fits && mask != 0) groups[mask].push_back(m);
+        }
+
+        for (auto& [mask, group] : groups) {
+            // Материалы с одинаковыми текстурами занимают один прямоугольник
+            std::map<MaterialTextureSlots, size_t> tileIndex;
+            std::vector<MaterialTextureSlots> tiles;
+            std::vector<size_t> materialTile(group.size());
+            for (size_t g = 0; g < group.size(); ++g) {
+                auto [it, inserted] = tileIndex.try_emplace(materials[group[g]], tiles.size());
+                if (inserted) tiles.push_back(materials[group[g]]);
+                materialTile[g] = it->second;
+            }
+            if (tiles.size() < 2) continue;
+
+            std::vector<AtlasItem> items;
+            for (const auto& t : tiles) {
+                int first = *std::find_if(t.begin(), t.end(), [](int s) { return s >= 0; });
+                items.push_back({images[first].width, images[first].height});
+            }
+
+            AtlasLayout layout = packAtlas(items, settings.maxAtlasSize, settings.padding);
+            if (layout.pageCount == 0) continue;
+
+            for (int page = 0; page < layout.pageCount; ++page) {
+                size_t onPage = std::count_if(layout.rects.begin(), layout.rects.end(),
+                                              [page](const AtlasRect& r) { return r.page == page; });
+                if (onPage < 2) continue;   // один тайл на странице — атлас ничего не даёт
+
+                MaterialTextureSlots pageSlots;
+                pageSlots.fill(-1);
+                // Слоты с одинаковыми источниками (общая metallicRoughness) получают один атлас
+                std::map<std::vector<int>, int> pageAtlases;
+                for (int slot = 0; slot < MAX_MATERIAL_MAPS; ++slot) {
+                    if (!(mask & (1u << slot))) continue;
+                    std::vector<int> sources(tiles.size());
+                    for (size_t t = 0; t < tiles.size(); ++t) sources[t] = tiles[t][slot];
+
+                    auto [it, inserted] = pageAtlases.try_emplace(sources, -1);
+                    if (inserted) {
+                        std::vector<const Image*> tileImages(tiles.size(), nullptr);
+                        for (size_t t = 0; t < tiles.size(); ++t) tileImages[t] = &images[sources[t]];
+                        Image atlas = buildAtlasImage(layout, page, tileImages, settings.padding, DefaultSlotColor(slot));
+                        images.push_back(atlas);
+                        it->second = static_cast<int>(images.size()) - 1;
+                    }
+                    pageSlots[slot] = it->second;
+                }
+                ++result.stats.atlasPages;
+
+                for (size_t g = 0; g < group.size(); ++g) {
+                    const AtlasRect& rect = layout.rects[materialTile[g]];
+                    if (rect.page != page) continue;
+                    size_t m = group[g];
+                    for (int slot = 0; slot < MAX_MATERIAL_MAPS; ++slot) {
+                        if (mask & (1u << slot)) materials[m][slot] = pageSlots[slot];
+                    }
+                    result.materialUv[m] = atlasUvTransform(rect, layout.width, layout.height);
+                    ++result.stats.atlasedMaterials;
+                }
+            }
+        }
+    }
+
+    // ---------- Освобождаем то, на что больше никто не ссылается ----------
+    std::vector<bool> used(images.size(), false);
+    for (const auto& slots : materials) {
+        for (int s : slots) if (s >= 0) used[s] = true;
+    }
+    for (size_t i = 0; i < images.size(); ++i) {
+        if (!used[i] && images[i].data) {
+            UnloadImage(images[i]);
+            images[i] = Image{};
+        }
+    }
+    result.stats.resultImages = static_cast<int>(std::count(used.begin(), used.end(), true));
+
+    return result;
+}
+
+} // namespace kalan
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "raylib.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace kalan {
+
+// ---------- ORM ----------
+
+// Источник одного канала ORM: канал channel изображения image или константа fallback
+struct OrmChannel {
+    const Image* image = nullptr;
+    int channel = 0;        // 0..3 = R, G, B, A
+    float fallback = 1.0f;
+};
+
+// Собрать RGBA8 текстуру R = AO, G = roughness, B = metallic (раскладка glTF).
+// Размер — наибольший из источников, меньшие масштабируются. Потокобезопасно.
+[[nodiscard]] Image packOrmImage(const OrmChannel& ao, const OrmChannel& roughness, const OrmChannel& metallic);
+
+// Хэш содержимого изображения (размер, формат, пиксели) для дедупликации
+[[nodiscard]] uint64_t hashImage(const Image& image);
+[[nodiscard]] bool imagesEqual(const Image& a, const Image& b);
+
+// ---------- Атлас ----------
+
+struct AtlasItem {
+    int width = 0;
+    int height = 0;
+};
+
+struct AtlasRect {
+    int page = 0;
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+struct AtlasLayout {
+    int width = 0;
+    int height = 0;
+    int pageCount = 0;
+    std::vector<AtlasRect> rects;   // в порядке входных элементов
+};
+
+// Shelf-упаковка. Берётся наименьшая степень двойки, в которую всё влезает на одну
+// страницу; если не влезает и в maxSize — несколько страниц maxSize x maxSize.
+// Элемент больше maxSize не упаковывается: pageCount == 0.
+[[nodiscard]] AtlasLayout packAtlas(const std::vector<AtlasItem>& items, int maxSize, int padding);
+
+// Собрать страницу атласа (RGBA8). tiles[i] == nullptr — прямоугольник заливается fill.
+// Края тайлов продлеваются в padding, чтобы билинейка и первые mip не тянули соседей.
+[[nodiscard]] Image buildAtlasImage(const AtlasLayout& layout, int page,
+                                    const std::vector<const Image*>& tiles, int padding, Color fill);
+
+// uv' = offset + uv * scale
+struct UvTransform {
+    Vector2 offset{0.0f, 0.0f};
+    Vector2 scale{1.0f, 1.0f};
+};
+
+[[nodiscard]] UvTransform atlasUvTransform(const AtlasRect& rect, int atlasWidth, int atlasHeight);
+// Применить transform после существующего преобразования base
+[[nodiscard]] UvTransform combineUvTransform(const UvTransform& base, const UvTransform& atlas);
+
+// UV за пределами [0, 1] означают тайлинг — такой меш в атлас класть нельзя
+[[nodiscard]] bool texcoordsInUnitRange(const float* texcoords, int vertexCount, float epsilon = 1e-3f);
+void remapTexcoords(float* texcoords, int vertexCount, const UvTransform& transform);
+
+// ---------- Упаковка материалов модели ----------
+
+// Слоты материала (MATERIAL_MAP_*): индекс в общем списке изображений или -1
+using MaterialTextureSlots = std::array<int, MAX_MATERIAL_MAPS>;
+
+struct TexturePackSettings {
+    bool packOrm = true;
+    bool atlas = true;
+    int maxTileSize = 256;      // крупнее — остаётся отдельной текстурой
+    int maxAtlasSize = 2048;
+    int padding = 4;
+};
+
+struct TexturePackStats {
+    int sourceImages = 0;
+    int duplicatesRemoved = 0;
+    int ormPacked = 0;          // собранных ORM текстур
+    int atlasedMaterials = 0;
+    int atlasPages = 0;
+    int resultImages = 0;       // уникальных изображений после упаковки
+};
+
+struct TexturePackResult {
+    std::vector<UvTransform> materialUv;    // преобразование UV для мешей каждого материала
+    std::vector<bool> materialOrm;          // ORM в слоте METALNESS, слоты ROUGHNESS и OCCLUSION пусты
+    TexturePackStats stats;
+};
+
+// Дедупликация одинаковых изображений, сборка ORM и атласы для мелких карт.
+// images дополняется новыми изображениями, ставшие ненужными освобождаются (data == nullptr);
+// materials переписываются на новые индексы. atlasable[i] — все меши материала i имеют UV в [0, 1].
+// Работает только с CPU данными.
+TexturePackResult packMaterialTextures(std::vector<Image>& images,
+                                       std::vector<MaterialTextureSlots>& materials,
+                                       const std::vector<bool>& atlasable,
+                                       const TexturePackSettings& settings);
+
+} // namespace kalan
@@ -0,0 +1,338 @@
+#include "VertexQuantization.hpp"
+#include "../rendering/PBRMaterial.hpp"
+#include "raymath.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+namespace kalan {
+
+namespace {
+
+// Типы атрибутов GL, которых нет среди констант rlgl
+constexpr int GlShort = 0x1402;
+constexpr int GlUnsignedShort = 0x1403;
+constexpr int GlHalfFloat = 0x140B;
+
+// С запасом относительно MAX_MESH_VERTEX_BUFFERS: UnloadMesh освобождает vboId[0..MAX)
+constexpr int VboSlotCount = 16;
+
+inline uint16_t quantizeUnorm16(float v) {
+    return static_cast<uint16_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 65535.0f));
+}
+
+inline float angleDegrees(const float a[3], const float b[3]) {
+    // atan2(|a x b|, a . b): acos от скалярного произведения во float теряет
+    // углы меньше ~0.02°, а ошибка snorm16 на порядок меньше
+    double cx = static_cast<double>(a[1]) * b[2] - static_cast<double>(a[2]) * b[1];
+    double cy = static_cast<double>(a[2]) * b[0] - static_cast<double>(a[0]) * b[2];
+    double cz = static_cast<double>(a[0]) * b[1] - static_cast<double>(a[1]) * b[0];
+    double d = static_cast<double>(a[0]) * b[0] + static_cast<double>(a[1]) * b[1] + static_cast<double>(a[2]) * b[2];
+    return static_cast<float>(std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), d) * RAD2DEG);
+}
+
+inline void normalize3(float v[3]) {
+    float len = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (len > 0.0f) {
+        v[0] /= len;
+        v[1] /= len;
+        v[2] /= len;
+    } else {
+        v[0] = 0.0f;
+        v[1] = 0.0f;
+        v[2] = 1.0f;
+    }
+}
+
+} // anonymous namespace
+
+// ============ Кодеки ============
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xffu) - 127 + 15;
+    uint32_t mantissa = bits & 0x7fffffu;
+
+    if (((bits >> 23) & 0xffu) == 0xffu) {
+        // Inf / NaN
+        return static_cast<uint16_t>(sign | 0x7c00u | (mantissa ? 0x200u : 0u));
+    }
+    if (exponent >= 31) {
+        return static_cast<uint16_t>(sign | 0x7c00u); // переполнение → Inf
+    }
+    if (exponent <= 0) {
+        // Денормализованные half (или ноль)
+        if (exponent < -10) return static_cast<uint16_t>(sign);
+        mantissa |= 0x800000u;
+        uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1u))) ++half;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    // Округление к ближайшему чётному
+    uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    uint32_t rest = mantissa & 0x1fffu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) ++half;
+    return static_cast<uint16_t>(half);
+}
+
+float halfToFloat(uint16_t value) {
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1fu;
+    uint32_t mantissa = value & 0x3ffu;
+    uint32_t bits;
+
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // Нормализуем денормал
+            exponent = 127 - 15 + 1;
+            while (!(mantissa & 0x400u)) {
+                mantissa <<= 1;
+                --exponent;
+            }
+            mantissa &= 0x3ffu;
+            bits = sign | (exponent << 23) | (mantissa << 13);
+        }
+    } else if (exponent == 31) {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+void encodeOctahedral(const float n[3], int16_t out[2]) {
+    float l1 = std::fabs(n[0]) + std::fabs(n[1]) + std::fabs(n[2]);
+    float u = l1 > 0.0f ? n[0] / l1 : 0.0f;
+    float v = l1 > 0.0f ? n[1] / l1 : 0.0f;
+    if (n[2] < 0.0f) {
+        // Нижняя полусфера отражается в углы квадрата
+        float tu = (1.0f - std::fabs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+        float tv = (1.0f - std::fabs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+        u = tu;
+        v = tv;
+    }
+    out[0] = static_cast<int16_t>(std::lround(std::clamp(u, -1.0f, 1.0f) * 32767.0f));
+    out[1] = static_cast<int16_t>(std::lround(std::clamp(v, -1.0f, 1.0f) * 32767.0f));
+}
+
+void decodeOctahedral(const int16_t in[2], float n[3]) {
+    // Должно совпадать с octDecode в pbr_packed.vs
+    float x = std::max(in[0] / 32767.0f, -1.0f);
+    float y = std::max(in[1] / 32767.0f, -1.0f);
+    float z = 1.0f - std::fabs(x) - std::fabs(y);
+    float t = std::max(-z, 0.0f);
+    x += x >= 0.0f ? -t : t;
+    y += y >= 0.0f ? -t : t;
+    n[0] = x;
+    n[1] = y;
+    n[2] = z;
+    normalize3(n);
+}
+
+// ============ Упаковка ============
+
+PackedMeshData packMesh(const Mesh& mesh, TexcoordEncoding texcoords) {
+    PackedMeshData data;
+    size_t vertexCount = static_cast<size_t>(mesh.vertexCount);
+    if (!mesh.vertices || vertexCount == 0) return data;
+
+    // AABB позиций и диапазон UV
+    float pmin[3] = {mesh.vertices[0], mesh.vertices[1], mesh.vertices[2]};
+    float pmax[3] = {pmin[0], pmin[1], pmin[2]};
+    for (size_t i = 1; i < vertexCount; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            pmin[k] = std::min(pmin[k], mesh.vertices[i * 3 + k]);
+            pmax[k] = std::max(pmax[k], mesh.vertices[i * 3 + k]);
+        }
+    }
+    float pscale[3];
+    for (int k = 0; k < 3; ++k) pscale[k] = pmax[k] > pmin[k] ? pmax[k] - pmin[k] : 1.0f;
+
+    float tmin[2] = {0.0f, 0.0f};
+    float tscale[2] = {1.0f, 1.0f};
+    if (mesh.texcoords && texcoords == TexcoordEncoding::Unorm16) {
+        float tmax[2] = {mesh.texcoords[0], mesh.texcoords[1]};
+        tmin[0] = tmax[0];
+        tmin[1] = tmax[1];
+        for (size_t i = 1; i < vertexCount; ++i) {
+            for (int k = 0; k < 2; ++k) {
+                tmin[k] = std::min(tmin[k], mesh.texcoords[i * 2 + k]);
+                tmax[k] = std::max(tmax[k], mesh.texcoords[i * 2 + k]);
+            }
+        }
+        for (int k = 0; k < 2; ++k) tscale[k] = tmax[k] > tmin[k] ? tmax[k] - tmin[k] : 1.0f;
+    }
+
+    data.info.positionOffset = {pmin[0], pmin[1], pmin[2]};
+    data.info.positionScale = {pscale[0], pscale[1], pscale[2]};
+    data.info.texcoordOffset = {tmin[0], tmin[1]};
+    data.info.texcoordScale = {tscale[0], tscale[1]};
+
+    data.texcoords = texcoords;
+    data.vertices.resize(vertexCount);
+    QuantizationError& err = data.error;
+
+    for (size_t i = 0; i < vertexCount; ++i) {
+        PackedVertex& pv = data.vertices[i];
+
+        for (int k = 0; k < 3; ++k) {
+            float p = mesh.vertices[i * 3 + k];
+            pv.position[k] = quantizeUnorm16((p - pmin[k]) / pscale[k]);
+            float decoded = pmin[k] + pv.position[k] / 65535.0f * pscale[k];
+            err.position = std::max(err.position, std::fabs(decoded - p));
+        }
+
+        float tangentSign = mesh.tangents ? mesh.tangents[i * 4 + 3] : 1.0f;
+        pv.position[3] = tangentSign < 0.0f ? 0 : 65535;
+
+        if (mesh.normals) {
+            float n[3] = {mesh.normals[i * 3], mesh.normals[i * 3 + 1], mesh.normals[i * 3 + 2]};
+            normalize3(n);
+            encodeOctahedral(n, pv.normal);
+            float d[3];
+            decodeOctahedral(pv.normal, d);
+            err.normalDegrees = std::max(err.normalDegrees, angleDegrees(n, d));
+        } else {
+            pv.normal[0] = pv.normal[1] = 0; // (0, 0, 1)
+        }
+
+        if (mesh.tangents) {
+            float t[3] = {mesh.tangents[i * 4], mesh.tangents[i * 4 + 1], mesh.tangents[i * 4 + 2]};
+            normalize3(t);
+            encodeOctahedral(t, pv.tangent);
+            float d[3];
+            decodeOctahedral(pv.tangent, d);
+            err.tangentDegrees = std::max(err.tangentDegrees, angleDegrees(t, d));
+        } else {
+            pv.tangent[0] = 32767; // (1, 0, 0)
+            pv.tangent[1] = 0;
+        }
+
+        if (mesh.texcoords) {
+            for (int k = 0; k < 2; ++k) {
+                float uv = mesh.texcoords[i * 2 + k];
+                float decoded;
+                if (texcoords == TexcoordEncoding::Half) {
+                    pv.texcoord[k] = floatToHalf(uv);
+                    decoded = halfToFloat(pv.texcoord[k]);
+                } else {
+                    pv.texcoord[k] = quantizeUnorm16((uv - tmin[k]) / tscale[k]);
+                    decoded = tmin[k] + pv.texcoord[k] / 65535.0f * tscale[k];
+                }
+                err.texcoord = std::max(err.texcoord, std::fabs(decoded - uv));
+            }
+        } else {
+            pv.texcoord[0] = pv.texcoord[1] = 0;
+        }
+
+        if (mesh.colors) {
+            std::memcpy(pv.color, mesh.colors + i * 4, 4);
+        } else {
+            pv.color[0] = pv.color[1] = pv.color[2] = pv.color[3] = 255;
+        }
+    }
+
+    if (mesh.indices) {
+        data.indices.assign(mesh.indices, mesh.indices + mesh.triangleCount * 3);
+    }
+    return data;
+}
+
+Mesh uploadPackedMesh(const PackedMeshData& data) {
+    Mesh mesh = {0};
+    mesh.vertexCount = static_cast<int>(data.vertices.size());
+    mesh.triangleCount = data.indices.empty() ? mesh.vertexCount / 3 : static_cast<int>(data.indices.size() / 3);
+
+    if (!data.indices.empty()) {
+        size_t bytes = data.indices.size() * sizeof(unsigned short);
+        mesh.indices = (unsigned short*)MemAlloc(static_cast<unsigned int>(bytes));
+        std::memcpy(mesh.indices, data.indices.data(), bytes);
+    }
+
+    mesh.vboId = (unsigned int*)MemAlloc(VboSlotCount * sizeof(unsigned int));
+    mesh.vaoId = rlLoadVertexArray();
+    rlEnableVertexArray(mesh.vaoId);
+
+    constexpr int stride = sizeof(PackedVertex);
+    mesh.vboId[0] = rlLoadVertexBuffer(data.vertices.data(),
+                                       static_cast<int>(data.vertices.size() * stride), false);
+
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION, 4, GlUnsignedShort, true,
+                         stride, offsetof(PackedVertex, position));
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION);
+
+    if (data.texcoords == TexcoordEncoding::Half) {
+        rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD, 2, GlHalfFloat, false,
+                             stride, offsetof(PackedVertex, texcoord));
+    } else {
+        rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD, 2, GlUnsignedShort, true,
+                             stride, offsetof(PackedVertex, texcoord));
+    }
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD);
+
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL, 2, GlShort, true,
+                         stride, offsetof(PackedVertex, normal));
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL);
+
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TANGENT, 2, GlShort, true,
+                         stride, offsetof(PackedVertex, tangent));
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TANGENT);
+
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR, 4, RL_UNSIGNED_BYTE, true,
+                         stride, offsetof(PackedVertex, color));
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR);
+
+    if (!data.indices.empty()) {
+        mesh.vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_INDICES] = rlLoadVertexBufferElement(
+            data.indices.data(), static_cast<int>(data.indices.size() * sizeof(unsigned short)), false);
+    }
+
+    rlDisableVertexArray();
+    return mesh;
+}
+
+// ============ Отрисовка ============
+
+void setPackedMeshUniforms(const Shader& shader, const PackedMeshInfo& info) {
+    // Локации кэшируются на шейдер — glGetUniformLocation на каждый меш слишком дорог
+    static unsigned int cachedShader = 0;
+    static int locPosOffset = -1, locPosScale = -1, locUvOffset = -1, locUvScale = -1;
+    if (cachedShader != shader.id) {
+        cachedShader = shader.id;
+        locPosOffset = GetShaderLocation(shader, "positionOffset");
+        locPosScale = GetShaderLocation(shader, "positionScale");
+        locUvOffset = GetShaderLocation(shader, "texcoordOffset");
+        locUvScale = GetShaderLocation(shader, "texcoordScale");
+    }
+
+    SetShaderValue(shader, locPosOffset, &info.positionOffset, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locPosScale, &info.positionScale, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, locUvOffset, &info.texcoordOffset, SHADER_UNIFORM_VEC2);
+    SetShaderValue(shader, locUvScale, &info.texcoordScale, SHADER_UNIFORM_VEC2);
+}
+
+void drawPackedModel(const Model& model, const PackedModelInfo& packed, const Matrix& transform) {
+    Matrix world = MatrixMultiply(model.transform, transform);
+    for (int m = 0; m < model.meshCount; ++m) {
+        const Material& material = model.materials[model.meshMaterial[m]];
+        setPackedMeshUniforms(material.shader, packed.meshes[m]);
+        PBRMaterial::applyOrmUniform(material);
+        DrawMesh(model.meshes[m], material, world);
+    }
+}
+
+} // namespace kalan
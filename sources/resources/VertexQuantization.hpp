@@ -0,0 +1,103 @@
+#pragma once
+
+#include "raylib.h"
+#include <cstdint>
+#include <vector>
+
+namespace kalan {
+
+// Формат вершин при upload
+enum class VertexFormat {
+    Float32,    // отдельные float-потоки raylib (~52+ байт на вершину)
+    Packed      // одна interleaved вершина PackedVertex, 24 байта
+};
+
+enum class TexcoordEncoding {
+    Half,       // half-float, без деквантизации; точность падает при |uv| > 1
+    Unorm16     // unorm16 относительно диапазона UV меша
+};
+
+// Сжатая вершина:
+//   position — unorm16 относительно AABB меша, w хранит знак тангента (0 → -1, 1 → +1)
+//   normal, tangent — octahedral snorm16
+//   texcoord — half или unorm16
+//   color — rgba8
+struct PackedVertex {
+    uint16_t position[4];
+    int16_t normal[2];
+    int16_t tangent[2];
+    uint16_t texcoord[2];
+    uint8_t color[4];
+};
+static_assert(sizeof(PackedVertex) == 24, "PackedVertex must stay tightly packed");
+
+// Параметры деквантизации, передаются в шейдер uniform'ами на каждый меш
+struct PackedMeshInfo {
+    Vector3 positionOffset{0, 0, 0};
+    Vector3 positionScale{1, 1, 1};
+    Vector2 texcoordOffset{0, 0};
+    Vector2 texcoordScale{1, 1};
+};
+
+// Фактическая ошибка квантования, измеренная при упаковке
+struct QuantizationError {
+    float position = 0.0f;      // максимум по осям, в единицах меша
+    float normalDegrees = 0.0f;
+    float tangentDegrees = 0.0f;
+    float texcoord = 0.0f;
+};
+
+// Результат упаковки на CPU (считается на воркере)
+struct PackedMeshData {
+    std::vector<PackedVertex> vertices;
+    std::vector<unsigned short> indices;
+    PackedMeshInfo info;
+    QuantizationError error;
+    TexcoordEncoding texcoords = TexcoordEncoding::Unorm16;
+};
+
+// ---------- Кодеки (используются упаковкой и проверкой ошибок) ----------
+
+uint16_t floatToHalf(float value);
+float halfToFloat(uint16_t value);
+
+// Единичный вектор → два snorm16 (octahedral)
+void encodeOctahedral(const float n[3], int16_t out[2]);
+void decodeOctahedral(const int16_t in[2], float n[3]);
+
+// Теоретическая граница ошибки unorm16 на отрезке длины extent (без учёта округления float)
+constexpr float unorm16ErrorBound(float extent) { return extent / 65535.0f * 0.5f; }
+
+// Граница ошибки half для значения value: половина шага мантиссы (2^-11 относительно),
+// для денормалов — половина наименьшего шага 2^-24
+constexpr float halfErrorBound(float value) {
+    const float magnitude = value < 0.0f ? -value : value;
+    return magnitude * 0.00048828125f > 2.98023224e-8f ? magnitude * 0.00048828125f : 2.98023224e-8f;
+}
+
+// Граница угловой ошибки octahedral snorm16, в градусах. Округление сдвигает точку
+// квадрата не больше чем на полшага 1/32767 по каждой оси, точку октаэдра — не больше
+// чем на шаг * sqrt(1.5); её длина не меньше 1/sqrt(3), отсюда угол <= шаг * sqrt(4.5).
+constexpr float octahedralErrorBoundDegrees() { return 2.12132034f / 32767.0f * 57.2957795f; }
+
+// ---------- Упаковка и upload ----------
+
+[[nodiscard]] PackedMeshData packMesh(const Mesh& mesh, TexcoordEncoding texcoords = TexcoordEncoding::Unorm16);
+
+// Создать VAO с interleaved буфером (главный поток). CPU-копия индексов
+// сохраняется: DrawMesh по ней решает, рисовать ли индексированно.
+[[nodiscard]] Mesh uploadPackedMesh(const PackedMeshData& data);
+
+// Деквантизация для всех мешей модели
+struct PackedModelInfo {
+    std::vector<PackedMeshInfo> meshes;
+    std::vector<QuantizationError> errors;
+};
+
+// Выставить uniform'ы деквантизации перед DrawMesh меша в формате Packed
+void setPackedMeshUniforms(const Shader& shader, const PackedMeshInfo& info);
+
+// Нарисовать модель, все меши которой в формате Packed
+void drawPackedModel(const Model& model, const PackedModelInfo& packed, const Matrix& transform);
+
+} // namespace kalan
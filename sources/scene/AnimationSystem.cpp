@@ -0,0 +1,184 @@
+#include "AnimationSystem.hpp"
+#include "../resources/ParallelLoader.hpp"
+#include "../core/Profiler.hpp"
+#include "rlgl.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+namespace kalan {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void SamplePose(const ModelAnimations& animations, int clip, float time, ClipCursor& cursor, Pose& out) {
+    if (clip >= 0 && clip < static_cast<int>(animations.clips.size())) {
+        sampleClip(animations.clips[clip], animations.skeleton, time, out, &cursor);
+    } else {
+        out.assign(animations.skeleton.bindPose.begin(), animations.skeleton.bindPose.end());
+    }
+}
+
+void AdvanceTime(const ModelAnimations& animations, int clip, bool loop, float dt, float& time) {
+    if (clip < 0 || clip >= static_cast<int>(animations.clips.size())) return;
+    const float duration = animations.clips[clip].duration;
+    if (duration <= 0.0f) {
+        time = 0.0f;
+        return;
+    }
+    time += dt;
+    if (loop) {
+        time = std::fmod(time, duration);
+        if (time < 0.0f) time += duration;
+    } else {
+        time = std::clamp(time, 0.0f, duration);
+    }
+}
+
+// Время, поза и палитра одного аниматора. Пишет только в сам аниматор.
+void EvaluateAnimator(Animator& animator, float dt) {
+    const ModelAnimations& animations = *animator.animations;
+    const Skeleton& skeleton = animations.skeleton;
+
+    if (animator.playing) {
+        const float step = dt * animator.speed;
+        AdvanceTime(animations, animator.clip, animator.loop, step, animator.time);
+        if (animator.previousClip >= 0) {
+            AdvanceTime(animations, animator.previousClip, animator.loop, step, animator.previousTime);
+            animator.fade = animator.fadeDuration > 0.0f
+                ? std::min(1.0f, animator.fade + dt / animator.fadeDuration) : 1.0f;
+            if (animator.fade >= 1.0f) animator.previousClip = -1;
+        }
+    }
+
+    SamplePose(animations, animator.clip, animator.time, animator.cursor, animator.pose);
+    if (animator.previousClip >= 0) {
+        SamplePose(animations, animator.previousClip, animator.previousTime, animator.previousCursor, animator.blendPose);
+        blendPoses(animator.blendPose, animator.pose, animator.fade, animator.pose);
+    }
+
+    animator.skinning.resize(skeleton.getJointCount());
+    computeModelMatrices(skeleton, animator.pose, animator.skinning.data());
+    computeSkinningMatrices(skeleton, animator.skinning.data(), animator.skinning.data());
+}
+
+} // anonymous namespace
+
+// ============ Управление ============
+
+void AnimationSystem::play(Animator& animator, int clip, float fadeSeconds, bool loop) {
+    if (fadeSeconds > 0.0f && animator.clip >= 0 && clip != animator.clip) {
+        // Новый кроссфейд во время старого начинается от текущего клипа
+        animator.previousClip = animator.clip;
+        animator.previousTime = animator.time;
+        std::swap(animator.cursor, animator.previousCursor);
+        animator.fade = 0.0f;
+        animator.fadeDuration = fadeSeconds;
+    } else {
+        animator.previousClip = -1;
+        animator.fade = 1.0f;
+    }
+    animator.clip = clip;
+    animator.time = 0.0f;
+    animator.loop = loop;
+    animator.playing = true;
+}
+
+bool AnimationSystem::play(Animator& animator, std::string_view name, float fadeSeconds, bool loop) {
+    if (!animator.animations) return false;
+    const int clip = animator.animations->findClip(name);
+    if (clip < 0) return false;
+    play(animator, clip, fadeSeconds, loop);
+    return true;
+}
+
+// ============ Кадр ============
+
+AnimationSystem::Stats AnimationSystem::update(float dt, ImageThreadPool* pool) {
+    KALAN_PROFILE_ZONE("AnimationSystem::update");
+    Stats stats;
+
+    animators_.clear();
+    models_.clear();
+    for (auto [entity, animator] : registry_.view<Animator>().each()) {
+        if (!animator.animations) continue;
+        animators_.push_back(&animator);
+        const auto* renderer = registry_.try_get<MeshRenderer>(entity);
+        models_.push_back(renderer && renderer->visible && renderer->model ? renderer->model.get() : nullptr);
+        stats.joints += animator.animations->skeleton.getJointCount();
+    }
+    stats.animators = animators_.size();
+
+    auto start = Clock::now();
+    auto evaluate = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) EvaluateAnimator(*animators_[i], dt);
+    };
+    if (pool && animators_.size() >= settings_.parallelThreshold) {
+        pool->parallelFor(animators_.size(), settings_.parallelChunk, evaluate);
+    } else {
+        evaluate(0, animators_.size());
+    }
+    stats.evaluateMs = MsSince(start);
+
+    start = Clock::now();
+    cpuSkinned_.clear();
+    for (size_t i = 0; i < animators_.size(); ++i) {
+        raylib::Model* model = models_[i];
+        if (!model || std::find(cpuSkinned_.begin(), cpuSkinned_.end(), model) != cpuSkinned_.end()) continue;
+        cpuSkinned_.push_back(model);
+        skinOnCpu(*animators_[i], *model, pool, stats);
+    }
+    stats.skinningMs = MsSince(start);
+
+    lastStats_ = stats;
+    return stats;
+}
+
+void AnimationSystem::skinOnCpu(const Animator& animator, raylib::Model& model, ImageThreadPool* pool, Stats& stats) {
+    bool packed = false;
+    for (int m = 0; m < model.meshCount; ++m) {
+        Mesh& mesh = model.meshes[m];
+        if (!mesh.boneIds || !mesh.boneWeights || !mesh.vertices || mesh.vaoId == 0) continue;
+        if (mesh.boneCount > static_cast<int>(animator.skinning.size())) continue;
+        // Скиннинг шейдер сделает это сам по палитре из DrawList
+        const Shader& shader = model.materials[model.meshMaterial[m]].shader;
+        if (shader.locs && shader.locs[SHADER_LOC_BONE_MATRICES] != -1) continue;
+
+        if (!packed) {
+            palette_.resize(animator.skinning.size());
+            packSkinPalette(animator.skinning.data(), static_cast<int>(animator.skinning.size()), palette_.data());
+            packed = true;
+        }
+
+        // Буферы результата живут в меше: их освобождает UnloadMesh
+        const size_t vertexCount = static_cast<size_t>(mesh.vertexCount);
+        if (!mesh.animVertices) mesh.animVertices = (float*)MemAlloc(vertexCount * 3 * sizeof(float));
+        if (mesh.normals && !mesh.animNormals) mesh.animNormals = (float*)MemAlloc(vertexCount * 3 * sizeof(float));
+
+        const SkinningInput input{mesh.vertices, mesh.normals, mesh.boneIds, mesh.boneWeights, vertexCount};
+        auto skin = [&](size_t begin, size_t end) {
+            skinVertices(input, palette_.data(), mesh.animVertices, mesh.animNormals, begin, end);
+        };
+        if (pool && vertexCount >= settings_.skinningChunk * 2) {
+            pool->parallelFor(vertexCount, settings_.skinningChunk, skin);
+        } else {
+            skin(0, vertexCount);
+        }
+
+        UpdateMeshBuffer(mesh, RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION, mesh.animVertices,
+                         static_cast<int>(vertexCount * 3 * sizeof(float)), 0);
+        if (mesh.animNormals) {
+            UpdateMeshBuffer(mesh, RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL, mesh.animNormals,
+                             static_cast<int>(vertexCount * 3 * sizeof(float)), 0);
+        }
+        stats.cpuSkinnedVertices += vertexCount;
+    }
+}
+
+} // namespace kalan
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Components.hpp"
+#include "../animation/Skinning.hpp"
+#include <entt/entt.hpp>
+#include <string_view>
+#include <vector>
+
+namespace kalan {
+
+class ImageThreadPool;
+
+// Оценка поз сущностей с Animator: сэмплинг клипов, кроссфейд и палитра скиннинга.
+// Аниматоры независимы и оцениваются параллельно, по чанку на задачу.
+// Модели, которые рисуются не скиннинг шейдером (он не загружен или скелет больше
+// MaxGpuSkinningJoints), скиннятся на CPU — SIMD, по вершинам на воркерах — и их
+// позиции и нормали перезаливаются в VBO. Тангенты на CPU пути не скиннятся.
+// Модель, общая для нескольких аниматоров, на CPU пути показывает позу первого.
+class AnimationSystem {
+public:
+    struct Settings {
+        size_t parallelThreshold = 8;       // аниматоров; меньше — в вызывающем потоке
+        size_t parallelChunk = 4;
+        size_t skinningChunk = 4096;        // вершин на задачу CPU скиннинга
+    };
+
+    struct Stats {
+        size_t animators = 0;
+        size_t joints = 0;
+        size_t cpuSkinnedVertices = 0;
+        double evaluateMs = 0.0;
+        double skinningMs = 0.0;
+    };
+
+    explicit AnimationSystem(entt::registry& registry) : registry_(registry) {}
+    AnimationSystem(entt::registry& registry, const Settings& settings)
+        : registry_(registry), settings_(settings) {}
+
+    AnimationSystem(const AnimationSystem&) = delete;
+    AnimationSystem& operator=(const AnimationSystem&) = delete;
+
+    // Переключить клип; fadeSeconds > 0 — кроссфейд из текущего. clip = -1 — поза покоя.
+    static void play(Animator& animator, int clip, float fadeSeconds = 0.0f, bool loop = true);
+    // По имени; false, если клипа нет (аниматор не меняется)
+    static bool play(Animator& animator, std::string_view name, float fadeSeconds = 0.0f, bool loop = true);
+
+    // Продвинуть время на dt и пересчитать палитры. pool == nullptr — однопоточно.
+    // Только главный поток: CPU путь обновляет буферы мешей.
+    Stats update(float dt, ImageThreadPool* pool = nullptr);
+
+    void setSettings(const Settings& settings) { settings_ = settings; }
+    [[nodiscard]] const Settings& getSettings() const noexcept { return settings_; }
+    [[nodiscard]] const Stats& getLastStats() const noexcept { return lastStats_; }
+
+private:
+    void skinOnCpu(const Animator& animator, raylib::Model& model, ImageThreadPool* pool, Stats& stats);
+
+    entt::registry& registry_;
+    Settings settings_;
+    Stats lastStats_;
+
+    std::vector<Animator*> animators_;
+    std::vector<raylib::Model*> models_;
+    std::vector<raylib::Model*> cpuSkinned_;    // модели, уже скиннутые в этом кадре
+    std::vector<SkinMatrix> palette_;
+};
+
+} // namespace kalan
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "raylib-cpp.hpp"
+#include "raymath.h"
+#include "../rendering/Lighting.hpp"
+#include "../rendering/OcclusionBuffer.hpp"
+#include "../animation/AnimationClip.hpp"
+#include <entt/entt.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace kalan {
+
+struct PackedModelInfo;
+class ModelLods;
+
+// Локальная трансформация относительно родителя.
+// Менять через registry.replace/patch — иначе TransformSystem не увидит изменения.
+struct LocalTransform {
+    Vector3 translation{0.0f, 0.0f, 0.0f};
+    Quaternion rotation{0.0f, 0.0f, 0.0f, 1.0f};
+    Vector3 scale{1.0f, 1.0f, 1.0f};
+
+    [[nodiscard]] Matrix toMatrix() const {
+        // Порядок как в DrawModelEx: scale, затем rotation, затем translation
+        Matrix m = MatrixMultiply(MatrixScale(scale.x, scale.y, scale.z), QuaternionToMatrix(rotation));
+        return MatrixMultiply(m, MatrixTranslate(translation.x, translation.y, translation.z));
+    }
+};
+
+// Мировая матрица, пишется только TransformSystem
+struct WorldTransform {
+    Matrix matrix = MatrixIdentity();
+};
+
+// Связи иерархии (интрузивный список детей). Менять через TransformSystem::setParent.
+struct Hierarchy {
+    entt::entity parent = entt::null;
+    entt::entity firstChild = entt::null;
+    entt::entity nextSibling = entt::null;
+    entt::entity prevSibling = entt::null;
+    uint32_t childCount = 0;
+};
+
+// Модель (или один её меш), рисуемая с WorldTransform сущности
+struct MeshRenderer {
+    std::shared_ptr<raylib::Model> model;
+    int meshIndex = -1;             // -1 — все меши модели
+    Color tint = WHITE;
+    bool visible = true;
+    std::shared_ptr<PackedModelInfo> packed;   // для VertexFormat::Packed
+    std::shared_ptr<const ModelLods> lods;      // LoadedModel::lods; уровень выбирает RenderSystem
+    int lodLevel = 0;               // уровень прошлого кадра (гистерезис), пишет RenderSystem
+};
+
+// Локальные bounds меша сущности — для отсечения по фрустуму.
+// Сущности без MeshBounds не отсекаются.
+struct MeshBounds {
+    BoundingBox local{};
+};
+
+// Окклюдер сущности (LoadedModel::occluders) — рисуется в буфер OcclusionSystem
+// с WorldTransform сущности (и model.transform её MeshRenderer)
+struct Occluder {
+    std::shared_ptr<const ModelOccluders> occluders;
+    int meshIndex = -1;             // -1 — все меши модели
+};
+
+// Узел импортированной сцены (имя узла ассета)
+struct SceneNodeName {
+    std::string name;
+};
+
+// Проигрывание клипов скелета модели MeshRenderer. Клип менять через
+// AnimationSystem::play; skinning пишет только AnimationSystem.
+struct Animator {
+    std::shared_ptr<const ModelAnimations> animations;
+    int clip = -1;                  // -1 — поза покоя
+    float time = 0.0f;              // в секундах
+    float speed = 1.0f;
+    bool loop = true;
+    bool playing = true;
+
+    // Кроссфейд: предыдущий клип продолжает идти, пока вес нового растёт до 1
+    int previousClip = -1;
+    float previousTime = 0.0f;
+    float fade = 1.0f;              // вес текущего клипа
+    float fadeDuration = 0.0f;
+
+    // Палитра скиннинга (пространство модели), по суставу на элемент
+    std::vector<Matrix> skinning;
+
+    // Рабочие буферы оценки позы — переиспользуются между кадрами
+    Pose pose;
+    Pose blendPose;
+
+    // Позиции чтения сжатых клипов (текущего и предыдущего при кроссфейде)
+    ClipCursor cursor;
+    ClipCursor previousCursor;
+};
+
+// Источник света; position/direction задаются в локальных координатах сущности
+struct LightComponent {
+    Light light;
+    int slot = -1;                  // индекс в LightingSystem, выдаётся SceneLights::sync
+};
+
+} // namespace kalan
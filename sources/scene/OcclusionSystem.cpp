@@ -0,0 +1,87 @@
+#include "OcclusionSystem.hpp"
+#include "../core/Profiler.hpp"
+#include "rlgl.h"
+#include <algorithm>
+#include <chrono>
+
+namespace kalan {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // anonymous namespace
+
+void OcclusionSystem::setSettings(const Settings& settings) {
+    settings_ = settings;
+    buffer_.setSettings(settings.buffer);
+}
+
+OcclusionSystem::Stats OcclusionSystem::update(ImageThreadPool* pool) {
+    const Matrix view = rlGetMatrixModelview();
+    const Matrix inverse = MatrixInvert(view);
+    return update(MatrixMultiply(view, rlGetMatrixProjection()), {inverse.m12, inverse.m13, inverse.m14}, pool);
+}
+
+OcclusionSystem::Stats OcclusionSystem::update(const Matrix& viewProjection, Vector3 cameraPosition,
+                                               ImageThreadPool* pool) {
+    KALAN_PROFILE_ZONE("OcclusionSystem::update");
+    Stats stats;
+    auto start = Clock::now();
+
+    const Frustum frustum = Frustum::fromMatrix(viewProjection);
+    candidates_.clear();
+    for (auto [entity, occluder, world] : registry_.view<const Occluder, const WorldTransform>().each()) {
+        if (!occluder.occluders) continue;
+        Matrix transform = world.matrix;
+        if (const auto* renderer = registry_.try_get<MeshRenderer>(entity); renderer && renderer->model) {
+            transform = MatrixMultiply(renderer->model->transform, world.matrix);
+        }
+
+        const std::vector<OccluderMesh>& meshes = occluder.occluders->meshes;
+        const size_t first = occluder.meshIndex < 0 ? 0 : static_cast<size_t>(occluder.meshIndex);
+        const size_t last = occluder.meshIndex < 0 ? meshes.size() : std::min(meshes.size(), first + 1);
+        for (size_t i = first; i < last; ++i) {
+            if (meshes[i].isEmpty()) continue;
+            const BoundingBox box = transformBounds(meshes[i].bounds, transform);
+            if (!frustum.intersects(box)) continue;
+
+            // Внутри bounds камера видит окклюдер во весь экран
+            const Vector3 center = Vector3Scale(Vector3Add(box.min, box.max), 0.5f);
+            const float diagonal = Vector3Distance(box.min, box.max);
+            const float distance = Vector3Distance(center, cameraPosition);
+            const float screenSize = distance > diagonal * 0.5f ? diagonal / distance : 1e30f;
+            if (screenSize < settings_.minScreenSize) continue;
+            candidates_.push_back({{&meshes[i], transform}, screenSize});
+        }
+    }
+    stats.candidates = static_cast<int>(candidates_.size());
+
+    std::sort(candidates_.begin(), candidates_.end(),
+              [](const Candidate& a, const Candidate& b) { return a.screenSize > b.screenSize; });
+    instances_.clear();
+    size_t triangles = 0;
+    for (const Candidate& candidate : candidates_) {
+        if (static_cast<int>(instances_.size()) >= settings_.maxOccluders) break;
+        const size_t count = candidate.instance.mesh->getTriangleCount();
+        if (triangles + count > settings_.maxTriangles) continue;
+        triangles += count;
+        instances_.push_back(candidate.instance);
+    }
+    stats.occluders = static_cast<int>(instances_.size());
+    stats.selectMs = MsSince(start);
+
+    start = Clock::now();
+    const OcclusionBuffer::Stats bufferStats = buffer_.render(viewProjection, instances_.data(), instances_.size(), pool);
+    stats.triangles = bufferStats.triangles;
+    stats.renderMs = MsSince(start);
+
+    lastStats_ = stats;
+    return stats;
+}
+
+} // namespace kalan
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Components.hpp"
+#include "RenderSystem.hpp"
+#include "../rendering/OcclusionBuffer.hpp"
+#include <entt/entt.hpp>
+#include <vector>
+
+namespace kalan {
+
+class ImageThreadPool;
+
+// Буфер перекрытия кадра из сущностей с Occluder и WorldTransform. Окклюдеры в
+// фрустуме выбираются по экранному размеру (диагональ bounds к расстоянию до камеры)
+// от крупных к мелким, пока не кончится бюджет треугольников.
+// RenderSystem::setOcclusion(&getBuffer()) отсекает по нему сущности с MeshBounds.
+class OcclusionSystem {
+public:
+    struct Settings {
+        size_t maxTriangles = 16384;        // бюджет окклюдеров на кадр
+        int maxOccluders = 128;
+        float minScreenSize = 0.1f;         // диагональ / расстояние; меньше — не рисуется
+        OcclusionBuffer::Settings buffer;
+    };
+
+    struct Stats {
+        int candidates = 0;                 // окклюдеры в фрустуме
+        int occluders = 0;                  // нарисованы
+        int triangles = 0;
+        double selectMs = 0.0;
+        double renderMs = 0.0;
+    };
+
+    explicit OcclusionSystem(entt::registry& registry) : registry_(registry) {}
+    OcclusionSystem(entt::registry& registry, const Settings& settings)
+        : registry_(registry), settings_(settings), buffer_(settings.buffer) {}
+
+    OcclusionSystem(const OcclusionSystem&) = delete;
+    OcclusionSystem& operator=(const OcclusionSystem&) = delete;
+
+    // Вызывать внутри BeginMode3D: матрицы и позиция камеры берутся из rlgl
+    Stats update(ImageThreadPool* pool = nullptr);
+    Stats update(const Matrix& viewProjection, Vector3 cameraPosition, ImageThreadPool* pool = nullptr);
+
+    [[nodiscard]] const OcclusionBuffer& getBuffer() const noexcept { return buffer_; }
+
+    void setSettings(const Settings& settings);
+    [[nodiscard]] const Settings& getSettings() const noexcept { return settings_; }
+    [[nodiscard]] const Stats& getLastStats() const noexcept { return lastStats_; }
+
+private:
+    struct Candidate {
+        OccluderInstance instance;
+        float screenSize = 0.0f;
+    };
+
+    entt::registry& registry_;
+    Settings settings_;
+    OcclusionBuffer buffer_;
+    Stats lastStats_;
+
+    std::vector<Candidate> candidates_;
+    std::vector<OccluderInstance> instances_;
+};
+
+} // namespace kalan
@@ -0,0 +1,200 @@
+#include "RenderSystem.hpp"
+#include "../rendering/DrawList.hpp"
+#include "../rendering/InstancedRenderer.hpp"
+#include "../rendering/OcclusionBuffer.hpp"
+#include "../rendering/PBRMaterial.hpp"
+#include "../resources/ModelLod.hpp"
+#include "../resources/VertexQuantization.hpp"
+#include "../core/Profiler.hpp"
+#include "rlgl.h"
+#include <algorithm>
+#include <cmath>
+
+namespace kalan {
+
+// ============ Фрустум ============
+
+Frustum Frustum::fromMatrix(const Matrix& m) {
+    // Строки матрицы в нотации column-vector (raymath хранит по столбцам)
+    const Vector4 row0{m.m0, m.m4, m.m8, m.m12};
+    const Vector4 row1{m.m1, m.m5, m.m9, m.m13};
+    const Vector4 row2{m.m2, m.m6, m.m10, m.m14};
+    const Vector4 row3{m.m3, m.m7, m.m11, m.m15};
+
+    auto add = [](Vector4 a, Vector4 b) { return Vector4{a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w}; };
+    auto sub = [](Vector4 a, Vector4 b) { return Vector4{a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w}; };
+
+    Frustum f;
+    f.planes = {add(row3, row0), sub(row3, row0),     // left, right
+                add(row3, row1), sub(row3, row1),     // bottom, top
+                add(row3, row2), sub(row3, row2)};    // near, far
+    for (Vector4& p : f.planes) {
+        float len = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+        if (len > 0.0f) p = {p.x / len, p.y / len, p.z / len, p.w / len};
+    }
+    return f;
+}
+
+bool Frustum::intersects(const BoundingBox& box) const {
+    for (const Vector4& p : planes) {
+        // Вершина AABB, дальше всех продвинутая вдоль нормали плоскости
+        float x = p.x >= 0.0f ? box.max.x : box.min.x;
+        float y = p.y >= 0.0f ? box.max.y : box.min.y;
+        float z = p.z >= 0.0f ? box.max.z : box.min.z;
+        if (p.x * x + p.y * y + p.z * z + p.w < 0.0f) return false;
+    }
+    return true;
+}
+
+BoundingBox transformBounds(const BoundingBox& local, const Matrix& m) {
+    // Arvo: центр переносится матрицей, полуразмеры — модулем её 3x3 части
+    Vector3 center = Vector3Scale(Vector3Add(local.min, local.max), 0.5f);
+    Vector3 extent = Vector3Scale(Vector3Subtract(local.max, local.min), 0.5f);
+    Vector3 c = Vector3Transform(center, m);
+    Vector3 e{
+        std::fabs(m.m0) * extent.x + std::fabs(m.m4) * extent.y + std::fabs(m.m8) * extent.z,
+        std::fabs(m.m1) * extent.x + std::fabs(m.m5) * extent.y + std::fabs(m.m9) * extent.z,
+        std::fabs(m.m2) * extent.x + std::fabs(m.m6) * extent.y + std::fabs(m.m10) * extent.z,
+    };
+    return {Vector3Subtract(c, e), Vector3Add(c, e)};
+}
+
+// ============ RenderSystem ============
+
+namespace {
+
+// Наибольший масштаб по осям — ошибка LOD в мире растёт вместе с ним
+float MaxAxisScale(const Matrix& m) {
+    const float x = m.m0 * m.m0 + m.m1 * m.m1 + m.m2 * m.m2;
+    const float y = m.m4 * m.m4 + m.m5 * m.m5 + m.m6 * m.m6;
+    const float z = m.m8 * m.m8 + m.m9 * m.m9 + m.m10 * m.m10;
+    return std::sqrt(std::max({x, y, z}));
+}
+
+const Mesh& LodMesh(const MeshRenderer& renderer, int meshIndex, int level) {
+    if (!renderer.lods) return renderer.model->meshes[meshIndex];
+    return renderer.lods->getMesh(*renderer.model, meshIndex, level);
+}
+
+const PackedMeshInfo* LodPacked(const MeshRenderer& renderer, int meshIndex, int level) {
+    if (renderer.lods) return renderer.lods->getPackedInfo(meshIndex, level, renderer.packed.get());
+    return renderer.packed ? &renderer.packed->meshes[meshIndex] : nullptr;
+}
+
+} // anonymous namespace
+
+RenderSystem::Stats RenderSystem::submit(DrawList& drawList) {
+    const Matrix view = rlGetMatrixModelview();
+    const Matrix projection = rlGetMatrixProjection();
+    const Matrix inverse = MatrixInvert(view);
+
+    // Экранная ошибка LOD — по текущей проекции и размеру кадра
+    if (projection.m5 > 0.0f) lodParams_.fovY = 2.0f * std::atan(1.0f / projection.m5) * RAD2DEG;
+    lodParams_.screenHeight = static_cast<float>(GetRenderHeight());
+
+    return submit(drawList, Frustum::fromMatrix(MatrixMultiply(view, projection)),
+                  {inverse.m12, inverse.m13, inverse.m14});
+}
+
+RenderSystem::Stats RenderSystem::submit(DrawList& drawList, const Frustum& frustum, Vector3 cameraPosition) {
+    KALAN_PROFILE_ZONE("RenderSystem::submit");
+    Stats stats;
+    InstanceBatcher* batcher =
+        batcher_ && PBRMaterial::isShaderLoaded(PBRShaderVariant::Instanced) ? batcher_ : nullptr;
+    if (batcher) batcher->begin();
+
+    auto view = registry_.view<MeshRenderer, const WorldTransform>();
+    for (auto [entity, renderer, world] : view.each()) {
+        if (!renderer.visible || !renderer.model) continue;
+        const raylib::Model& model = *renderer.model;
+        const Matrix transform = MatrixMultiply(model.transform, world.matrix);
+
+        const auto* bounds = registry_.try_get<MeshBounds>(entity);
+        BoundingBox box{};
+        if (bounds) box = transformBounds(bounds->local, transform);
+
+        if (culling_ && bounds) {
+            if (!frustum.intersects(box)) {
+                ++stats.culled;
+                continue;
+            }
+            if (occlusion_ && !occlusion_->isVisible(box)) {
+                ++stats.occluded;
+                continue;
+            }
+        }
+
+        // Уровень LOD по экранной ошибке; расстояние — до центра bounds (или до начала
+        // координат сущности), с гистерезисом от уровня прошлого кадра
+        int level = 0;
+        if (renderer.lods && renderer.lods->getLevelCount() > 1) {
+            const Vector3 center = bounds ? Vector3Scale(Vector3Add(box.min, box.max), 0.5f)
+                                          : Vector3{transform.m12, transform.m13, transform.m14};
+            renderer.lodLevel = selectLod(*renderer.lods, Vector3Distance(cameraPosition, center),
+                                          MaxAxisScale(transform), lodParams_, renderer.lodLevel);
+            level = renderer.lodLevel;
+            if (level > 0) ++stats.reducedLod;
+        }
+
+        // Палитра скиннинга — если модель рисуется скиннинг шейдером (иначе Animator
+        // уже обновил вершины на CPU и DrawList её пропустит)
+        const Matrix* bones = nullptr;
+        int boneCount = 0;
+        if (const auto* animator = registry_.try_get<Animator>(entity); animator && !animator->skinning.empty()) {
+            bones = animator->skinning.data();
+            boneCount = static_cast<int>(animator->skinning.size());
+        }
+
+        // Инстансинг: батчи по (меш, материал, уровень LOD) — и для модели целиком,
+        // и для отдельных узлов сцены (spawnModelScene)
+        if (batcher && !bones && !renderer.packed && ColorIsEqual(renderer.tint, WHITE) &&
+            renderer.meshIndex < model.meshCount) {
+            const int first = renderer.meshIndex < 0 ? 0 : renderer.meshIndex;
+            const int last = renderer.meshIndex < 0 ? model.meshCount : renderer.meshIndex + 1;
+            for (int m = first; m < last; ++m) {
+                batcher->submit(LodMesh(renderer, m, level), model.materials[model.meshMaterial[m]],
+                                world.matrix, &model.transform);
+            }
+            ++stats.submitted;
+            continue;
+        }
+
+        if (renderer.meshIndex < 0) {
+            if (!renderer.lods) {
+                drawList.submitModel(model, world.matrix, renderer.tint, renderer.packed.get(), bones, boneCount);
+            } else {
+                for (int m = 0; m < model.meshCount; ++m) {
+                    drawList.submit(LodMesh(renderer, m, level), model.materials[model.meshMaterial[m]], transform,
+                                    renderer.tint, LodPacked(renderer, m, level), bones, boneCount);
+                }
+            }
+            ++stats.submitted;
+            continue;
+        }
+        if (renderer.meshIndex >= model.meshCount) continue;
+
+        drawList.submit(LodMesh(renderer, renderer.meshIndex, level),
+                        model.materials[model.meshMaterial[renderer.meshIndex]], transform, renderer.tint,
+                        LodPacked(renderer, renderer.meshIndex, level), bones, boneCount);
+        ++stats.submitted;
+    }
+
+    if (batcher) {
+        batcher->build(batchPool_);
+        for (const InstanceBatch& batch : batcher->getBatches()) {
+            if (batch.count >= minInstances_) {
+                stats.instanced += static_cast<int>(batch.count);
+                continue;
+            }
+            // Матрицы батча уже включают model.transform
+            const Matrix* transforms = batcher->getTransforms(batch);
+            for (size_t i = 0; i < batch.count; ++i) {
+                drawList.submit(*batch.mesh, *batch.material, transforms[i]);
+            }
+        }
+    }
+    lastStats_ = stats;
+    return stats;
+}
+
+} // namespace kalan
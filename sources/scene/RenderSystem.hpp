@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Components.hpp"
+#include "../resources/ModelLod.hpp"
+#include <entt/entt.hpp>
+#include <array>
+
+namespace kalan {
+
+class DrawList;
+class ImageThreadPool;
+class InstanceBatcher;
+class OcclusionBuffer;
+
+// Плоскости фрустума (ax + by + cz + d >= 0 — внутри), из матрицы view * projection
+struct Frustum {
+    std::array<Vector4, 6> planes{};
+
+    [[nodiscard]] static Frustum fromMatrix(const Matrix& viewProjection);
+    // AABB в мировых координатах пересекает фрустум или лежит внутри
+    [[nodiscard]] bool intersects(const BoundingBox& box) const;
+};
+
+// Мировой AABB для локальных bounds под матрицей transform
+[[nodiscard]] BoundingBox transformBounds(const BoundingBox& local, const Matrix& transform);
+
+// Отправка сущностей с MeshRenderer и WorldTransform в DrawList.
+// Сущности с MeshBounds отсекаются по фрустуму текущей камеры и, если задан буфер
+// перекрытия (OcclusionSystem), по нему — он должен быть построен с той же камерой.
+// У сущностей с MeshRenderer::lods уровень выбирается по экранной ошибке (selectLod)
+// с гистерезисом от MeshRenderer::lodLevel прошлого кадра.
+//
+// С заданным InstanceBatcher меши сущностей без скиннинга, формата Packed и tint
+// собираются в батчи по (меш, материал, уровень LOD) — как модели целиком (meshIndex < 0),
+// так и отдельные узлы из spawnModelScene. Батчи от minInstances рисует
+// InstancedRenderer::draw(batcher, getMinInstances()) после DrawList::flush,
+// меньшие уходят в DrawList как обычно.
+class RenderSystem {
+public:
+    struct Stats {
+        int submitted = 0;
+        int culled = 0;
+        int occluded = 0;           // прошли фрустум, но перекрыты окклюдерами
+        int instanced = 0;          // мешей, нарисованных батчами InstancedRenderer
+        int reducedLod = 0;         // нарисованы уровнем LOD грубее исходного
+    };
+
+    explicit RenderSystem(entt::registry& registry) : registry_(registry) {}
+
+    // Вызывать внутри BeginMode3D: фрустум и позиция камеры берутся из текущих матриц
+    // rlgl, fovY и screenHeight параметров LOD — из проекции и размера кадра
+    Stats submit(DrawList& drawList);
+    // cameraPosition — для выбора LOD; параметры — как заданы setLodParams
+    Stats submit(DrawList& drawList, const Frustum& frustum, Vector3 cameraPosition);
+
+    void setCulling(bool enabled) noexcept { culling_ = enabled; }
+    [[nodiscard]] bool isCullingEnabled() const noexcept { return culling_; }
+    // nullptr — без отсечения перекрытых
+    void setOcclusion(const OcclusionBuffer* occlusion) noexcept { occlusion_ = occlusion; }
+    // batcher == nullptr — всё через DrawList. pool — для InstanceBatcher::build.
+    // Без инстансного варианта PBR шейдера батчинг не включается.
+    void setInstancing(InstanceBatcher* batcher, ImageThreadPool* pool = nullptr, size_t minInstances = 2) noexcept {
+        batcher_ = batcher;
+        batchPool_ = pool;
+        minInstances_ = minInstances;
+    }
+    [[nodiscard]] size_t getMinInstances() const noexcept { return minInstances_; }
+    // Порог и гистерезис выбора LOD
+    void setLodParams(const LodSelectParams& params) noexcept { lodParams_ = params; }
+    [[nodiscard]] const LodSelectParams& getLodParams() const noexcept { return lodParams_; }
+    [[nodiscard]] const Stats& getLastStats() const noexcept { return lastStats_; }
+
+private:
+    entt::registry& registry_;
+    bool culling_ = true;
+    const OcclusionBuffer* occlusion_ = nullptr;
+    InstanceBatcher* batcher_ = nullptr;
+    ImageThreadPool* batchPool_ = nullptr;
+    size_t minInstances_ = 2;
+    LodSelectParams lodParams_;
+    Stats lastStats_;
+};
+
+} // namespace kalan
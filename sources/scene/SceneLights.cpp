@@ -0,0 +1,44 @@
+#include "SceneLights.hpp"
+
+namespace kalan {
+
+SceneLights::SceneLights(entt::registry& registry) : registry_(registry) {
+    registry_.on_destroy<LightComponent>().connect<&SceneLights::onDestroy>(*this);
+}
+
+SceneLights::~SceneLights() {
+    registry_.on_destroy<LightComponent>().disconnect(this);
+}
+
+void SceneLights::onDestroy(entt::registry& registry, entt::entity entity) {
+    int slot = registry.get<LightComponent>(entity).slot;
+    if (slot < 0) return;
+    LightingSystem::instance().getLight(slot).enabled = false;
+    freeSlots_.push_back(slot);
+}
+
+void SceneLights::sync() {
+    auto& lighting = LightingSystem::instance();
+
+    registry_.view<LightComponent, WorldTransform>().each(
+        [&](LightComponent& lc, const WorldTransform& world) {
+            if (lc.slot < 0) {
+                if (!freeSlots_.empty()) {
+                    lc.slot = freeSlots_.back();
+                    freeSlots_.pop_back();
+                } else {
+                    lc.slot = lighting.addLight(lc.light);
+                    if (lc.slot < 0) return;   // MaxLights исчерпан
+                }
+            }
+
+            Light light = lc.light;
+            light.position = Vector3Transform(lc.light.position, world.matrix);
+            Vector3 origin = Vector3Transform({0.0f, 0.0f, 0.0f}, world.matrix);
+            light.direction = Vector3Normalize(Vector3Subtract(
+                Vector3Transform(lc.light.direction, world.matrix), origin));
+            lighting.getLight(lc.slot) = light;
+        });
+}
+
+} // namespace kalan
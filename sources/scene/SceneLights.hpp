@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Components.hpp"
+#include <entt/entt.hpp>
+#include <vector>
+
+namespace kalan {
+
+// Переносит LightComponent сущностей в LightingSystem с учётом WorldTransform.
+// Слоты уничтоженных источников отключаются и переиспользуются — индексы
+// остальных источников в LightingSystem не сдвигаются.
+class SceneLights {
+public:
+    explicit SceneLights(entt::registry& registry);
+    ~SceneLights();
+
+    SceneLights(const SceneLights&) = delete;
+    SceneLights& operator=(const SceneLights&) = delete;
+
+    // Вызывать после TransformSystem::update
+    void sync();
+
+private:
+    void onDestroy(entt::registry& registry, entt::entity entity);
+
+    entt::registry& registry_;
+    std::vector<int> freeSlots_;
+};
+
+} // namespace kalan
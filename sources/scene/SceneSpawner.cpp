@@ -0,0 +1,72 @@
+#include "SceneSpawner.hpp"
+#include "TransformSystem.hpp"
+#include "../resources/ParallelLoader.hpp"
+
+namespace kalan {
+
+namespace {
+
+void addMeshRenderer(entt::registry& registry, entt::entity entity, const LoadedModel& loaded, int meshIndex) {
+    registry.emplace<MeshRenderer>(entity, MeshRenderer{
+        .model = loaded.model,
+        .meshIndex = meshIndex,
+        .packed = loaded.packed,
+        .lods = loaded.lods,
+    });
+    if (meshIndex >= 0 && meshIndex < static_cast<int>(loaded.scene->meshBounds.size())) {
+        registry.emplace<MeshBounds>(entity, MeshBounds{loaded.scene->meshBounds[meshIndex]});
+    }
+    if (loaded.occluders) {
+        registry.emplace<Occluder>(entity, Occluder{.occluders = loaded.occluders, .meshIndex = meshIndex});
+    }
+}
+
+} // anonymous namespace
+
+entt::entity spawnModelScene(entt::registry& registry, const LoadedModel& loaded,
+                             const LocalTransform& root, entt::entity parent) {
+    entt::entity rootEntity = TransformSystem::createEntity(registry, root, parent);
+    if (!loaded.model) return rootEntity;
+
+    if (!loaded.scene) {
+        registry.emplace<MeshRenderer>(rootEntity, MeshRenderer{
+            .model = loaded.model,
+            .packed = loaded.packed,
+            .lods = loaded.lods,
+        });
+        if (loaded.occluders) {
+            registry.emplace<Occluder>(rootEntity, Occluder{.occluders = loaded.occluders});
+        }
+        return rootEntity;
+    }
+
+    const auto& nodes = loaded.scene->nodes;
+    std::vector<entt::entity> entities(nodes.size(), entt::null);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const ModelSceneNode& node = nodes[i];
+        // Родитель в списке всегда раньше ребёнка
+        entt::entity nodeParent = node.parent >= 0 ? entities[node.parent] : rootEntity;
+        entt::entity entity = TransformSystem::createEntity(registry, LocalTransform{
+            .translation = node.translation,
+            .rotation = node.rotation,
+            .scale = node.scale,
+        }, nodeParent);
+        registry.emplace<SceneNodeName>(entity, node.name);
+        entities[i] = entity;
+
+        if (node.meshes.size() == 1) {
+            addMeshRenderer(registry, entity, loaded, node.meshes.front());
+        } else {
+            for (int meshIndex : node.meshes) {
+                entt::entity meshEntity = TransformSystem::createEntity(registry, {}, entity);
+                addMeshRenderer(registry, meshEntity, loaded, meshIndex);
+            }
+        }
+    }
+
+    TraceLog(LOG_INFO, "SceneSpawner: %s -> %zu nodes, %d mesh instances",
+             loaded.report.path.c_str(), nodes.size(), loaded.scene->meshInstances);
+    return rootEntity;
+}
+
+} // namespace kalan
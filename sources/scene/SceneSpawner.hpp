@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Components.hpp"
+#include <entt/entt.hpp>
+
+namespace kalan {
+
+struct LoadedModel;
+
+// Создаёт поддерево сущностей по графу узлов загруженной модели (LoadOptions::keepHierarchy).
+// Узел — сущность с LocalTransform и SceneNodeName. Единственный меш узла вешается
+// на саму сущность, при нескольких — на дочерние сущности, по одной на меш.
+// Все MeshRenderer ссылаются на общую модель, поэтому повторно используемые меши
+// не дублируются. Без графа (scene == nullptr) создаётся одна сущность на всю модель.
+// С LoadOptions::buildOccluders сущности с мешами получают Occluder того же меша.
+// Возвращает корень поддерева; удалять через TransformSystem::destroySubtree.
+entt::entity spawnModelScene(entt::registry& registry, const LoadedModel& loaded,
+                             const LocalTransform& root = {}, entt::entity parent = entt::null);
+
+} // namespace kalan
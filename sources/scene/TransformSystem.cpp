@@ -0,0 +1,265 @@
+#include "TransformSystem.hpp"
+#include "../resources/ParallelLoader.hpp"
+#include "../core/Profiler.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace kalan {
+
+static constexpr uint32_t NoParent = UINT32_MAX;
+static constexpr uint32_t NoSlot = UINT32_MAX;
+
+TransformSystem::TransformSystem(entt::registry& registry)
+    : TransformSystem(registry, Settings{}) {}
+
+TransformSystem::TransformSystem(entt::registry& registry, const Settings& settings)
+    : registry_(registry), settings_(settings)
+{
+    registry_.on_construct<LocalTransform>().connect<&TransformSystem::onStructureChanged>(*this);
+    registry_.on_destroy<LocalTransform>().connect<&TransformSystem::onStructureChanged>(*this);
+    registry_.on_construct<Hierarchy>().connect<&TransformSystem::onStructureChanged>(*this);
+    registry_.on_update<Hierarchy>().connect<&TransformSystem::onStructureChanged>(*this);
+    registry_.on_destroy<Hierarchy>().connect<&TransformSystem::onStructureChanged>(*this);
+    registry_.on_update<LocalTransform>().connect<&TransformSystem::onLocalUpdated>(*this);
+}
+
+TransformSystem::~TransformSystem() {
+    registry_.on_construct<LocalTransform>().disconnect(this);
+    registry_.on_destroy<LocalTransform>().disconnect(this);
+    registry_.on_construct<Hierarchy>().disconnect(this);
+    registry_.on_update<Hierarchy>().disconnect(this);
+    registry_.on_destroy<Hierarchy>().disconnect(this);
+    registry_.on_update<LocalTransform>().disconnect(this);
+}
+
+// ============ Иерархия ============
+
+entt::entity TransformSystem::createEntity(entt::registry& registry, const LocalTransform& local,
+                                           entt::entity parent) {
+    entt::entity entity = registry.create();
+    registry.emplace<Hierarchy>(entity);
+    registry.emplace<WorldTransform>(entity);
+    registry.emplace<LocalTransform>(entity, local);
+    if (parent != entt::null) setParent(registry, entity, parent);
+    return entity;
+}
+
+void TransformSystem::setParent(entt::registry& registry, entt::entity child, entt::entity parent) {
+    // get_or_emplace может переаллоцировать хранилище — ссылки берём заново после каждого вызова
+    if (parent != entt::null) registry.get_or_emplace<Hierarchy>(parent);
+    registry.get_or_emplace<Hierarchy>(child);
+
+    Hierarchy current = registry.get<Hierarchy>(child);
+    if (current.parent == parent) return;
+
+    // Нельзя сделать узел потомком собственного потомка
+    for (entt::entity p = parent; p != entt::null && registry.all_of<Hierarchy>(p);
+         p = registry.get<Hierarchy>(p).parent) {
+        if (p == child) {
+            TraceLog(LOG_WARNING, "TransformSystem: setParent would create a cycle, ignored");
+            return;
+        }
+    }
+
+    // Отцепить от старого родителя
+    if (current.parent != entt::null) {
+        registry.patch<Hierarchy>(current.parent, [&](Hierarchy& h) {
+            if (h.firstChild == child) h.firstChild = current.nextSibling;
+            --h.childCount;
+        });
+        if (current.prevSibling != entt::null) {
+            registry.patch<Hierarchy>(current.prevSibling, [&](Hierarchy& h) { h.nextSibling = current.nextSibling; });
+        }
+        if (current.nextSibling != entt::null) {
+            registry.patch<Hierarchy>(current.nextSibling, [&](Hierarchy& h) { h.prevSibling = current.prevSibling; });
+        }
+    }
+
+    // Прицепить первым ребёнком нового
+    entt::entity next = entt::null;
+    if (parent != entt::null) {
+        registry.patch<Hierarchy>(parent, [&](Hierarchy& h) {
+            next = h.firstChild;
+            h.firstChild = child;
+            ++h.childCount;
+        });
+        if (next != entt::null) {
+            registry.patch<Hierarchy>(next, [&](Hierarchy& h) { h.prevSibling = child; });
+        }
+    }
+
+    registry.patch<Hierarchy>(child, [&](Hierarchy& h) {
+        h.parent = parent;
+        h.prevSibling = entt::null;
+        h.nextSibling = next;
+    });
+}
+
+void TransformSystem::destroySubtree(entt::registry& registry, entt::entity root) {
+    if (!registry.valid(root)) return;
+    setParent(registry, root, entt::null);
+
+    std::vector<entt::entity> stack{root};
+    std::vector<entt::entity> subtree;
+    while (!stack.empty()) {
+        entt::entity e = stack.back();
+        stack.pop_back();
+        subtree.push_back(e);
+        if (const auto* h = registry.try_get<Hierarchy>(e)) {
+            for (entt::entity c = h->firstChild; c != entt::null; c = registry.get<Hierarchy>(c).nextSibling) {
+                stack.push_back(c);
+            }
+        }
+    }
+    registry.destroy(subtree.begin(), subtree.end());
+}
+
+// ============ Сигналы ============
+
+void TransformSystem::onStructureChanged(entt::registry&, entt::entity) {
+    structureDirty_ = true;
+}
+
+void TransformSystem::onLocalUpdated(entt::registry&, entt::entity entity) {
+    if (structureDirty_) return;   // после перестройки пересчитается всё
+    uint32_t id = static_cast<uint32_t>(entt::to_entity(entity));
+    if (id >= slotOf_.size()) return;
+    uint32_t slot = slotOf_[id];
+    if (slot == NoSlot || dirty_[slot]) return;
+    dirty_[slot] = 1;
+    dirtyList_.push_back(slot);
+}
+
+// ============ Раскладка ============
+
+void TransformSystem::rebuild() {
+    entities_.clear();
+    parents_.clear();
+    levelStart_.clear();
+    dirtyList_.clear();
+
+    // Корни: без родителя или с родителем без LocalTransform
+    auto view = registry_.view<LocalTransform>();
+    for (entt::entity e : view) {
+        const auto* h = registry_.try_get<Hierarchy>(e);
+        if (!h || h->parent == entt::null || !registry_.all_of<LocalTransform>(h->parent)) {
+            entities_.push_back(e);
+            parents_.push_back(NoParent);
+        }
+    }
+
+    // Обход в ширину: дети каждого уровня идут непрерывным блоком
+    size_t levelBegin = 0;
+    while (levelBegin < entities_.size()) {
+        levelStart_.push_back(levelBegin);
+        size_t levelEnd = entities_.size();
+        for (size_t i = levelBegin; i < levelEnd; ++i) {
+            const auto* h = registry_.try_get<Hierarchy>(entities_[i]);
+            if (!h) continue;
+            for (entt::entity c = h->firstChild; c != entt::null; c = registry_.get<Hierarchy>(c).nextSibling) {
+                if (!registry_.all_of<LocalTransform>(c)) continue;
+                entities_.push_back(c);
+                parents_.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        levelBegin = levelEnd;
+    }
+    levelStart_.push_back(entities_.size());
+
+    const size_t count = entities_.size();
+    locals_.resize(count);
+    worlds_.resize(count);
+    dirty_.assign(count, 1);
+    changed_.assign(count, 0);
+
+    uint32_t maxId = 0;
+    for (entt::entity e : entities_) maxId = std::max(maxId, static_cast<uint32_t>(entt::to_entity(e)));
+    slotOf_.assign(count ? maxId + 1 : 0, NoSlot);
+    for (size_t i = 0; i < count; ++i) {
+        slotOf_[entt::to_entity(entities_[i])] = static_cast<uint32_t>(i);
+        registry_.get_or_emplace<WorldTransform>(entities_[i]);
+    }
+}
+
+// ============ Обновление ============
+
+template <typename Fn>
+void TransformSystem::forRange(ImageThreadPool* pool, size_t begin, size_t end, Fn&& fn) {
+    size_t count = end - begin;
+    if (pool && count >= settings_.parallelThreshold) {
+        pool->parallelFor(count, settings_.parallelChunk, [&](size_t b, size_t e) {
+            fn(begin + b, begin + e);
+        });
+    } else {
+        fn(begin, end);
+    }
+}
+
+TransformSystem::Stats TransformSystem::update(ImageThreadPool* pool) {
+    KALAN_PROFILE_ZONE("TransformSystem::update");
+    Stats stats;
+    bool allDirty = !settings_.useDirtyFlags;
+
+    if (structureDirty_) {
+        rebuild();
+        structureDirty_ = false;
+        stats.rebuilt = true;
+        allDirty = true;
+    }
+
+    stats.entities = entities_.size();
+    stats.levels = levelStart_.empty() ? 0 : levelStart_.size() - 1;
+    if (!allDirty && dirtyList_.empty()) return stats;
+
+    // Хранилища берём заранее: поиск пула в registry из воркеров небезопасен
+    auto& localStorage = registry_.storage<LocalTransform>();
+    auto& worldStorage = registry_.storage<WorldTransform>();
+
+    if (allDirty) {
+        forRange(pool, 0, entities_.size(), [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) {
+                locals_[i] = localStorage.get(entities_[i]).toMatrix();
+                dirty_[i] = 1;
+            }
+        });
+    } else {
+        forRange(pool, 0, dirtyList_.size(), [&](size_t b, size_t e) {
+            for (size_t k = b; k < e; ++k) {
+                uint32_t i = dirtyList_[k];
+                locals_[i] = localStorage.get(entities_[i]).toMatrix();
+            }
+        });
+    }
+
+    std::atomic<size_t> updated{0};
+    for (size_t level = 0; level + 1 < levelStart_.size(); ++level) {
+        forRange(pool, levelStart_[level], levelStart_[level + 1], [&](size_t b, size_t e) {
+            size_t local = 0;
+            for (size_t i = b; i < e; ++i) {
+                uint32_t p = parents_[i];
+                if (p == NoParent) {
+                    changed_[i] = dirty_[i];
+                    if (dirty_[i]) worlds_[i] = locals_[i];
+                } else {
+                    changed_[i] = dirty_[i] | changed_[p];
+                    if (changed_[i]) worlds_[i] = MatrixMultiply(locals_[i], worlds_[p]);
+                }
+                local += changed_[i];
+            }
+            updated.fetch_add(local, std::memory_order_relaxed);
+        });
+    }
+
+    forRange(pool, 0, entities_.size(), [&](size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) {
+            if (changed_[i]) worldStorage.get(entities_[i]).matrix = worlds_[i];
+            dirty_[i] = 0;
+        }
+    });
+    dirtyList_.clear();
+
+    stats.updated = updated.load();
+    return stats;
+}
+
+} // namespace kalan
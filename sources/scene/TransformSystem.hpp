@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Components.hpp"
+#include <entt/entt.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace kalan {
+
+class ImageThreadPool;
+
+// Распространение мировых матриц по иерархии.
+// Сущности с LocalTransform раскладываются в SoA массивы в порядке обхода в ширину:
+// уровень за уровнем, родитель всегда раньше ребёнка. Уровень обрабатывается
+// параллельно — узлы одного уровня независимы. Раскладка перестраивается только
+// при изменении структуры (создание/удаление сущностей, setParent).
+class TransformSystem {
+public:
+    struct Settings {
+        bool useDirtyFlags = true;      // false — пересчитывать все матрицы каждый кадр
+        size_t parallelThreshold = 4096;
+        size_t parallelChunk = 1024;
+    };
+
+    struct Stats {
+        size_t entities = 0;
+        size_t levels = 0;
+        size_t updated = 0;             // пересчитанных мировых матриц
+        bool rebuilt = false;
+    };
+
+    explicit TransformSystem(entt::registry& registry);
+    TransformSystem(entt::registry& registry, const Settings& settings);
+    ~TransformSystem();
+
+    TransformSystem(const TransformSystem&) = delete;
+    TransformSystem& operator=(const TransformSystem&) = delete;
+
+    // Создать сущность с LocalTransform/WorldTransform/Hierarchy
+    static entt::entity createEntity(entt::registry& registry, const LocalTransform& local = {},
+                                     entt::entity parent = entt::null);
+    // parent == entt::null — сделать корнем
+    static void setParent(entt::registry& registry, entt::entity child, entt::entity parent);
+    // Удалить сущность вместе с потомками
+    static void destroySubtree(entt::registry& registry, entt::entity root);
+
+    // pool == nullptr — однопоточно
+    Stats update(ImageThreadPool* pool = nullptr);
+
+    void setSettings(const Settings& settings) { settings_ = settings; }
+    [[nodiscard]] const Settings& getSettings() const noexcept { return settings_; }
+
+private:
+    void onStructureChanged(entt::registry&, entt::entity);
+    void onLocalUpdated(entt::registry&, entt::entity entity);
+
+    void rebuild();
+
+    template <typename Fn>
+    void forRange(ImageThreadPool* pool, size_t begin, size_t end, Fn&& fn);
+
+    entt::registry& registry_;
+    Settings settings_;
+    bool structureDirty_ = true;
+
+    // SoA в порядке BFS
+    std::vector<entt::entity> entities_;
+    std::vector<uint32_t> parents_;         // UINT32_MAX для корней
+    std::vector<Matrix> locals_;
+    std::vector<Matrix> worlds_;
+    std::vector<uint8_t> dirty_;            // локальная матрица изменилась
+    std::vector<uint8_t> changed_;          // мировая матрица пересчитана в этом кадре
+    std::vector<size_t> levelStart_;        // уровень L: [levelStart_[L], levelStart_[L + 1])
+
+    std::vector<uint32_t> slotOf_;          // entt::to_entity(e) -> индекс в SoA
+    std::vector<uint32_t> dirtyList_;
+};
+
+} // namespace kalan